@@ -0,0 +1,27 @@
+-- Bot profiles for the loadtesttool
+--
+-- weight:           relative amount of bots that are using the profile
+-- movesPerSecond:   how often the bot changes its movement
+-- attacksPerSecond: how often the bot attacks one of the entities it has seen
+-- sessionSeconds:   time after which the bot disconnects - 0 means that it stays until the tool quits
+-- reconnectSeconds: time a disconnected bot waits before it logs in again - negative means never
+
+profiles = {
+	walker = {
+		weight = 6,
+		movesPerSecond = 2,
+		attacksPerSecond = 0,
+		sessionSeconds = 0
+	},
+	fighter = {
+		weight = 3,
+		movesPerSecond = 1,
+		attacksPerSecond = 1
+	},
+	hopper = {
+		weight = 1,
+		movesPerSecond = 0.5,
+		sessionSeconds = 30,
+		reconnectSeconds = 5
+	}
+}
@@ -24,6 +24,7 @@
 #include "network/EntitySpawnHandler.h"
 #include "network/EntityUpdateHandler.h"
 #include "network/UserSpawnHandler.h"
+#include "network/VoxelUpdateHandler.h"
 #include "voxel/MaterialColor.h"
 #include "core/Rest.h"
 
@@ -101,6 +102,8 @@ core::AppState Client::onConstruct() {
 	core::Var::get(cfg::HTTPBaseURL, "https://localhost/");
 	_rotationSpeed = core::Var::getSafe(cfg::ClientMouseRotationSpeed);
 	_maxTargetDistance = core::Var::get(cfg::ClientCameraMaxTargetDistance, "250.0");
+	_interpolationDelay = core::Var::get(cfg::ClientInterpolationDelay, "100");
+	_maxExtrapolation = core::Var::get(cfg::ClientMaxExtrapolation, "200");
 	core::Var::get(cfg::VoxelMeshSize, "16", core::CV_READONLY);
 	_worldRenderer.onConstruct();
 
@@ -108,7 +111,7 @@ core::AppState Client::onConstruct() {
 }
 
 #define regHandler(type, handler, ...) \
-	r->registerHandler(network::EnumNameServerMsgType(type), std::make_shared<handler>(__VA_ARGS__));
+	r->registerHandler(type, std::make_shared<handler>(__VA_ARGS__));
 
 core::AppState Client::onInit() {
 	eventBus()->subscribe<network::NewConnectionEvent>(*this);
@@ -123,6 +126,7 @@ core::AppState Client::onInit() {
 	regHandler(network::ServerMsgType::UserSpawn, UserSpawnHandler);
 	regHandler(network::ServerMsgType::AuthFailed, AuthFailedHandler);
 	regHandler(network::ServerMsgType::Seed, SeedHandler, _world, _eventBus);
+	regHandler(network::ServerMsgType::VoxelUpdate, VoxelUpdateHandler, _world);
 
 	core::AppState state = Super::onInit();
 	if (state != core::AppState::Running) {
@@ -321,20 +325,23 @@ void Client::disconnect() {
 	_messageSender->sendClientMessage(fbb, network::ClientMsgType::UserDisconnect, network::CreateUserDisconnect(fbb).Union());
 }
 
-void Client::entityUpdate(frontend::ClientEntityId id, const glm::vec3& pos, float orientation) {
+void Client::entityUpdate(frontend::ClientEntityId id, uint64_t serverMillis, const glm::vec3& pos, float orientation) {
 	const frontend::ClientEntityPtr& entity = _worldRenderer.getEntity(id);
 	if (!entity) {
 		Log::warn("Could not get entity with id %li", id);
 		return;
 	}
-	entity->lerpPosition(pos, orientation);
+	entity->addSnapshot(serverMillis, pos, orientation);
 }
 
 void Client::entitySpawn(frontend::ClientEntityId id, network::EntityType type, float orientation, const glm::vec3& pos) {
 	Log::info("Entity %li spawned at pos %f:%f:%f (type %i)", id, pos.x, pos.y, pos.z, (int)type);
 	const std::string_view& meshName = "chr_skelett2_bake"; // core::string::toLower(network::EnumNameEntityType(type));
 	const video::MeshPtr& mesh = _meshPool->getMesh(meshName);
-	_worldRenderer.addEntity(std::make_shared<frontend::ClientEntity>(id, type, pos, orientation, mesh));
+	const frontend::ClientEntityPtr& entity = std::make_shared<frontend::ClientEntity>(id, type, pos, orientation, mesh);
+	entity->interpolation().setDelay(_interpolationDelay->intVal());
+	entity->interpolation().setMaxExtrapolation(_maxExtrapolation->intVal());
+	_worldRenderer.addEntity(entity);
 }
 
 void Client::entityRemove(frontend::ClientEntityId id) {
@@ -41,6 +41,8 @@ protected:
 	network::MoveDirection _lastMoveMask = network::MoveDirection::NONE;
 	core::VarPtr _rotationSpeed;
 	core::VarPtr _maxTargetDistance;
+	core::VarPtr _interpolationDelay;
+	core::VarPtr _maxExtrapolation;
 	frontend::ClientEntityPtr _player;
 	voxel::VoxelFont _voxelFont;
 	ui::turbobadger::WaitingMessage _waiting;
@@ -94,7 +96,7 @@ public:
 	void spawn(frontend::ClientEntityId id, const char *name, const glm::vec3& pos, float orientation);
 
 	void entitySpawn(frontend::ClientEntityId id, network::EntityType type, float orientation, const glm::vec3& pos);
-	void entityUpdate(frontend::ClientEntityId id, const glm::vec3& pos, float orientation);
+	void entityUpdate(frontend::ClientEntityId id, uint64_t serverMillis, const glm::vec3& pos, float orientation);
 	void entityRemove(frontend::ClientEntityId id);
 	frontend::ClientEntityPtr getEntity(frontend::ClientEntityId id) const;
 };
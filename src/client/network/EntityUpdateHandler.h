@@ -14,5 +14,5 @@ CLIENTPROTOHANDLERIMPL(EntityUpdate) {
 	const network::Vec3 *_pos = message->pos();
 	const glm::vec3 pos(_pos->x(), _pos->y(), _pos->z());
 	const float orientation = message->rotation();
-	client->entityUpdate(id, pos, orientation);
+	client->entityUpdate(id, message->serverTime(), pos, orientation);
 }
@@ -0,0 +1,32 @@
+/**
+ * @file
+ */
+
+#include "ServerMessages_generated.h"
+#include "VoxelUpdateHandler.h"
+#include "voxel/World.h"
+#include "core/Log.h"
+
+void VoxelUpdateHandler::execute(ENetPeer* peer, const void* raw) {
+	const network::VoxelUpdate* message = getMsg<network::VoxelUpdate>(raw);
+	_positions.clear();
+	_voxels.clear();
+	for (const network::VoxelChunkDelta* delta : *message->chunks()) {
+		const network::IVec3* chunk = delta->chunk();
+		if (chunk == nullptr) {
+			Log::warn("Received voxel changes without chunk position");
+			continue;
+		}
+		const glm::ivec3 chunkPos(chunk->x(), chunk->y(), chunk->z());
+		_changes.clear();
+		if (!voxel::decodeChunkDelta(delta->changes()->data(), delta->changes()->size(), _changes)) {
+			Log::warn("Failed to decode the voxel changes of chunk %i:%i:%i", chunkPos.x, chunkPos.y, chunkPos.z);
+			continue;
+		}
+		for (const voxel::VoxelChange& change : _changes) {
+			_positions.push_back(voxel::deltaPosition(chunkPos, change.index));
+			_voxels.push_back(change.voxel);
+		}
+	}
+	_world->setVoxels(_positions.data(), _voxels.data(), (int)_positions.size());
+}
@@ -0,0 +1,31 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "network/Network.h"
+#include "voxel/ChunkDelta.h"
+#include <vector>
+
+namespace voxel {
+class World;
+typedef std::shared_ptr<World> WorldPtr;
+}
+
+/**
+ * Handler that applies the voxel modifications of the server to the world that was created from the seed
+ */
+class VoxelUpdateHandler: public network::IProtocolHandler {
+private:
+	voxel::WorldPtr _world;
+	std::vector<voxel::VoxelChange> _changes;
+	std::vector<glm::ivec3> _positions;
+	std::vector<voxel::Voxel> _voxels;
+public:
+	VoxelUpdateHandler(const voxel::WorldPtr& world) :
+			_world(world) {
+	}
+
+	void execute(ENetPeer* peer, const void* message) override;
+};
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 #include <memory>
 
 #include "group/GroupId.h"
@@ -28,6 +29,29 @@ typedef std::vector<CharacterId> FilteredEntities;
 #define AI_NOTHING_SELECTED (-1)
 #endif
 
+class CompiledTree;
+typedef std::shared_ptr<CompiledTree> CompiledTreePtr;
+
+/**
+ * @brief The state of one node of a @ai{CompiledTree} for one @ai{AI} instance
+ */
+struct TreeNodeState {
+	int selectorState = AI_NOTHING_SELECTED;
+	int limitState = 0;
+	/**
+	 * The remaining time of a @ai{ITimedNode} or @c -1 if the timer is not started
+	 */
+	int64_t timerMillis = -1L;
+	/**
+	 * Only updated if we are in debugging mode for this entity
+	 */
+	int64_t lastExecMillis = -1L;
+	/**
+	 * Only updated if we are in debugging mode for this entity
+	 */
+	TreeNodeStatus lastStatus = UNKNOWN;
+};
+
 /**
  * @brief This is the type the library works with. It interacts with it's real world entity by
  * the @ai{ICharacter} interface.
@@ -40,13 +64,26 @@ typedef std::vector<CharacterId> FilteredEntities;
  */
 class AI : public NonCopyable, public std::enable_shared_from_this<AI> {
 	friend class TreeNode;
+	friend class CompiledTree;
 	friend class LUAAIRegistry;
 	friend class IFilter;
 	friend class Filter;
 	friend class Server;
 protected:
+	/**
+	 * The program of the behaviour - assigned with the first execution after the behaviour was set
+	 * @sa CompiledTree::execute()
+	 */
+	CompiledTreePtr _compiled;
+	/**
+	 * The state of every node of the compiled behaviour - indexed by the node ordinal
+	 */
+	typedef std::vector<TreeNodeState> TreeNodeStates;
+	TreeNodeStates _nodeStates;
+
 	/**
 	 * This map is only filled if we are in debugging mode for this entity
+	 * @note The maps below are only used for nodes that are not part of the compiled behaviour
 	 */
 	typedef std::unordered_map<int, TreeNodeStatus> NodeStates;
 	NodeStates _lastStatus;
@@ -141,6 +178,13 @@ public:
 	 */
 	bool isDebuggingActive() const;
 
+	/**
+	 * @brief Returns the state of the node with the given ordinal in the compiled behaviour
+	 * @return @c nullptr if the behaviour was not yet compiled for this ai or the node is not part of it
+	 */
+	TreeNodeState* getNodeState(int ordinal);
+	const TreeNodeState* getNodeState(int ordinal) const;
+
 	/**
 	 * @brief Get the current behaviour for this ai
 	 */
@@ -197,6 +241,20 @@ public:
 	}
 };
 
+inline TreeNodeState* AI::getNodeState(int ordinal) {
+	if (ordinal < 0 || ordinal >= (int)_nodeStates.size()) {
+		return nullptr;
+	}
+	return &_nodeStates[ordinal];
+}
+
+inline const TreeNodeState* AI::getNodeState(int ordinal) const {
+	if (ordinal < 0 || ordinal >= (int)_nodeStates.size()) {
+		return nullptr;
+	}
+	return &_nodeStates[ordinal];
+}
+
 inline TreeNodePtr AI::getBehaviour() const {
 	return _behaviour;
 }
@@ -284,6 +342,8 @@ inline void AI::update(int64_t dt, bool debuggingActive) {
 	if (_reset) {
 		// safe to do it like this, because update is not called from multiple threads
 		_reset = false;
+		_compiled.reset();
+		_nodeStates.clear();
 		_lastStatus.clear();
 		_lastExecMillis.clear();
 		_filteredEntities.clear();
@@ -7,94 +7,100 @@
  */
 #pragma once
 
-#include <vector>
-#include <memory>
+#include <limits>
 #include "ICharacter.h"
-#include <algorithm>
 #include "aggro/Entry.h"
+#include "common/InlineVector.h"
+#include "common/NonCopyable.h"
 
 namespace ai {
 
 /**
  * @brief Manages the aggro values for one @c AI instance. There are several ways to degrade the aggro values.
+ *
+ * The entries are stored inline - there is no heap allocation as long as there are not more than
+ * @c InlineEntries attackers. The aggro values are not reduced with every update, the entries derive their
+ * current value from the time that is shared by all entries (see @c EntryClock). The entries that dropped
+ * to zero are only removed once the earliest expiration time is reached.
+ *
+ * @note The entries are not ordered - use @c getHighestEntry() to get the entry with the highest aggro.
  */
-class AggroMgr {
+class AggroMgr : public NonCopyable {
 public:
-	typedef std::vector<Entry> Entries;
+	static const size_t InlineEntries = 8u;
+	typedef InlineVector<Entry, InlineEntries> Entries;
 	typedef Entries::iterator EntriesIter;
 protected:
 	mutable Entries _entries;
-
-	mutable bool _dirty;
+	mutable EntryClock _clock;
+	// index of the entry with the highest aggro - only valid if the clock is not dirty
+	mutable size_t _highest = 0u;
+	// all entries are reduced in the same way - the order of the entries doesn't change over time
+	mutable bool _uniform = true;
 
 	float _minAggro = 0.0f;
 	float _reduceRatioSecond = 0.0f;
 	float _reduceValueSecond = 0.0f;
 	ReductionType _reduceType = DISABLED;
 
-	class CharacterIdPredicate {
-	private:
-		const CharacterId& _id;
-	public:
-		explicit CharacterIdPredicate(const CharacterId& id) :
-			_id(id) {
-		}
-
-		inline bool operator()(const Entry &n1) {
-			return n1.getCharacterId() == _id;
-		}
-	};
-
-	static bool EntrySorter(const Entry& a, const Entry& b) {
-		if (a.getAggro() > b.getAggro()) {
-			return false;
-		}
-		if (::fabs(a.getAggro() - b.getAggro()) < 0.0000001f) {
-			return a.getCharacterId() < b.getCharacterId();
+	/**
+	 * @return @c true if @c a has a higher aggro than @c b - equal values are ordered by the character id
+	 */
+	static inline bool isHigher(const Entry& a, const Entry& b) {
+		const float aggroA = a.getAggro();
+		const float aggroB = b.getAggro();
+		if (::fabs(aggroA - aggroB) < 0.0000001f) {
+			return a.getCharacterId() > b.getCharacterId();
 		}
-		return true;
+		return aggroA > aggroB;
 	}
 
 	/**
-	 * @brief Remove the entries from the list that have no aggro left.
-	 * This list is ordered, so we will only remove the first X elements.
+	 * @brief Remove the entries from the list that have no aggro left - but only if one of them might have expired.
 	 */
-	void cleanupList() {
-		EntriesIter::difference_type remove = 0;
-		for (EntriesIter i = _entries.begin(); i != _entries.end(); ++i) {
-			const float aggroValue = i->getAggro();
-			if (aggroValue > 0.0f) {
-				break;
-			}
-
-			++remove;
-		}
-
-		if (remove == 0) {
+	void cleanupList() const {
+		if (_clock.millis < _clock.nextExpireMillis) {
 			return;
 		}
-
-		const int size = static_cast<int>(_entries.size());
-		if (size == remove) {
-			_entries.clear();
-			return;
+		int64_t nextExpire = std::numeric_limits<int64_t>::max();
+		for (size_t i = 0u; i < _entries.size();) {
+			const Entry& e = _entries[i];
+			if (e.getAggro() <= 0.0f) {
+				_entries.swapErase(i);
+				continue;
+			}
+			const int64_t expire = e.getExpireMillis();
+			if (expire < nextExpire) {
+				nextExpire = expire;
+			}
+			++i;
 		}
-
-		EntriesIter i = _entries.begin();
-		std::advance(i, remove);
-		_entries.erase(_entries.begin(), i);
+		if (nextExpire <= _clock.millis) {
+			nextExpire = _clock.millis + 1;
+		}
+		_clock.nextExpireMillis = nextExpire;
+		_clock.dirty = true;
 	}
 
-	inline void sort() const {
-		if (!_dirty) {
+	void updateHighest() const {
+		cleanupList();
+		if (!_clock.dirty || _entries.empty()) {
 			return;
 		}
-		std::sort(_entries.begin(), _entries.end(), EntrySorter);
-		_dirty = false;
+		_highest = 0u;
+		_uniform = true;
+		const Entry& first = _entries[0];
+		for (size_t i = 1u; i < _entries.size(); ++i) {
+			const Entry& e = _entries[i];
+			if (isHigher(e, _entries[_highest])) {
+				_highest = i;
+			}
+			_uniform &= e.hasSameReduction(first);
+		}
+		_clock.dirty = false;
 	}
 public:
-	explicit AggroMgr(std::size_t expectedEntrySize = 0u) :
-		_dirty(false) {
+	explicit AggroMgr(std::size_t expectedEntrySize = 0u) {
 		if (expectedEntrySize > 0) {
 			_entries.reserve(expectedEntrySize);
 		}
@@ -129,13 +135,14 @@ public:
 	 * @param[in] deltaMillis The current milliseconds to use to update the aggro value of the entries.
 	 */
 	void update(int64_t deltaMillis) {
-		for (EntriesIter i = _entries.begin(); i != _entries.end(); ++i) {
-			_dirty |= i->reduceByTime(deltaMillis);
+		_clock.millis += deltaMillis;
+		if (_entries.empty()) {
+			return;
 		}
-
-		if (_dirty) {
-			sort();
-			cleanupList();
+		cleanupList();
+		if (!_uniform) {
+			// the entries are reduced differently - the highest entry might have changed
+			_clock.dirty = true;
 		}
 	}
 
@@ -144,12 +151,19 @@ public:
 	 * @param[in] id The entity id to increase the aggro against
 	 * @param[in] amount The amount to increase the aggro for
 	 * @return The aggro @c Entry that was added or updated. Useful for changing the reduce type or amount.
+	 * @note The returned pointer is only valid until the next call to a non-const method of the manager.
 	 */
 	EntryPtr addAggro(CharacterId id, float amount) {
-		const CharacterIdPredicate p(id);
-		EntriesIter i = std::find_if(_entries.begin(), _entries.end(), p);
-		if (i == _entries.end()) {
-			Entry newEntry(id, amount);
+		const bool dirty = _clock.dirty;
+		size_t index = 0u;
+		const size_t size = _entries.size();
+		for (; index < size; ++index) {
+			if (_entries[index].getCharacterId() == id) {
+				break;
+			}
+		}
+		if (index == size) {
+			Entry newEntry(id, amount, &_clock);
 			switch (_reduceType) {
 			case RATIO:
 				newEntry.setReduceByRatio(_reduceRatioSecond, _minAggro);
@@ -158,38 +172,47 @@ public:
 				newEntry.setReduceByValue(_reduceValueSecond);
 				break;
 			default:
+				// no reduction - but the entry might still have to be removed if the amount was zero
+				newEntry.addAggro(0.0f);
 				break;
 			}
 			_entries.push_back(newEntry);
-			_dirty = true;
-			return &_entries.back();
+			if (size > 0u) {
+				_uniform &= newEntry.hasSameReduction(_entries[0]);
+			}
+		} else {
+			_entries[index].addAggro(amount);
 		}
 
-		i->addAggro(amount);
-		_dirty = true;
-		return &*i;
+		// an increased aggro value can only make this entry the new highest one
+		if (!dirty && size > 0u) {
+			_clock.dirty = false;
+			if (isHigher(_entries[index], _entries[_highest])) {
+				_highest = index;
+			}
+		}
+		return &_entries[index];
 	}
 
 	/**
-	 * @return All the aggro entries
+	 * @return All the aggro entries - they are not ordered
 	 */
 	const Entries& getEntries() const {
+		cleanupList();
 		return _entries;
 	}
 
 	/**
 	 * @brief Get the entry with the highest aggro value.
 	 *
-	 * @note Might execute a sort on the list if its dirty
+	 * @note Might scan the entries if an entry was modified
 	 */
 	EntryPtr getHighestEntry() const {
+		updateHighest();
 		if (_entries.empty()) {
 			return nullptr;
 		}
-
-		sort();
-
-		return &_entries.back();
+		return &_entries[_highest];
 	}
 };
 
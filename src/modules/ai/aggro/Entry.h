@@ -4,6 +4,8 @@
 #pragma once
 
 #include "common/Types.h"
+#include <limits>
+#include <math.h>
 
 namespace ai {
 
@@ -11,34 +13,63 @@ enum ReductionType {
 	DISABLED, RATIO, VALUE
 };
 
+/**
+ * @brief The time base that is shared by all entries of one @c AggroMgr
+ *
+ * The entries don't reduce their aggro with every update - they store the aggro value of the time
+ * they were last modified and derive the current value from the elapsed time.
+ */
+struct EntryClock {
+	int64_t millis = 0;
+	/**
+	 * The earliest time at which one of the entries might drop to zero aggro
+	 */
+	int64_t nextExpireMillis = std::numeric_limits<int64_t>::max();
+	/**
+	 * An entry was modified - the order of the entries might have changed
+	 */
+	bool dirty = false;
+};
+
 /**
  * @brief One entry for the @c AggroMgr
  */
 class Entry {
 protected:
+	// the aggro value at the time @c _stampMillis
 	float _aggro;
 	float _minAggro;
 	float _reduceRatioSecond;
 	float _reduceValueSecond;
 	ReductionType _reduceType;
 	CharacterId _id;
+	int64_t _stampMillis;
+	EntryClock* _clock;
+
+	int64_t now() const;
+	/**
+	 * @brief Stores the current aggro value - must be called before the value or the reduction is changed
+	 */
+	void materialize();
+	void changed();
 
 	void reduceByRatio(float ratio);
 	void reduceByValue(float value);
 
 public:
-	Entry(const CharacterId& id, float aggro = 0.0f) :
-			_aggro(aggro), _minAggro(0.0f), _reduceRatioSecond(0.0f), _reduceValueSecond(0.0f), _reduceType(DISABLED), _id(id) {
+	Entry(const CharacterId& id = CharacterId(), float aggro = 0.0f, EntryClock* clock = nullptr) :
+			_aggro(aggro), _minAggro(0.0f), _reduceRatioSecond(0.0f), _reduceValueSecond(0.0f), _reduceType(DISABLED), _id(id),
+			_stampMillis(clock != nullptr ? clock->millis : 0), _clock(clock) {
 	}
 
 	Entry(const Entry &other) :
 			_aggro(other._aggro), _minAggro(other._minAggro), _reduceRatioSecond(other._reduceRatioSecond), _reduceValueSecond(other._reduceValueSecond), _reduceType(
-					other._reduceType), _id(other._id) {
+					other._reduceType), _id(other._id), _stampMillis(other._stampMillis), _clock(other._clock) {
 	}
 
 	Entry(Entry &&other) :
 			_aggro(other._aggro), _minAggro(other._minAggro), _reduceRatioSecond(other._reduceRatioSecond), _reduceValueSecond(other._reduceValueSecond), _reduceType(
-					other._reduceType), _id(other._id) {
+					other._reduceType), _id(other._id), _stampMillis(other._stampMillis), _clock(other._clock) {
 	}
 
 	float getAggro() const;
@@ -51,6 +82,15 @@ public:
 	bool reduceByTime(int64_t millis);
 	void resetAggro();
 
+	/**
+	 * @return The time of the @c EntryClock at which the aggro drops to zero
+	 */
+	int64_t getExpireMillis() const;
+	/**
+	 * @return @c true if both entries reduce their aggro in the same way
+	 */
+	bool hasSameReduction(const Entry& other) const;
+
 	const CharacterId& getCharacterId() const;
 	bool operator <(Entry& other) const;
 	Entry& operator=(const Entry& other);
@@ -58,31 +98,61 @@ public:
 
 typedef Entry* EntryPtr;
 
+inline int64_t Entry::now() const {
+	return _clock != nullptr ? _clock->millis : _stampMillis;
+}
+
+inline void Entry::materialize() {
+	_aggro = getAggro();
+	_stampMillis = now();
+}
+
+inline void Entry::changed() {
+	if (_clock == nullptr) {
+		return;
+	}
+	_clock->dirty = true;
+	const int64_t expire = getExpireMillis();
+	if (expire < _clock->nextExpireMillis) {
+		_clock->nextExpireMillis = expire;
+	}
+}
+
 inline void Entry::addAggro(float aggro) {
+	materialize();
 	_aggro += aggro;
+	changed();
 }
 
 inline void Entry::setReduceByRatio(float reduceRatioSecond, float minAggro) {
+	materialize();
 	_reduceType = RATIO;
 	_reduceRatioSecond = reduceRatioSecond;
 	_minAggro = minAggro;
+	changed();
 }
 
 inline void Entry::setReduceByValue(float reduceValueSecond) {
+	materialize();
 	_reduceType = VALUE;
 	_reduceValueSecond = reduceValueSecond;
+	changed();
 }
 
 inline bool Entry::reduceByTime(int64_t millis) {
 	switch (_reduceType) {
 	case RATIO: {
+		materialize();
 		const float f = static_cast<float>(millis) / 1000.0f;
 		reduceByRatio(f * _reduceRatioSecond);
+		changed();
 		return true;
 	}
 	case VALUE: {
+		materialize();
 		const float f = static_cast<float>(millis) / 1000.0f;
 		reduceByValue(f * _reduceValueSecond);
+		changed();
 		return true;
 	}
 	case DISABLED:
@@ -107,15 +177,69 @@ inline void Entry::reduceByValue(float value) {
 }
 
 inline float Entry::getAggro() const {
+	const int64_t elapsedMillis = now() - _stampMillis;
+	if (elapsedMillis <= 0 || _aggro <= 0.0f) {
+		return _aggro;
+	}
+	const float seconds = static_cast<float>(elapsedMillis) / 1000.0f;
+	switch (_reduceType) {
+	case RATIO: {
+		if (_reduceRatioSecond >= 1.0f) {
+			return 0.0f;
+		}
+		const float aggro = _aggro * ::powf(1.0f - _reduceRatioSecond, seconds);
+		return aggro < _minAggro ? 0.0f : aggro;
+	}
+	case VALUE: {
+		const float aggro = _aggro - seconds * _reduceValueSecond;
+		return aggro < 0.000001f ? 0.0f : aggro;
+	}
+	case DISABLED:
+		break;
+	}
 	return _aggro;
 }
 
+inline int64_t Entry::getExpireMillis() const {
+	if (_aggro <= 0.0f) {
+		return _stampMillis;
+	}
+	double seconds;
+	switch (_reduceType) {
+	case RATIO:
+		if (_reduceRatioSecond <= 0.0f || _minAggro <= 0.0f) {
+			return std::numeric_limits<int64_t>::max();
+		}
+		if (_reduceRatioSecond >= 1.0f || _aggro < _minAggro) {
+			return _stampMillis + 1;
+		}
+		seconds = ::log((double)_minAggro / (double)_aggro) / ::log(1.0 - (double)_reduceRatioSecond);
+		break;
+	case VALUE:
+		if (_reduceValueSecond <= 0.0f) {
+			return std::numeric_limits<int64_t>::max();
+		}
+		seconds = ((double)_aggro - 0.000001) / (double)_reduceValueSecond;
+		break;
+	default:
+		return std::numeric_limits<int64_t>::max();
+	}
+	return _stampMillis + (int64_t)::ceil(seconds * 1000.0);
+}
+
+inline bool Entry::hasSameReduction(const Entry& other) const {
+	return _reduceType == other._reduceType && _reduceRatioSecond == other._reduceRatioSecond
+			&& _reduceValueSecond == other._reduceValueSecond && _minAggro == other._minAggro;
+}
+
 inline void Entry::resetAggro() {
 	_aggro = 0.0f;
+	_stampMillis = now();
+	changed();
 }
 
 inline bool Entry::operator <(Entry& other) const {
-	return _aggro < other._aggro;
+	return getAggro() < other.getAggro();
 }
 
 inline Entry& Entry::operator=(const Entry& other) {
@@ -125,6 +249,8 @@ inline Entry& Entry::operator=(const Entry& other) {
 	_reduceValueSecond = other._reduceValueSecond;
 	_reduceType = other._reduceType;
 	_id = other._id;
+	_stampMillis = other._stampMillis;
+	_clock = other._clock;
 	return *this;
 }
 
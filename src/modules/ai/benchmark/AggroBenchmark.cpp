@@ -0,0 +1,43 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "aggro/AggroMgr.h"
+#include <memory>
+
+namespace {
+
+const int Targets = 1000;
+
+/**
+ * @brief Lets every attacker hit its target with every tick, the aggro is reduced by value and the
+ * target selects the attacker with the highest aggro afterwards.
+ *
+ * The first argument is the amount of attackers per target.
+ */
+void aggroTick(benchmark::State& state) {
+	const int attackers = (int)state.range(0);
+	std::unique_ptr<ai::AggroMgr[]> mgrs(new ai::AggroMgr[Targets]);
+	for (int i = 0; i < Targets; ++i) {
+		mgrs[i].setReduceByValue(1.0f);
+	}
+	int tick = 0;
+	while (state.KeepRunning()) {
+		for (int i = 0; i < Targets; ++i) {
+			ai::AggroMgr& mgr = mgrs[i];
+			// only a part of the attackers is hitting with each tick
+			for (int a = tick % 4; a < attackers; a += 4) {
+				mgr.addAggro(a, (float)(1 + ((a + i) % 7)));
+			}
+			mgr.update(100L);
+			benchmark::DoNotOptimize(mgr.getHighestEntry());
+		}
+		++tick;
+	}
+	state.SetItemsProcessed(state.iterations() * Targets);
+}
+
+}
+
+BENCHMARK(aggroTick)->Arg(4)->Arg(8)->Arg(32)->Arg(128);
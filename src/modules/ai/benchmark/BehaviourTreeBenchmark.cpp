@@ -0,0 +1,202 @@
+/**
+ * @file
+ */
+
+#include "core/benchmark/AbstractBenchmark.h"
+#include "core/App.h"
+#include "core/Log.h"
+#include "SimpleAI.h"
+#include "tree/loaders/lua/LUATreeLoader.h"
+#include <vector>
+
+namespace {
+
+const int AIs = 50000;
+const char *Trees[] = { "ANIMAL_WOLF", "ANIMAL_RABBIT", "BLACKSMITH" };
+const int TreeAmount = sizeof(Trees) / sizeof(Trees[0]);
+
+/**
+ * @brief Stands in for the tasks of the backend that the shipped trees are using
+ */
+class StandInTask: public ai::ITask {
+public:
+	StandInTask(const std::string& name, const std::string& parameters, const ai::ConditionPtr& condition, const std::string& type) :
+			ai::ITask(name, parameters, condition) {
+		_type = type;
+	}
+
+	ai::TreeNodeStatus doAction(const ai::AIPtr& entity, int64_t deltaMillis) override {
+		return ai::FINISHED;
+	}
+};
+
+class StandInTaskFactory: public ai::ITreeNodeFactory {
+private:
+	std::string _type;
+public:
+	StandInTaskFactory(const std::string& type) :
+			_type(type) {
+	}
+
+	ai::TreeNodePtr create(const ai::TreeNodeFactoryContext *ctx) const override {
+		return std::make_shared<StandInTask>(ctx->name, ctx->parameters, ctx->condition, _type);
+	}
+};
+
+/**
+ * @brief Stands in for the conditions of the backend - the result only depends on the character id, so
+ * every tree takes the same branches with every tick.
+ */
+class StandInCondition: public ai::ICondition {
+private:
+	int _modulo;
+public:
+	StandInCondition(const std::string& name, const std::string& parameters, int modulo) :
+			ai::ICondition(name, parameters), _modulo(modulo) {
+	}
+
+	bool evaluate(const ai::AIPtr& entity) override {
+		return entity->getId() % _modulo == 0;
+	}
+};
+
+class StandInConditionFactory: public ai::IConditionFactory {
+private:
+	std::string _type;
+	int _modulo;
+public:
+	StandInConditionFactory(const std::string& type, int modulo) :
+			_type(type), _modulo(modulo) {
+	}
+
+	ai::ConditionPtr create(const ai::ConditionFactoryContext *ctx) const override {
+		return std::make_shared<StandInCondition>(_type, ctx->parameters, _modulo);
+	}
+};
+
+/**
+ * @brief Stands in for the filters of the backend - every third character selects its neighbour
+ */
+class StandInFilter: public ai::IFilter {
+public:
+	StandInFilter(const std::string& name, const std::string& parameters) :
+			ai::IFilter(name, parameters) {
+	}
+
+	void filter(const ai::AIPtr& entity) override {
+		ai::FilteredEntities& entities = getFilteredEntities(entity);
+		entities.clear();
+		const ai::CharacterId id = entity->getId();
+		if (id % 3 == 0) {
+			entities.push_back((id + 1) % AIs);
+		}
+	}
+};
+
+class StandInFilterFactory: public ai::IFilterFactory {
+private:
+	std::string _type;
+public:
+	StandInFilterFactory(const std::string& type) :
+			_type(type) {
+	}
+
+	ai::FilterPtr create(const ai::FilterFactoryContext *ctx) const override {
+		return std::make_shared<StandInFilter>(_type, ctx->parameters);
+	}
+};
+
+}
+
+/**
+ * @brief Ticks the behaviour trees that are shipped with the server for a lot of ai instances.
+ *
+ * The backend specific nodes are replaced by stand-ins, the structure of the trees is the same.
+ * The first argument selects the execution: @c 0 walks the @c TreeNode graph, @c 1 executes the
+ * @c CompiledTree.
+ */
+class BehaviourTreeBenchmark: public core::AbstractBenchmark {
+protected:
+	const StandInTaskFactory _spawn { "Spawn" };
+	const StandInTaskFactory _triggerCooldown { "TriggerCooldown" };
+	const StandInTaskFactory _triggerCooldownOnSelection { "TriggerCooldownOnSelection" };
+	const StandInTaskFactory _attackOnSelection { "AttackOnSelection" };
+	const StandInTaskFactory _setPointOfInterest { "SetPointOfInterest" };
+	const StandInConditionFactory _isOnCooldown { "IsOnCooldown", 2 };
+	const StandInConditionFactory _isCloseToSelection { "IsCloseToSelection", 6 };
+	const StandInConditionFactory _isSelectionAlive { "IsSelectionAlive", 1 };
+	const StandInFilterFactory _selectIncreasePartner { "SelectIncreasePartner" };
+	const StandInFilterFactory _selectEntitiesOfTypes { "SelectEntitiesOfTypes" };
+
+	ai::AIRegistry _registry;
+	ai::LUATreeLoader _loader { _registry };
+	ai::Zone _zone { "benchmark" };
+	std::vector<ai::AIPtr> _ais;
+
+public:
+	bool onInitApp() override {
+		_registry.registerNodeFactory("Spawn", _spawn);
+		_registry.registerNodeFactory("TriggerCooldown", _triggerCooldown);
+		_registry.registerNodeFactory("TriggerCooldownOnSelection", _triggerCooldownOnSelection);
+		_registry.registerNodeFactory("AttackOnSelection", _attackOnSelection);
+		_registry.registerNodeFactory("SetPointOfInterest", _setPointOfInterest);
+		_registry.registerConditionFactory("IsOnCooldown", _isOnCooldown);
+		_registry.registerConditionFactory("IsCloseToSelection", _isCloseToSelection);
+		_registry.registerConditionFactory("IsSelectionAlive", _isSelectionAlive);
+		_registry.registerFilterFactory("SelectIncreasePartner", _selectIncreasePartner);
+		_registry.registerFilterFactory("SelectEntitiesOfTypes", _selectEntitiesOfTypes);
+
+		const io::FilesystemPtr& filesystem = core::App::getInstance()->filesystem();
+		if (!_loader.init(filesystem->load("behaviourtrees.lua"))) {
+			Log::error("could not load the behaviourtrees: %s", _loader.getError().c_str());
+			return false;
+		}
+		_ais.reserve(AIs);
+		for (int i = 0; i < AIs; ++i) {
+			const ai::TreeNodePtr& tree = _loader.load(Trees[i % TreeAmount]);
+			if (!tree) {
+				Log::error("could not find the behaviour tree %s", Trees[i % TreeAmount]);
+				return false;
+			}
+			const ai::AIPtr& ai = std::make_shared<ai::AI>(tree);
+			ai->setCharacter(std::make_shared<ai::ICharacter>(i));
+			_zone.addAI(ai);
+			_ais.push_back(ai);
+		}
+		// process the scheduled adds
+		_zone.update(0L);
+		return true;
+	}
+
+	void onCleanupApp() override {
+		for (const ai::AIPtr& ai : _ais) {
+			_zone.removeAI(ai);
+		}
+		_zone.update(0L);
+		_ais.clear();
+		_loader.shutdown();
+	}
+};
+
+BENCHMARK_DEFINE_F(BehaviourTreeBenchmark, tick)(benchmark::State& state) {
+	const bool compiled = state.range(0) != 0;
+	if (!compiled) {
+		// drop the compiled behaviour from the zone update - the node states are stored in the maps again
+		for (const ai::AIPtr& ai : _ais) {
+			ai->setBehaviour(ai->getBehaviour());
+		}
+	}
+	while (state.KeepRunning()) {
+		for (const ai::AIPtr& ai : _ais) {
+			ai->update(100L, false);
+			if (compiled) {
+				ai::CompiledTree::execute(ai, 100L);
+			} else {
+				ai->getBehaviour()->execute(ai, 100L);
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * _ais.size());
+}
+
+BENCHMARK_REGISTER_F(BehaviourTreeBenchmark, tick)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
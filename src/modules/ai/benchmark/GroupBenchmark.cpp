@@ -0,0 +1,74 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "group/GroupMgr.h"
+#include <vector>
+
+namespace {
+
+const int Groups = 100;
+const int MembersPerGroup = 50;
+
+struct GroupSetup {
+	ai::GroupMgr mgr;
+	std::vector<ai::AIPtr> ais;
+
+	GroupSetup() {
+		ais.reserve(Groups * MembersPerGroup);
+		for (int i = 0; i < Groups * MembersPerGroup; ++i) {
+			const ai::AIPtr& ai = std::make_shared<ai::AI>(ai::TreeNodePtr());
+			ai->setCharacter(std::make_shared<ai::ICharacter>(i));
+			ai->getCharacter()->setPosition(glm::vec3((float)i, 0.0f, (float)(i % 7)));
+			mgr.add(i % Groups, ai);
+			ais.push_back(ai);
+		}
+		mgr.update(0L);
+	}
+};
+
+GroupSetup& setup() {
+	static GroupSetup s;
+	return s;
+}
+
+/**
+ * @brief Runs the group queries that the group conditions and steerings are doing from several threads
+ */
+void groupQueries(benchmark::State& state) {
+	const GroupSetup& s = setup();
+	const ai::GroupMgr& mgr = s.mgr;
+	const int amount = (int)s.ais.size();
+	int i = state.thread_index * 997;
+	while (state.KeepRunning()) {
+		const ai::AIPtr& ai = s.ais[i % amount];
+		const ai::GroupId groupId = i % Groups;
+		benchmark::DoNotOptimize(mgr.isInGroup(groupId, ai));
+		benchmark::DoNotOptimize(mgr.isGroupLeader(groupId, ai));
+		benchmark::DoNotOptimize(mgr.getGroupSize(groupId));
+		benchmark::DoNotOptimize(mgr.getPosition(groupId));
+		++i;
+	}
+	state.SetItemsProcessed(state.iterations() * 4);
+}
+
+/**
+ * @brief Moves some of the group members and updates the average group positions
+ */
+void groupUpdate(benchmark::State& state) {
+	GroupSetup& s = setup();
+	int tick = 0;
+	while (state.KeepRunning()) {
+		for (size_t i = tick % 10; i < s.ais.size(); i += 10) {
+			s.ais[i]->getCharacter()->setPosition(glm::vec3((float)(i + tick), 0.0f, 0.0f));
+		}
+		s.mgr.update(100L);
+		++tick;
+	}
+}
+
+}
+
+BENCHMARK(groupQueries)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(groupUpdate);
@@ -0,0 +1,130 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "SimpleAI.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <string.h>
+#include <vector>
+
+namespace {
+
+const int AIs = 20000;
+const short Port = 10101;
+
+int connectDebugger() {
+	const int fd = socket(PF_INET, SOCK_STREAM, IPPROTO_TCP);
+	struct sockaddr_in sin;
+	memset(&sin, 0, sizeof(sin));
+	sin.sin_family = AF_INET;
+	sin.sin_port = htons(Port);
+	sin.sin_addr.s_addr = inet_addr("127.0.0.1");
+	if (connect(fd, (struct sockaddr*) &sin, sizeof(sin)) != 0) {
+		close(fd);
+		return -1;
+	}
+	fcntl(fd, F_SETFL, O_NONBLOCK);
+	return fd;
+}
+
+void sendMessage(int fd, const ai::IProtocolMessage& msg) {
+	ai::streamContainer out;
+	msg.serialize(out);
+	ai::streamContainer data;
+	ai::IProtocolMessage::addInt(data, static_cast<int32_t>(out.size()));
+	data.insert(data.end(), out.begin(), out.end());
+	const std::vector<uint8_t> buf(data.begin(), data.end());
+	send(fd, buf.data(), buf.size(), 0);
+}
+
+/**
+ * @return The amount of bytes the debugger received
+ */
+size_t drain(int fd) {
+	size_t received = 0u;
+	uint8_t buf[65536];
+	for (;;) {
+		const ssize_t len = recv(fd, buf, sizeof(buf), 0);
+		if (len <= 0) {
+			break;
+		}
+		received += len;
+	}
+	return received;
+}
+
+}
+
+/**
+ * @brief Measures the tick of a zone with 20k ai instances and the debug server.
+ *
+ * Every tick a tenth of the characters is moving. The first argument selects the debugger: @c 0 means
+ * that no debugger is connected, @c 1 attaches a debugger that watches the whole zone, @c 2 attaches a
+ * debugger that filters the entities by an area.
+ */
+void serverTick(benchmark::State& state) {
+	const int debugger = (int)state.range(0);
+	ai::AIRegistry registry;
+	ai::Zone zone("benchmark");
+	ai::Server server(registry, Port, "127.0.0.1");
+	if (!server.start()) {
+		state.SkipWithError("could not start the server");
+		return;
+	}
+	server.addZone(&zone);
+
+	const ai::TreeNodePtr& root = std::make_shared<ai::PrioritySelector>("root", "", ai::True::get());
+	std::vector<ai::ICharacterPtr> characters;
+	characters.reserve(AIs);
+	for (int i = 0; i < AIs; ++i) {
+		const ai::AIPtr& ai = std::make_shared<ai::AI>(root);
+		const ai::ICharacterPtr& chr = std::make_shared<ai::ICharacter>(i);
+		chr->setPosition(glm::vec3((float)(i % 200), 0.0f, (float)(i / 200)));
+		ai->setCharacter(chr);
+		zone.addAI(ai);
+		characters.push_back(chr);
+	}
+	zone.update(0L);
+
+	int fd = -1;
+	if (debugger > 0) {
+		fd = connectDebugger();
+		if (fd == -1) {
+			state.SkipWithError("could not connect the debugger");
+			return;
+		}
+		// accept the connection
+		server.update(0L);
+		server.setDebug("benchmark");
+		if (debugger == 2) {
+			sendMessage(fd, ai::AIFilterMessage(ai::AIStateFilter(glm::vec3(100.0f, 0.0f, 50.0f), 20.0f)));
+		}
+		server.update(0L);
+	}
+
+	size_t received = 0u;
+	int tick = 0;
+	while (state.KeepRunning()) {
+		for (int i = tick % 10; i < AIs; i += 10) {
+			const ai::ICharacterPtr& chr = characters[i];
+			chr->setPosition(chr->getPosition() + glm::vec3(0.0f, (tick & 1) ? 1.0f : -1.0f, 0.0f));
+		}
+		zone.update(100L);
+		server.update(100L);
+		if (fd != -1) {
+			received += drain(fd);
+		}
+		++tick;
+	}
+	state.counters["bytes/tick"] = (double)received / (double)state.iterations();
+	if (fd != -1) {
+		close(fd);
+	}
+}
+
+BENCHMARK(serverTick)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,142 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include <vector>
+#include <stddef.h>
+
+namespace ai {
+
+/**
+ * @brief A vector that stores up to @c N elements inline and only allocates if it grows beyond that.
+ *
+ * The elements are always stored contiguously - once the inline storage is exceeded, all elements are
+ * moved into the heap storage. The elements must be default constructible and copyable.
+ */
+template<class T, size_t N>
+class InlineVector {
+private:
+	T _inline[N];
+	std::vector<T> _heap;
+	size_t _size = 0u;
+	bool _onHeap = false;
+
+	void moveToHeap(size_t capacity) {
+		_heap.reserve(capacity);
+		_heap.assign(_inline, _inline + _size);
+		_onHeap = true;
+	}
+public:
+	typedef T value_type;
+	typedef T* iterator;
+	typedef const T* const_iterator;
+
+	inline T* data() {
+		return _onHeap ? _heap.data() : _inline;
+	}
+
+	inline const T* data() const {
+		return _onHeap ? _heap.data() : _inline;
+	}
+
+	inline iterator begin() {
+		return data();
+	}
+
+	inline iterator end() {
+		return data() + size();
+	}
+
+	inline const_iterator begin() const {
+		return data();
+	}
+
+	inline const_iterator end() const {
+		return data() + size();
+	}
+
+	inline size_t size() const {
+		return _onHeap ? _heap.size() : _size;
+	}
+
+	inline bool empty() const {
+		return size() == 0u;
+	}
+
+	/**
+	 * @return @c true if the elements are stored in the heap storage
+	 */
+	inline bool allocated() const {
+		return _onHeap;
+	}
+
+	inline T& operator[](size_t index) {
+		return data()[index];
+	}
+
+	inline const T& operator[](size_t index) const {
+		return data()[index];
+	}
+
+	inline T& back() {
+		return data()[size() - 1u];
+	}
+
+	inline const T& back() const {
+		return data()[size() - 1u];
+	}
+
+	void reserve(size_t capacity) {
+		if (_onHeap) {
+			_heap.reserve(capacity);
+		} else if (capacity > N) {
+			moveToHeap(capacity);
+		}
+	}
+
+	void push_back(const T& value) {
+		if (_onHeap) {
+			_heap.push_back(value);
+			return;
+		}
+		if (_size < N) {
+			_inline[_size++] = value;
+			return;
+		}
+		moveToHeap(N * 2u);
+		_heap.push_back(value);
+	}
+
+	void pop_back() {
+		if (_onHeap) {
+			_heap.pop_back();
+		} else {
+			--_size;
+		}
+	}
+
+	/**
+	 * @brief Removes the element at the given index by moving the last element into its place
+	 * @note This doesn't keep the order of the elements
+	 */
+	void swapErase(size_t index) {
+		T* d = data();
+		const size_t last = size() - 1u;
+		if (index != last) {
+			d[index] = d[last];
+		}
+		pop_back();
+	}
+
+	/**
+	 * @note The heap storage is kept, but the elements are stored inline again
+	 */
+	void clear() {
+		_heap.clear();
+		_onHeap = false;
+		_size = 0u;
+	}
+};
+
+}
@@ -6,13 +6,14 @@
 #include "common/Thread.h"
 #include "common/Types.h"
 #include "common/Math.h"
+#include "common/NonCopyable.h"
 #include "ICharacter.h"
 #include "AI.h"
-#include <map>
 #include <memory>
-#include <numeric>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
+#include <atomic>
+#include <mutex>
 
 namespace ai {
 
@@ -23,40 +24,127 @@ namespace ai {
  *
  * Every @ai{Zone} has its own @c GroupMgr instance. It is automatically updated with the zone.
  * The average group position is only updated once per @c update() call.
+ *
+ * The modifications are done on dense per group member arrays that are guarded by a mutex. The
+ * queries don't lock at all - they are answered from an immutable snapshot that is published with
+ * @c update() or with the first query after the group memberships were modified. The average group
+ * position is maintained incrementally - only the members that moved since the last @c update() are
+ * touched.
+ *
+ * @note A replaced snapshot is freed with the second @c update() call after it was replaced. The
+ * queries must not run concurrently with two @c update() calls.
  */
-class GroupMgr {
+class GroupMgr : public NonCopyable {
 private:
-	struct AveragePositionFunctor {
-		glm::vec3 operator()(const glm::vec3& result, const AIPtr& ai) {
-			return ai->getCharacter()->getPosition() + result;
-		}
+	struct Group {
+		AIPtr leader;
+		std::vector<AIPtr> members;
+		// the positions of the members at the time they were last summed up
+		std::vector<glm::vec3> positions;
+		glm::dvec3 positionSum { 0.0 };
+		// the index of the group in the current snapshot
+		mutable uint32_t snapshotIndex = 0u;
 	};
 
-	typedef std::unordered_set<AIPtr> GroupMembersSet;
-	typedef GroupMembersSet::iterator GroupMembersSetIter;
-	typedef GroupMembersSet::const_iterator GroupMembersSetConstIter;
+	struct Membership {
+		GroupId id;
+		uint32_t index;
+	};
 
-	ReadWriteLock _groupLock = {"groupmgr-group"};
-	struct Group {
-		AIPtr leader;
-		GroupMembersSet members;
-		glm::vec3 position;
+	/**
+	 * @brief The group memberships of a snapshot - only replaced if a member was added or removed
+	 */
+	struct SnapshotMembers {
+		struct GroupView {
+			// the snapshots don't keep the ai instances alive
+			std::weak_ptr<AI> leader;
+			const AI* leaderPtr;
+			uint32_t firstMember;
+			uint32_t memberCount;
+		};
+		std::unordered_map<GroupId, uint32_t> groupIndices;
+		std::vector<GroupView> groups;
+		// the members of all groups - the members of one group are stored next to each other
+		std::vector<std::weak_ptr<AI> > members;
+		// the range in memberGroups for each member
+		std::unordered_map<const AI*, std::pair<uint32_t, uint32_t> > memberGroupRanges;
+		std::vector<GroupId> memberGroups;
+
+		const GroupView* group(GroupId id) const {
+			auto i = groupIndices.find(id);
+			if (i == groupIndices.end()) {
+				return nullptr;
+			}
+			return &groups[i->second];
+		}
+	};
+
+	struct Snapshot {
+		std::shared_ptr<const SnapshotMembers> members;
+		// the average positions, indexed like the groups of the members
+		std::vector<glm::vec3> positions;
 	};
 
-	typedef std::unordered_multimap<AIPtr, GroupId> GroupMembers;
 	typedef std::unordered_map<GroupId, Group> Groups;
-	typedef Groups::const_iterator GroupsConstIter;
 	typedef Groups::iterator GroupsIter;
 
-	GroupMembersSet _empty;
-	ReadWriteLock _lock = {"groupmgr"};
+	mutable std::mutex _writeLock;
 	Groups _groups;
-	GroupMembers _groupMembers;
+	std::unordered_map<const AI*, std::vector<Membership> > _memberships;
+
+	mutable std::atomic<const Snapshot*> _snapshot;
+	mutable std::atomic_bool _membersDirty { false };
+	mutable std::vector<std::unique_ptr<const Snapshot> > _retired;
+	std::vector<std::unique_ptr<const Snapshot> > _retiredPrevious;
+
+	static glm::vec3 position(const AIPtr& ai) {
+		const ICharacterPtr& chr = ai->getCharacter();
+		if (!chr) {
+			return glm::vec3(0.0f);
+		}
+		return chr->getPosition();
+	}
+
+	static glm::vec3 averagePosition(const Group& group) {
+		return glm::vec3(group.positionSum / (double)group.members.size());
+	}
+
+	/**
+	 * @note The write lock must be held
+	 */
+	void publish(Snapshot* snapshot) const {
+		const Snapshot* old = _snapshot.exchange(snapshot, std::memory_order_acq_rel);
+		_retired.emplace_back(old);
+	}
+
+	/**
+	 * @note The write lock must be held
+	 */
+	void publishMembers() const;
+
+	/**
+	 * @return The current snapshot - the group memberships are published first if they were modified
+	 */
+	inline const Snapshot* snapshot() const {
+		if (_membersDirty.load(std::memory_order_acquire)) {
+			std::lock_guard<std::mutex> lock(_writeLock);
+			if (_membersDirty.load(std::memory_order_relaxed)) {
+				publishMembers();
+			}
+		}
+		return _snapshot.load(std::memory_order_acquire);
+	}
+
+	bool removeLocked(GroupId id, const AIPtr& ai);
 
 public:
 	GroupMgr () {
+		Snapshot* snapshot = new Snapshot();
+		snapshot->members = std::make_shared<SnapshotMembers>();
+		_snapshot = snapshot;
 	}
 	virtual ~GroupMgr () {
+		delete _snapshot.load();
 	}
 
 	/**
@@ -71,10 +159,13 @@ public:
 	 * whenever you destroy the @ai{AI} instance.
 	 * @return @c true if the add to the group was successful.
 	 *
-	 * @note This method performs a write lock on the group manager
+	 * @note This method locks the group manager for other modifications
 	 */
 	bool add(GroupId id, const AIPtr& ai);
 
+	/**
+	 * @brief Updates the average group positions and publishes a new snapshot if anything changed
+	 */
 	void update(int64_t deltaTime);
 
 	/**
@@ -88,7 +179,7 @@ public:
 	 * @c false if the removal failed (e.g. the @ai{AI} instance was not part of
 	 * the group)
 	 *
-	 * @note This method performs a write lock on the group manager
+	 * @note This method locks the group manager for other modifications
 	 */
 	bool remove(GroupId id, const AIPtr& ai);
 
@@ -96,7 +187,7 @@ public:
 	 * @brief Use this method to remove a @ai{AI} instance from all the group it is
 	 * part of. Useful if you e.g. destroy a @ai{AI} instance.
 	 *
-	 * @note This method performs a write lock on the group manager
+	 * @note This method locks the group manager for other modifications
 	 */
 	bool removeFromAllGroups(const AIPtr& ai);
 
@@ -105,32 +196,29 @@ public:
 	 *
 	 * @note If the given group doesn't exist or some other error occurred, this method returns @c glm::vec3::VEC3_INFINITE
 	 * @note The position of a group is calculated once per @c update() call.
-	 *
-	 * @note This method performs a read lock on the group manager
 	 */
 	glm::vec3 getPosition(GroupId id) const;
 
 	/**
 	 * @return The @ai{ICharacter} object of the leader, or @c nullptr if no such group exists.
-	 *
-	 * @note This method performs a read lock on the group manager
 	 */
 	AIPtr getLeader(GroupId id) const;
 
 	/**
 	 * @brief Visit all the group members of the given group until the functor returns @c false
-	 *
-	 * @note This methods performs a read lock on the group manager
 	 */
 	template<typename Func>
 	void visit(GroupId id, Func& func) const {
-		ScopedReadLock scopedLock(_lock);
-		const GroupsConstIter& i = _groups.find(id);
-		if (i == _groups.end()) {
+		const SnapshotMembers& members = *snapshot()->members;
+		const SnapshotMembers::GroupView* group = members.group(id);
+		if (group == nullptr) {
 			return;
 		}
-		for (GroupMembersSetConstIter it = i->second.members.begin(); it != i->second.members.end(); ++it) {
-			const AIPtr& chr = *it;
+		for (uint32_t i = group->firstMember; i < group->firstMember + group->memberCount; ++i) {
+			const AIPtr& chr = members.members[i].lock();
+			if (!chr) {
+				continue;
+			}
 			if (!func(chr))
 				break;
 		}
@@ -139,164 +227,213 @@ public:
 	/**
 	 * @return If the group doesn't exist, this method returns @c 0 - otherwise the amount of members
 	 * that must be bigger than @c 1
-	 *
-	 * @note This method performs a read lock on the group manager
 	 */
 	int getGroupSize(GroupId id) const;
 
-	/**
-	 * @note This method performs a read lock on the group manager
-	 */
 	bool isInAnyGroup(const AIPtr& ai) const;
 
-	/**
-	 * @note This method performs a read lock on the group manager
-	 */
 	bool isInGroup(GroupId id, const AIPtr& ai) const;
 
-	/**
-	 * @note This method performs a read lock on the group manager
-	 */
 	bool isGroupLeader(GroupId id, const AIPtr& ai) const;
 };
 
+inline void GroupMgr::publishMembers() const {
+	const std::shared_ptr<SnapshotMembers>& members = std::make_shared<SnapshotMembers>();
+	Snapshot* snapshot = new Snapshot();
+	members->groups.reserve(_groups.size());
+	snapshot->positions.reserve(_groups.size());
+	for (const auto& i : _groups) {
+		const Group& group = i.second;
+		group.snapshotIndex = (uint32_t)members->groups.size();
+		members->groupIndices.emplace(i.first, group.snapshotIndex);
+		members->groups.push_back({group.leader, group.leader.get(), (uint32_t)members->members.size(), (uint32_t)group.members.size()});
+		members->members.insert(members->members.end(), group.members.begin(), group.members.end());
+		snapshot->positions.push_back(averagePosition(group));
+	}
+	for (const auto& i : _memberships) {
+		const uint32_t first = (uint32_t)members->memberGroups.size();
+		for (const Membership& membership : i.second) {
+			members->memberGroups.push_back(membership.id);
+		}
+		members->memberGroupRanges.emplace(i.first, std::make_pair(first, (uint32_t)i.second.size()));
+	}
+	snapshot->members = members;
+	_membersDirty.store(false, std::memory_order_release);
+	publish(snapshot);
+}
 
 inline void GroupMgr::update(int64_t) {
-	ScopedReadLock scopedLock(_lock);
-	for (auto i = _groups.begin(); i != _groups.end(); ++i) {
-		Group& group = i->second;
-		glm::vec3 averagePosition(0.0f);
-		{
-			ScopedReadLock lock(_groupLock);
-			averagePosition = std::accumulate(group.members.begin(), group.members.end(), glm::vec3(0.0f), AveragePositionFunctor());
-			averagePosition *= 1.0f / (float) group.members.size();
+	std::lock_guard<std::mutex> lock(_writeLock);
+	bool moved = false;
+	for (auto& i : _groups) {
+		Group& group = i.second;
+		const size_t size = group.members.size();
+		for (size_t m = 0u; m < size; ++m) {
+			const glm::vec3& pos = position(group.members[m]);
+			glm::vec3& lastPos = group.positions[m];
+			if (pos == lastPos) {
+				continue;
+			}
+			group.positionSum += glm::dvec3(pos) - glm::dvec3(lastPos);
+			lastPos = pos;
+			moved = true;
+		}
+	}
+	_retiredPrevious.clear();
+	if (_membersDirty.load(std::memory_order_relaxed)) {
+		publishMembers();
+	} else if (moved) {
+		const Snapshot* current = _snapshot.load(std::memory_order_relaxed);
+		Snapshot* snapshot = new Snapshot();
+		snapshot->members = current->members;
+		snapshot->positions.resize(_groups.size());
+		for (const auto& i : _groups) {
+			snapshot->positions[i.second.snapshotIndex] = averagePosition(i.second);
 		}
-		ScopedWriteLock lock(_groupLock);
-		group.position = averagePosition;
+		publish(snapshot);
 	}
+	_retiredPrevious.swap(_retired);
 }
 
 inline bool GroupMgr::add(GroupId id, const AIPtr& ai) {
-	ScopedWriteLock scopedLock(_lock);
+	std::lock_guard<std::mutex> lock(_writeLock);
+	std::vector<Membership>& memberships = _memberships[ai.get()];
+	for (const Membership& membership : memberships) {
+		if (membership.id == id) {
+			return false;
+		}
+	}
 	GroupsIter i = _groups.find(id);
 	if (i == _groups.end()) {
-		Group group;
-		group.leader = ai;
-		i = _groups.insert(std::pair<GroupId, Group>(id, group)).first;
+		i = _groups.emplace(id, Group()).first;
+		i->second.leader = ai;
 	}
 
 	Group& group = i->second;
-	ScopedWriteLock lock(_groupLock);
-	std::pair<GroupMembersSetIter, bool> ret = group.members.insert(ai);
-	if (ret.second) {
-		_groupMembers.insert(GroupMembers::value_type(ai, id));
-		return true;
-	}
-	return false;
+	const glm::vec3& pos = position(ai);
+	memberships.push_back({id, (uint32_t)group.members.size()});
+	group.members.push_back(ai);
+	group.positions.push_back(pos);
+	group.positionSum += glm::dvec3(pos);
+	_membersDirty.store(true, std::memory_order_release);
+	return true;
 }
 
-inline bool GroupMgr::remove(GroupId id, const AIPtr& ai) {
-	ScopedWriteLock scopedLock(_lock);
-	const GroupsIter& i = _groups.find(id);
-	if (i == _groups.end()) {
+inline bool GroupMgr::removeLocked(GroupId id, const AIPtr& ai) {
+	auto mi = _memberships.find(ai.get());
+	if (mi == _memberships.end()) {
 		return false;
 	}
-	Group& group = i->second;
-	GroupMembersSetIter si;
-	{
-		ScopedReadLock lock(_groupLock);
-		si = group.members.find(ai);
-		if (si == group.members.end()) {
-			return false;
+	std::vector<Membership>& memberships = mi->second;
+	auto membership = memberships.begin();
+	for (; membership != memberships.end(); ++membership) {
+		if (membership->id == id) {
+			break;
 		}
 	}
-	{
-		ScopedWriteLock lock(_groupLock);
-		group.members.erase(si);
-		if (group.members.empty()) {
-			_groups.erase(i);
-		} else if (group.leader == ai) {
-			group.leader = *group.members.begin();
+	if (membership == memberships.end()) {
+		return false;
+	}
+	const GroupsIter& i = _groups.find(id);
+	ai_assert(i != _groups.end(), "group membership without group");
+	Group& group = i->second;
+	const uint32_t index = membership->index;
+	const uint32_t last = (uint32_t)group.members.size() - 1u;
+	group.positionSum -= glm::dvec3(group.positions[index]);
+	if (index != last) {
+		// move the last member into the gap and fix its index
+		group.members[index] = group.members[last];
+		group.positions[index] = group.positions[last];
+		for (Membership& moved : _memberships[group.members[index].get()]) {
+			if (moved.id == id) {
+				moved.index = index;
+				break;
+			}
 		}
 	}
+	group.members.pop_back();
+	group.positions.pop_back();
+	if (group.members.empty()) {
+		_groups.erase(i);
+	} else if (group.leader == ai) {
+		group.leader = group.members.front();
+	}
 
-	auto range = _groupMembers.equal_range(ai);
-	for (auto it = range.first; it != range.second; ++it) {
-		if (it->second == id) {
-			_groupMembers.erase(it);
-			break;
-		}
+	memberships.erase(membership);
+	if (memberships.empty()) {
+		_memberships.erase(mi);
 	}
+	_membersDirty.store(true, std::memory_order_release);
 	return true;
 }
 
+inline bool GroupMgr::remove(GroupId id, const AIPtr& ai) {
+	std::lock_guard<std::mutex> lock(_writeLock);
+	return removeLocked(id, ai);
+}
+
 inline bool GroupMgr::removeFromAllGroups(const AIPtr& ai) {
-	std::list<GroupId> groups;
-	{
-		ScopedReadLock scopedLock(_lock);
-		auto range = _groupMembers.equal_range(ai);
-		for (auto it = range.first; it != range.second; ++it) {
-			groups.push_back(it->second);
-		}
+	std::lock_guard<std::mutex> lock(_writeLock);
+	auto mi = _memberships.find(ai.get());
+	if (mi == _memberships.end()) {
+		return true;
+	}
+	std::vector<GroupId> groups;
+	for (const Membership& membership : mi->second) {
+		groups.push_back(membership.id);
 	}
 	for (GroupId groupId : groups) {
-		remove(groupId, ai);
+		removeLocked(groupId, ai);
 	}
 	return true;
 }
 
 inline AIPtr GroupMgr::getLeader(GroupId id) const {
-	ScopedReadLock scopedLock(_lock);
-	const GroupsConstIter& i = _groups.find(id);
-	if (i == _groups.end()) {
+	const SnapshotMembers::GroupView* group = snapshot()->members->group(id);
+	if (group == nullptr) {
 		return AIPtr();
 	}
-
-	ScopedReadLock lock(_groupLock);
-	return i->second.leader;
+	return group->leader.lock();
 }
 
 inline glm::vec3 GroupMgr::getPosition(GroupId id) const {
-	ScopedReadLock scopedLock(_lock);
-	const GroupsConstIter& i = _groups.find(id);
-	if (i == _groups.end()) {
+	const Snapshot* s = snapshot();
+	auto i = s->members->groupIndices.find(id);
+	if (i == s->members->groupIndices.end()) {
 		return VEC3_INFINITE;
 	}
-
-	ScopedReadLock lock(_groupLock);
-	return i->second.position;
+	return s->positions[i->second];
 }
 
 inline bool GroupMgr::isGroupLeader(GroupId id, const AIPtr& ai) const {
-	ScopedReadLock scopedLock(_lock);
-	const GroupsConstIter& i = _groups.find(id);
-	if (i == _groups.end()) {
-		return 0;
+	const SnapshotMembers::GroupView* group = snapshot()->members->group(id);
+	if (group == nullptr) {
+		return false;
 	}
-	ScopedReadLock lock(_groupLock);
-	return i->second.leader == ai;
+	return group->leaderPtr == ai.get();
 }
 
 inline int GroupMgr::getGroupSize(GroupId id) const {
-	ScopedReadLock scopedLock(_lock);
-	const GroupsConstIter& i = _groups.find(id);
-	if (i == _groups.end()) {
+	const SnapshotMembers::GroupView* group = snapshot()->members->group(id);
+	if (group == nullptr) {
 		return 0;
 	}
-	ScopedReadLock lock(_groupLock);
-	return static_cast<int>(std::distance(i->second.members.begin(), i->second.members.end()));
+	return static_cast<int>(group->memberCount);
 }
 
 inline bool GroupMgr::isInAnyGroup(const AIPtr& ai) const {
-	ScopedReadLock scopedLock(_lock);
-	return _groupMembers.find(ai) != _groupMembers.end();
+	const SnapshotMembers& members = *snapshot()->members;
+	return members.memberGroupRanges.find(ai.get()) != members.memberGroupRanges.end();
 }
 
 inline bool GroupMgr::isInGroup(GroupId id, const AIPtr& ai) const {
-	ScopedReadLock scopedLock(_lock);
-	auto range = _groupMembers.equal_range(ai);
-	for (auto it = range.first; it != range.second; ++it) {
-		if (it->second == id) {
+	const SnapshotMembers& members = *snapshot()->members;
+	auto i = members.memberGroupRanges.find(ai.get());
+	if (i == members.memberGroupRanges.end()) {
+		return false;
+	}
+	for (uint32_t g = i->second.first; g < i->second.first + i->second.second; ++g) {
+		if (members.memberGroups[g] == id) {
 			return true;
 		}
 	}
@@ -0,0 +1,69 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "IProtocolMessage.h"
+#include "AIStubTypes.h"
+
+namespace ai {
+
+/**
+ * @brief Message for the remote debugging interface
+ *
+ * Limits the entities the server is sending the states for to the given area or the given character ids.
+ * The server answers with a new full @c AIStateMessage.
+ */
+class AIFilterMessage: public IProtocolMessage {
+private:
+	AIStateFilter _filter;
+
+public:
+	explicit AIFilterMessage(const AIStateFilter& filter) :
+			IProtocolMessage(PROTO_FILTER), _filter(filter) {
+	}
+
+	explicit AIFilterMessage(streamContainer& in) :
+			IProtocolMessage(PROTO_FILTER) {
+		const uint8_t type = readByte(in);
+		if (type == AIStateFilter::AREA) {
+			const float x = readFloat(in);
+			const float y = readFloat(in);
+			const float z = readFloat(in);
+			const float radius = readFloat(in);
+			_filter = AIStateFilter(glm::vec3(x, y, z), radius);
+		} else if (type == AIStateFilter::IDS) {
+			const int size = readInt(in);
+			std::vector<CharacterId> ids;
+			ids.reserve(size);
+			for (int i = 0; i < size; ++i) {
+				ids.push_back(readInt(in));
+			}
+			_filter = AIStateFilter(ids);
+		}
+	}
+
+	void serialize(streamContainer& out) const override {
+		addByte(out, _id);
+		addByte(out, _filter.getType());
+		if (_filter.getType() == AIStateFilter::AREA) {
+			const glm::vec3& center = _filter.getCenter();
+			addFloat(out, center.x);
+			addFloat(out, center.y);
+			addFloat(out, center.z);
+			addFloat(out, _filter.getRadius());
+		} else if (_filter.getType() == AIStateFilter::IDS) {
+			const std::vector<CharacterId>& ids = _filter.getIds();
+			addInt(out, static_cast<int>(ids.size()));
+			for (const CharacterId& id : ids) {
+				addInt(out, id);
+			}
+		}
+	}
+
+	inline const AIStateFilter& getFilter() const {
+		return _filter;
+	}
+};
+
+}
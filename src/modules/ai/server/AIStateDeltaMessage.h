@@ -0,0 +1,56 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "AIStateMessage.h"
+
+namespace ai {
+
+/**
+ * @brief Message for the remote debugging interface
+ *
+ * The changes of the world state since the last @c AIStateMessage or @c AIStateDeltaMessage. The states
+ * of new or modified entities are replaced, the removed entities are no longer watched - either because
+ * they were removed from the zone or because they don't pass the @c AIStateFilter anymore.
+ */
+class AIStateDeltaMessage: public AIStateMessage {
+private:
+	std::vector<CharacterId> _removed;
+
+public:
+	AIStateDeltaMessage() :
+			AIStateMessage(PROTO_STATE_DELTA) {
+	}
+
+	explicit AIStateDeltaMessage(streamContainer& in) :
+			AIStateMessage(PROTO_STATE_DELTA, in) {
+		const int removedSize = readInt(in);
+		_removed.reserve(removedSize);
+		for (int i = 0; i < removedSize; ++i) {
+			_removed.push_back(readInt(in));
+		}
+	}
+
+	void addRemoved(const CharacterId& id) {
+		_removed.push_back(id);
+	}
+
+	void serialize(streamContainer& out) const override {
+		AIStateMessage::serialize(out);
+		addInt(out, static_cast<int>(_removed.size()));
+		for (const CharacterId& id : _removed) {
+			addInt(out, id);
+		}
+	}
+
+	inline bool empty() const {
+		return AIStateMessage::empty() && _removed.empty();
+	}
+
+	inline const std::vector<CharacterId>& getRemoved() const {
+		return _removed;
+	}
+};
+
+}
@@ -15,7 +15,7 @@ namespace ai {
  * State of the world. You receive basic information about every watched AI controller entity
  */
 class AIStateMessage: public IProtocolMessage {
-private:
+protected:
 	typedef std::vector<AIStateWorld> States;
 	States _states;
 
@@ -61,19 +61,23 @@ private:
 		}
 	}
 
-public:
-	AIStateMessage() :
-			IProtocolMessage(PROTO_STATE) {
-	}
-
-	explicit AIStateMessage(streamContainer& in) :
-			IProtocolMessage(PROTO_STATE) {
+	AIStateMessage(const ProtocolId& id, streamContainer& in) :
+			IProtocolMessage(id) {
 		const int treeSize = readInt(in);
 		for (int i = 0; i < treeSize; ++i) {
 			readState(in);
 		}
 	}
 
+public:
+	explicit AIStateMessage(const ProtocolId& id = PROTO_STATE) :
+			IProtocolMessage(id) {
+	}
+
+	explicit AIStateMessage(streamContainer& in) :
+			AIStateMessage(PROTO_STATE, in) {
+	}
+
 	void addState(const AIStateWorld& tree) {
 		_states.push_back(tree);
 	}
@@ -90,6 +94,10 @@ public:
 		}
 	}
 
+	inline bool empty() const {
+		return _states.empty();
+	}
+
 	inline const std::vector<AIStateWorld>& getStates() const {
 		return _states;
 	}
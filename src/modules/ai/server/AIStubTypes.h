@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
 #include "common/Math.h"
 #include "common/Types.h"
 #include "tree/TreeNode.h"
@@ -238,4 +239,67 @@ public:
 	}
 };
 
+
+/**
+ * @brief Limits the entities that the server is sending to the debuggers
+ *
+ * The filter is either an area around a center, or a list of character ids.
+ */
+class AIStateFilter {
+public:
+	enum Type : uint8_t {
+		NONE, AREA, IDS
+	};
+private:
+	Type _type;
+	glm::vec3 _center;
+	float _radius;
+	// sorted
+	std::vector<CharacterId> _ids;
+public:
+	AIStateFilter() :
+			_type(NONE), _center(0.0f), _radius(0.0f) {
+	}
+
+	AIStateFilter(const glm::vec3& center, float radius) :
+			_type(AREA), _center(center), _radius(radius) {
+	}
+
+	explicit AIStateFilter(const std::vector<CharacterId>& ids) :
+			_type(IDS), _center(0.0f), _radius(0.0f), _ids(ids) {
+		std::sort(_ids.begin(), _ids.end());
+	}
+
+	inline Type getType() const {
+		return _type;
+	}
+
+	inline const glm::vec3& getCenter() const {
+		return _center;
+	}
+
+	inline float getRadius() const {
+		return _radius;
+	}
+
+	inline const std::vector<CharacterId>& getIds() const {
+		return _ids;
+	}
+
+	/**
+	 * @return @c true if the state of the given character should be sent to the debuggers
+	 */
+	inline bool accept(const CharacterId& id, const glm::vec3& position) const {
+		switch (_type) {
+		case AREA:
+			return glm::distance2(_center, position) <= _radius * _radius;
+		case IDS:
+			return std::binary_search(_ids.begin(), _ids.end(), id);
+		case NONE:
+			break;
+		}
+		return true;
+	}
+};
+
 }
@@ -0,0 +1,25 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "IProtocolHandler.h"
+#include "AIFilterMessage.h"
+#include "Server.h"
+
+namespace ai {
+
+class FilterHandler: public ai::IProtocolHandler {
+private:
+	Server& _server;
+public:
+	explicit FilterHandler(Server& server) : _server(server) {
+	}
+
+	void execute(const ClientId& clientId, const IProtocolMessage& message) override {
+		const AIFilterMessage& msg = static_cast<const AIFilterMessage&>(message);
+		_server.setFilter(clientId, msg.getFilter());
+	}
+};
+
+}
@@ -51,6 +51,8 @@ const ProtocolId PROTO_STEP = 9;
 const ProtocolId PROTO_UPDATENODE = 10;
 const ProtocolId PROTO_DELETENODE = 11;
 const ProtocolId PROTO_ADDNODE = 12;
+const ProtocolId PROTO_STATE_DELTA = 13;
+const ProtocolId PROTO_FILTER = 14;
 
 /**
  * @brief A protocol message is used for the serialization of the ai states for remote debugging
@@ -75,6 +75,11 @@ public:
 	 * @return @c false if there are no clients
 	 */
 	bool broadcast(const IProtocolMessage& msg);
+	/**
+	 * @brief Broadcasts an already serialized message
+	 * @return @c false if there are no clients
+	 */
+	bool broadcast(const streamContainer& out);
 	bool sendToClient(Client* client, const IProtocolMessage& msg);
 };
 
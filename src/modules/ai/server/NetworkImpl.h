@@ -231,9 +231,16 @@ inline bool Network::broadcast(const IProtocolMessage& msg) {
 	if (_clientSockets.empty()) {
 		return false;
 	}
-	_time = 0L;
 	streamContainer out;
 	msg.serialize(out);
+	return broadcast(out);
+}
+
+inline bool Network::broadcast(const streamContainer& out) {
+	if (_clientSockets.empty()) {
+		return false;
+	}
+	_time = 0L;
 	for (ClientSocketsIter i = _clientSockets.begin(); i != _clientSockets.end(); ++i) {
 		Client& client = *i;
 		if (client.socket == INVALID_SOCKET) {
@@ -26,8 +26,11 @@ public:
 		_registry.clear();
 	}
 
+	/**
+	 * @note Replaces a handler that was registered for the same type before
+	 */
 	inline void registerHandler(const ProtocolId& type, IProtocolHandler* handler) {
-		_registry.insert(std::make_pair(type, handler));
+		_registry[type] = handler;
 	}
 
 	inline IProtocolHandler* getHandler(const IProtocolMessage& msg) {
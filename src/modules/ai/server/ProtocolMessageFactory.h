@@ -6,6 +6,8 @@
 #include "common/NonCopyable.h"
 #include "IProtocolMessage.h"
 #include "AIStateMessage.h"
+#include "AIStateDeltaMessage.h"
+#include "AIFilterMessage.h"
 #include "AICharacterDetailsMessage.h"
 #include "AICharacterStaticMessage.h"
 #include "AIPauseMessage.h"
@@ -34,6 +36,8 @@ private:
 	uint8_t *_aiUpdateNode;
 	uint8_t *_aiAddNode;
 	uint8_t *_aiDeleteNode;
+	uint8_t *_aiStateDelta;
+	uint8_t *_aiFilter;
 
 	ProtocolMessageFactory() :
 		_aiState(new uint8_t[sizeof(AIStateMessage)]),
@@ -48,7 +52,9 @@ private:
 		_aiCharacterStatic(new uint8_t[sizeof(AICharacterStaticMessage)]),
 		_aiUpdateNode(new uint8_t[sizeof(AIUpdateNodeMessage)]),
 		_aiAddNode(new uint8_t[sizeof(AIAddNodeMessage)]),
-		_aiDeleteNode(new uint8_t[sizeof(AIDeleteNodeMessage)]) {
+		_aiDeleteNode(new uint8_t[sizeof(AIDeleteNodeMessage)]),
+		_aiStateDelta(new uint8_t[sizeof(AIStateDeltaMessage)]),
+		_aiFilter(new uint8_t[sizeof(AIFilterMessage)]) {
 	}
 public:
 	~ProtocolMessageFactory() {
@@ -65,6 +71,8 @@ public:
 		delete[] _aiUpdateNode;
 		delete[] _aiAddNode;
 		delete[] _aiDeleteNode;
+		delete[] _aiStateDelta;
+		delete[] _aiFilter;
 	}
 
 	static ProtocolMessageFactory& get() {
@@ -125,6 +133,10 @@ public:
 			return new (_aiAddNode) AIAddNodeMessage(in);
 		} else if (type == PROTO_DELETENODE) {
 			return new (_aiDeleteNode) AIDeleteNodeMessage(in);
+		} else if (type == PROTO_STATE_DELTA) {
+			return new (_aiStateDelta) AIStateDeltaMessage(in);
+		} else if (type == PROTO_FILTER) {
+			return new (_aiFilter) AIFilterMessage(in);
 		}
 
 		return nullptr;
@@ -4,12 +4,17 @@
 #pragma once
 
 #include "common/Thread.h"
+#include "common/ThreadPool.h"
 #include "tree/TreeNode.h"
 #include <unordered_set>
+#include <unordered_map>
+#include <deque>
+#include <future>
 #include "Network.h"
 #include "zone/Zone.h"
 #include "AIRegistry.h"
 #include "AIStateMessage.h"
+#include "AIStateDeltaMessage.h"
 #include "AINamesMessage.h"
 #include "AIStubTypes.h"
 #include "AICharacterDetailsMessage.h"
@@ -32,6 +37,7 @@ class ChangeHandler;
 class AddNodeHandler;
 class DeleteNodeHandler;
 class UpdateNodeHandler;
+class FilterHandler;
 class NopHandler;
 
 /**
@@ -45,6 +51,11 @@ class NopHandler;
  * clients. If someone selected a particular @ai{AI} instance by sending @ai{AISelectMessage} to the server, it
  * will also broadcast an @ai{AICharacterDetailsMessage} to all connected clients.
  *
+ * The full world state is only sent once after a client connected, the debug zone or the filter changed. After
+ * that, the server only sends an @ai{AIStateDeltaMessage} with the entities that changed since the last update.
+ * The debuggers can limit the watched entities with an @ai{AIFilterMessage}. The messages are serialized on a
+ * background thread and sent with one of the next @c update() calls.
+ *
  * You can only debug one @ai{Zone} at the same time. The debugging session is shared between all connected clients.
  */
 class Server: public INetworkListener {
@@ -65,6 +76,7 @@ protected:
 	AddNodeHandler *_addNodeHandler;
 	DeleteNodeHandler *_deleteNodeHandler;
 	UpdateNodeHandler *_updateNodeHandler;
+	FilterHandler *_filterHandler;
 	NopHandler _nopHandler;
 	std::atomic_bool _pause;
 	// the current active debugging zone
@@ -73,6 +85,25 @@ protected:
 	std::vector<std::string> _names;
 	uint32_t _broadcastMask = 0u;
 
+	/**
+	 * @brief The state of an entity that was sent to the debuggers
+	 */
+	struct TrackedState {
+		glm::vec3 position;
+		float orientation;
+		CharacterAttributes attributes;
+		uint32_t generation;
+	};
+	typedef std::unordered_map<CharacterId, TrackedState> TrackedStates;
+	TrackedStates _tracked;
+	uint32_t _generation = 0u;
+	// send the complete world state with the next update
+	bool _fullState = true;
+	AIStateFilter _filter;
+	ThreadPool _serializer { 1, "aidebug" };
+	// the serialized messages in the order they must be sent
+	std::deque<std::future<streamContainer> > _serialized;
+
 	enum EventType {
 		EV_SELECTION,
 		EV_STEP,
@@ -83,6 +114,7 @@ protected:
 		EV_PAUSE,
 		EV_RESET,
 		EV_SETDEBUG,
+		EV_FILTER,
 
 		EV_MAX
 	};
@@ -96,15 +128,30 @@ protected:
 			bool pauseState;
 		} data;
 		std::string strData = "";
+		AIStateFilter filter;
 		EventType type;
 	};
 	std::vector<Event> _events;
 
 	void resetSelection();
+	/**
+	 * @brief Compiles the modified behaviour tree again for all @c AI instances of the zone that are executing it
+	 */
+	void resetBehaviour(Zone* zone, const TreeNodePtr& root);
 
 	void addChildren(const TreeNodePtr& node, std::vector<AIStateNodeStatic>& out) const;
 	void addChildren(const TreeNodePtr& node, AIStateNode& parent, const AIPtr& ai) const;
 
+	/**
+	 * @brief Serializes the given message on the background thread and enqueues it for the broadcast
+	 */
+	void broadcastAsync(IProtocolMessage* msg);
+	/**
+	 * @brief Broadcasts the serialized messages that are ready - in the order they were enqueued
+	 */
+	void flushSerialized();
+	void resetTrackedState();
+
 	// only call these from the Server::update method
 	void broadcastState(const Zone* zone);
 	void broadcastCharacterDetails(const Zone* zone);
@@ -204,6 +251,11 @@ public:
 	 */
 	void pause(const ClientId& clientId, bool pause);
 
+	/**
+	 * @brief Limits the entities that the state is broadcasted for
+	 */
+	void setFilter(const ClientId& clientId, const AIStateFilter& filter);
+
 	/**
 	 * @brief Performs one step of the @ai{AI} in pause mode
 	 */
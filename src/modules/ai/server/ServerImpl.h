@@ -12,6 +12,7 @@
 #include "AddNodeHandler.h"
 #include "DeleteNodeHandler.h"
 #include "UpdateNodeHandler.h"
+#include "FilterHandler.h"
 
 namespace ai {
 
@@ -24,7 +25,7 @@ inline Server::Server(AIRegistry& aiRegistry, short port, const std::string& hos
 		_aiRegistry(aiRegistry), _network(port, hostname), _selectedCharacterId(AI_NOTHING_SELECTED), _time(0L),
 		_selectHandler(new SelectHandler(*this)), _pauseHandler(new PauseHandler(*this)), _resetHandler(new ResetHandler(*this)),
 		_stepHandler(new StepHandler(*this)), _changeHandler(new ChangeHandler(*this)), _addNodeHandler(new AddNodeHandler(*this)),
-		_deleteNodeHandler(new DeleteNodeHandler(*this)), _updateNodeHandler(new UpdateNodeHandler(*this)), _pause(false), _zone(nullptr) {
+		_deleteNodeHandler(new DeleteNodeHandler(*this)), _updateNodeHandler(new UpdateNodeHandler(*this)), _filterHandler(new FilterHandler(*this)), _pause(false), _zone(nullptr) {
 	_network.addListener(this);
 	ProtocolHandlerRegistry& r = ai::ProtocolHandlerRegistry::get();
 	r.registerHandler(ai::PROTO_SELECT, _selectHandler);
@@ -36,6 +37,7 @@ inline Server::Server(AIRegistry& aiRegistry, short port, const std::string& hos
 	r.registerHandler(ai::PROTO_ADDNODE, _addNodeHandler);
 	r.registerHandler(ai::PROTO_DELETENODE, _deleteNodeHandler);
 	r.registerHandler(ai::PROTO_UPDATENODE, _updateNodeHandler);
+	r.registerHandler(ai::PROTO_FILTER, _filterHandler);
 }
 
 inline Server::~Server() {
@@ -47,6 +49,7 @@ inline Server::~Server() {
 	delete _addNodeHandler;
 	delete _deleteNodeHandler;
 	delete _updateNodeHandler;
+	delete _filterHandler;
 	_network.removeListener(this);
 }
 
@@ -118,16 +121,79 @@ inline void Server::addChildren(const TreeNodePtr& node, AIStateNode& parent, co
 	}
 }
 
+inline void Server::broadcastAsync(IProtocolMessage* msg) {
+	std::shared_ptr<IProtocolMessage> message(msg);
+	_serialized.push_back(_serializer.enqueue([message] () {
+		streamContainer out;
+		message->serialize(out);
+		return out;
+	}));
+}
+
+inline void Server::flushSerialized() {
+	while (!_serialized.empty()) {
+		std::future<streamContainer>& front = _serialized.front();
+		if (front.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			break;
+		}
+		_network.broadcast(front.get());
+		_serialized.pop_front();
+	}
+}
+
+inline void Server::resetTrackedState() {
+	_tracked.clear();
+	_fullState = true;
+}
+
 inline void Server::broadcastState(const Zone* zone) {
 	_broadcastMask |= SV_BROADCAST_STATE;
-	AIStateMessage msg;
+	const uint32_t generation = ++_generation;
+	const bool fullState = _fullState;
+	AIStateMessage* msg = fullState ? new AIStateMessage() : new AIStateDeltaMessage();
 	auto func = [&] (const AIPtr& ai) {
 		const ICharacterPtr& chr = ai->getCharacter();
-		const AIStateWorld b(chr->getId(), chr->getPosition(), chr->getOrientation(), chr->getAttributes());
-		msg.addState(b);
+		const CharacterId id = chr->getId();
+		const glm::vec3& position = chr->getPosition();
+		if (!_filter.accept(id, position)) {
+			return;
+		}
+		const float orientation = chr->getOrientation();
+		const CharacterAttributes& attributes = chr->getAttributes();
+		auto i = _tracked.find(id);
+		if (i == _tracked.end()) {
+			_tracked.emplace(id, TrackedState{position, orientation, attributes, generation});
+		} else {
+			TrackedState& tracked = i->second;
+			tracked.generation = generation;
+			if (!fullState && tracked.position == position && tracked.orientation == orientation && tracked.attributes == attributes) {
+				return;
+			}
+			tracked.position = position;
+			tracked.orientation = orientation;
+			tracked.attributes = attributes;
+		}
+		msg->addState(AIStateWorld(id, position, orientation, attributes));
 	};
 	zone->execute(func);
-	_network.broadcast(msg);
+	_fullState = false;
+
+	// the entities that were removed from the zone or don't pass the filter anymore
+	for (auto i = _tracked.begin(); i != _tracked.end();) {
+		if (i->second.generation == generation) {
+			++i;
+			continue;
+		}
+		if (!fullState) {
+			static_cast<AIStateDeltaMessage*>(msg)->addRemoved(i->first);
+		}
+		i = _tracked.erase(i);
+	}
+	if (!fullState && static_cast<AIStateDeltaMessage*>(msg)->empty()) {
+		delete msg;
+		return;
+	}
+	broadcastAsync(msg);
 }
 
 inline void Server::broadcastStaticCharacterDetails(const Zone* zone) {
@@ -180,8 +246,7 @@ inline void Server::broadcastCharacterDetails(const Zone* zone) {
 			aggro.addAggro(AIStateAggroEntry(e.getCharacterId(), e.getAggro()));
 		}
 
-		const AICharacterDetailsMessage msg(ai->getId(), aggro, root);
-		_network.broadcast(msg);
+		broadcastAsync(new AICharacterDetailsMessage(ai->getId(), aggro, root));
 		return true;
 	};
 	if (!zone->execute(id, func)) {
@@ -192,7 +257,7 @@ inline void Server::broadcastCharacterDetails(const Zone* zone) {
 inline void Server::handleEvents(Zone* zone, bool pauseState) {
 	std::vector<Event> events;
 	{
-		ScopedReadLock scopedLock(_lock);
+		ScopedWriteLock scopedLock(_lock);
 		events = std::move(_events);
 		_events.clear();
 	}
@@ -218,7 +283,7 @@ inline void Server::handleEvents(Zone* zone, bool pauseState) {
 					return;
 				ai->setPause(false);
 				ai->update(queuedStepMillis, true);
-				ai->getBehaviour()->execute(ai, queuedStepMillis);
+				CompiledTree::execute(ai, queuedStepMillis);
 				ai->setPause(true);
 			};
 			zone->executeParallel(func);
@@ -255,6 +320,8 @@ inline void Server::handleEvents(Zone* zone, bool pauseState) {
 			break;
 		}
 		case EV_NEWCONNECTION: {
+			// the new client needs the complete world state
+			_fullState = true;
 			_network.sendToClient(event.data.newClient, AIPauseMessage(pauseState));
 			_network.sendToClient(event.data.newClient, AINamesMessage(_names));
 			ai_log("new remote debugger connection (%i)", _network.getConnectedClients());
@@ -291,6 +358,7 @@ inline void Server::handleEvents(Zone* zone, bool pauseState) {
 			Zone* nullzone = nullptr;
 			_zone = nullzone;
 			resetSelection();
+			resetTrackedState();
 
 			for (Zone* z : _zones) {
 				const bool debug = z->getName() == event.strData;
@@ -304,6 +372,11 @@ inline void Server::handleEvents(Zone* zone, bool pauseState) {
 
 			break;
 		}
+		case EV_FILTER: {
+			_filter = event.filter;
+			resetTrackedState();
+			break;
+		}
 		case EV_MAX:
 			break;
 		}
@@ -314,6 +387,16 @@ inline void Server::resetSelection() {
 	_selectedCharacterId = AI_NOTHING_SELECTED;
 }
 
+inline void Server::resetBehaviour(Zone* zone, const TreeNodePtr& root) {
+	CompiledTree::invalidate(root);
+	auto func = [&] (const AIPtr& ai) {
+		if (ai->getBehaviour() == root) {
+			ai->setBehaviour(root);
+		}
+	};
+	zone->executeParallel(func);
+}
+
 inline bool Server::updateNode(const CharacterId& characterId, int32_t nodeId, const std::string& name, const std::string& type, const std::string& condition) {
 	Zone* zone = _zone;
 	if (zone == nullptr) {
@@ -351,6 +434,7 @@ inline bool Server::updateNode(const CharacterId& characterId, int32_t nodeId, c
 			return false;
 		}
 		parent->replaceChild(nodeId, newNode);
+		resetBehaviour(zone, root);
 	}
 
 	Event event;
@@ -389,6 +473,7 @@ inline bool Server::addNode(const CharacterId& characterId, int32_t parentNodeId
 	if (!node->addChild(newNode)) {
 		return false;
 	}
+	resetBehaviour(zone, ai->getBehaviour());
 
 	Event event;
 	event.type = EV_UPDATESTATICCHRDETAILS;
@@ -415,6 +500,7 @@ inline bool Server::deleteNode(const CharacterId& characterId, int32_t nodeId) {
 		return false;
 	}
 	parent->replaceChild(nodeId, TreeNodePtr());
+	resetBehaviour(zone, root);
 	Event event;
 	event.type = EV_UPDATESTATICCHRDETAILS;
 	event.data.zone = zone;
@@ -468,6 +554,13 @@ inline void Server::pause(const ClientId& /*clientId*/, bool state) {
 	enqueueEvent(event);
 }
 
+inline void Server::setFilter(const ClientId& /*clientId*/, const AIStateFilter& filter) {
+	Event event;
+	event.type = EV_FILTER;
+	event.filter = filter;
+	enqueueEvent(event);
+}
+
 inline void Server::step(int64_t stepMillis) {
 	Event event;
 	event.type = EV_STEP;
@@ -493,10 +586,16 @@ inline void Server::update(int64_t deltaTime) {
 				broadcastCharacterDetails(zone);
 			}
 		}
-	} else if (pauseState) {
-		pause(1, false);
-		resetSelection();
+	} else {
+		if (pauseState) {
+			pause(1, false);
+			resetSelection();
+		}
+		if (clients == 0) {
+			resetTrackedState();
+		}
 	}
+	flushSerialized();
 	_network.update(deltaTime);
 }
 
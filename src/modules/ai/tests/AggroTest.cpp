@@ -73,3 +73,21 @@ TEST_F(AggroTest, testAggroMgrDegradeValue) {
 	const float newAggro = entry->getAggro();
 	ASSERT_FLOAT_EQ(expected, newAggro);
 }
+
+TEST_F(AggroTest, testAggroMgrInlineHighest) {
+	ai::AggroMgr mgr;
+	mgr.setReduceByRatio(0.5f, 0.6f);
+	for (int i = 1; i <= (int)ai::AggroMgr::InlineEntries; ++i) {
+		mgr.addAggro(i, (float)i);
+	}
+	ASSERT_FALSE(mgr.getEntries().allocated());
+	ASSERT_EQ((int)ai::AggroMgr::InlineEntries, mgr.getHighestEntry()->getCharacterId());
+	mgr.addAggro(1, 100.0f);
+	ASSERT_EQ(1, mgr.getHighestEntry()->getCharacterId());
+	mgr.update(1000);
+	ASSERT_FLOAT_EQ(50.5f, mgr.getHighestEntry()->getAggro());
+	// the entry with 2.0 dropped below the minimum aggro after two seconds
+	mgr.update(1000);
+	ASSERT_EQ(ai::AggroMgr::InlineEntries - 1u, mgr.getEntries().size());
+	ASSERT_EQ(1, mgr.getHighestEntry()->getCharacterId());
+}
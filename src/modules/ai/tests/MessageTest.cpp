@@ -101,6 +101,40 @@ TEST_F(MessageTest, testAIStateMessage) {
 	ASSERT_FLOAT_EQ(1.0f, d->getStates()[0].getOrientation());
 }
 
+TEST_F(MessageTest, testAIStateDeltaMessage) {
+	ai::AIStateDeltaMessage m;
+	m.addState(ai::AIStateWorld(1, ai::ZERO, 1.0f));
+	m.addRemoved(2);
+	m.addRemoved(3);
+
+	ai::AIStateDeltaMessage* d = serializeDeserialize(m);
+	ASSERT_EQ(ai::PROTO_STATE_DELTA, d->getId());
+	ASSERT_EQ(1u, d->getStates().size());
+	ASSERT_EQ(1, d->getStates()[0].getId());
+	ASSERT_EQ(2u, d->getRemoved().size());
+	ASSERT_EQ(3, d->getRemoved()[1]);
+}
+
+TEST_F(MessageTest, testAIFilterMessage) {
+	{
+		ai::AIFilterMessage m(ai::AIStateFilter(glm::vec3(1.0f, 2.0f, 3.0f), 10.0f));
+		ai::AIFilterMessage* d = serializeDeserialize(m);
+		ASSERT_EQ(m.getId(), d->getId());
+		ASSERT_EQ(ai::AIStateFilter::AREA, d->getFilter().getType());
+		ASSERT_FLOAT_EQ(10.0f, d->getFilter().getRadius());
+		ASSERT_TRUE(d->getFilter().accept(1, glm::vec3(1.0f, 2.0f, 12.0f)));
+		ASSERT_FALSE(d->getFilter().accept(1, glm::vec3(1.0f, 2.0f, 14.0f)));
+	}
+	{
+		ai::AIFilterMessage m(ai::AIStateFilter(std::vector<ai::CharacterId>{5, 3}));
+		ai::AIFilterMessage* d = serializeDeserialize(m);
+		ASSERT_EQ(ai::AIStateFilter::IDS, d->getFilter().getType());
+		ASSERT_TRUE(d->getFilter().accept(3, ai::ZERO));
+		ASSERT_TRUE(d->getFilter().accept(5, ai::ZERO));
+		ASSERT_FALSE(d->getFilter().accept(4, ai::ZERO));
+	}
+}
+
 TEST_F(MessageTest, testIProtocolMessageStep) {
 	ai::IProtocolMessage m(ai::PROTO_STEP);
 	ai::IProtocolMessage* d = serializeDeserialize(m);
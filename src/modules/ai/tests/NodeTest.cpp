@@ -149,3 +149,98 @@ TEST_F(NodeTest, testPrioritySelectorWithCondition) {
 	ASSERT_EQ(ai::CANNOTEXECUTE, idle1->getLastStatus(e));
 	ASSERT_EQ(ai::FINISHED, idle2->getLastStatus(e));
 }
+
+TEST_F(NodeTest, testCompiledSequence) {
+	ai::Sequence::Factory f;
+	ai::TreeNodeFactoryContext ctx("testsequence", "", ai::True::get());
+	ai::TreeNodePtr node = f.create(&ctx);
+
+	ai::Idle::Factory idleFac;
+	ai::TreeNodeFactoryContext idleCtx1("testidle", "2", ai::True::get());
+	ai::TreeNodePtr idle1 = idleFac.create(&idleCtx1);
+	ai::TreeNodeFactoryContext idleCtx2("testidle2", "2", ai::True::get());
+	ai::TreeNodePtr idle2 = idleFac.create(&idleCtx2);
+
+	node->addChild(idle1);
+	node->addChild(idle2);
+
+	ai::AIPtr ai(new ai::AI(node));
+	ai::ICharacterPtr chr(new ai::ICharacter(1));
+	ai->setCharacter(chr);
+	ai->update(1, true);
+	ai::CompiledTree::execute(ai, 1);
+	ASSERT_EQ(0, node->getOrdinal());
+	ASSERT_EQ(1, idle1->getOrdinal());
+	ASSERT_EQ(2, idle2->getOrdinal());
+	ASSERT_EQ(ai::RUNNING, idle1->getLastStatus(ai));
+	ASSERT_EQ(ai::UNKNOWN, idle2->getLastStatus(ai));
+	ai->update(1, true);
+	ai::CompiledTree::execute(ai, 1);
+	ASSERT_EQ(ai::RUNNING, idle1->getLastStatus(ai));
+	ASSERT_EQ(ai::UNKNOWN, idle2->getLastStatus(ai));
+	ai->update(1, true);
+	ai::CompiledTree::execute(ai, 1);
+	ASSERT_EQ(ai::FINISHED, idle1->getLastStatus(ai));
+	ASSERT_EQ(ai::RUNNING, idle2->getLastStatus(ai));
+	ai->update(1, true);
+	ai::CompiledTree::execute(ai, 1);
+	ASSERT_EQ(ai::FINISHED, idle1->getLastStatus(ai));
+	ASSERT_EQ(ai::RUNNING, idle2->getLastStatus(ai));
+	ai->update(1, true);
+	ai::CompiledTree::execute(ai, 1);
+	ASSERT_EQ(ai::FINISHED, idle1->getLastStatus(ai));
+	ASSERT_EQ(ai::FINISHED, idle2->getLastStatus(ai));
+	ai->update(1, true);
+	ai::CompiledTree::execute(ai, 1);
+	ASSERT_EQ(ai::RUNNING, idle1->getLastStatus(ai));
+	ASSERT_EQ(ai::FINISHED, idle2->getLastStatus(ai));
+}
+
+TEST_F(NodeTest, testCompiledTimerPerAI) {
+	ai::Idle::Factory idleFac;
+	ai::TreeNodeFactoryContext idleCtx("testidle", "2", ai::True::get());
+	ai::TreeNodePtr idle = idleFac.create(&idleCtx);
+
+	ai::AIPtr e1(new ai::AI(idle));
+	e1->setCharacter(ai::ICharacterPtr(new ai::ICharacter(1)));
+	ai::AIPtr e2(new ai::AI(idle));
+	e2->setCharacter(ai::ICharacterPtr(new ai::ICharacter(2)));
+
+	// the timer of the idle node is stored per ai - the second ai starts its own timer
+	ASSERT_EQ(ai::RUNNING, ai::CompiledTree::execute(e1, 1));
+	ASSERT_EQ(ai::RUNNING, ai::CompiledTree::execute(e2, 1));
+	ASSERT_EQ(ai::FINISHED, ai::CompiledTree::execute(e1, 2));
+	ASSERT_EQ(ai::RUNNING, ai::CompiledTree::execute(e1, 1));
+	ASSERT_EQ(ai::FINISHED, ai::CompiledTree::execute(e2, 2));
+}
+
+TEST_F(NodeTest, testCompiledAdapter) {
+	// the random selector is executed through the adapter - it runs its children with the dense node state
+	ai::RandomSelector::Factory f;
+	ai::TreeNodeFactoryContext ctx("testrandomselector", "", ai::True::get());
+	ai::TreeNodePtr node = f.create(&ctx);
+
+	ai::Sequence::Factory sequenceFac;
+	ai::TreeNodeFactoryContext sequenceCtx("testsequence", "", ai::True::get());
+	ai::TreeNodePtr sequence = sequenceFac.create(&sequenceCtx);
+	ai::Idle::Factory idleFac;
+	ai::TreeNodeFactoryContext idleCtx1("testidle", "2", ai::True::get());
+	ai::TreeNodePtr idle1 = idleFac.create(&idleCtx1);
+	ai::TreeNodeFactoryContext idleCtx2("testidle2", "2", ai::True::get());
+	ai::TreeNodePtr idle2 = idleFac.create(&idleCtx2);
+	sequence->addChild(idle1);
+	sequence->addChild(idle2);
+	node->addChild(sequence);
+
+	ai::AIPtr e(new ai::AI(node));
+	e->setCharacter(ai::ICharacterPtr(new ai::ICharacter(1)));
+	e->update(1, true);
+	ASSERT_EQ(ai::FINISHED, ai::CompiledTree::execute(e, 1));
+	ASSERT_EQ(1, sequence->getOrdinal());
+	ASSERT_EQ(ai::RUNNING, sequence->getLastStatus(e));
+	ASSERT_EQ(ai::RUNNING, idle1->getLastStatus(e));
+	e->update(1, true);
+	ai::CompiledTree::execute(e, 2);
+	ASSERT_EQ(ai::FINISHED, idle1->getLastStatus(e));
+	ASSERT_EQ(ai::RUNNING, idle2->getLastStatus(e));
+}
@@ -0,0 +1,350 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "tree/TreeNode.h"
+#include "tree/TreeNodeImpl.h"
+#include "tree/PrioritySelector.h"
+#include "tree/Sequence.h"
+#include "tree/Parallel.h"
+#include "tree/Invert.h"
+#include "tree/Limit.h"
+#include "tree/Succeed.h"
+#include "tree/Fail.h"
+#include "tree/ITask.h"
+#include "tree/ITimedNode.h"
+#include "AI.h"
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <typeinfo>
+
+namespace ai {
+
+/**
+ * @brief A behaviour tree that was flattened into a contiguous array of nodes.
+ *
+ * The nodes are stored in breadth first order - the children of a node are always stored next to each other.
+ * The index of a node in this array is its ordinal, which is also the index of its state in the state buffer
+ * of the @c AI instances that execute the tree. This replaces the hash lookups of the @c TreeNode state
+ * accessors with a plain array access.
+ *
+ * The stock composites and decorators are executed directly by the compiled tree, @c ITask and @c ITimedNode
+ * implementations are executed by calling their hooks. Every other node is executed through an adapter that
+ * calls @c TreeNode::execute() - its state accessors also use the dense state of the @c AI.
+ *
+ * @note The compiled tree is shared by all @c AI instances that execute the same root node. If the tree
+ * is modified, call @c invalidate() and reset the behaviour of the @c AI instances.
+ */
+class CompiledTree {
+private:
+	enum class Kind : uint8_t {
+		PrioritySelector, Sequence, Parallel, Invert, Limit, Succeed, Fail, Timed, Task, Adapter
+	};
+
+	struct Node {
+		Kind kind = Kind::Adapter;
+		uint32_t firstChild = 0u;
+		uint32_t childCount = 0u;
+		int amount = 0;
+		ICondition* condition = nullptr;
+		TreeNode* node = nullptr;
+	};
+
+	std::vector<Node> _nodes;
+	// keeps the nodes alive - indexed by the ordinal, too
+	TreeNodes _treeNodes;
+
+	static std::mutex& mutex() {
+		static std::mutex m;
+		return m;
+	}
+
+	static Kind kind(TreeNode* node);
+
+	TreeNodeStatus record(const AIPtr& entity, TreeNodeState& state, TreeNodeStatus status) const;
+	TreeNodeStatus execute(const AIPtr& entity, uint32_t index, int64_t deltaMillis) const;
+	void resetState(const AIPtr& entity, uint32_t index) const;
+	void resetChildren(const AIPtr& entity, const Node& node) const;
+
+	explicit CompiledTree(const TreeNodePtr& root);
+public:
+	/**
+	 * @return The compiled tree for the given root node - it's only compiled if there is no @c AI
+	 * instance that is still executing it.
+	 */
+	static CompiledTreePtr get(const TreeNodePtr& root);
+
+	/**
+	 * @brief Drops the compiled tree for the given root node - the next call to @c get() compiles it again
+	 */
+	static void invalidate(const TreeNodePtr& root);
+
+	/**
+	 * @brief Executes the behaviour of the given @c AI
+	 *
+	 * The behaviour is compiled with the first execution after it was set and the state buffer of the
+	 * @c AI is sized to the amount of nodes.
+	 */
+	static TreeNodeStatus execute(const AIPtr& entity, int64_t deltaMillis);
+
+	/**
+	 * @return The amount of nodes in the tree
+	 */
+	size_t size() const;
+};
+
+inline size_t CompiledTree::size() const {
+	return _nodes.size();
+}
+
+inline CompiledTree::Kind CompiledTree::kind(TreeNode* node) {
+	const std::type_info& type = typeid(*node);
+	if (type == typeid(PrioritySelector)) {
+		return Kind::PrioritySelector;
+	}
+	if (type == typeid(Sequence)) {
+		return Kind::Sequence;
+	}
+	if (type == typeid(Parallel)) {
+		return Kind::Parallel;
+	}
+	if (type == typeid(Invert) && node->getChildren().size() == 1u) {
+		return Kind::Invert;
+	}
+	if (type == typeid(Limit) && node->getChildren().size() == 1u) {
+		return Kind::Limit;
+	}
+	if (type == typeid(Succeed) && node->getChildren().size() == 1u) {
+		return Kind::Succeed;
+	}
+	if (type == typeid(Fail) && node->getChildren().size() == 1u) {
+		return Kind::Fail;
+	}
+	if (dynamic_cast<ITask*>(node) != nullptr) {
+		return Kind::Task;
+	}
+	if (dynamic_cast<ITimedNode*>(node) != nullptr) {
+		return Kind::Timed;
+	}
+	return Kind::Adapter;
+}
+
+inline CompiledTree::CompiledTree(const TreeNodePtr& root) {
+	_nodes.emplace_back();
+	_treeNodes.push_back(root);
+	for (uint32_t i = 0u; i < (uint32_t)_nodes.size(); ++i) {
+		TreeNode* treeNode = _treeNodes[i].get();
+		const TreeNodes& children = treeNode->getChildren();
+		treeNode->_ordinal = (int)i;
+		Node& node = _nodes[i];
+		node.kind = kind(treeNode);
+		node.node = treeNode;
+		node.condition = treeNode->getCondition().get();
+		node.firstChild = (uint32_t)_nodes.size();
+		node.childCount = (uint32_t)children.size();
+		if (node.kind == Kind::Limit) {
+			node.amount = static_cast<Limit*>(treeNode)->getAmount();
+		}
+		// the children of adapter nodes get an ordinal, too - they are using the dense state of the ai
+		for (const TreeNodePtr& child : children) {
+			_nodes.emplace_back();
+			_treeNodes.push_back(child);
+		}
+	}
+}
+
+inline CompiledTreePtr CompiledTree::get(const TreeNodePtr& root) {
+	std::lock_guard<std::mutex> lock(mutex());
+	CompiledTreePtr compiled = root->_compiled.lock();
+	if (!compiled) {
+		compiled = CompiledTreePtr(new CompiledTree(root));
+		root->_compiled = compiled;
+	}
+	return compiled;
+}
+
+inline void CompiledTree::invalidate(const TreeNodePtr& root) {
+	std::lock_guard<std::mutex> lock(mutex());
+	root->_compiled.reset();
+}
+
+inline TreeNodeStatus CompiledTree::execute(const AIPtr& entity, int64_t deltaMillis) {
+	if (!entity->_compiled) {
+		entity->_compiled = get(entity->_behaviour);
+		entity->_nodeStates.assign(entity->_compiled->size(), TreeNodeState());
+	}
+	return entity->_compiled->execute(entity, 0u, deltaMillis);
+}
+
+inline TreeNodeStatus CompiledTree::record(const AIPtr& entity, TreeNodeState& state, TreeNodeStatus status) const {
+	if (entity->_debuggingActive) {
+		state.lastStatus = status;
+	}
+	return status;
+}
+
+inline void CompiledTree::resetChildren(const AIPtr& entity, const Node& node) const {
+	for (uint32_t i = 0u; i < node.childCount; ++i) {
+		resetState(entity, node.firstChild + i);
+	}
+}
+
+inline void CompiledTree::resetState(const AIPtr& entity, uint32_t index) const {
+	const Node& node = _nodes[index];
+	if (node.kind == Kind::Adapter) {
+		node.node->resetState(entity);
+		return;
+	}
+	if (node.kind == Kind::Sequence) {
+		entity->_nodeStates[index].selectorState = AI_NOTHING_SELECTED;
+	}
+	resetChildren(entity, node);
+}
+
+inline TreeNodeStatus CompiledTree::execute(const AIPtr& entity, uint32_t index, int64_t deltaMillis) const {
+	const Node& node = _nodes[index];
+	if (node.kind == Kind::Adapter) {
+		return node.node->execute(entity, deltaMillis);
+	}
+	TreeNodeState& state = entity->_nodeStates[index];
+	if (!node.condition->evaluate(entity)) {
+		return record(entity, state, CANNOTEXECUTE);
+	}
+	if (entity->_debuggingActive) {
+		state.lastExecMillis = entity->_time;
+	}
+
+	switch (node.kind) {
+	case Kind::PrioritySelector: {
+		const uint32_t start = state.selectorState == AI_NOTHING_SELECTED ? 0u : (uint32_t)state.selectorState;
+		TreeNodeStatus overallResult = FINISHED;
+		uint32_t i = start;
+		for (uint32_t j = 0u; j < i; ++j) {
+			resetState(entity, node.firstChild + j);
+		}
+		for (; i < node.childCount; ++i) {
+			const uint32_t child = node.firstChild + i;
+			const TreeNodeStatus result = execute(entity, child, deltaMillis);
+			if (result == RUNNING) {
+				state.selectorState = (int)i;
+			} else if (result == CANNOTEXECUTE || result == FAILED) {
+				resetState(entity, child);
+				state.selectorState = AI_NOTHING_SELECTED;
+				continue;
+			} else {
+				state.selectorState = AI_NOTHING_SELECTED;
+			}
+			resetState(entity, child);
+			overallResult = result;
+			break;
+		}
+		for (++i; i < node.childCount; ++i) {
+			resetState(entity, node.firstChild + i);
+		}
+		return record(entity, state, overallResult);
+	}
+	case Kind::Sequence: {
+		TreeNodeStatus result = FINISHED;
+		const uint32_t progress = state.selectorState < 0 ? 0u : (uint32_t)state.selectorState;
+		for (uint32_t i = progress; i < node.childCount; ++i) {
+			result = execute(entity, node.firstChild + i, deltaMillis);
+			if (result == RUNNING) {
+				state.selectorState = (int)i;
+				break;
+			} else if (result == CANNOTEXECUTE || result == FAILED) {
+				resetState(entity, index);
+				break;
+			} else if (result == EXCEPTION) {
+				break;
+			}
+		}
+		if (result != RUNNING) {
+			resetState(entity, index);
+		}
+		return record(entity, state, result);
+	}
+	case Kind::Parallel: {
+		bool totalStatus = false;
+		for (uint32_t i = 0u; i < node.childCount; ++i) {
+			const uint32_t child = node.firstChild + i;
+			const bool isActive = execute(entity, child, deltaMillis) == RUNNING;
+			if (!isActive) {
+				resetState(entity, child);
+			}
+			totalStatus |= isActive;
+		}
+		if (!totalStatus) {
+			resetChildren(entity, node);
+		}
+		return record(entity, state, totalStatus ? RUNNING : FINISHED);
+	}
+	case Kind::Invert: {
+		const TreeNodeStatus status = execute(entity, node.firstChild, deltaMillis);
+		if (status == FINISHED) {
+			return record(entity, state, FAILED);
+		} else if (status == FAILED || status == CANNOTEXECUTE) {
+			return record(entity, state, FINISHED);
+		} else if (status == EXCEPTION) {
+			return record(entity, state, EXCEPTION);
+		}
+		return record(entity, state, RUNNING);
+	}
+	case Kind::Limit: {
+		if (state.limitState >= node.amount) {
+			return record(entity, state, FINISHED);
+		}
+		const TreeNodeStatus status = execute(entity, node.firstChild, deltaMillis);
+		++state.limitState;
+		return record(entity, state, status == RUNNING ? RUNNING : FAILED);
+	}
+	case Kind::Succeed: {
+		const TreeNodeStatus status = execute(entity, node.firstChild, deltaMillis);
+		return record(entity, state, status == RUNNING ? RUNNING : FINISHED);
+	}
+	case Kind::Fail: {
+		const TreeNodeStatus status = execute(entity, node.firstChild, deltaMillis);
+		return record(entity, state, status == RUNNING ? RUNNING : FAILED);
+	}
+	case Kind::Timed: {
+		ITimedNode* timed = static_cast<ITimedNode*>(node.node);
+		if (state.timerMillis == -1L) {
+			state.timerMillis = timed->getMillis();
+			const TreeNodeStatus status = timed->executeStart(entity, deltaMillis);
+			if (status == FINISHED) {
+				state.timerMillis = -1L;
+			}
+			return record(entity, state, status);
+		}
+		if (state.timerMillis - deltaMillis > 0) {
+			state.timerMillis -= deltaMillis;
+			const TreeNodeStatus status = timed->executeRunning(entity, deltaMillis);
+			if (status == FINISHED) {
+				state.timerMillis = -1L;
+			}
+			return record(entity, state, status);
+		}
+		state.timerMillis = -1L;
+		return record(entity, state, timed->executeExpired(entity, deltaMillis));
+	}
+	case Kind::Task: {
+		ITask* task = static_cast<ITask*>(node.node);
+#if AI_EXCEPTIONS
+		try {
+#endif
+			return record(entity, state, task->doAction(entity, deltaMillis));
+#if AI_EXCEPTIONS
+		} catch (...) {
+			ai_log_error("Exception while running task %s of type %s", task->getName().c_str(), task->getType().c_str());
+		}
+		return record(entity, state, EXCEPTION);
+#endif
+	}
+	case Kind::Adapter:
+		break;
+	}
+	return node.node->execute(entity, deltaMillis);
+}
+
+}
@@ -37,6 +37,13 @@ public:
 	}
 	virtual ~ITimedNode() {}
 
+	/**
+	 * @return The time in millis the node is running once it was started
+	 */
+	int64_t getMillis() const {
+		return _millis;
+	}
+
 	TreeNodeStatus execute(const AIPtr& entity, int64_t deltaMillis) override {
 		const TreeNodeStatus result = TreeNode::execute(entity, deltaMillis);
 		if (result == CANNOTEXECUTE)
@@ -30,6 +30,13 @@ public:
 		}
 	}
 
+	/**
+	 * @return The amount of runs the attached child is executed
+	 */
+	int getAmount() const {
+		return _amount;
+	}
+
 	TreeNodeStatus execute(const AIPtr& entity, int64_t deltaMillis) override {
 		ai_assert(_children.size() == 1, "Limit must have exactly one node");
 
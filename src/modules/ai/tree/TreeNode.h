@@ -17,6 +17,7 @@ namespace ai {
 class TreeNode;
 typedef std::shared_ptr<TreeNode> TreeNodePtr;
 typedef std::vector<TreeNodePtr> TreeNodes;
+class CompiledTree;
 
 /**
  * @brief Execution states of a TreeNode::execute() call
@@ -86,6 +87,7 @@ enum TreeNodeStatus {
  * to store your state!
  */
 class TreeNode : public MemObject {
+	friend class CompiledTree;
 protected:
 	static int getNextId() {
 		static int _nextId;
@@ -101,6 +103,14 @@ protected:
 	std::string _type;
 	std::string _parameters;
 	ConditionPtr _condition;
+	/**
+	 * @brief The index of this node in the @c CompiledTree it is part of - @c -1 if it wasn't compiled yet
+	 */
+	int _ordinal = -1;
+	/**
+	 * @brief Only set for the root node of a behaviour - shared by all @c AI instances that execute it
+	 */
+	std::weak_ptr<CompiledTree> _compiled;
 
 	TreeNodeStatus state(const AIPtr& entity, TreeNodeStatus treeNodeState);
 	int getSelectorState(const AIPtr& entity) const;
@@ -129,6 +139,12 @@ public:
 	 */
 	int getId() const;
 
+	/**
+	 * @brief The index of the node state in the @c CompiledTree
+	 * @return @c -1 if the node is not part of a compiled behaviour
+	 */
+	int getOrdinal() const;
+
 	/**
 	 * @brief Each node can have a user defines name that can be retrieved with this method.
 	 */
@@ -12,6 +12,10 @@ inline int TreeNode::getId() const {
 	return _id;
 }
 
+inline int TreeNode::getOrdinal() const {
+	return _ordinal;
+}
+
 inline void TreeNode::setName(const std::string& name) {
 	if (name.empty()) {
 		return;
@@ -69,10 +73,17 @@ inline void TreeNode::setLastExecMillis(const AIPtr& entity) {
 	if (!entity->_debuggingActive) {
 		return;
 	}
+	if (TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		nodeState->lastExecMillis = entity->_time;
+		return;
+	}
 	entity->_lastExecMillis[getId()] = entity->_time;
 }
 
 inline int TreeNode::getSelectorState(const AIPtr& entity) const {
+	if (const TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		return nodeState->selectorState;
+	}
 	AI::SelectorStates::const_iterator i = entity->_selectorStates.find(getId());
 	if (i == entity->_selectorStates.end()) {
 		return AI_NOTHING_SELECTED;
@@ -81,10 +92,17 @@ inline int TreeNode::getSelectorState(const AIPtr& entity) const {
 }
 
 inline void TreeNode::setSelectorState(const AIPtr& entity, int selected) {
+	if (TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		nodeState->selectorState = selected;
+		return;
+	}
 	entity->_selectorStates[getId()] = selected;
 }
 
 inline int TreeNode::getLimitState(const AIPtr& entity) const {
+	if (const TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		return nodeState->limitState;
+	}
 	AI::LimitStates::const_iterator i = entity->_limitStates.find(getId());
 	if (i == entity->_limitStates.end()) {
 		return 0;
@@ -93,6 +111,10 @@ inline int TreeNode::getLimitState(const AIPtr& entity) const {
 }
 
 inline void TreeNode::setLimitState(const AIPtr& entity, int amount) {
+	if (TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		nodeState->limitState = amount;
+		return;
+	}
 	entity->_limitStates[getId()] = amount;
 }
 
@@ -100,6 +122,10 @@ inline TreeNodeStatus TreeNode::state(const AIPtr& entity, TreeNodeStatus treeNo
 	if (!entity->_debuggingActive) {
 		return treeNodeState;
 	}
+	if (TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		nodeState->lastStatus = treeNodeState;
+		return treeNodeState;
+	}
 	entity->_lastStatus[getId()] = treeNodeState;
 	return treeNodeState;
 }
@@ -108,6 +134,9 @@ inline int64_t TreeNode::getLastExecMillis(const AIPtr& entity) const {
 	if (!entity->_debuggingActive) {
 		return -1L;
 	}
+	if (const TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		return nodeState->lastExecMillis;
+	}
 	AI::LastExecMap::const_iterator i = entity->_lastExecMillis.find(getId());
 	if (i == entity->_lastExecMillis.end()) {
 		return -1L;
@@ -119,6 +148,9 @@ inline TreeNodeStatus TreeNode::getLastStatus(const AIPtr& entity) const {
 	if (!entity->_debuggingActive) {
 		return UNKNOWN;
 	}
+	if (const TreeNodeState* nodeState = entity->getNodeState(_ordinal)) {
+		return nodeState->lastStatus;
+	}
 	AI::NodeStates::const_iterator i = entity->_lastStatus.find(getId());
 	if (i == entity->_lastStatus.end()) {
 		return UNKNOWN;
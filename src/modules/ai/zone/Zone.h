@@ -15,6 +15,7 @@
 
 #include "ICharacter.h"
 #include "group/GroupMgr.h"
+#include "tree/CompiledTree.h"
 #include "common/Thread.h"
 #include "common/ThreadPool.h"
 #include "common/Types.h"
@@ -77,6 +78,19 @@ protected:
 	 */
 	bool doDestroyAI(const CharacterId& id);
 
+	/**
+	 * @brief Snapshot of the current @c AI instances to be able to iterate over them without holding the zone lock
+	 */
+	std::vector<AIPtr> copyAIs() const {
+		std::vector<AIPtr> copy;
+		ScopedReadLock scopedLock(_lock);
+		copy.reserve(_ais.size());
+		for (const auto& e : _ais) {
+			copy.push_back(e.second);
+		}
+		return copy;
+	}
+
 public:
 	Zone(const std::string& name, int threadCount = std::min(1u, std::thread::hardware_concurrency())) :
 			_name(name), _debug(false), _threadPool(threadCount) {
@@ -256,17 +270,12 @@ public:
 	 */
 	template<typename Func>
 	void executeParallel(Func& func) {
-		std::vector<std::future<void> > results;
-		_lock.lockRead();
-		AIMap copy(_ais);
-		_lock.unlockRead();
-		for (auto i = copy.begin(); i != _ais.end(); ++i) {
-			const AIPtr& ai = i->second;
-			results.emplace_back(executeAsync(ai, func));
-		}
-		for (auto & result: results) {
-			result.wait();
-		}
+		const std::vector<AIPtr>& ais = copyAIs();
+		_threadPool.parallelFor(0, (int)ais.size(), [&] (int start, int end) {
+			for (int i = start; i < end; ++i) {
+				func(ais[i]);
+			}
+		});
 	}
 
 	/**
@@ -278,17 +287,12 @@ public:
 	 */
 	template<typename Func>
 	void executeParallel(const Func& func) const {
-		std::vector<std::future<void> > results;
-		_lock.lockRead();
-		AIMap copy(_ais);
-		_lock.unlockRead();
-		for (auto i = copy.begin(); i != copy.end(); ++i) {
-			const AIPtr& ai = i->second;
-			results.emplace_back(executeAsync(ai, func));
-		}
-		for (auto & result: results) {
-			result.wait();
-		}
+		const std::vector<AIPtr>& ais = copyAIs();
+		_threadPool.parallelFor(0, (int)ais.size(), [&] (int start, int end) {
+			for (int i = start; i < end; ++i) {
+				func(ais[i]);
+			}
+		});
 	}
 
 	/**
@@ -443,7 +447,7 @@ inline void Zone::update(int64_t dt) {
 			return;
 		}
 		ai->update(dt, _debug);
-		ai->getBehaviour()->execute(ai, dt);
+		CompiledTree::execute(ai, dt);
 	};
 	executeParallel(func);
 	_groupManager.update(dt);
@@ -32,7 +32,7 @@ bool Attributes::update(long dt) {
 		max[p.first] *= 1.0 + (p.second * 0.01);
 	}
 
-	core::ScopedReadLock scopedLock(_attribLock);
+	core::ScopedWriteLock scopedLock(_attribLock);
 	if (!_listeners.empty()) {
 		const TypeSet& diff = core::mapFindChangedValues(_max, max);
 		for (const auto& listener : _listeners) {
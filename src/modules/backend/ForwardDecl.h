@@ -99,6 +99,9 @@ namespace stock {
 class StockDataProvider;
 typedef std::shared_ptr<StockDataProvider> StockDataProviderPtr;
 
+class Journal;
+typedef std::shared_ptr<Journal> JournalPtr;
+
 }
 
 namespace eventmgr {
@@ -0,0 +1,117 @@
+/**
+ * @file
+ */
+
+#include "core/benchmark/AbstractBenchmark.h"
+#include "core/App.h"
+#include "core/Var.h"
+#include "core/GameConfig.h"
+#include "math/Random.h"
+#include "backend/world/MapProvider.h"
+#include "backend/world/Map.h"
+#include "backend/spawn/SpawnMgr.h"
+#include "backend/entity/Npc.h"
+#include "backend/entity/EntityStorage.h"
+#include "backend/entity/ai/AIRegistry.h"
+#include "backend/entity/ai/AILoader.h"
+#include "network/ProtocolHandlerRegistry.h"
+#include "network/ServerNetwork.h"
+#include "network/ServerMessageSender.h"
+#include "cooldown/CooldownProvider.h"
+#include "attrib/ContainerProvider.h"
+#include "voxel/MaterialColor.h"
+
+namespace backend {
+
+namespace {
+
+const int Entities = 50000;
+const int MapSize = 1024;
+
+const char *CONTAINER = R"(function animal(name)
+local c = attrib.createContainer(name)
+c:absolute("SPEED", 1.5)
+c:absolute("HEALTH", 100.0)
+c:absolute("STRENGTH", 5.0)
+c:absolute("VIEWDISTANCE", 20.0)
+c:absolute("FIELDOFVIEW", 240.0)
+c:register()
+end
+
+function init()
+animal("ANIMAL_RABBIT")
+animal("ANIMAL_WOLF")
+end)";
+
+}
+
+class MapBenchmark: public core::AbstractBenchmark {
+protected:
+	MapProviderPtr _mapProvider;
+	MapPtr _map;
+
+	bool onInitApp() override {
+		core::Var::get(cfg::ServerSeed, "1");
+		core::Var::get(cfg::VoxelMeshSize, "16", core::CV_READONLY);
+		voxel::initDefaultMaterialColors();
+		core::App* app = core::App::getInstance();
+		const core::EventBusPtr& eventBus = app->eventBus();
+		const io::FilesystemPtr& filesystem = app->filesystem();
+		const core::TimeProviderPtr& timeProvider = app->timeProvider();
+		const EntityStoragePtr& entityStorage = std::make_shared<EntityStorage>(eventBus);
+		const network::ProtocolHandlerRegistryPtr& protocolHandlerRegistry = std::make_shared<network::ProtocolHandlerRegistry>();
+		const network::ServerNetworkPtr& network = std::make_shared<network::ServerNetwork>(protocolHandlerRegistry, eventBus);
+		const network::ServerMessageSenderPtr& messageSender = std::make_shared<network::ServerMessageSender>(network);
+		const AIRegistryPtr& registry = std::make_shared<AIRegistry>();
+		registry->init();
+		const AILoaderPtr& loader = std::make_shared<AILoader>(registry);
+		const attrib::ContainerProviderPtr& containerProvider = std::make_shared<attrib::ContainerProvider>();
+		if (!containerProvider->init(CONTAINER)) {
+			return false;
+		}
+		const cooldown::CooldownProviderPtr& cooldownProvider = std::make_shared<cooldown::CooldownProvider>();
+		_mapProvider = std::make_shared<MapProvider>(filesystem, eventBus, timeProvider,
+				entityStorage, messageSender, loader, containerProvider, cooldownProvider);
+		if (!_mapProvider->init()) {
+			return false;
+		}
+		_map = _mapProvider->map(1);
+
+		math::Random random(1);
+		for (int i = 0; i < Entities; ++i) {
+			const glm::ivec3 pos(random.random(0, MapSize), 0, random.random(0, MapSize));
+			if (!_map->spawnMgr()->spawn(network::EntityType::ANIMAL_RABBIT, &pos)) {
+				return false;
+			}
+		}
+		// let the npcs find the ground - this generates the voxel world they are walking on
+		_map->update(0l);
+		return true;
+	}
+
+	void onCleanupApp() override {
+		_map = MapPtr();
+		_mapProvider->shutdown();
+		_mapProvider = MapProviderPtr();
+	}
+};
+
+/**
+ * One tick of a map with @c Entities npcs that are spread over @c MapSize x @c MapSize
+ */
+BENCHMARK_DEFINE_F(MapBenchmark, tick)(benchmark::State& state) {
+	if (!_map || _map->npcCount() < Entities) {
+		state.SkipWithError("Failed to spawn the npcs");
+		return;
+	}
+	while (state.KeepRunning()) {
+		_map->update(100l);
+	}
+	state.SetItemsProcessed(state.iterations() * _map->npcCount());
+}
+
+BENCHMARK_REGISTER_F(MapBenchmark, tick)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}
+
+BENCHMARK_MAIN()
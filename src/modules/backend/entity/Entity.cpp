@@ -12,6 +12,8 @@
 #include "backend/world/Map.h"
 #include "poi/PoiProvider.h"
 #include "network/ServerMessageSender.h"
+#include "core/GameConfig.h"
+#include "core/TimeProvider.h"
 #include "attrib/ContainerProvider.h"
 
 namespace backend {
@@ -21,8 +23,9 @@ Entity::Entity(EntityId id,
 		const network::ServerMessageSenderPtr& messageSender,
 		const core::TimeProviderPtr& timeProvider,
 		const attrib::ContainerProviderPtr& containerProvider) :
-		_messageSender(messageSender), _containerProvider(containerProvider),
+		_timeProvider(timeProvider), _messageSender(messageSender), _containerProvider(containerProvider),
 		_map(map), _entityId(id) {
+	_entityUpdateInterval = core::Var::get(cfg::ServerEntityUpdateInterval, "100");
 	_attribs.addListener(std::bind(&Entity::onAttribChange, this, std::placeholders::_1));
 }
 
@@ -108,6 +111,7 @@ void Entity::onAttribChange(const attrib::DirtyValue& v) {
 	Log::debug("Attrib changed for type %s (current: %s) to value %f",
 			network::EnumNameAttribType(v.type), (v.current ? "true" : "false"), v.value);
 	_dirtyAttributeTypes.insert(v);
+	_attribsChanged = true;
 }
 
 void Entity::addContainer(const std::string& id) {
@@ -165,8 +169,16 @@ void Entity::updateVisible(const EntitySet& set) {
 	core_assert(stillVisible.size() + add.size() == _visible.size());
 	_visibleLock.unlockWrite();
 
-	for (const auto& e : _visible) {
-		sendEntityUpdate(e);
+	// the clients interpolate between the updates - so they are only sent with a fixed rate
+	const uint64_t now = _timeProvider->tickMillis();
+	if (now >= _nextEntityUpdateMillis) {
+		_nextEntityUpdateMillis = now + (uint64_t)_entityUpdateInterval->intVal();
+		if (_peer != nullptr) {
+			sendEntityUpdate(ptr());
+		}
+		for (const auto& e : _visible) {
+			sendEntityUpdate(e);
+		}
 	}
 
 	if (!add.empty()) {
@@ -185,7 +197,7 @@ void Entity::sendEntityUpdate(const EntityPtr& entity) const {
 	const network::Vec3 pos { _pos.x, _pos.y, _pos.z };
 	_entityUpdateFBB.Clear();
 	_messageSender->sendServerMessage(_peer, _entityUpdateFBB, network::ServerMsgType::EntityUpdate,
-			network::CreateEntityUpdate(_entityUpdateFBB, entity->id(), &pos, entity->orientation()).Union());
+			network::CreateEntityUpdate(_entityUpdateFBB, entity->id(), &pos, entity->orientation(), _timeProvider->tickMillis()).Union());
 }
 
 void Entity::sendEntitySpawn(const EntityPtr& entity) const {
@@ -7,13 +7,16 @@
 #include "core/GLM.h"
 #include "math/Rect.h"
 #include "core/ReadWriteLock.h"
+#include "core/Var.h"
 #include "attrib/Attributes.h"
 #include "backend/ForwardDecl.h"
+#include "EntityComponents.h"
 #include "ServerMessages_generated.h"
 #include "network/IProtocolHandler.h"
 
 #include <unordered_set>
 #include <memory>
+#include <atomic>
 
 namespace backend {
 
@@ -36,8 +39,12 @@ private:
 	mutable flatbuffers::FlatBufferBuilder _entityUpdateFBB;
 	mutable flatbuffers::FlatBufferBuilder _entitySpawnFBB;
 	mutable flatbuffers::FlatBufferBuilder _entityRemoveFBB;
+	core::VarPtr _entityUpdateInterval;
+	uint64_t _nextEntityUpdateMillis = 0u;
 
 protected:
+	core::TimeProviderPtr _timeProvider;
+
 	// network stuff
 	network::ServerMessageSenderPtr _messageSender;
 	ENetPeer *_peer = nullptr;
@@ -46,8 +53,10 @@ protected:
 	attrib::ContainerProviderPtr _containerProvider;
 	attrib::Attributes _attribs;
 	std::unordered_set<attrib::DirtyValue> _dirtyAttributeTypes;
+	std::atomic_bool _attribsChanged { true };
 
 	MapPtr _map;
+	ComponentHandle _componentHandle;
 
 	EntityId _entityId;
 	network::EntityType _entityType = network::EntityType::NONE;
@@ -85,6 +94,17 @@ public:
 	const MapPtr& map() const;
 	void setMap(const MapPtr& map, const glm::vec3& pos);
 
+	/**
+	 * @brief The handle of the entity in the @c EntityComponents of the map
+	 */
+	const ComponentHandle& componentHandle() const;
+	void setComponentHandle(const ComponentHandle& handle);
+
+	/**
+	 * @return @c true if any attribute value changed since the last call
+	 */
+	bool fetchAttribsChanged();
+
 	void setPointOfInterest();
 
 	bool dead() const;
@@ -245,6 +265,18 @@ inline void Entity::setMap(const MapPtr& map, const glm::vec3& pos) {
 	_pos = pos;
 }
 
+inline const ComponentHandle& Entity::componentHandle() const {
+	return _componentHandle;
+}
+
+inline void Entity::setComponentHandle(const ComponentHandle& handle) {
+	_componentHandle = handle;
+}
+
+inline bool Entity::fetchAttribsChanged() {
+	return _attribsChanged.exchange(false);
+}
+
 inline bool Entity::dead() const {
 	return _attribs.current(attrib::Type::HEALTH) < 0.00001;
 }
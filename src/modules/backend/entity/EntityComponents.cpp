@@ -0,0 +1,206 @@
+/**
+ * @file
+ */
+
+#include "EntityComponents.h"
+#include "Entity.h"
+#include "math/Frustum.h"
+#include <algorithm>
+
+namespace backend {
+
+namespace {
+// don't let the grid grow too large if the entities are spread over a large area
+const int MaxCellsPerEntity = 4;
+const int MinCells = 1024;
+}
+
+ComponentHandle EntityComponents::add(const EntityPtr& entity, bool gameThread) {
+	uint32_t slot;
+	if (_freeSlots.empty()) {
+		slot = (uint32_t)_indices.size();
+		_indices.push_back(0u);
+		_generations.push_back(0u);
+	} else {
+		slot = _freeSlots.back();
+		_freeSlots.pop_back();
+	}
+	const int index = size();
+	_indices[slot] = (uint32_t)index;
+	_entities.push_back(entity);
+	_positions.push_back(entity->pos());
+	_orientations.push_back(entity->orientation());
+	_sizes.push_back(entity->size());
+	_speeds.push_back(0.0f);
+	_viewDistances.push_back(0.0f);
+	_fieldOfViews.push_back(0.0f);
+	_flags.push_back(gameThread ? (uint8_t)(GameThread | Added) : (uint8_t)Added);
+	_slots.push_back(slot);
+	return ComponentHandle{slot, _generations[slot]};
+}
+
+bool EntityComponents::valid(const ComponentHandle& handle) const {
+	return handle.slot < _generations.size() && _generations[handle.slot] == handle.generation;
+}
+
+int EntityComponents::index(const ComponentHandle& handle) const {
+	if (!valid(handle)) {
+		return -1;
+	}
+	return (int)_indices[handle.slot];
+}
+
+bool EntityComponents::remove(const ComponentHandle& handle) {
+	const int idx = index(handle);
+	if (idx < 0) {
+		return false;
+	}
+	const int last = size() - 1;
+	if (idx != last) {
+		_entities[idx] = std::move(_entities[last]);
+		_positions[idx] = _positions[last];
+		_orientations[idx] = _orientations[last];
+		_sizes[idx] = _sizes[last];
+		_speeds[idx] = _speeds[last];
+		_viewDistances[idx] = _viewDistances[last];
+		_fieldOfViews[idx] = _fieldOfViews[last];
+		_flags[idx] = _flags[last];
+		_slots[idx] = _slots[last];
+		_indices[_slots[idx]] = (uint32_t)idx;
+	}
+	_entities.pop_back();
+	_positions.pop_back();
+	_orientations.pop_back();
+	_sizes.pop_back();
+	_speeds.pop_back();
+	_viewDistances.pop_back();
+	_fieldOfViews.pop_back();
+	_flags.pop_back();
+	_slots.pop_back();
+
+	// invalidate all handles to this slot
+	++_generations[handle.slot];
+	_freeSlots.push_back(handle.slot);
+	// the grid is invalid now
+	_gridWidth = _gridHeight = 0;
+	return true;
+}
+
+void EntityComponents::sync(int index) {
+	const EntityPtr& entity = _entities[index];
+	uint8_t flags = _flags[index] & ~(DirtyMask | Added);
+	const glm::vec3& pos = entity->pos();
+	if (pos != _positions[index]) {
+		_positions[index] = pos;
+		flags |= Moved;
+	}
+	const float orientation = entity->orientation();
+	if (orientation != _orientations[index]) {
+		_orientations[index] = orientation;
+		flags |= Rotated;
+	}
+	// the attribute values are only fetched if any of them changed
+	if (entity->fetchAttribsChanged() || (_flags[index] & Added) != 0) {
+		_speeds[index] = (float)entity->current(attrib::Type::SPEED);
+		_viewDistances[index] = (float)entity->current(attrib::Type::VIEWDISTANCE);
+		const double fieldOfView = entity->current(attrib::Type::FIELDOFVIEW);
+		_fieldOfViews[index] = fieldOfView <= 1.0 ? 0.0f : (float)glm::radians(fieldOfView);
+		flags |= AttribsChanged;
+	}
+	_sizes[index] = entity->size();
+	_flags[index] = flags;
+}
+
+inline int EntityComponents::cellX(float x) const {
+	return glm::clamp((int)((x - _gridMins.x) / _cellSize), 0, _gridWidth - 1);
+}
+
+inline int EntityComponents::cellZ(float z) const {
+	return glm::clamp((int)((z - _gridMins.y) / _cellSize), 0, _gridHeight - 1);
+}
+
+void EntityComponents::buildGrid(float cellSize) {
+	const int n = size();
+	if (n == 0) {
+		_gridWidth = _gridHeight = 0;
+		return;
+	}
+	glm::vec2 mins(_positions[0].x, _positions[0].z);
+	glm::vec2 maxs = mins;
+	_maxHalfSize = 0.0f;
+	for (int i = 0; i < n; ++i) {
+		const glm::vec3& p = _positions[i];
+		mins = glm::min(mins, glm::vec2(p.x, p.z));
+		maxs = glm::max(maxs, glm::vec2(p.x, p.z));
+		_maxHalfSize = glm::max(_maxHalfSize, _sizes[i] * 0.5f);
+	}
+	const int maxCells = glm::max(MinCells, n * MaxCellsPerEntity);
+	const glm::vec2 extent = maxs - mins;
+	_cellSize = cellSize;
+	for (;;) {
+		_gridWidth = (int)(extent.x / _cellSize) + 1;
+		_gridHeight = (int)(extent.y / _cellSize) + 1;
+		if ((int64_t)_gridWidth * (int64_t)_gridHeight <= (int64_t)maxCells) {
+			break;
+		}
+		_cellSize *= 2.0f;
+	}
+	_gridMins = mins;
+
+	// counting sort of the entity indices by their cell
+	const int cells = _gridWidth * _gridHeight;
+	_cellStart.assign(cells + 1, 0);
+	_cellEntries.resize(n);
+	std::vector<int> cellOf(n);
+	for (int i = 0; i < n; ++i) {
+		const glm::vec3& p = _positions[i];
+		cellOf[i] = cellZ(p.z) * _gridWidth + cellX(p.x);
+		++_cellStart[cellOf[i] + 1];
+	}
+	for (int c = 0; c < cells; ++c) {
+		_cellStart[c + 1] += _cellStart[c];
+	}
+	std::vector<int> fill(_cellStart.begin(), _cellStart.end() - 1);
+	for (int i = 0; i < n; ++i) {
+		_cellEntries[fill[cellOf[i]]++] = i;
+	}
+}
+
+void EntityComponents::visible(int index, std::vector<int>& result) const {
+	result.clear();
+	const float fieldOfView = _fieldOfViews[index];
+	if (fieldOfView <= 0.0f || _gridWidth <= 0) {
+		return;
+	}
+	const glm::vec3& eye = _positions[index];
+	const float orientation = _orientations[index];
+	const float viewDistance = _viewDistances[index];
+	// the view rect must intersect the rect of the other entity
+	const float range = viewDistance + _maxHalfSize;
+	const int minX = cellX(eye.x - range);
+	const int maxX = cellX(eye.x + range);
+	const int minZ = cellZ(eye.z - range);
+	const int maxZ = cellZ(eye.z + range);
+	for (int z = minZ; z <= maxZ; ++z) {
+		const int row = z * _gridWidth;
+		const int* begin = &_cellEntries[0] + _cellStart[row + minX];
+		const int* end = &_cellEntries[0] + _cellStart[row + maxX + 1];
+		for (const int* i = begin; i != end; ++i) {
+			const int other = *i;
+			if (other == index) {
+				continue;
+			}
+			const glm::vec3& target = _positions[other];
+			const float distance = viewDistance + _sizes[other] * 0.5f;
+			if (glm::abs(target.x - eye.x) >= distance || glm::abs(target.z - eye.z) >= distance) {
+				continue;
+			}
+			if (!math::Frustum::isVisible(eye, orientation, target, fieldOfView)) {
+				continue;
+			}
+			result.push_back(other);
+		}
+	}
+}
+
+}
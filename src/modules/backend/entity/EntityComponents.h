@@ -0,0 +1,162 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "backend/ForwardDecl.h"
+#include "core/GLM.h"
+#include "core/Assert.h"
+#include <vector>
+#include <stdint.h>
+
+namespace backend {
+
+/**
+ * @brief Stable reference to the components of an entity - stays valid while other entities are added or removed
+ */
+struct ComponentHandle {
+	uint32_t slot = 0xFFFFFFFFu;
+	uint32_t generation = 0u;
+};
+
+/**
+ * @brief Dense storage of the per tick state of the entities of a map
+ *
+ * The state that is needed for the tick of all entities (position, orientation, speed, the current attribute
+ * values that are used for the visibility) is kept in one array per component. This allows the map to run the
+ * update passes over a contiguous index range - split up in chunks for the thread pool - without chasing the
+ * pointers through the @c Entity and its @c attrib::Attributes instances.
+ *
+ * The @c Entity is still the owner of the state - @c sync() copies it into the arrays once per tick.
+ *
+ * @note Removing an entity moves the last entity into the free index - the index of an entity is only valid until
+ * the next @c remove() call. Use the @c ComponentHandle to keep a reference.
+ */
+class EntityComponents {
+public:
+	enum Flags : uint8_t {
+		// the entity must be updated on the game thread
+		GameThread = 1 << 0,
+		// the entity asked to be removed in its last update
+		Remove = 1 << 1,
+		// the entity wasn't synced yet
+		Added = 1 << 2,
+		// dirty flags - set by sync()
+		Moved = 1 << 3,
+		Rotated = 1 << 4,
+		AttribsChanged = 1 << 5,
+
+		DirtyMask = Moved | Rotated | AttribsChanged
+	};
+
+private:
+	// dense - indexed by the component index
+	std::vector<EntityPtr> _entities;
+	std::vector<glm::vec3> _positions;
+	std::vector<float> _orientations;
+	std::vector<float> _sizes;
+	std::vector<float> _speeds;
+	std::vector<float> _viewDistances;
+	// the field of view in radians - 0 if the entity is blind
+	std::vector<float> _fieldOfViews;
+	std::vector<uint8_t> _flags;
+	std::vector<uint32_t> _slots;
+
+	// sparse - indexed by the handle slot
+	std::vector<uint32_t> _indices;
+	std::vector<uint32_t> _generations;
+	std::vector<uint32_t> _freeSlots;
+
+	// uniform grid over the positions - the entries of a cell are stored in one block of _cellEntries
+	float _cellSize = 32.0f;
+	glm::vec2 _gridMins { 0.0f };
+	int _gridWidth = 0;
+	int _gridHeight = 0;
+	float _maxHalfSize = 0.0f;
+	std::vector<int> _cellStart;
+	std::vector<int> _cellEntries;
+
+	int cellX(float x) const;
+	int cellZ(float z) const;
+public:
+	/**
+	 * @param[in] gameThread @c true if the update of the entity is not thread safe
+	 */
+	ComponentHandle add(const EntityPtr& entity, bool gameThread);
+	bool remove(const ComponentHandle& handle);
+	bool valid(const ComponentHandle& handle) const;
+	/**
+	 * @return The current index of the entity in the component arrays or @c -1 if the handle is not valid
+	 */
+	int index(const ComponentHandle& handle) const;
+	int size() const;
+
+	/**
+	 * @brief Copies the state of the entity at the given index into the component arrays and updates the dirty flags
+	 * @note Different indices can be synced in parallel
+	 */
+	void sync(int index);
+
+	/**
+	 * @brief Sorts the entities into the cells of the grid that is used by @c visible()
+	 * @note Call this after all entities were synced
+	 */
+	void buildGrid(float cellSize);
+
+	/**
+	 * @brief Collects the indices of the entities that can be seen by the entity at the given index
+	 * @note This is only reading the component arrays and the grid - it can be executed in parallel
+	 * for different indices
+	 */
+	void visible(int index, std::vector<int>& result) const;
+
+	const EntityPtr& entity(int index) const;
+	const glm::vec3& position(int index) const;
+	float orientation(int index) const;
+	float speed(int index) const;
+	float viewDistance(int index) const;
+	float fieldOfView(int index) const;
+
+	uint8_t flags(int index) const;
+	void setFlag(int index, Flags flag);
+};
+
+inline int EntityComponents::size() const {
+	return (int)_entities.size();
+}
+
+inline const EntityPtr& EntityComponents::entity(int index) const {
+	core_assert(index >= 0 && index < size());
+	return _entities[index];
+}
+
+inline const glm::vec3& EntityComponents::position(int index) const {
+	return _positions[index];
+}
+
+inline float EntityComponents::orientation(int index) const {
+	return _orientations[index];
+}
+
+inline float EntityComponents::speed(int index) const {
+	return _speeds[index];
+}
+
+inline float EntityComponents::viewDistance(int index) const {
+	return _viewDistances[index];
+}
+
+inline float EntityComponents::fieldOfView(int index) const {
+	return _fieldOfViews[index];
+}
+
+inline uint8_t EntityComponents::flags(int index) const {
+	return _flags[index];
+}
+
+inline void EntityComponents::setFlag(int index, Flags flag) {
+	_flags[index] |= flag;
+}
+
+}
@@ -15,7 +15,7 @@ namespace backend {
 /**
  * @brief Manages the Entity instances of the backend.
  *
- * This includes calling the Entity::update() method as well as performing the visibility calculations.
+ * The tick of the entities and the visibility calculations are performed by the @c Map they are on.
  */
 class EntityStorage : public core::IEventBusHandler<EntityDeleteEvent>{
 private:
@@ -29,8 +29,6 @@ private:
 
 	core::EventBusPtr _eventBus;
 	long _time;
-
-	bool updateEntity(const EntityPtr& entity, long dt);
 public:
 	EntityStorage(const core::EventBusPtr& eventBus);
 
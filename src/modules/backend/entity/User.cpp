@@ -22,7 +22,6 @@ User::User(ENetPeer* peer, EntityId id,
 		Super(id, map, messageSender, timeProvider, containerProvider),
 		_name(name),
 		_dbHandler(dbHandler),
-		_timeProvider(timeProvider),
 		_cooldownProvider(cooldownProvider),
 		_stockMgr(this, stockDataProvider, dbHandler),
 		_cooldownMgr(this, timeProvider, cooldownProvider, dbHandler, persistenceMgr),
@@ -23,7 +23,6 @@ private:
 	std::string _name;
 	std::string _email;
 	persistence::DBHandlerPtr _dbHandler;
-	core::TimeProviderPtr _timeProvider;
 	cooldown::CooldownProviderPtr _cooldownProvider;
 
 	UserStockMgr _stockMgr;
@@ -44,13 +44,9 @@ void UserMovementMgr::update(long dt) {
 	pos.y = map->findFloor(pos);
 	Log::trace("move: dt %li, speed: %f p(%f:%f:%f), pitch: %f, yaw: %f", dt, speed,
 			pos.x, pos.y, pos.z, orientation, _yaw);
+	// the new position is sent with the next entity update - see Entity::updateVisible()
 	_user->setPos(pos);
 
-	const network::Vec3 netPos { pos.x, pos.y, pos.z };
-	_user->sendToVisible(_entityUpdateFBB,
-			network::ServerMsgType::EntityUpdate,
-			network::CreateEntityUpdate(_entityUpdateFBB, _user->id(), &netPos, orientation).Union(), true);
-
 	_user->logoutMgr().updateLastActionTime();
 }
 
@@ -16,7 +16,6 @@ private:
 	network::MoveDirection _moveMask = network::MoveDirection::NONE;
 	float _yaw = 0.0f;
 	User* _user;
-	flatbuffers::FlatBufferBuilder _entityUpdateFBB;
 
 	bool isMove(network::MoveDirection dir) const;
 	void addMove(network::MoveDirection dir);
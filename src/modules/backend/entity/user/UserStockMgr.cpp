@@ -12,7 +12,7 @@
 namespace backend {
 
 UserStockMgr::UserStockMgr(User* user, const stock::StockDataProviderPtr& stockDataProvider, const persistence::DBHandlerPtr& dbHandler) :
-		_user(user), _dbHandler(dbHandler), _stock(stockDataProvider) {
+		_user(user), _stockDataProvider(stockDataProvider), _dbHandler(dbHandler), _stock(stockDataProvider, user->id()) {
 }
 
 void UserStockMgr::update(long dt) {
@@ -9,6 +9,7 @@
 #include "core/Var.h"
 #include "core/Log.h"
 #include "core/App.h"
+#include "core/TimeProvider.h"
 #include "io/Filesystem.h"
 #include "cooldown/CooldownProvider.h"
 #include "attrib/ContainerProvider.h"
@@ -48,6 +49,7 @@ ServerLoop::ServerLoop(const core::TimeProviderPtr& timeProvider, const MapProvi
 		_cooldownProvider(cooldownProvider), _eventMgr(eventMgr), _dbHandler(dbHandler),
 		_stockDataProvider(stockDataProvider), _metricMgr(metricMgr), _filesystem(filesystem),
 		_persistenceMgr(persistenceMgr) {
+	_stockJournalPersister = std::make_shared<StockJournalPersister>(_dbHandler, std::make_shared<stock::Journal>());
 	_eventBus->subscribe<network::DisconnectEvent>(*this);
 }
 
@@ -86,6 +88,14 @@ void ServerLoop::onIdle(uv_idle_t* handle) {
 	if (lifetimeSeconds != loop->_lifetimeSeconds) {
 		metric.gauge("uptime", lifetimeSeconds);
 		loop->_lifetimeSeconds = lifetimeSeconds;
+		if (loop->_ticks > 0u) {
+			metric.gauge("tick.avg_us", (uint32_t)(loop->_tickMicrosSum / loop->_ticks));
+			metric.gauge("tick.max_us", loop->_tickMicrosMax);
+			metric.gauge("tick.count", loop->_ticks);
+		}
+		loop->_tickMicrosSum = 0u;
+		loop->_tickMicrosMax = 0u;
+		loop->_ticks = 0u;
 	}
 }
 
@@ -112,7 +122,7 @@ void ServerLoop::construct() {
 }
 
 #define regHandler(type, handler, ...) \
-	r->registerHandler(network::EnumNameClientMsgType(type), std::make_shared<handler>(__VA_ARGS__));
+	r->registerHandler(type, std::make_shared<handler>(__VA_ARGS__));
 
 bool ServerLoop::init() {
 	_loop = new uv_loop_t;
@@ -143,6 +153,10 @@ bool ServerLoop::init() {
 		Log::error("Failed to create cooldown table");
 		return false;
 	}
+	if (!_stockJournalPersister->init()) {
+		Log::error("Failed to init the stock journal persistence");
+		return false;
+	}
 	if (!_eventMgr->init()) {
 		Log::error("Failed to init event manager");
 		return false;
@@ -199,8 +213,10 @@ bool ServerLoop::init() {
 		const ServerLoop* loop = (const ServerLoop*)handle->data;
 		const long dt = handle->repeat;
 		const persistence::PersistenceMgrPtr& persistenceMgr = loop->_persistenceMgr;
-		core::App::getInstance()->threadPool().enqueue([=] () {
+		const StockJournalPersisterPtr& stockJournalPersister = loop->_stockJournalPersister;
+		core::App::getInstance()->threadPool().schedule([=] () {
 			persistenceMgr->update(dt);
+			stockJournalPersister->flush();
 		});
 	}, 10000);
 
@@ -226,6 +242,16 @@ bool ServerLoop::init() {
 		return false;
 	}
 
+	const std::string& replayFile = core::Var::getSafe(cfg::ServerReplay)->strVal();
+	if (!replayFile.empty()) {
+		_replay = std::make_shared<network::PacketReplay>(_network);
+		if (!_replay->init(replayFile, core::Var::getSafe(cfg::ServerReplaySpeed)->floatVal())) {
+			Log::error("Failed to replay %s", replayFile.c_str());
+			return false;
+		}
+		return true;
+	}
+
 	const core::VarPtr& port = core::Var::getSafe(cfg::ServerPort);
 	const core::VarPtr& host = core::Var::getSafe(cfg::ServerHost);
 	const core::VarPtr& maxclients = core::Var::getSafe(cfg::ServerMaxClients);
@@ -234,6 +260,13 @@ bool ServerLoop::init() {
 		return false;
 	}
 	Log::info("Server socket is up at %s:%i", host->strVal().c_str(), port->intVal());
+	if (core::Var::getSafe(cfg::ServerNetworkThread)->boolVal() && !_network->startThread()) {
+		Log::warn("Could not start the network thread");
+	}
+	const std::string& captureFile = core::Var::getSafe(cfg::ServerCapture)->strVal();
+	if (!captureFile.empty() && !_network->startCapture(captureFile)) {
+		Log::warn("Could not start the capture");
+	}
 
 	return true;
 }
@@ -241,10 +274,14 @@ bool ServerLoop::init() {
 void ServerLoop::shutdown() {
 	uv_signal_stop(&_signal);
 	_persistenceMgr->shutdown();
+	_stockJournalPersister->flush();
 	_world->shutdown();
 	_dbHandler->shutdown();
 	_metricMgr->shutdown();
 	_input.shutdown();
+	if (_replay) {
+		_replay->shutdown();
+	}
 	_network->shutdown();
 	uv_timer_stop(&_worldTimer);
 	uv_timer_stop(&_persistenceMgrTimer);
@@ -259,14 +296,31 @@ void ServerLoop::shutdown() {
 
 void ServerLoop::update(long dt) {
 	core_trace_scoped(ServerLoop);
+	const double tickStart = core::TimeProvider::systemNanos();
 	// not everything is ticket in here directly, a lot is handled by libuv timers
 	uv_run(_loop, UV_RUN_NOWAIT);
+	if (_replay) {
+		_replay->update();
+	}
 	_network->update();
 	const int eventSkip = _eventBus->update(200);
 	if (eventSkip != _lastEventSkip) {
 		_metricMgr->metric().gauge("events.skip", eventSkip);
 		_lastEventSkip = eventSkip;
 	}
+	// systemNanos() returns seconds
+	const uint32_t tickMicros = (uint32_t)((core::TimeProvider::systemNanos() - tickStart) * 1000000.0);
+	_tickMicrosSum += tickMicros;
+	_tickMicrosMax = (std::max)(_tickMicrosMax, tickMicros);
+	++_ticks;
+	if (_replay) {
+		_replay->addTick(tickMicros);
+		if (_replay->finished() && !_replayReported) {
+			_replay->report();
+			_replayReported = true;
+			core::App::getInstance()->requestQuit();
+		}
+	}
 }
 
 // TODO: doesn't belong here
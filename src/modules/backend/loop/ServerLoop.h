@@ -9,11 +9,13 @@
 #include "core/Input.h"
 #include "core/EventBus.h"
 #include "network/ServerNetwork.h"
+#include "network/PacketReplay.h"
 #include "network/NetworkEvents.h"
 #include "backend/ForwardDecl.h"
 #include "backend/world/World.h"
 #include "network/ProtocolHandlerRegistry.h"
 #include "backend/entity/EntityStorage.h"
+#include "backend/persistence/StockJournalPersister.h"
 #include "persistence/DBHandler.h"
 
 #include <uv.h>
@@ -42,6 +44,9 @@ private:
 	MetricMgrPtr _metricMgr;
 	io::FilesystemPtr _filesystem;
 	persistence::PersistenceMgrPtr _persistenceMgr;
+	StockJournalPersisterPtr _stockJournalPersister;
+	network::PacketReplayPtr _replay;
+	bool _replayReported = false;
 
 	uv_loop_t *_loop = nullptr;
 	uv_timer_t _worldTimer;
@@ -52,6 +57,10 @@ private:
 	int _lastEventSkip = 0;
 	int _lastDeltaFrame = 0;
 	uint64_t _lifetimeSeconds = 0u;
+	// the duration of the ticks since the last time the tick metrics were sent
+	uint64_t _tickMicrosSum = 0u;
+	uint32_t _tickMicrosMax = 0u;
+	uint32_t _ticks = 0u;
 
 	static void onIdle(uv_idle_t* handle);
 	static void signalCallback(uv_signal_t* handle, int signum);
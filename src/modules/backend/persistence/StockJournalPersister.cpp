@@ -0,0 +1,49 @@
+/**
+ * @file
+ */
+
+#include "StockJournalPersister.h"
+#include "BackendModels.h"
+#include "persistence/DBHandler.h"
+#include "core/Log.h"
+
+namespace backend {
+
+StockJournalPersister::StockJournalPersister(const persistence::DBHandlerPtr& dbHandler, const stock::JournalPtr& journal) :
+		_dbHandler(dbHandler), _journal(journal) {
+}
+
+bool StockJournalPersister::init() {
+	if (!_dbHandler->createTable(db::StockModel())) {
+		Log::error("Failed to create stock table");
+		return false;
+	}
+	return true;
+}
+
+bool StockJournalPersister::flush() {
+	_entries.clear();
+	const size_t position = _journal->coalesce(_entries);
+	if (_entries.empty()) {
+		_journal->checkpoint(position);
+		return true;
+	}
+	std::vector<db::StockModel> models(_entries.size());
+	for (size_t i = 0u; i < _entries.size(); ++i) {
+		const stock::JournalEntry& entry = _entries[i];
+		db::StockModel& model = models[i];
+		model.setUserid(entry.owner);
+		model.setItemid(entry.itemId);
+		model.setAmount(entry.delta);
+	}
+	if (!_dbHandler->insert(models)) {
+		Log::warn("Failed to persist %i stock changes - retry with the next flush", (int)_entries.size());
+		_journal->requeue(_entries);
+		return false;
+	}
+	_journal->checkpoint(position);
+	Log::debug("Persisted %i stock changes", (int)_entries.size());
+	return true;
+}
+
+}
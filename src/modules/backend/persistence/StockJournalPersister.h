@@ -0,0 +1,46 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "backend/ForwardDecl.h"
+#include "stock/Journal.h"
+#include <vector>
+#include <memory>
+
+namespace backend {
+
+/**
+ * @brief Writes the item amount changes that were recorded in the @c stock::Journal into the database.
+ *
+ * The journal entries are coalesced per user and item and written with one batched upsert statement
+ * into the stock table - the amounts are relative updates. The journal records are only dropped
+ * if the statement was successful.
+ */
+class StockJournalPersister {
+private:
+	persistence::DBHandlerPtr _dbHandler;
+	stock::JournalPtr _journal;
+	std::vector<stock::JournalEntry> _entries;
+public:
+	StockJournalPersister(const persistence::DBHandlerPtr& dbHandler, const stock::JournalPtr& journal);
+
+	bool init();
+
+	/**
+	 * @brief Persists the journal entries since the last call
+	 * @note Must not be called concurrently - the journal itself can be modified while this is running
+	 */
+	bool flush();
+
+	const stock::JournalPtr& journal() const;
+};
+
+inline const stock::JournalPtr& StockJournalPersister::journal() const {
+	return _journal;
+}
+
+typedef std::shared_ptr<StockJournalPersister> StockJournalPersisterPtr;
+
+}
@@ -0,0 +1,76 @@
+/**
+ * @file
+ */
+
+#include "NpcTest.h"
+#include "backend/entity/EntityComponents.h"
+
+namespace backend {
+
+class EntityComponentsTest: public NpcTest {
+private:
+	using Super = NpcTest;
+};
+
+TEST_F(EntityComponentsTest, testHandles) {
+	const NpcPtr& npc1 = create();
+	const NpcPtr& npc2 = create();
+	const NpcPtr& npc3 = create();
+	const EntityComponents& components = map->components();
+	ASSERT_EQ(3, components.size());
+	const ComponentHandle handle2 = npc2->componentHandle();
+	ASSERT_TRUE(map->removeNpc(npc2->id()));
+	ASSERT_EQ(2, components.size());
+	EXPECT_FALSE(components.valid(handle2));
+	EXPECT_EQ(-1, components.index(handle2));
+	ASSERT_TRUE(components.valid(npc1->componentHandle()));
+	ASSERT_TRUE(components.valid(npc3->componentHandle()));
+	EXPECT_EQ(npc1, components.entity(components.index(npc1->componentHandle())));
+	EXPECT_EQ(npc3, components.entity(components.index(npc3->componentHandle())));
+
+	// the slot is reused - but the old handle must stay invalid
+	const NpcPtr& npc4 = create();
+	EXPECT_EQ(handle2.slot, npc4->componentHandle().slot);
+	EXPECT_FALSE(components.valid(handle2));
+	EXPECT_EQ(npc4, components.entity(components.index(npc4->componentHandle())));
+}
+
+TEST_F(EntityComponentsTest, testVisible) {
+	const NpcPtr& viewer = create();
+	const NpcPtr& close = create();
+	const NpcPtr& far = create();
+	viewer->setPos(glm::vec3(0.0f));
+	close->setPos(glm::vec3(5.0f, 0.0f, 5.0f));
+	far->setPos(glm::vec3(20000.0f, 0.0f, 0.0f));
+	// the field of view is not set to the max value on spawn
+	viewer->setCurrent(attrib::Type::FIELDOFVIEW, 360.0);
+	far->setCurrent(attrib::Type::FIELDOFVIEW, 360.0);
+
+	EntityComponents components;
+	const int viewerIndex = components.index(components.add(viewer, false));
+	const int closeIndex = components.index(components.add(close, false));
+	const int farIndex = components.index(components.add(far, false));
+	for (int i = 0; i < components.size(); ++i) {
+		components.sync(i);
+		EXPECT_NE(0, components.flags(i) & EntityComponents::AttribsChanged);
+	}
+	EXPECT_FLOAT_EQ(10000.0f, components.viewDistance(viewerIndex));
+	components.buildGrid(32.0f);
+
+	std::vector<int> visible;
+	components.visible(viewerIndex, visible);
+	ASSERT_EQ(1u, visible.size());
+	EXPECT_EQ(closeIndex, visible[0]);
+	components.visible(farIndex, visible);
+	EXPECT_TRUE(visible.empty());
+
+	// only the moved entity is flagged as dirty
+	close->setPos(glm::vec3(6.0f, 0.0f, 6.0f));
+	for (int i = 0; i < components.size(); ++i) {
+		components.sync(i);
+	}
+	EXPECT_NE(0, components.flags(closeIndex) & EntityComponents::Moved);
+	EXPECT_EQ(0, components.flags(viewerIndex) & EntityComponents::DirtyMask);
+}
+
+}
@@ -0,0 +1,179 @@
+/**
+ * @file
+ */
+
+#include "core/tests/AbstractTest.h"
+#include "backend/world/VoxelReplicator.h"
+#include "network/ProtocolHandlerRegistry.h"
+#include "network/ServerNetwork.h"
+#include "network/ClientNetwork.h"
+#include "network/ServerMessageSender.h"
+#include "network/NetworkEvents.h"
+#include "math/Random.h"
+#include <thread>
+#include <chrono>
+
+namespace backend {
+
+namespace {
+
+const uint16_t Port = 17899;
+const int Edits = 1000;
+
+class VoxelUpdateCounter: public network::IProtocolHandler {
+public:
+	std::unordered_map<glm::ivec3, voxel::Voxel, std::hash<glm::ivec3> > voxels;
+	size_t payloadBytes = 0u;
+	int messages = 0;
+
+	void execute(ENetPeer* peer, const void* raw) override {
+		const network::VoxelUpdate* message = getMsg<network::VoxelUpdate>(raw);
+		std::vector<voxel::VoxelChange> changes;
+		for (const network::VoxelChunkDelta* delta : *message->chunks()) {
+			const network::IVec3* chunk = delta->chunk();
+			ASSERT_NE(nullptr, chunk);
+			const glm::ivec3 chunkPos(chunk->x(), chunk->y(), chunk->z());
+			changes.clear();
+			ASSERT_TRUE(voxel::decodeChunkDelta(delta->changes()->data(), delta->changes()->size(), changes));
+			for (const voxel::VoxelChange& change : changes) {
+				voxels[voxel::deltaPosition(chunkPos, change.index)] = change.voxel;
+			}
+			payloadBytes += delta->changes()->size();
+		}
+		++messages;
+	}
+};
+
+}
+
+class VoxelReplicatorTest: public core::AbstractTest, public core::IEventBusHandler<network::NewConnectionEvent> {
+protected:
+	core::EventBusPtr _serverEventBus;
+	core::EventBusPtr _clientEventBus;
+	network::ServerNetworkPtr _server;
+	network::ClientNetworkPtr _client;
+	network::ServerMessageSenderPtr _messageSender;
+	std::shared_ptr<VoxelUpdateCounter> _counter;
+	ENetPeer* _peer = nullptr;
+
+	void update() {
+		_server->update();
+		_client->update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	/**
+	 * @brief Replicates the given changes and waits until the client received all of them
+	 * @return The amount of bytes that are needed for the changes
+	 */
+	size_t replicate(VoxelReplicator& replicator, const std::unordered_map<glm::ivec3, voxel::Voxel, std::hash<glm::ivec3> >& expected) {
+		const size_t before = _counter->payloadBytes;
+		const int messages = _counter->messages;
+		const math::RectFloat viewRect(-256.0f, -256.0f, 256.0f, 256.0f);
+		EXPECT_GT(replicator.replicate(1, _peer, viewRect), 0);
+		replicator.endTick();
+		for (int i = 0; i < 5000 && _counter->messages == messages; ++i) {
+			update();
+		}
+		EXPECT_EQ(expected.size(), _counter->voxels.size());
+		for (const auto& e : expected) {
+			auto i = _counter->voxels.find(e.first);
+			if (i == _counter->voxels.end()) {
+				ADD_FAILURE() << "Voxel at " << glm::to_string(e.first) << " wasn't replicated";
+				break;
+			}
+			EXPECT_TRUE(e.second.isSame(i->second));
+		}
+		return _counter->payloadBytes - before;
+	}
+
+public:
+	void SetUp() override {
+		core::AbstractTest::SetUp();
+		_serverEventBus = std::make_shared<core::EventBus>();
+		_clientEventBus = std::make_shared<core::EventBus>();
+		_serverEventBus->subscribe<network::NewConnectionEvent>(*this);
+
+		_server = std::make_shared<network::ServerNetwork>(std::make_shared<network::ProtocolHandlerRegistry>(), _serverEventBus);
+		_client = std::make_shared<network::ClientNetwork>(std::make_shared<network::ProtocolHandlerRegistry>(), _clientEventBus);
+		_messageSender = std::make_shared<network::ServerMessageSender>(_server);
+		_counter = std::make_shared<VoxelUpdateCounter>();
+		_client->registry()->registerHandler(network::ServerMsgType::VoxelUpdate, _counter);
+
+		ASSERT_TRUE(_server->init());
+		ASSERT_TRUE(_client->init());
+		ASSERT_TRUE(_server->bind(Port, "127.0.0.1"));
+		ASSERT_NE(nullptr, _client->connect(Port, "127.0.0.1"));
+		for (int i = 0; i < 5000 && _peer == nullptr; ++i) {
+			update();
+		}
+		ASSERT_NE(nullptr, _peer) << "Could not connect to the local server";
+	}
+
+	void TearDown() override {
+		_client->shutdown();
+		_server->shutdown();
+		_serverEventBus->unsubscribe<network::NewConnectionEvent>(*this);
+		core::AbstractTest::TearDown();
+	}
+
+	void onEvent(const network::NewConnectionEvent& event) override {
+		_peer = event.peer();
+	}
+};
+
+TEST_F(VoxelReplicatorTest, testBytesPerEditsBuilding) {
+	VoxelReplicator replicator(_messageSender);
+	std::unordered_map<glm::ivec3, voxel::Voxel, std::hash<glm::ivec3> > expected;
+	const voxel::Voxel wall = voxel::createVoxel(voxel::VoxelType::Rock, 3);
+	// a wall of 10 rows with 100 voxels each
+	for (int i = 0; i < Edits; ++i) {
+		const glm::ivec3 pos(i % 100, 60 + i / 100, 10);
+		replicator.track(pos, wall);
+		expected[pos] = wall;
+	}
+	const size_t bytes = replicate(replicator, expected);
+	::Log::info("%i edits (wall) need %i bytes", Edits, (int)bytes);
+	EXPECT_LT(bytes, Edits * sizeof(voxel::VoxelChange) / 10);
+}
+
+TEST_F(VoxelReplicatorTest, testBytesPerEditsScattered) {
+	VoxelReplicator replicator(_messageSender);
+	std::unordered_map<glm::ivec3, voxel::Voxel, std::hash<glm::ivec3> > expected;
+	math::Random random(1);
+	for (int i = 0; i < Edits; ++i) {
+		const glm::ivec3 pos(random.random(-100, 100), random.random(0, 100), random.random(-100, 100));
+		const voxel::Voxel voxel = voxel::createVoxel(random.random(0, 1) == 0 ? voxel::VoxelType::Air : voxel::VoxelType::Grass, 0);
+		replicator.track(pos, voxel);
+		expected[pos] = voxel;
+	}
+	const size_t bytes = replicate(replicator, expected);
+	::Log::info("%i edits (scattered) need %i bytes", Edits, (int)bytes);
+	EXPECT_LT(bytes, Edits * sizeof(voxel::VoxelChange));
+}
+
+TEST_F(VoxelReplicatorTest, testOnlyMissingChanges) {
+	VoxelReplicator replicator(_messageSender);
+	std::unordered_map<glm::ivec3, voxel::Voxel, std::hash<glm::ivec3> > expected;
+	const voxel::Voxel rock = voxel::createVoxel(voxel::VoxelType::Rock, 0);
+	for (int i = 0; i < 10; ++i) {
+		const glm::ivec3 pos(i, 10, 0);
+		replicator.track(pos, rock);
+		expected[pos] = rock;
+	}
+	replicate(replicator, expected);
+	// nothing changed - nothing is sent
+	EXPECT_EQ(0, replicator.replicate(1, _peer, math::RectFloat(-256.0f, -256.0f, 256.0f, 256.0f)));
+
+	const voxel::Voxel sand = voxel::createVoxel(voxel::VoxelType::Sand, 0);
+	replicator.track(glm::ivec3(0, 10, 0), sand);
+	expected[glm::ivec3(0, 10, 0)] = sand;
+	const size_t bytes = replicate(replicator, expected);
+	EXPECT_LT(bytes, 8u) << "Only the new change should have been sent";
+
+	// the changes are outside of the view
+	replicator.track(glm::ivec3(1000, 10, 1000), sand);
+	EXPECT_EQ(0, replicator.replicate(1, _peer, math::RectFloat(-256.0f, -256.0f, 256.0f, 256.0f)));
+}
+
+}
@@ -8,7 +8,7 @@
 #include "core/String.h"
 #include "core/EventBus.h"
 #include "core/App.h"
-#include "math/QuadTree.h"
+#include "core/ThreadPool.h"
 #include "io/Filesystem.h"
 #include "backend/entity/Npc.h"
 #include "backend/entity/User.h"
@@ -20,12 +20,9 @@
 
 namespace backend {
 
-math::RectFloat Map::QuadTreeNode::getRect() const {
-	return entity->rect();
-}
-
-bool Map::QuadTreeNode::operator==(const QuadTreeNode& rhs) const {
-	return rhs.entity == entity;
+namespace {
+// the cell size of the grid that is used to find the entities in the view range
+const float VisibilityCellSize = 32.0f;
 }
 
 Map::Map(MapId mapId,
@@ -38,8 +35,8 @@ Map::Map(MapId mapId,
 		const attrib::ContainerProviderPtr& containerProvider,
 		const cooldown::CooldownProviderPtr& cooldownProvider) :
 		_mapId(mapId), _mapIdStr(std::to_string(mapId)),
-		_eventBus(eventBus), _filesystem(filesystem), _attackMgr(this),
-		_quadTree(math::RectFloat::getMaxRect(), 100.0f), _quadTreeCache(_quadTree) {
+		_eventBus(eventBus), _filesystem(filesystem), _messageSender(messageSender), _attackMgr(this),
+		_voxelReplicator(messageSender) {
 	_poiProvider = std::make_shared<poi::PoiProvider>(timeProvider);
 	_spawnMgr = std::make_shared<backend::SpawnMgr>(this, filesystem, entityStorage, messageSender,
 			timeProvider, loader, containerProvider, cooldownProvider);
@@ -49,55 +46,106 @@ Map::~Map() {
 	shutdown();
 }
 
-bool Map::updateEntity(const EntityPtr& entity, long dt) {
-	if (!entity->update(dt)) {
-		return false;
+template<class F>
+void Map::parallelUpdate(F&& func) {
+	const int n = _components.size();
+	if (n <= 0) {
+		return;
 	}
-	const math::RectFloat& rect = entity->viewRect();
-	// TODO: maybe move into the entity instance to reduce memory allocations.
-	math::QuadTree<QuadTreeNode, float>::Contents contents;
-	_quadTreeCache.query(rect, contents);
-	EntitySet set;
-	set.reserve(contents.size());
-	for (const QuadTreeNode& node : contents) {
-		// TODO: check the distance - the rect might contain more than the circle would...
-		if (entity->inFrustum(node.entity)) {
-			set.insert(node.entity);
+	core::ThreadPool& threadPool = core::App::getInstance()->threadPool();
+	// a few chunks per thread to be able to balance the load
+	const int minGrainSize = 64;
+	const int chunks = (int)(threadPool.size() + 1u) * 4;
+	const int grainSize = glm::max(minGrainSize, (n + chunks - 1) / chunks);
+	const int buffers = (n + grainSize - 1) / grainSize;
+	if ((int)_messageBuffers.size() < buffers) {
+		_messageBuffers.resize(buffers);
+	}
+	threadPool.parallelFor(0, n, [this, &func, grainSize] (int start, int end) {
+		network::ServerMessageSender::ScopedBuffer scopedBuffer(_messageBuffers[start / grainSize]);
+		for (int i = start; i < end; ++i) {
+			func(i);
 		}
+	}, grainSize);
+	for (int i = 0; i < buffers; ++i) {
+		_messageSender->flush(_messageBuffers[i]);
+	}
+}
+
+void Map::removeEntities() {
+	for (int i = _components.size() - 1; i >= 0; --i) {
+		if ((_components.flags(i) & EntityComponents::Remove) == 0) {
+			continue;
+		}
+		const EntityPtr entity = _components.entity(i);
+		_components.remove(entity->componentHandle());
+		Log::debug("remove entity " PRIEntId, entity->id());
+		if (entity->entityType() == network::EntityType::PLAYER) {
+			_voxelReplicator.removeViewer(entity->id());
+			_users.erase(entity->id());
+		} else {
+			_npcs.erase(entity->id());
+		}
+		_eventBus->enqueue(std::make_shared<EntityDeleteEvent>(entity->id(), entity->entityType()));
+	}
+}
+
+void Map::removeComponents(const EntityPtr& entity) {
+	// the handle might belong to the components of another map already
+	const int index = _components.index(entity->componentHandle());
+	if (index >= 0 && _components.entity(index) == entity) {
+		_components.remove(entity->componentHandle());
 	}
-	set.erase(entity);
-	entity->updateVisible(set);
-	return true;
+}
+
+void Map::updateVisibility() {
+	parallelUpdate([this] (int index) {
+		_components.sync(index);
+	});
+	_components.buildGrid(VisibilityCellSize);
+	parallelUpdate([this] (int index) {
+		// reused by the tasks of the same thread to reduce memory allocations
+		thread_local std::vector<int> visible;
+		_components.visible(index, visible);
+		EntitySet set;
+		set.reserve(visible.size());
+		for (int other : visible) {
+			set.insert(_components.entity(other));
+		}
+		_components.entity(index)->updateVisible(set);
+	});
 }
 
 void Map::update(long dt) {
 	_spawnMgr->update(dt);
 	_zone->update(dt);
 	_attackMgr.update(dt);
-	updateQuadTree();
 
-	for (auto i = _users.begin(); i != _users.end();) {
-		UserPtr user = i->second;
-		if (updateEntity(user, dt)) {
-			++i;
+	// the users are talking to the database and the network - they are updated on the game thread
+	for (int i = 0; i < _components.size(); ++i) {
+		if ((_components.flags(i) & EntityComponents::GameThread) == 0) {
 			continue;
 		}
-		Log::debug("remove user " PRIEntId, user->id());
-		_quadTree.remove(QuadTreeNode { user });
-		i = _users.erase(i);
-		_eventBus->enqueue(std::make_shared<EntityDeleteEvent>(user->id(), user->entityType()));
-	}
-	for (auto i = _npcs.begin(); i != _npcs.end();) {
-		NpcPtr npc = i->second;
-		if (updateEntity(npc, dt)) {
-			++i;
-			continue;
+		if (!_components.entity(i)->update(dt)) {
+			_components.setFlag(i, EntityComponents::Remove);
+		}
+	}
+	parallelUpdate([this, dt] (int index) {
+		if ((_components.flags(index) & EntityComponents::GameThread) != 0) {
+			return;
+		}
+		if (!_components.entity(index)->update(dt)) {
+			_components.setFlag(index, EntityComponents::Remove);
 		}
-		Log::debug("remove npc " PRIEntId, npc->id());
-		_quadTree.remove(QuadTreeNode { npc });
-		i = _npcs.erase(i);
-		_eventBus->enqueue(std::make_shared<EntityDeleteEvent>(npc->id(), npc->entityType()));
+	});
+	removeEntities();
+	updateVisibility();
+
+	for (const auto& e : _users) {
+		const UserPtr& user = e.second;
+		_voxelReplicator.replicate(user->id(), user->peer(), user->viewRect());
 	}
+	_voxelReplicator.endTick();
 }
 
 bool Map::init() {
@@ -164,6 +212,7 @@ void Map::addUser(const UserPtr& user) {
 	}
 	const glm::vec3& pos = findStartPosition(user);
 	user->setMap(ptr(), pos);
+	user->setComponentHandle(_components.add(user, true));
 	_eventBus->enqueue(std::make_shared<EntityAddToMapEvent>(user));
 }
 
@@ -173,7 +222,8 @@ bool Map::removeUser(EntityId id) {
 		return false;
 	}
 	UserPtr user = i->second;
-	_quadTree.remove(QuadTreeNode { user });
+	removeComponents(user);
+	_voxelReplicator.removeViewer(id);
 	_users.erase(i);
 	_eventBus->enqueue(std::make_shared<EntityRemoveFromMapEvent>(user));
 	return true;
@@ -195,6 +245,7 @@ bool Map::addNpc(const NpcPtr& npc) {
 	}
 	const glm::vec3& pos = findStartPosition(npc);
 	npc->setMap(ptr(), pos);
+	npc->setComponentHandle(_components.add(npc, false));
 	_zone->addAI(npc->ai());
 	_eventBus->enqueue(std::make_shared<EntityAddToMapEvent>(npc));
 	return true;
@@ -206,7 +257,7 @@ bool Map::removeNpc(EntityId id) {
 		return false;
 	}
 	NpcPtr npc = i->second;
-	_quadTree.remove(QuadTreeNode { npc });
+	removeComponents(npc);
 	_npcs.erase(i);
 	_zone->removeAI(npc->ai());
 	_eventBus->enqueue(std::make_shared<EntityRemoveFromMapEvent>(npc));
@@ -229,22 +280,16 @@ int Map::findFloor(const glm::vec3& pos) const {
 			return pos.y;
 		}
 	}
-	return _voxelWorld->findFloor(pos.x, pos.z, voxel::isFloor);
+	return _voxelWorld->findFloor(pos.x, pos.z);
 }
 
-glm::ivec3 Map::randomPos() const {
-	return _voxelWorld->randomPos();
+void Map::setVoxel(const glm::ivec3& pos, const voxel::Voxel& voxel) {
+	_voxelWorld->setVoxel(pos, voxel);
+	_voxelReplicator.track(pos, voxel);
 }
 
-void Map::updateQuadTree() {
-	// TODO: a full rebuild is not needed every frame
-	_quadTree.clear();
-	for (auto i : _npcs) {
-		_quadTree.insert(QuadTreeNode { i.second });
-	}
-	for (auto i : _users) {
-		_quadTree.insert(QuadTreeNode { i.second });
-	}
+glm::ivec3 Map::randomPos() const {
+	return _voxelWorld->randomPos();
 }
 
 }
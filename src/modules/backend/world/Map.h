@@ -6,10 +6,12 @@
 
 #include "backend/ForwardDecl.h"
 #include "commonlua/LUA.h"
-#include "math/QuadTree.h"
 #include "math/Rect.h"
 #include "ai/common/Types.h"
 #include "backend/attack/AttackMgr.h"
+#include "backend/entity/EntityComponents.h"
+#include "network/ServerMessageSender.h"
+#include "VoxelReplicator.h"
 #include "MapId.h"
 #include <memory>
 #include <unordered_map>
@@ -27,6 +29,7 @@ private:
 	SpawnMgrPtr _spawnMgr;
 	poi::PoiProviderPtr _poiProvider;
 	io::FilesystemPtr _filesystem;
+	network::ServerMessageSenderPtr _messageSender;
 
 	lua::LUA _lua;
 
@@ -41,22 +44,27 @@ private:
 	Users _users;
 
 	AttackMgr _attackMgr;
+	VoxelReplicator _voxelReplicator;
 
-	struct QuadTreeNode {
-		EntityPtr entity;
+	EntityComponents _components;
+	// one buffer per chunk of the parallel passes - see parallelUpdate()
+	std::vector<network::MessageBuffer> _messageBuffers;
 
-		math::RectFloat getRect() const;
-		bool operator==(const QuadTreeNode& rhs) const;
-	};
-
-	math::QuadTree<QuadTreeNode, float> _quadTree;
-	math::QuadTreeCache<QuadTreeNode, float> _quadTreeCache;
-
-	void updateQuadTree();
 	/**
-	 * @return @c false if the entity should be removed from the server.
+	 * @brief Executes the given functor for every index of the entity components. The indices are split
+	 * into chunks that are executed by the thread pool.
+	 *
+	 * The messages that are sent from within the functor are collected per chunk and handed over to the
+	 * network after all chunks are done - in the order of the indices.
 	 */
-	bool updateEntity(const EntityPtr& entity, long dt);
+	template<class F>
+	void parallelUpdate(F&& func);
+	/**
+	 * @brief Removes the entities that returned @c false in their last update
+	 */
+	void removeEntities();
+	void removeComponents(const EntityPtr& entity);
+	void updateVisibility();
 
 	glm::vec3 findStartPosition(const EntityPtr& entity) const;
 
@@ -108,6 +116,13 @@ public:
 	int userCount() const;
 
 	int findFloor(const glm::vec3& pos) const;
+
+	const EntityComponents& components() const;
+
+	/**
+	 * @brief Modifies the voxel world of this map and replicates the change to the users that see it
+	 */
+	void setVoxel(const glm::ivec3& pos, const voxel::Voxel& voxel);
 	glm::ivec3 randomPos() const;
 
 	const AttackMgr& attackMgr() const;
@@ -156,6 +171,10 @@ inline ai::Zone* Map::zone() const {
 	return _zone;
 }
 
+inline const EntityComponents& Map::components() const {
+	return _components;
+}
+
 inline int Map::npcCount() const {
 	return _npcs.size();
 }
@@ -0,0 +1,105 @@
+/**
+ * @file
+ */
+
+#include "VoxelReplicator.h"
+#include "core/Log.h"
+#include "core/Trace.h"
+
+namespace backend {
+
+VoxelReplicator::VoxelReplicator(const network::ServerMessageSenderPtr& messageSender) :
+		_messageSender(messageSender) {
+}
+
+void VoxelReplicator::track(const glm::ivec3& pos, const voxel::Voxel& voxel) {
+	_tracker.track(pos, voxel);
+}
+
+const std::vector<uint8_t>* VoxelReplicator::encode(const glm::ivec3& chunkPos, uint32_t sinceVersion) {
+	std::vector<Encoded>& encoded = _cache[chunkPos];
+	for (const Encoded& e : encoded) {
+		if (e.sinceVersion == sinceVersion) {
+			return &e.data;
+		}
+	}
+	_changes.clear();
+	if (!_tracker.changes(chunkPos, sinceVersion, _changes)) {
+		return nullptr;
+	}
+	encoded.push_back(Encoded { sinceVersion, std::vector<uint8_t>() });
+	if (!voxel::encodeChunkDelta(_changes, encoded.back().data)) {
+		Log::error("Failed to encode the voxel changes of chunk %i:%i:%i", chunkPos.x, chunkPos.y, chunkPos.z);
+		encoded.pop_back();
+		return nullptr;
+	}
+	return &encoded.back().data;
+}
+
+int VoxelReplicator::replicate(EntityId id, ENetPeer* peer, const math::RectFloat& viewRect) {
+	if (peer == nullptr) {
+		return 0;
+	}
+	core_trace_scoped(VoxelReplicate);
+	Viewer& viewer = _viewers[id];
+	const glm::ivec2 mins(glm::floor(viewRect.getMinX() / voxel::DeltaChunkSize), glm::floor(viewRect.getMinZ() / voxel::DeltaChunkSize));
+	const glm::ivec2 maxs(glm::floor(viewRect.getMaxX() / voxel::DeltaChunkSize) + 1, glm::floor(viewRect.getMaxZ() / voxel::DeltaChunkSize) + 1);
+
+	_candidates.clear();
+	if (!viewer.initialized || viewer.mins != mins || viewer.maxs != maxs) {
+		// the view changed - chunks that were modified before might have become visible
+		viewer.mins = mins;
+		viewer.maxs = maxs;
+		viewer.initialized = true;
+		for (const auto& e : _tracker.chunks()) {
+			if (viewer.visible(e.first)) {
+				_candidates.push_back(e.first);
+			}
+		}
+	} else {
+		for (const glm::ivec3& chunkPos : _tracker.dirty()) {
+			if (viewer.visible(chunkPos)) {
+				_candidates.push_back(chunkPos);
+			}
+		}
+	}
+
+	if (_candidates.empty()) {
+		return 0;
+	}
+
+	std::vector<flatbuffers::Offset<network::VoxelChunkDelta>> deltas;
+	for (const glm::ivec3& chunkPos : _candidates) {
+		const uint32_t version = _tracker.version(chunkPos);
+		uint32_t& known = viewer.known[chunkPos];
+		if (known >= version) {
+			continue;
+		}
+		const std::vector<uint8_t>* data = encode(chunkPos, known);
+		if (data == nullptr) {
+			continue;
+		}
+		const network::IVec3 chunk(chunkPos.x, chunkPos.y, chunkPos.z);
+		deltas.push_back(network::CreateVoxelChunkDelta(_fbb, &chunk, version, _fbb.CreateVector(*data)));
+		_sentBytes += data->size();
+		known = version;
+	}
+	if (deltas.empty()) {
+		return 0;
+	}
+	const int amount = (int)deltas.size();
+	_messageSender->sendServerMessage(peer, _fbb, network::ServerMsgType::VoxelUpdate,
+			network::CreateVoxelUpdate(_fbb, _fbb.CreateVector(deltas)).Union());
+	return amount;
+}
+
+void VoxelReplicator::removeViewer(EntityId id) {
+	_viewers.erase(id);
+}
+
+void VoxelReplicator::endTick() {
+	_tracker.clearDirty();
+	_cache.clear();
+}
+
+}
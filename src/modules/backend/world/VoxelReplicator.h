@@ -0,0 +1,87 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "backend/ForwardDecl.h"
+#include "network/ServerMessageSender.h"
+#include "voxel/ChunkDelta.h"
+#include "math/Rect.h"
+#include <unordered_map>
+#include <vector>
+
+namespace backend {
+
+/**
+ * @brief Replicates server side voxel modifications to the clients
+ *
+ * The clients create their world from the seed - every modification that the server applies
+ * afterwards is tracked per delta chunk (see @c voxel::ChunkDeltaTracker) and sent as run-length
+ * and palette encoded @c network::VoxelUpdate message. Only those chunks that are inside the view
+ * rect of the user are sent. The chunk version that every user knows is remembered, so only the
+ * missing changes are sent - also for chunks that were modified before they got visible.
+ */
+class VoxelReplicator {
+private:
+	network::ServerMessageSenderPtr _messageSender;
+	voxel::ChunkDeltaTracker _tracker;
+
+	struct Viewer {
+		// the visible delta chunks on the x and z axis - max is exclusive
+		glm::ivec2 mins { 0 };
+		glm::ivec2 maxs { 0 };
+		bool initialized = false;
+		std::unordered_map<glm::ivec3, uint32_t, std::hash<glm::ivec3> > known;
+
+		inline bool visible(const glm::ivec3& chunkPos) const {
+			return chunkPos.x >= mins.x && chunkPos.x < maxs.x && chunkPos.z >= mins.y && chunkPos.z < maxs.y;
+		}
+	};
+	std::unordered_map<EntityId, Viewer> _viewers;
+
+	struct Encoded {
+		uint32_t sinceVersion;
+		std::vector<uint8_t> data;
+	};
+	// the encoded deltas of the current tick - most viewers know the same chunk version
+	std::unordered_map<glm::ivec3, std::vector<Encoded>, std::hash<glm::ivec3> > _cache;
+
+	flatbuffers::FlatBufferBuilder _fbb;
+	std::vector<voxel::VoxelChange> _changes;
+	std::vector<glm::ivec3> _candidates;
+	size_t _sentBytes = 0u;
+
+	const std::vector<uint8_t>* encode(const glm::ivec3& chunkPos, uint32_t sinceVersion);
+public:
+	VoxelReplicator(const network::ServerMessageSenderPtr& messageSender);
+
+	/**
+	 * @brief Must be called for every voxel that the server modified after the world was created
+	 */
+	void track(const glm::ivec3& pos, const voxel::Voxel& voxel);
+
+	/**
+	 * @brief Sends all the changes in the given view rect that the viewer doesn't know yet
+	 * @return The amount of delta chunks that were sent
+	 */
+	int replicate(EntityId id, ENetPeer* peer, const math::RectFloat& viewRect);
+
+	void removeViewer(EntityId id);
+
+	/**
+	 * @brief Call this after all viewers were replicated in the current tick
+	 */
+	void endTick();
+
+	/**
+	 * @return The size of all the delta chunk payloads that were sent so far
+	 */
+	size_t sentBytes() const;
+};
+
+inline size_t VoxelReplicator::sentBytes() const {
+	return _sentBytes;
+}
+
+}
@@ -0,0 +1,100 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <atomic>
+#include <utility>
+
+namespace core {
+
+/**
+ * @brief Bounded lock free queue for exactly one producer thread and one consumer thread
+ *
+ * The capacity is rounded up to the next power of two. @c push() fails if the queue is full - it's
+ * up to the producer to decide whether to retry, to drop or to keep the data for later.
+ *
+ * @note The read and the write index live on their own cache lines to prevent the producer and the
+ * consumer from bouncing the same cache line.
+ */
+template<class Data>
+class SPSCQueue {
+private:
+	static constexpr size_t CacheLine = 64u;
+
+	std::unique_ptr<Data[]> _buffer;
+	uint32_t _mask;
+	uint8_t _padding0[CacheLine];
+	// written by the consumer
+	std::atomic<uint32_t> _head { 0u };
+	uint8_t _padding1[CacheLine - sizeof(std::atomic<uint32_t>)];
+	// written by the producer
+	std::atomic<uint32_t> _tail { 0u };
+	uint8_t _padding2[CacheLine - sizeof(std::atomic<uint32_t>)];
+
+	static uint32_t powerOfTwo(uint32_t value) {
+		uint32_t n = 1u;
+		while (n < value) {
+			n <<= 1;
+		}
+		return n;
+	}
+
+public:
+	explicit SPSCQueue(uint32_t capacity) :
+			_buffer(new Data[powerOfTwo(capacity)]), _mask(powerOfTwo(capacity) - 1u) {
+	}
+
+	/**
+	 * @note Must only be called from the producer thread
+	 * @return @c false if the queue is full
+	 */
+	bool push(Data&& data) {
+		const uint32_t tail = _tail.load(std::memory_order_relaxed);
+		if (tail - _head.load(std::memory_order_acquire) > _mask) {
+			return false;
+		}
+		_buffer[tail & _mask] = std::move(data);
+		_tail.store(tail + 1u, std::memory_order_release);
+		return true;
+	}
+
+	bool push(const Data& data) {
+		Data copy(data);
+		return push(std::move(copy));
+	}
+
+	/**
+	 * @note Must only be called from the consumer thread
+	 * @return @c false if the queue is empty
+	 */
+	bool pop(Data& data) {
+		const uint32_t head = _head.load(std::memory_order_relaxed);
+		if (head == _tail.load(std::memory_order_acquire)) {
+			return false;
+		}
+		data = std::move(_buffer[head & _mask]);
+		_head.store(head + 1u, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @note Only a snapshot if called while the other thread is active
+	 */
+	inline uint32_t size() const {
+		return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+	}
+
+	inline bool empty() const {
+		return size() == 0u;
+	}
+
+	inline uint32_t capacity() const {
+		return _mask + 1u;
+	}
+};
+
+}
@@ -0,0 +1,64 @@
+/**
+ * @file
+ */
+
+#include "core/tests/AbstractTest.h"
+#include "collection/SPSCQueue.h"
+#include <thread>
+
+namespace core {
+
+class SPSCQueueTest : public core::AbstractTest {
+};
+
+TEST_F(SPSCQueueTest, testCapacity) {
+	core::SPSCQueue<int> queue(100);
+	EXPECT_EQ(128u, queue.capacity());
+	for (int i = 0; i < 128; ++i) {
+		ASSERT_TRUE(queue.push(i));
+	}
+	EXPECT_FALSE(queue.push(128)) << "The queue should be full";
+	EXPECT_EQ(128u, queue.size());
+	int v;
+	ASSERT_TRUE(queue.pop(v));
+	EXPECT_EQ(0, v);
+	EXPECT_TRUE(queue.push(128));
+}
+
+TEST_F(SPSCQueueTest, testPushPop) {
+	core::SPSCQueue<int> queue(16);
+	int v;
+	EXPECT_FALSE(queue.pop(v));
+	// wrap around several times
+	for (int i = 0; i < 100; ++i) {
+		ASSERT_TRUE(queue.push(i));
+		ASSERT_TRUE(queue.push(i + 1));
+		ASSERT_TRUE(queue.pop(v));
+		ASSERT_EQ(i, v);
+		ASSERT_TRUE(queue.pop(v));
+		ASSERT_EQ(i + 1, v);
+	}
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(SPSCQueueTest, testConcurrent) {
+	core::SPSCQueue<int> queue(64);
+	const int n = 100000;
+	std::thread thread([&] () {
+		for (int i = 0; i < n; ++i) {
+			while (!queue.push(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+	for (int i = 0; i < n; ++i) {
+		int v;
+		while (!queue.pop(v)) {
+			std::this_thread::yield();
+		}
+		ASSERT_EQ(i, v);
+	}
+	thread.join();
+}
+
+}
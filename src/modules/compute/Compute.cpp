@@ -0,0 +1,135 @@
+/**
+ * @file
+ */
+#include "Compute.h"
+#include "host/HostCompute.h"
+#ifdef COMPUTE_OPENCL
+#include "cl/CLCompute.h"
+#endif
+#include "core/Log.h"
+#include "core/Assert.h"
+
+namespace compute {
+
+namespace _priv {
+
+static Backend _backend = Backend::None;
+
+}
+
+#ifdef COMPUTE_OPENCL
+#define COMPUTE_DISPATCH(func, ...) \
+	if (_priv::_backend == Backend::Host) { \
+		return host::func(__VA_ARGS__); \
+	} \
+	return cl::func(__VA_ARGS__)
+#else
+#define COMPUTE_DISPATCH(func, ...) \
+	return host::func(__VA_ARGS__)
+#endif
+
+bool init() {
+	if (init(Backend::OpenCL)) {
+		return true;
+	}
+	return init(Backend::Host);
+}
+
+bool init(Backend backend) {
+	core_assert(_priv::_backend == Backend::None);
+	switch (backend) {
+	case Backend::OpenCL:
+#ifdef COMPUTE_OPENCL
+		if (cl::init()) {
+			_priv::_backend = backend;
+			return true;
+		}
+		cl::shutdown();
+#else
+		Log::debug("Compiled without OpenCL support");
+#endif
+		return false;
+	case Backend::Host:
+		if (host::init()) {
+			_priv::_backend = backend;
+			return true;
+		}
+		host::shutdown();
+		return false;
+	case Backend::None:
+		break;
+	}
+	return false;
+}
+
+void shutdown() {
+	if (_priv::_backend == Backend::Host) {
+		host::shutdown();
+	}
+#ifdef COMPUTE_OPENCL
+	else if (_priv::_backend == Backend::OpenCL) {
+		cl::shutdown();
+	}
+#endif
+	_priv::_backend = Backend::None;
+}
+
+Backend backend() {
+	return _priv::_backend;
+}
+
+Id createBuffer(BufferFlag flags, size_t size, void* data) {
+	COMPUTE_DISPATCH(createBuffer, flags, size, data);
+}
+
+bool updateBuffer(Id buffer, size_t size, const void* data, bool blockingWrite) {
+	COMPUTE_DISPATCH(updateBuffer, buffer, size, data, blockingWrite);
+}
+
+bool deleteBuffer(Id& buffer) {
+	COMPUTE_DISPATCH(deleteBuffer, buffer);
+}
+
+bool readBuffer(Id buffer, size_t size, void* data) {
+	COMPUTE_DISPATCH(readBuffer, buffer, size, data);
+}
+
+Id createProgram(const std::string& source) {
+	COMPUTE_DISPATCH(createProgram, source);
+}
+
+size_t requiredAlignment() {
+	COMPUTE_DISPATCH(requiredAlignment);
+}
+
+bool configureProgram(Id program) {
+	COMPUTE_DISPATCH(configureProgram, program);
+}
+
+bool deleteProgram(Id& program) {
+	COMPUTE_DISPATCH(deleteProgram, program);
+}
+
+Id createKernel(Id program, const char *name) {
+	COMPUTE_DISPATCH(createKernel, program, name);
+}
+
+bool deleteKernel(Id& kernel) {
+	COMPUTE_DISPATCH(deleteKernel, kernel);
+}
+
+bool kernelArg(Id kernel, uint32_t index, size_t size, const void* data) {
+	COMPUTE_DISPATCH(kernelArg, kernel, index, size, data);
+}
+
+bool kernelRun(Id kernel, const glm::ivec3& workSize, int workDim, bool blocking) {
+	COMPUTE_DISPATCH(kernelRun, kernel, workSize, workDim, blocking);
+}
+
+bool finish() {
+	COMPUTE_DISPATCH(finish);
+}
+
+#undef COMPUTE_DISPATCH
+
+}
@@ -3,7 +3,8 @@
  * @defgroup Compute
  * @{
  *
- * The compute module contains wrappers around OpenCL.
+ * The compute module contains wrappers around OpenCL. If no OpenCL device is available, the
+ * kernels can also be executed on the host - see @c HostKernel.h
  *
  * @see Shader
  *
@@ -22,8 +23,16 @@
 
 namespace compute {
 
+/**
+ * @brief Initializes the OpenCL backend and falls back to the host backend if that fails
+ */
 bool init();
+bool init(Backend backend);
 void shutdown();
+/**
+ * @return The backend that was initialized or @c Backend::None
+ */
+Backend backend();
 
 Id createBuffer(BufferFlag flags, size_t size = 0, void* data = nullptr);
 bool updateBuffer(Id buffer, size_t size, const void* data, bool blockingWrite = true);
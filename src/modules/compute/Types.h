@@ -23,4 +23,11 @@ enum class BufferFlag {
 };
 CORE_ENUM_BIT_OPERATIONS(BufferFlag)
 
+enum class Backend {
+	None,
+	OpenCL,
+	// native kernels that are executed on the core thread pool - see HostKernel.h
+	Host
+};
+
 }
@@ -1,6 +1,7 @@
 /**
  * @file
  */
+#include "CLCompute.h"
 #include "CL.h"
 #include "CLSymbol.h"
 #include "compute/Compute.h"
@@ -16,6 +17,7 @@
 #include <unordered_map>
 
 namespace compute {
+namespace cl {
 
 namespace _priv {
 struct Context {
@@ -622,3 +624,4 @@ void shutdown() {
 }
 
 }
+}
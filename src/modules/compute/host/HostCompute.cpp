@@ -0,0 +1,265 @@
+/**
+ * @file
+ */
+#include "HostCompute.h"
+#include "HostKernel.h"
+#include "core/Log.h"
+#include "core/Assert.h"
+#include "core/ThreadPool.h"
+#include <glm/common.hpp>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <string.h>
+
+namespace compute {
+namespace host {
+
+namespace _priv {
+
+struct Buffer {
+	uint8_t* data = nullptr;
+	size_t size = 0u;
+	size_t capacity = 0u;
+	// false if the memory is owned by the caller (@c BufferFlag::UseHostPointer)
+	bool owned = false;
+};
+
+struct Program {
+};
+
+struct Kernel {
+	std::string name;
+	HostKernel func;
+	std::vector<std::vector<uint8_t>> args;
+};
+
+struct Registry {
+	std::mutex mutex;
+	std::unordered_map<std::string, HostKernel> kernels;
+};
+
+static Registry& registry() {
+	static Registry r;
+	return r;
+}
+
+/**
+ * @brief Buffers that are created with @c BufferFlag::UseHostPointer and that are multiples of this
+ * size are not copied.
+ */
+static constexpr size_t Alignment = 64u;
+
+static std::unique_ptr<core::ThreadPool> _threadPool;
+
+}
+
+size_t requiredAlignment() {
+	return _priv::Alignment;
+}
+
+bool configureProgram(Id program) {
+	return program != InvalidId;
+}
+
+bool deleteProgram(Id& program) {
+	if (program == InvalidId) {
+		return true;
+	}
+	delete (_priv::Program*)program;
+	program = InvalidId;
+	return true;
+}
+
+Id createBuffer(BufferFlag flags, size_t size, void* data) {
+	if (!_priv::_threadPool) {
+		return InvalidId;
+	}
+	core_assert(size > 0);
+	_priv::Buffer* buffer = new _priv::Buffer();
+	buffer->size = size;
+	buffer->capacity = size;
+	if ((flags & BufferFlag::UseHostPointer) != BufferFlag::None && data != nullptr) {
+		buffer->data = (uint8_t*)data;
+		return (Id)buffer;
+	}
+	buffer->data = new uint8_t[size];
+	buffer->owned = true;
+	if (data != nullptr) {
+		memcpy(buffer->data, data, size);
+	}
+	return (Id)buffer;
+}
+
+bool deleteBuffer(Id& buffer) {
+	if (buffer == InvalidId) {
+		return true;
+	}
+	_priv::Buffer* b = (_priv::Buffer*)buffer;
+	if (b->owned) {
+		delete[] b->data;
+	}
+	delete b;
+	buffer = InvalidId;
+	return true;
+}
+
+bool updateBuffer(Id buffer, size_t size, const void* data, bool blockingWrite) {
+	if (buffer == InvalidId) {
+		return false;
+	}
+	_priv::Buffer* b = (_priv::Buffer*)buffer;
+	if (b->data == data && size <= b->capacity) {
+		b->size = size;
+		return true;
+	}
+	// never write into memory of the caller that isn't the one we were created with
+	if (!b->owned || size > b->capacity) {
+		if (b->owned) {
+			delete[] b->data;
+		}
+		b->data = new uint8_t[size];
+		b->capacity = size;
+		b->owned = true;
+	}
+	memcpy(b->data, data, size);
+	b->size = size;
+	return true;
+}
+
+bool readBuffer(Id buffer, size_t size, void* data) {
+	if (buffer == InvalidId) {
+		return false;
+	}
+	if (size <= 0) {
+		return false;
+	}
+	if (data == nullptr) {
+		return false;
+	}
+	const _priv::Buffer* b = (const _priv::Buffer*)buffer;
+	if (b->data != data) {
+		memcpy(data, b->data, glm::min(size, b->size));
+	}
+	return true;
+}
+
+Id createProgram(const std::string& source) {
+	if (!_priv::_threadPool) {
+		return InvalidId;
+	}
+	// there is nothing to compile - the kernels are looked up by name in createKernel()
+	return (Id)new _priv::Program();
+}
+
+Id createKernel(Id program, const char *name) {
+	if (program == InvalidId) {
+		return InvalidId;
+	}
+	core_assert(name != nullptr);
+	_priv::Registry& r = _priv::registry();
+	std::unique_lock<std::mutex> lock(r.mutex);
+	auto i = r.kernels.find(name);
+	if (i == r.kernels.end()) {
+		Log::debug("No native implementation for kernel %s", name);
+		return InvalidId;
+	}
+	_priv::Kernel* kernel = new _priv::Kernel();
+	kernel->name = name;
+	kernel->func = i->second;
+	return (Id)kernel;
+}
+
+bool deleteKernel(Id& kernel) {
+	if (kernel == InvalidId) {
+		return false;
+	}
+	delete (_priv::Kernel*)kernel;
+	kernel = InvalidId;
+	return true;
+}
+
+bool kernelArg(Id kernel, uint32_t index, size_t size, const void* data) {
+	if (kernel == InvalidId) {
+		return false;
+	}
+	_priv::Kernel* k = (_priv::Kernel*)kernel;
+	if (k->args.size() <= index) {
+		k->args.resize(index + 1);
+	}
+	const uint8_t* bytes = (const uint8_t*)data;
+	k->args[index].assign(bytes, bytes + size);
+	return true;
+}
+
+bool kernelRun(Id kernel, const glm::ivec3& workSize, int workDim, bool blocking) {
+	if (kernel == InvalidId) {
+		return false;
+	}
+	core_assert_always(workDim > 0);
+	core_assert_always(workDim <= 3);
+	core_assert(_priv::_threadPool);
+	int workItems = 1;
+	for (int i = 0; i < workDim; ++i) {
+		workItems *= workSize[i];
+	}
+	if (workItems <= 0) {
+		return true;
+	}
+	const _priv::Kernel* k = (const _priv::Kernel*)kernel;
+	const HostKernelArgs args(k->args);
+	// the kernels are always executed synchronously - the blocking flag doesn't matter
+	_priv::_threadPool->parallelFor(0, workItems, [&] (int start, int end) {
+		const HostWorkRange range { start, end, workSize, workDim };
+		k->func(args, range);
+	});
+	return true;
+}
+
+bool finish() {
+	return true;
+}
+
+bool init() {
+	core_assert(!_priv::_threadPool);
+	const size_t threads = (std::max)(1u, std::thread::hardware_concurrency());
+	_priv::_threadPool.reset(new core::ThreadPool(threads, "Compute"));
+	Log::info("Host compute backend uses %i threads", (int)threads);
+	return true;
+}
+
+void shutdown() {
+	if (_priv::_threadPool) {
+		_priv::_threadPool->shutdown();
+		_priv::_threadPool.reset();
+	}
+}
+
+}
+
+const std::vector<uint8_t>& HostKernelArgs::raw(uint32_t index) const {
+	core_assert_msg(index < _args.size(), "Kernel argument %u wasn't set", index);
+	return _args[index];
+}
+
+void* HostKernelArgs::bufferData(Id buffer) {
+	if (buffer == InvalidId) {
+		return nullptr;
+	}
+	return ((host::_priv::Buffer*)buffer)->data;
+}
+
+void registerHostKernel(const std::string& name, const HostKernel& kernel) {
+	host::_priv::Registry& r = host::_priv::registry();
+	std::unique_lock<std::mutex> lock(r.mutex);
+	r.kernels[name] = kernel;
+}
+
+bool unregisterHostKernel(const std::string& name) {
+	host::_priv::Registry& r = host::_priv::registry();
+	std::unique_lock<std::mutex> lock(r.mutex);
+	return r.kernels.erase(name) > 0;
+}
+
+}
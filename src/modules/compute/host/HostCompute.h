@@ -0,0 +1,40 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "compute/Types.h"
+#include "compute/cl/CLTypes.h"
+#include <glm/vec3.hpp>
+#include <string>
+#include <stdint.h>
+
+namespace compute {
+
+/**
+ * @brief Host backend of the compute module that executes native kernels on the core thread pool.
+ * @note Don't use this directly - see @c Compute.h
+ */
+namespace host {
+
+bool init();
+void shutdown();
+
+Id createBuffer(BufferFlag flags, size_t size, void* data);
+bool updateBuffer(Id buffer, size_t size, const void* data, bool blockingWrite);
+bool deleteBuffer(Id& buffer);
+bool readBuffer(Id buffer, size_t size, void* data);
+
+Id createProgram(const std::string& source);
+size_t requiredAlignment();
+bool configureProgram(Id program);
+bool deleteProgram(Id& program);
+
+Id createKernel(Id program, const char *name);
+bool deleteKernel(Id& kernel);
+bool kernelArg(Id kernel, uint32_t index, size_t size, const void* data);
+bool kernelRun(Id kernel, const glm::ivec3& workSize, int workDim, bool blocking);
+bool finish();
+
+}
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ */
+#pragma once
+
+#include "compute/Types.h"
+#include "compute/cl/CLTypes.h"
+#include <glm/vec3.hpp>
+#include <functional>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace compute {
+
+/**
+ * @brief The part of the global work-items that a native kernel has to process.
+ *
+ * The work-items are flattened - use @c globalId() to get the id that @c get_global_id()
+ * would return in the OpenCL kernel.
+ * @ingroup Compute
+ */
+struct HostWorkRange {
+	// first flattened work-item index
+	int begin;
+	// flattened work-item index that is not processed anymore
+	int end;
+	glm::ivec3 workSize;
+	int workDim;
+
+	inline glm::ivec3 globalId(int index) const {
+		const int w = workSize.x;
+		const int h = workDim > 1 ? workSize.y : 1;
+		return glm::ivec3(index % w, (index / w) % h, index / (w * h));
+	}
+};
+
+/**
+ * @brief The arguments that were set via @c compute::kernelArg() for a native kernel
+ * @ingroup Compute
+ */
+class HostKernelArgs {
+private:
+	const std::vector<std::vector<uint8_t>>& _args;
+
+	const std::vector<uint8_t>& raw(uint32_t index) const;
+public:
+	explicit HostKernelArgs(const std::vector<std::vector<uint8_t>>& args) :
+			_args(args) {
+	}
+
+	/**
+	 * @return The value of a by-value kernel argument
+	 */
+	template<class T>
+	inline const T& value(uint32_t index) const {
+		return *reinterpret_cast<const T*>(raw(index).data());
+	}
+
+	/**
+	 * @return The memory of the buffer that was given as kernel argument
+	 */
+	template<class T>
+	inline T* buffer(uint32_t index) const {
+		return static_cast<T*>(bufferData(value<Id>(index)));
+	}
+
+	static void* bufferData(Id buffer);
+};
+
+/**
+ * @brief Native implementation of a compute kernel. Must be thread safe, because the
+ * global work-items are split into several ranges that are executed in parallel.
+ */
+typedef std::function<void(const HostKernelArgs& args, const HostWorkRange& range)> HostKernel;
+
+/**
+ * @brief Registers the native implementation of the kernel with the given name for the
+ * host backend. An existing kernel with the same name is replaced.
+ * @note The generated compute shader wrappers offer typed @c register<Kernel>Host() methods
+ * for this. Registration must happen before the @c compute::Shader::setup() call.
+ * @ingroup Compute
+ */
+void registerHostKernel(const std::string& name, const HostKernel& kernel);
+bool unregisterHostKernel(const std::string& name);
+
+}
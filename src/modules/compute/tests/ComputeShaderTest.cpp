@@ -13,8 +13,25 @@ private:
 protected:
 	bool _supported = false;
 public:
+	static void registerHostKernels() {
+		compute::TestShader::registerExampleHost([] (const int8_t* buf, int8_t* buf2, const compute::HostWorkRange& range) {
+			memcpy(&buf2[range.begin], &buf[range.begin], range.end - range.begin);
+		});
+		compute::TestShader::registerExample2Host([] (const int8_t* buf, int8_t* buf2, const int32_t& N, const compute::HostWorkRange& range) {
+			memcpy(&buf2[range.begin], &buf[range.begin], range.end - range.begin);
+		});
+		compute::TestShader::registerExampleVectorAddIntHost([] (const int32_t* A, const int32_t* B, int32_t* C, const compute::HostWorkRange& range) {
+			for (int i = range.begin; i < range.end; ++i) {
+				C[i] = A[i] + B[i];
+			}
+		});
+		compute::TestShader::registerExampleVectorAddFloat3NoPointerHost([] (const glm::vec3& A, const glm::vec3& B, const glm::vec3& C, const compute::HostWorkRange& range) {
+		});
+	}
+
 	void SetUp() override {
 		Super::SetUp();
+		registerHostKernels();
 		_supported = compute::init();
 		if (!_supported) {
 			Log::warn("ComputeShaderTest is skipped");
@@ -99,6 +116,10 @@ TEST_F(ComputeShaderTest, testExecuteExampleVectorAddFloat3) {
 	if (!_supported) {
 		return;
 	}
+	if (compute::backend() == compute::Backend::Host) {
+		// relies on the 16 byte layout of the OpenCL float3 type
+		return;
+	}
 	compute::TestShader shader;
 	ASSERT_TRUE(shader.setup());
 	const std::vector<glm::vec3> A {glm::vec3{0.0f, 1.0f, 2.0f}, glm::vec3{0.0f, 1.0f, 2.0f}};
@@ -139,6 +160,39 @@ TEST_F(ComputeShaderTest, testExecuteVectorAdd) {
 	}
 }
 
+TEST_F(ComputeShaderTest, testCompareBackends) {
+	constexpr int size = 100000;
+	std::vector<int> a(size);
+	std::vector<int> b(size);
+	for (int i = 0; i < size; ++i) {
+		a[i] = i;
+		b[i] = size - 2 * i;
+	}
+	std::vector<int> host(size, 0);
+	compute::shutdown();
+	ASSERT_TRUE(compute::init(compute::Backend::Host));
+	{
+		compute::TestShader shader;
+		ASSERT_TRUE(shader.setup());
+		ASSERT_TRUE(shader.exampleVectorAddInt(a, b, host, glm::ivec1(size)));
+		shader.shutdown();
+	}
+	for (int i = 0; i < size; ++i) {
+		ASSERT_EQ(a[i] + b[i], host[i]) << "index: " << i;
+	}
+	compute::shutdown();
+	if (!compute::init(compute::Backend::OpenCL)) {
+		Log::info("No OpenCL device - only the host backend was tested");
+		return;
+	}
+	std::vector<int> cl(size, 0);
+	compute::TestShader shader;
+	ASSERT_TRUE(shader.setup());
+	ASSERT_TRUE(shader.exampleVectorAddInt(a, b, cl, glm::ivec1(size)));
+	shader.shutdown();
+	EXPECT_EQ(host, cl);
+}
+
 // just for comparing runtimes
 TEST_F(ComputeShaderTest, testExecuteVectorAddNonOpenCL) {
 	constexpr int size = 1000;
@@ -152,6 +152,8 @@ AppState App::onConstruct() {
 		logVar->setVal(logLevelVal);
 	}
 	core::Var::get(cfg::CoreSysLog, _syslog ? "true" : "false");
+	core::Var::get(cfg::CoreLogAsync, "true", core::CV_READONLY);
+	core::Var::get(cfg::CoreLogFile, "", core::CV_READONLY);
 	Log::init();
 
 	core::Command::registerCommand("set", [] (const core::CmdArgs& args) {
@@ -7,6 +7,7 @@
 #include "command/Command.h"
 #include "Log.h"
 #include "Var.h"
+#include "LockProfiler.h"
 
 namespace core {
 
@@ -178,6 +179,32 @@ void init() {
 			Log::info("* %s - %s", cmd.name().c_str(), cmd.help().c_str());
 		});
 	}).setHelp("Show the list of known commands (wildcards supported)");
+
+	core::Command::registerCommand("lockprofile", [] (const core::CmdArgs& args) {
+		const std::string cmd = args.empty() ? "dump" : args[0];
+		if (cmd == "start") {
+			core::LockProfiler::setEnabled(true);
+			Log::info("Started lock profiling");
+		} else if (cmd == "stop") {
+			core::LockProfiler::setEnabled(false);
+			Log::info("Stopped lock profiling");
+		} else if (cmd == "reset") {
+			core::LockProfiler::reset();
+		} else if (cmd == "dump") {
+			core::LockProfiler::dump();
+		} else {
+			Log::error("Unknown argument %s - expected start, stop, reset or dump", cmd.c_str());
+		}
+	}).setHelp("Record lock contention statistics (start, stop, reset, dump)").setArgumentCompleter([] (const std::string& str, std::vector<std::string>& matches) -> int {
+		int n = 0;
+		for (const char* arg : {"start", "stop", "reset", "dump"}) {
+			if (core::string::startsWith(arg, str.c_str())) {
+				matches.push_back(arg);
+				++n;
+			}
+		}
+		return n;
+	});
 }
 
 }
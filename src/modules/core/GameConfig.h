@@ -35,6 +35,10 @@ constexpr const char *ClientCameraMaxTargetDistance = "cl_cameramaxtargetdistanc
 constexpr const char *ClientShadowMapShow = "cl_debug_shadowmapshow";
 constexpr const char *ClientDebugShadowMapCascade = "cl_debug_cascade";
 constexpr const char *ClientDebugShadow = "cl_debug_shadow";
+// the minimum time in millis the remote entities are rendered behind the server to interpolate between the updates
+constexpr const char *ClientInterpolationDelay = "cl_interpolationdelay";
+// the maximum time in millis the movement of a remote entity is continued if no update arrived
+constexpr const char *ClientMaxExtrapolation = "cl_maxextrapolation";
 
 constexpr const char *ServerUserTimeout = "sv_usertimeout";
 // the server side seed that is used to create the world
@@ -42,11 +46,25 @@ constexpr const char *ServerSeed = "sv_seed";
 constexpr const char *ServerHost = "sv_host";
 constexpr const char *ServerPort = "sv_port";
 constexpr const char *ServerMaxClients = "sv_maxclients";
+// service the network on a dedicated thread
+constexpr const char *ServerNetworkThread = "sv_networkthread";
+// write the inbound network traffic into the given file
+constexpr const char *ServerCapture = "sv_capture";
+// replay the given capture instead of opening the server socket
+constexpr const char *ServerReplay = "sv_replay";
+// the speed factor for the replay - 0 replays as fast as possible
+constexpr const char *ServerReplaySpeed = "sv_replayspeed";
+// the interval in millis the positions of the visible entities are sent to the clients
+constexpr const char *ServerEntityUpdateInterval = "sv_entityupdateinterval";
 
 constexpr const char *ShapeToolExtractRadius = "sh_extractradius";
 
 constexpr const char *CoreLogLevel = "core_loglevel";
 constexpr const char *CoreSysLog = "core_syslog";
+// write the log messages in a background thread
+constexpr const char *CoreLogAsync = "core_logasync";
+// the path of the file the log messages are appended to - empty to disable the log file
+constexpr const char *CoreLogFile = "core_logfile";
 
 // The size of the chunk that is extracted with each step
 constexpr const char *VoxelMeshSize = "voxel_meshsize";
@@ -0,0 +1,113 @@
+/**
+ * @file
+ */
+
+#include "LockProfiler.h"
+#include "Log.h"
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+
+namespace core {
+
+namespace {
+
+typedef std::unordered_map<std::string, std::unique_ptr<LockStats>> LockStatsMap;
+
+/**
+ * @note This is not a static member to prevent static initialization order issues with
+ * locks that are static members themselves (e.g. @c Var or @c Command)
+ */
+struct Registry {
+	// a plain mutex - the registry must not be guarded by a profiled lock
+	std::mutex mutex;
+	LockStatsMap stats;
+};
+
+Registry& registry() {
+	static Registry r;
+	return r;
+}
+
+}
+
+std::atomic_bool LockProfiler::_enabled { false };
+
+void LockStats::reset() {
+	readAcquisitions = 0u;
+	writeAcquisitions = 0u;
+	contended = 0u;
+	waitNanos = 0u;
+	maxWaitNanos = 0u;
+	holdNanos = 0u;
+}
+
+void LockStats::addWait(uint64_t nanos) {
+	waitNanos.fetch_add(nanos, std::memory_order_relaxed);
+	uint64_t current = maxWaitNanos.load(std::memory_order_relaxed);
+	while (current < nanos && !maxWaitNanos.compare_exchange_weak(current, nanos, std::memory_order_relaxed)) {
+	}
+}
+
+void LockProfiler::setEnabled(bool enabled) {
+	_enabled = enabled;
+}
+
+LockStats* LockProfiler::stats(const std::string& name) {
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	std::unique_ptr<LockStats>& stats = r.stats[name];
+	if (!stats) {
+		stats.reset(new LockStats());
+	}
+	return stats.get();
+}
+
+void LockProfiler::reset() {
+	Registry& r = registry();
+	std::lock_guard<std::mutex> lock(r.mutex);
+	for (auto& e : r.stats) {
+		e.second->reset();
+	}
+}
+
+std::vector<LockStatsSnapshot> LockProfiler::snapshot() {
+	std::vector<LockStatsSnapshot> snapshots;
+	{
+		Registry& r = registry();
+		std::lock_guard<std::mutex> lock(r.mutex);
+		snapshots.reserve(r.stats.size());
+		for (const auto& e : r.stats) {
+			const LockStats& s = *e.second;
+			snapshots.push_back(LockStatsSnapshot{e.first, s.readAcquisitions, s.writeAcquisitions,
+				s.contended, s.waitNanos, s.maxWaitNanos, s.holdNanos});
+		}
+	}
+	std::sort(snapshots.begin(), snapshots.end(), [] (const LockStatsSnapshot& a, const LockStatsSnapshot& b) {
+		return a.waitNanos > b.waitNanos;
+	});
+	return snapshots;
+}
+
+void LockProfiler::dump() {
+	const std::vector<LockStatsSnapshot>& snapshots = snapshot();
+	if (snapshots.empty()) {
+		Log::info("No lock statistics recorded - enable the profiler with 'lockprofile start'");
+		return;
+	}
+	Log::info("%-24s %12s %12s %12s %12s %12s %12s", "name", "reads", "writes", "contended", "wait(ms)", "maxwait(ms)", "hold(ms)");
+	for (const LockStatsSnapshot& s : snapshots) {
+		Log::info("%-24s %12lu %12lu %12lu %12.3f %12.3f %12.3f", s.name.c_str(),
+				(unsigned long)s.readAcquisitions, (unsigned long)s.writeAcquisitions, (unsigned long)s.contended,
+				(double)s.waitNanos / 1000000.0, (double)s.maxWaitNanos / 1000000.0, (double)s.holdNanos / 1000000.0);
+	}
+}
+
+uint64_t LockProfiler::nanos() {
+	const auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+}
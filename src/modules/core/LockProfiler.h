@@ -0,0 +1,91 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <string>
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+
+namespace core {
+
+/**
+ * @brief Contention statistics of all locks that share the same name.
+ * @sa LockProfiler
+ */
+struct LockStats {
+	std::atomic<uint64_t> readAcquisitions { 0u };
+	std::atomic<uint64_t> writeAcquisitions { 0u };
+	/**
+	 * @brief Amount of acquisitions that could not be satisfied without waiting
+	 */
+	std::atomic<uint64_t> contended { 0u };
+	std::atomic<uint64_t> waitNanos { 0u };
+	std::atomic<uint64_t> maxWaitNanos { 0u };
+	std::atomic<uint64_t> holdNanos { 0u };
+
+	void reset();
+	void addWait(uint64_t nanos);
+};
+
+/**
+ * @brief Copy of the @c LockStats values that is handed out to the caller
+ */
+struct LockStatsSnapshot {
+	std::string name;
+	uint64_t readAcquisitions;
+	uint64_t writeAcquisitions;
+	uint64_t contended;
+	uint64_t waitNanos;
+	uint64_t maxWaitNanos;
+	uint64_t holdNanos;
+};
+
+/**
+ * @brief Opt-in contention profiler for @c ReadWriteLock and @c RecursiveReadWriteLock.
+ *
+ * The statistics are keyed by the name that is given to the lock, so all chunk locks
+ * of a @c voxel::PagedVolume end up in the same bucket. If the profiler is not enabled,
+ * the only overhead for the locks is a relaxed load of a global flag.
+ *
+ * Use the @c lockprofile console command to start, stop, reset or dump the statistics.
+ */
+class LockProfiler {
+private:
+	static std::atomic_bool _enabled;
+public:
+	static inline bool enabled() {
+		return _enabled.load(std::memory_order_relaxed);
+	}
+
+	static void setEnabled(bool enabled);
+
+	/**
+	 * @return The @c LockStats for the given lock name. The returned pointer stays valid until the application ends.
+	 */
+	static LockStats* stats(const std::string& name);
+
+	/**
+	 * @brief Resets all collected values - the registered names are kept.
+	 */
+	static void reset();
+
+	/**
+	 * @return The collected statistics sorted by the accumulated wait time (highest first)
+	 */
+	static std::vector<LockStatsSnapshot> snapshot();
+
+	/**
+	 * @brief Prints the collected statistics to the log
+	 */
+	static void dump();
+
+	/**
+	 * @brief Monotonic timestamp in nanoseconds that is used to measure wait and hold times
+	 */
+	static uint64_t nanos();
+};
+
+}
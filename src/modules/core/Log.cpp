@@ -11,6 +11,14 @@
 #include <string.h>
 #include <stdio.h>
 #include <unordered_map>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <time.h>
 
 #ifdef HAVE_SYSLOG_H
 #include <syslog.h>
@@ -35,13 +43,12 @@
 static bool _syslog = false;
 static constexpr int bufSize = 4096;
 static SDL_LogPriority _logLevel = SDL_LOG_PRIORITY_INFO;
+static std::unordered_map<uint32_t, int> _logActive;
 
 #ifdef HAVE_SYSLOG_H
 static SDL_LogOutputFunction _sdlCallback = nullptr;
 static void *_sdlCallbackUserData = nullptr;
 
-static std::unordered_map<uint32_t, int> _logActive;
-
 static void sysLogOutputFunction(void *userdata, int category, SDL_LogPriority priority, const char *message) {
 	int syslogLevel = LOG_DEBUG;
 	if (priority == SDL_LOG_PRIORITY_CRITICAL) {
@@ -60,6 +67,408 @@ static void sysLogOutputFunction(void *userdata, int category, SDL_LogPriority p
 }
 #endif
 
+static inline uint64_t timestampMicros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+namespace {
+
+/**
+ * @brief Appends the log messages to a file. The file is rotated once it exceeds @c MaxSize.
+ */
+class LogFile {
+private:
+	static constexpr long MaxSize = 16 * 1024 * 1024;
+	std::mutex _mutex;
+	std::string _path;
+	FILE* _file = nullptr;
+	long _size = 0;
+
+	void close() {
+		if (_file != nullptr) {
+			fclose(_file);
+			_file = nullptr;
+		}
+	}
+
+	void rotate() {
+		close();
+		const std::string& rotated = _path + ".1";
+		::remove(rotated.c_str());
+		::rename(_path.c_str(), rotated.c_str());
+		_file = fopen(_path.c_str(), "w");
+		_size = 0;
+	}
+
+public:
+	void open(const std::string& path) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (path == _path) {
+			return;
+		}
+		close();
+		_path = path;
+		if (_path.empty()) {
+			return;
+		}
+		_file = fopen(_path.c_str(), "a");
+		if (_file != nullptr) {
+			fseek(_file, 0, SEEK_END);
+			_size = ftell(_file);
+		}
+	}
+
+	void shutdown() {
+		open("");
+	}
+
+	void write(uint64_t micros, SDL_LogPriority priority, uint32_t id, const char* msg) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_file == nullptr) {
+			return;
+		}
+		const time_t seconds = (time_t)(micros / 1000000u);
+		struct tm tm;
+#ifdef _WIN32
+		localtime_s(&tm, &seconds);
+#else
+		localtime_r(&seconds, &tm);
+#endif
+		char timeBuf[32];
+		strftime(timeBuf, sizeof(timeBuf), "%Y-%m-%d %H:%M:%S", &tm);
+		const int written = fprintf(_file, "%s.%06u %s (%u) %s\n", timeBuf, (uint32_t)(micros % 1000000u),
+				Log::toLogLevel((Log::Level)priority), id, msg);
+		if (written > 0) {
+			_size += written;
+		}
+		if (priority >= SDL_LOG_PRIORITY_ERROR) {
+			fflush(_file);
+		}
+		if (_size > MaxSize) {
+			rotate();
+		}
+	}
+};
+
+LogFile _logFile;
+
+}
+
+static void output(uint64_t micros, SDL_LogPriority priority, uint32_t id, const char* msg) {
+	if (_syslog) {
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, priority, "(%u) %s\n", id, msg);
+	} else {
+		const char* color;
+		switch (priority) {
+		case SDL_LOG_PRIORITY_DEBUG:
+			color = ANSI_COLOR_BLUE;
+			break;
+		case SDL_LOG_PRIORITY_WARN:
+			color = ANSI_COLOR_YELLOW;
+			break;
+		case SDL_LOG_PRIORITY_ERROR:
+		case SDL_LOG_PRIORITY_CRITICAL:
+			color = ANSI_COLOR_RED;
+			break;
+		default:
+			color = ANSI_COLOR_GREEN;
+			break;
+		}
+		SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, priority, "(%u) %s%s" ANSI_COLOR_RESET "\n", id, color, msg);
+	}
+	_logFile.write(micros, priority, id, msg);
+}
+
+namespace {
+
+/**
+ * @brief The header of a log record in the @c LogRing - followed by @c length bytes of the message
+ */
+struct LogRecord {
+	uint64_t micros;
+	uint32_t id;
+	uint16_t length;
+	int16_t priority;
+};
+
+/**
+ * @brief Single producer single consumer ring buffer of variable sized log records
+ *
+ * Every thread that logs gets its own ring - the producer never waits for the writer thread. If the
+ * ring is full, the record is dropped and counted.
+ */
+class LogRing {
+public:
+	static constexpr uint64_t Size = 64 * 1024;
+private:
+	static constexpr uint64_t Mask = Size - 1;
+	static_assert((Size & Mask) == 0, "Size must be a power of two");
+
+	uint8_t _buf[Size];
+	// written by the producer
+	std::atomic<uint64_t> _head { 0u };
+	std::atomic<uint32_t> _dropped { 0u };
+	// keep the producer and the writer thread counters in different cache lines
+	uint8_t _padding[64];
+	// written by the writer thread
+	std::atomic<uint64_t> _tail { 0u };
+
+	void write(uint64_t pos, const void* data, uint64_t len) {
+		const uint64_t offset = pos & Mask;
+		const uint64_t first = std::min(len, Size - offset);
+		memcpy(_buf + offset, data, first);
+		memcpy(_buf, (const uint8_t*)data + first, len - first);
+	}
+
+	void read(uint64_t pos, void* data, uint64_t len) const {
+		const uint64_t offset = pos & Mask;
+		const uint64_t first = std::min(len, Size - offset);
+		memcpy(data, _buf + offset, first);
+		memcpy((uint8_t*)data + first, _buf, len - first);
+	}
+
+public:
+	/**
+	 * @brief Set by the owning thread on exit - the ring is removed once the writer drained it
+	 */
+	std::atomic_bool orphaned { false };
+
+	/**
+	 * @return The amount of bytes that are used after the record was added, or @c 0 if the record was dropped
+	 */
+	uint64_t push(const LogRecord& record, const char* msg) {
+		const uint64_t head = _head.load(std::memory_order_relaxed);
+		const uint64_t tail = _tail.load(std::memory_order_acquire);
+		const uint64_t size = sizeof(record) + record.length;
+		const uint64_t used = head - tail;
+		if (used + size > Size) {
+			_dropped.fetch_add(1u, std::memory_order_relaxed);
+			return 0u;
+		}
+		write(head, &record, sizeof(record));
+		write(head + sizeof(record), msg, record.length);
+		_head.store(head + size, std::memory_order_release);
+		return used + size;
+	}
+
+	/**
+	 * @return @c false if the ring is empty
+	 */
+	bool peek(LogRecord& record) const {
+		const uint64_t tail = _tail.load(std::memory_order_relaxed);
+		if (tail == _head.load(std::memory_order_acquire)) {
+			return false;
+		}
+		read(tail, &record, sizeof(record));
+		return true;
+	}
+
+	/**
+	 * @brief Removes the record that was returned by @c peek()
+	 * @param[out] msg The null terminated message - must be able to hold @c bufSize bytes
+	 */
+	void pop(const LogRecord& record, char* msg) {
+		const uint64_t tail = _tail.load(std::memory_order_relaxed);
+		read(tail + sizeof(record), msg, record.length);
+		msg[record.length] = '\0';
+		_tail.store(tail + sizeof(record) + record.length, std::memory_order_release);
+	}
+
+	bool empty() const {
+		return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire);
+	}
+
+	uint32_t takeDropped() {
+		return _dropped.exchange(0u, std::memory_order_relaxed);
+	}
+};
+
+typedef std::shared_ptr<LogRing> LogRingPtr;
+
+/**
+ * @brief Drains the rings of all threads in a background thread. The records are written in the
+ * order of their timestamps.
+ */
+class LogWriter {
+private:
+	std::mutex _ringsMutex;
+	std::vector<LogRingPtr> _rings;
+	std::mutex _waitMutex;
+	std::condition_variable _condition;
+	std::thread _thread;
+	std::atomic_bool _running { false };
+	std::atomic<uint64_t> _dropped { 0u };
+
+	bool drain() {
+		std::vector<LogRingPtr> rings;
+		{
+			std::lock_guard<std::mutex> lock(_ringsMutex);
+			rings = _rings;
+		}
+		uint32_t dropped = 0u;
+		for (const LogRingPtr& ring : rings) {
+			dropped += ring->takeDropped();
+		}
+		if (dropped > 0u) {
+			_dropped += dropped;
+			char buf[128];
+			SDL_snprintf(buf, sizeof(buf), "Dropped %u log messages - the writer thread can't keep up", dropped);
+			output(timestampMicros(), SDL_LOG_PRIORITY_WARN, 0u, buf);
+		}
+		bool processed = false;
+		char msg[bufSize];
+		for (;;) {
+			LogRing* next = nullptr;
+			LogRecord nextRecord;
+			for (const LogRingPtr& ring : rings) {
+				LogRecord record;
+				if (!ring->peek(record)) {
+					continue;
+				}
+				if (next == nullptr || record.micros < nextRecord.micros) {
+					next = ring.get();
+					nextRecord = record;
+				}
+			}
+			if (next == nullptr) {
+				break;
+			}
+			next->pop(nextRecord, msg);
+			output(nextRecord.micros, (SDL_LogPriority)nextRecord.priority, nextRecord.id, msg);
+			processed = true;
+		}
+		removeOrphaned();
+		return processed;
+	}
+
+	void removeOrphaned() {
+		std::lock_guard<std::mutex> lock(_ringsMutex);
+		_rings.erase(std::remove_if(_rings.begin(), _rings.end(), [] (const LogRingPtr& ring) {
+			return ring->orphaned && ring->empty();
+		}), _rings.end());
+	}
+
+	void run() {
+		while (_running) {
+			if (drain()) {
+				continue;
+			}
+			std::unique_lock<std::mutex> lock(_waitMutex);
+			_condition.wait_for(lock, std::chrono::milliseconds(10));
+		}
+		drain();
+	}
+
+public:
+	~LogWriter() {
+		stop();
+	}
+
+	inline bool running() const {
+		return _running;
+	}
+
+	void start() {
+		if (_running) {
+			return;
+		}
+		_running = true;
+		_thread = std::thread([this] () {
+			run();
+		});
+	}
+
+	void stop() {
+		if (!_running) {
+			return;
+		}
+		_running = false;
+		_condition.notify_one();
+		_thread.join();
+	}
+
+	void wakeup() {
+		_condition.notify_one();
+	}
+
+	/**
+	 * @brief Blocks until the rings of all threads are empty
+	 */
+	void flush() {
+		for (;;) {
+			bool empty = true;
+			{
+				std::lock_guard<std::mutex> lock(_ringsMutex);
+				for (const LogRingPtr& ring : _rings) {
+					empty &= ring->empty();
+				}
+			}
+			if (empty || !_running) {
+				return;
+			}
+			wakeup();
+			std::this_thread::yield();
+		}
+	}
+
+	void add(const LogRingPtr& ring) {
+		std::lock_guard<std::mutex> lock(_ringsMutex);
+		_rings.push_back(ring);
+	}
+
+	inline uint64_t dropped() const {
+		return _dropped;
+	}
+};
+
+LogWriter _writer;
+
+/**
+ * @brief The ring of the calling thread - registered at the writer on first use
+ */
+struct ThreadLogRing {
+	LogRingPtr ring;
+
+	~ThreadLogRing() {
+		if (ring) {
+			ring->orphaned = true;
+		}
+	}
+
+	LogRing& get() {
+		if (!ring) {
+			ring = std::make_shared<LogRing>();
+			_writer.add(ring);
+		}
+		return *ring;
+	}
+};
+
+thread_local ThreadLogRing _threadRing;
+
+}
+
+static void logVA(uint32_t id, SDL_LogPriority priority, const char *msg, va_list args) {
+	char buf[bufSize];
+	const int len = SDL_vsnprintf(buf, sizeof(buf), msg, args);
+	buf[sizeof(buf) - 1] = '\0';
+	const uint64_t micros = timestampMicros();
+	if (!_writer.running()) {
+		output(micros, priority, id, buf);
+		return;
+	}
+	LogRecord record;
+	record.micros = micros;
+	record.id = id;
+	record.length = (uint16_t)std::min(std::max(len, 0), bufSize - 1);
+	record.priority = (int16_t)priority;
+	const uint64_t used = _threadRing.get().push(record, buf);
+	// the writer thread polls - only wake it up if the ring is filling up or an error should appear soon
+	if (used == 0u || used > LogRing::Size / 2 || priority >= SDL_LOG_PRIORITY_ERROR) {
+		_writer.wakeup();
+	}
+}
+
 Log::Level Log::toLogLevel(const std::string& string) {
 	if (core::string::iequals(string, "trace")) {
 		return Level::Trace;
@@ -127,9 +536,27 @@ void Log::init() {
 #endif
 		_syslog = false;
 	}
+
+	_logFile.open(core::Var::getSafe(cfg::CoreLogFile)->strVal());
+	if (core::Var::getSafe(cfg::CoreLogAsync)->boolVal()) {
+		_writer.start();
+	} else {
+		_writer.stop();
+	}
+}
+
+void Log::flush() {
+	_writer.flush();
+}
+
+uint64_t Log::dropped() {
+	return _writer.dropped();
 }
 
 void Log::shutdown() {
+	// write the pending messages before the output functions are reset
+	_writer.stop();
+	_logFile.shutdown();
 	// this is one of the last methods that is executed - so don't rely on anything
 	// still being available here - it won't
 #ifdef HAVE_SYSLOG_H
@@ -145,73 +572,14 @@ void Log::shutdown() {
 	_syslog = false;
 }
 
-static void traceVA(uint32_t id, const char *msg, va_list args) {
-	char buf[bufSize];
-	SDL_vsnprintf(buf, sizeof(buf), msg, args);
-	buf[sizeof(buf) - 1] = '\0';
-	if (_syslog) {
-		SDL_LogVerbose(SDL_LOG_CATEGORY_APPLICATION, "(%u) %s\n", id, buf);
-	} else {
-		SDL_LogVerbose(SDL_LOG_CATEGORY_APPLICATION, "(%u) " ANSI_COLOR_GREEN "%s" ANSI_COLOR_RESET "\n", id, buf);
-	}
-	va_end(args);
-}
-
-static void debugVA(uint32_t id, const char *msg, va_list args) {
-	char buf[bufSize];
-	SDL_vsnprintf(buf, sizeof(buf), msg, args);
-	buf[sizeof(buf) - 1] = '\0';
-	if (_syslog) {
-		SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "(%u) %s\n", id, buf);
-	} else {
-		SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "(%u) " ANSI_COLOR_BLUE "%s" ANSI_COLOR_RESET "\n", id, buf);
-	}
-	va_end(args);
-}
-
-static void infoVA(uint32_t id, const char *msg, va_list args) {
-	char buf[bufSize];
-	SDL_vsnprintf(buf, sizeof(buf), msg, args);
-	buf[sizeof(buf) - 1] = '\0';
-	if (_syslog) {
-		SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "(%u) %s\n", id, buf);
-	} else {
-		SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "(%u) " ANSI_COLOR_GREEN "%s" ANSI_COLOR_RESET "\n", id, buf);
-	}
-	va_end(args);
-}
-
-static void warnVA(uint32_t id, const char *msg, va_list args) {
-	char buf[bufSize];
-	SDL_vsnprintf(buf, sizeof(buf), msg, args);
-	buf[sizeof(buf) - 1] = '\0';
-	if (_syslog) {
-		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "(%u) %s\n", id, buf);
-	} else {
-		SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "(%u) " ANSI_COLOR_YELLOW "%s" ANSI_COLOR_RESET "\n", id, buf);
-	}
-	va_end(args);
-}
-
-static void errorVA(uint32_t id, const char *msg, va_list args) {
-	char buf[bufSize];
-	SDL_vsnprintf(buf, sizeof(buf), msg, args);
-	buf[sizeof(buf) - 1] = '\0';
-	if (_syslog) {
-		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "(%u) %s\n", id, buf);
-	} else {
-		SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "(%u) " ANSI_COLOR_RED "%s" ANSI_COLOR_RESET "\n", id, buf);
-	}
-	va_end(args);
-}
-
 void Log::trace(const char* msg, ...) {
 	if (_logLevel > SDL_LOG_PRIORITY_VERBOSE) {
 		return;
 	}
 	va_list args;
 	va_start(args, msg);
-	traceVA(0u, msg, args);
+	logVA(0u, SDL_LOG_PRIORITY_VERBOSE, msg, args);
+	va_end(args);
 }
 
 void Log::debug(const char* msg, ...) {
@@ -220,7 +588,8 @@ void Log::debug(const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	debugVA(0u, msg, args);
+	logVA(0u, SDL_LOG_PRIORITY_DEBUG, msg, args);
+	va_end(args);
 }
 
 void Log::info(const char* msg, ...) {
@@ -229,7 +598,8 @@ void Log::info(const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	infoVA(0u, msg, args);
+	logVA(0u, SDL_LOG_PRIORITY_INFO, msg, args);
+	va_end(args);
 }
 
 void Log::warn(const char* msg, ...) {
@@ -238,7 +608,8 @@ void Log::warn(const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	warnVA(0u, msg, args);
+	logVA(0u, SDL_LOG_PRIORITY_WARN, msg, args);
+	va_end(args);
 }
 
 void Log::error(const char* msg, ...) {
@@ -247,7 +618,8 @@ void Log::error(const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	errorVA(0u, msg, args);
+	logVA(0u, SDL_LOG_PRIORITY_ERROR, msg, args);
+	va_end(args);
 }
 
 void Log::trace(uint32_t id, const char* msg, ...) {
@@ -262,7 +634,8 @@ void Log::trace(uint32_t id, const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	traceVA(id, msg, args);
+	logVA(id, SDL_LOG_PRIORITY_VERBOSE, msg, args);
+	va_end(args);
 }
 
 void Log::debug(uint32_t id, const char* msg, ...) {
@@ -277,7 +650,8 @@ void Log::debug(uint32_t id, const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	debugVA(id, msg, args);
+	logVA(id, SDL_LOG_PRIORITY_DEBUG, msg, args);
+	va_end(args);
 }
 
 void Log::info(uint32_t id, const char* msg, ...) {
@@ -292,7 +666,8 @@ void Log::info(uint32_t id, const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	infoVA(id, msg, args);
+	logVA(id, SDL_LOG_PRIORITY_INFO, msg, args);
+	va_end(args);
 }
 
 void Log::warn(uint32_t id, const char* msg, ...) {
@@ -307,7 +682,8 @@ void Log::warn(uint32_t id, const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	warnVA(id, msg, args);
+	logVA(id, SDL_LOG_PRIORITY_WARN, msg, args);
+	va_end(args);
 }
 
 void Log::error(uint32_t id, const char* msg, ...) {
@@ -322,7 +698,8 @@ void Log::error(uint32_t id, const char* msg, ...) {
 	}
 	va_list args;
 	va_start(args, msg);
-	errorVA(id, msg, args);
+	logVA(id, SDL_LOG_PRIORITY_ERROR, msg, args);
+	va_end(args);
 }
 
 bool Log::enable(uint32_t id, Log::Level level) {
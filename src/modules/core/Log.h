@@ -41,8 +41,23 @@ public:
 	static Level toLogLevel(const std::string& string);
 	static const char* toLogLevel(Level level);
 
+	/**
+	 * @brief Applies the log config variables. If @c cfg::CoreLogAsync is set, the messages are
+	 * handed over to a background thread that writes them.
+	 */
 	static void init();
+	/**
+	 * @brief Writes the pending messages and stops the background thread
+	 */
 	static void shutdown();
+	/**
+	 * @brief Blocks until the background thread has written all pending messages
+	 */
+	static void flush();
+	/**
+	 * @return The amount of messages that were dropped because the buffer of the logging thread was full
+	 */
+	static uint64_t dropped();
 	static void trace(CORE_FORMAT_STRING const char* msg, ...) __attribute__((format(printf, 1, 2)));
 	static void debug(CORE_FORMAT_STRING const char* msg, ...) __attribute__((format(printf, 1, 2)));
 	static void info(CORE_FORMAT_STRING const char* msg, ...) __attribute__((format(printf, 1, 2)));
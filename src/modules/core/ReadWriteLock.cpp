@@ -0,0 +1,183 @@
+/**
+ * @file
+ */
+
+#include "ReadWriteLock.h"
+#include "Concurrency.h"
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define CORE_CPU_RELAX() _mm_pause()
+#else
+#define CORE_CPU_RELAX()
+#endif
+
+namespace core {
+
+namespace {
+
+/**
+ * @brief The amount of busy spins before the waiting thread starts to yield
+ */
+const uint32_t SpinCount = 64u;
+/**
+ * @brief The amount of yields before the waiting thread is parked
+ */
+const uint32_t YieldCount = 16u;
+const uint32_t MaxReaderSlots = 64u;
+const int MaxReadHolds = 16;
+
+/**
+ * @brief Acquisition timestamps of the read locks the current thread is holding - only filled if
+ * the @c LockProfiler is enabled. Read locks don't have an owner, so the hold time can't be stored
+ * in the lock itself.
+ */
+struct ReadHold {
+	const void* lock;
+	uint64_t start;
+};
+thread_local ReadHold readHolds[MaxReadHolds];
+thread_local int readHoldCount = 0;
+
+void relax(uint32_t spins) {
+	if (spins < SpinCount) {
+		CORE_CPU_RELAX();
+	} else {
+		std::this_thread::yield();
+	}
+}
+
+}
+
+ReadWriteLock::ReadWriteLock(const std::string& name, bool perCoreReaders) :
+		_slots(&_reader), _name(name) {
+	if (!perCoreReaders) {
+		return;
+	}
+	uint32_t slots = 1u;
+	while (slots < core::cpus() && slots < MaxReaderSlots) {
+		slots <<= 1;
+	}
+	if (slots <= 1u) {
+		return;
+	}
+	// over-allocate to be able to align the slots to the cache line boundaries
+	_slotBuffer.reset(new uint8_t[slots * sizeof(ReaderSlot) + CacheLineSize]);
+	const uintptr_t address = reinterpret_cast<uintptr_t>(_slotBuffer.get());
+	const uintptr_t aligned = (address + CacheLineSize - 1u) & ~(uintptr_t)(CacheLineSize - 1u);
+	_slots = reinterpret_cast<ReaderSlot*>(aligned);
+	for (uint32_t i = 0u; i < slots; ++i) {
+		new (&_slots[i]) ReaderSlot();
+	}
+	_slotMask = slots - 1u;
+}
+
+uint32_t ReadWriteLock::currentReaderSlot() {
+	static std::atomic_uint nextSlot { 0u };
+	thread_local const uint32_t slot = nextSlot.fetch_add(1u, std::memory_order_relaxed);
+	return slot;
+}
+
+void ReadWriteLock::wakeParkedSlow() const {
+	std::lock_guard<std::mutex> lock(_parkMutex);
+	_parkCondition.notify_all();
+}
+
+void ReadWriteLock::lockReadContended() const {
+	for (uint32_t spins = 0u;; ++spins) {
+		if (!_writer.load(std::memory_order_relaxed) && tryLockRead()) {
+			return;
+		}
+		if (spins < SpinCount + YieldCount) {
+			relax(spins);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_parkMutex);
+		_parked.fetch_add(1);
+		// the timeout is just a safety net - the wakeup happens in unlockWrite()
+		_parkCondition.wait_for(lock, std::chrono::milliseconds(1), [this] () {
+			return !_writer.load();
+		});
+		_parked.fetch_sub(1);
+	}
+}
+
+void ReadWriteLock::lockWriteContended() {
+	for (uint32_t spins = 0u;; ++spins) {
+		if (!_writer.load(std::memory_order_relaxed) && noReaders() && tryLockWrite()) {
+			return;
+		}
+		if (spins < SpinCount + YieldCount) {
+			relax(spins);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(_parkMutex);
+		_parked.fetch_add(1);
+		_parkCondition.wait_for(lock, std::chrono::milliseconds(1), [this] () {
+			return !_writer.load() && noReaders();
+		});
+		_parked.fetch_sub(1);
+	}
+}
+
+LockStats* ReadWriteLock::lockStats() const {
+	LockStats* stats = _stats.load(std::memory_order_acquire);
+	if (stats == nullptr) {
+		stats = LockProfiler::stats(_name);
+		_stats.store(stats, std::memory_order_release);
+	}
+	return stats;
+}
+
+void ReadWriteLock::lockReadProfiled() const {
+	LockStats* stats = lockStats();
+	if (!tryLockRead()) {
+		const uint64_t start = LockProfiler::nanos();
+		lockReadContended();
+		stats->addWait(LockProfiler::nanos() - start);
+		stats->contended.fetch_add(1u, std::memory_order_relaxed);
+	}
+	stats->readAcquisitions.fetch_add(1u, std::memory_order_relaxed);
+	if (readHoldCount >= MaxReadHolds) {
+		// too deeply nested - drop the oldest entry
+		for (int i = 1; i < MaxReadHolds; ++i) {
+			readHolds[i - 1] = readHolds[i];
+		}
+		--readHoldCount;
+	}
+	readHolds[readHoldCount++] = ReadHold{this, LockProfiler::nanos()};
+}
+
+void ReadWriteLock::unlockReadProfiled() const {
+	for (int i = readHoldCount - 1; i >= 0; --i) {
+		if (readHolds[i].lock != this) {
+			continue;
+		}
+		const uint64_t hold = LockProfiler::nanos() - readHolds[i].start;
+		lockStats()->holdNanos.fetch_add(hold, std::memory_order_relaxed);
+		for (int j = i + 1; j < readHoldCount; ++j) {
+			readHolds[j - 1] = readHolds[j];
+		}
+		--readHoldCount;
+		return;
+	}
+}
+
+void ReadWriteLock::lockWriteProfiled() {
+	LockStats* stats = lockStats();
+	if (!tryLockWrite()) {
+		const uint64_t start = LockProfiler::nanos();
+		lockWriteContended();
+		stats->addWait(LockProfiler::nanos() - start);
+		stats->contended.fetch_add(1u, std::memory_order_relaxed);
+	}
+	stats->writeAcquisitions.fetch_add(1u, std::memory_order_relaxed);
+	_writeAcquiredNanos = LockProfiler::nanos();
+}
+
+void ReadWriteLock::unlockWriteProfiled() {
+	const uint64_t hold = LockProfiler::nanos() - _writeAcquiredNanos;
+	_writeAcquiredNanos = 0u;
+	lockStats()->holdNanos.fetch_add(hold, std::memory_order_relaxed);
+}
+
+}
@@ -4,62 +4,177 @@
 
 #pragma once
 
+#include "LockProfiler.h"
 #include <string>
 #include <thread>
 #include <mutex>
-#define CORE_SHARED_MUTEX 0
-#define CORE_RECURSIVE_MUTEX 0
-
-#if CORE_SHARED_MUTEX
-#include <shared_mutex>
-#if __cplusplus > 201402L
-using Mutex = std::shared_mutex;
-#else
-using Mutex = std::shared_timed_mutex;
-#endif
-#else // CORE_SHARED_MUTEX
-#if CORE_RECURSIVE_MUTEX
-using Mutex = std::recursive_mutex;
-#else // CORE_RECURSIVE_MUTEX
-using Mutex = std::mutex;
-#endif // CORE_RECURSIVE_MUTEX
-#endif // CORE_SHARED_MUTEX
+#include <condition_variable>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <stdint.h>
 
 namespace core {
 
+/**
+ * @brief The size that is used to pad the lock state to prevent false sharing with neighbouring data
+ */
+static constexpr size_t CacheLineSize = 64u;
+
+/**
+ * @brief Reader-biased shared lock
+ *
+ * Readers only increment a counter in a reader slot and check the writer flag. A writer only
+ * takes the lock if there are no readers left - if there are readers, it backs off and lets
+ * them finish. New readers are never blocked by a writer that is just waiting - only by one
+ * that is holding the lock. This also means that a thread that already holds a read lock can
+ * safely acquire another read lock on the same object.
+ *
+ * The writer flag and the reader counters live on their own cache lines. If the lock is
+ * constructed with per core reader slots, every thread increments the counter of its own slot,
+ * which prevents readers on different cores from bouncing the same cache line. The price is
+ * a more expensive write lock, as the writer has to check every slot.
+ *
+ * Waiting is done by spinning first, then yielding and at last the waiting thread is parked on
+ * a condition variable.
+ *
+ * @note Upgrading a read lock to a write lock is not supported and will dead lock.
+ * @note A read lock must be released by the thread that acquired it.
+ * @sa LockProfiler
+ */
 class ReadWriteLock {
 private:
+	struct ReaderSlot {
+		std::atomic_int readers { 0 };
+		uint8_t padding[CacheLineSize - sizeof(std::atomic_int)];
+	};
+
+	mutable ReaderSlot _reader;
+	mutable std::atomic_bool _writer { false };
+	mutable std::atomic_int _parked { 0 };
+	uint8_t _padding[CacheLineSize - sizeof(std::atomic_bool) - sizeof(std::atomic_int)];
+
+	ReaderSlot* _slots;
+	uint32_t _slotMask = 0u;
+	std::unique_ptr<uint8_t[]> _slotBuffer;
+
+	mutable std::mutex _parkMutex;
+	mutable std::condition_variable _parkCondition;
+
 	const std::string _name;
-	mutable Mutex _mutex;
+	mutable std::atomic<LockStats*> _stats { nullptr };
+	uint64_t _writeAcquiredNanos = 0u;
+
+	static uint32_t currentReaderSlot();
+
+	inline ReaderSlot& readerSlot() const {
+		if (_slotMask == 0u) {
+			return *_slots;
+		}
+		return _slots[currentReaderSlot() & _slotMask];
+	}
+
+	inline bool noReaders() const {
+		for (uint32_t i = 0u; i <= _slotMask; ++i) {
+			if (_slots[i].readers.load() != 0) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	inline void wakeParked() const {
+		if (_parked.load() > 0) {
+			wakeParkedSlow();
+		}
+	}
+
+	void wakeParkedSlow() const;
+	void lockReadContended() const;
+	void lockWriteContended();
+
+	LockStats* lockStats() const;
+	void lockReadProfiled() const;
+	void unlockReadProfiled() const;
+	void lockWriteProfiled();
+	void unlockWriteProfiled();
 public:
-	ReadWriteLock(const std::string& name) :
-			_name(name) {
+	/**
+	 * @param name The name is used as key for the @c LockProfiler
+	 * @param perCoreReaders Spread the readers over several cache lines. Use this for
+	 * locks that are heavily read locked from many threads and rarely write locked.
+	 */
+	ReadWriteLock(const std::string& name, bool perCoreReaders = false);
+
+	inline const std::string& name() const {
+		return _name;
+	}
+
+	/**
+	 * @return @c true if the lock was acquired for reading without waiting, @c false otherwise.
+	 */
+	inline bool tryLockRead() const {
+		ReaderSlot& slot = readerSlot();
+		slot.readers.fetch_add(1);
+		if (!_writer.load()) {
+			return true;
+		}
+		slot.readers.fetch_sub(1);
+		wakeParked();
+		return false;
 	}
 
 	inline void lockRead() const {
-#if CORE_SHARED_MUTEX
-		_mutex.lock_shared();
-#else
-		_mutex.lock();
-#endif
+		if (LockProfiler::enabled()) {
+			lockReadProfiled();
+			return;
+		}
+		if (!tryLockRead()) {
+			lockReadContended();
+		}
 	}
 
 	inline void unlockRead() const {
-#if CORE_SHARED_MUTEX
-		_mutex.unlock_shared();
-#else
-		_mutex.unlock();
-#endif
+		if (LockProfiler::enabled()) {
+			unlockReadProfiled();
+		}
+		readerSlot().readers.fetch_sub(1);
+		wakeParked();
+	}
+
+	/**
+	 * @return @c true if the lock was acquired for writing without waiting, @c false otherwise.
+	 */
+	inline bool tryLockWrite() {
+		bool expected = false;
+		if (!_writer.compare_exchange_strong(expected, true)) {
+			return false;
+		}
+		if (noReaders()) {
+			return true;
+		}
+		// reader bias - let the readers that are already in finish their work
+		_writer.store(false);
+		wakeParked();
+		return false;
 	}
 
 	inline void lockWrite() {
-		_mutex.lock();
+		if (LockProfiler::enabled()) {
+			lockWriteProfiled();
+			return;
+		}
+		if (!tryLockWrite()) {
+			lockWriteContended();
+		}
 	}
 
 	inline void unlockWrite() {
-		_mutex.unlock();
+		if (_writeAcquiredNanos != 0u) {
+			unlockWriteProfiled();
+		}
+		_writer.store(false);
+		wakeParked();
 	}
 };
 
@@ -4,34 +4,65 @@
 
 #pragma once
 
+#include "ReadWriteLock.h"
 #include <string>
-#include <mutex>
+#include <thread>
+#include <atomic>
 
 namespace core {
 
+/**
+ * @brief Shared lock that allows the thread that holds the write lock to acquire the
+ * read or write lock again.
+ *
+ * @note Like for the @c ReadWriteLock, upgrading a read lock to a write lock is not supported.
+ */
 class RecursiveReadWriteLock {
 private:
-	const std::string _name;
-	mutable std::recursive_mutex _mutex;
+	mutable ReadWriteLock _lock;
+	std::atomic<std::thread::id> _owner;
+	mutable int _recursion = 0;
+
+	inline bool isOwner() const {
+		return _owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+	}
 public:
-	RecursiveReadWriteLock(const std::string& name) :
-			_name(name) {
+	RecursiveReadWriteLock(const std::string& name, bool perCoreReaders = false) :
+			_lock(name, perCoreReaders), _owner(std::thread::id()) {
 	}
 
 	inline void lockRead() const {
-		_mutex.lock();
+		if (isOwner()) {
+			++_recursion;
+			return;
+		}
+		_lock.lockRead();
 	}
 
 	inline void unlockRead() const {
-		_mutex.unlock();
+		if (isOwner()) {
+			--_recursion;
+			return;
+		}
+		_lock.unlockRead();
 	}
 
 	inline void lockWrite() {
-		_mutex.lock();
+		if (isOwner()) {
+			++_recursion;
+			return;
+		}
+		_lock.lockWrite();
+		_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+		_recursion = 1;
 	}
 
 	inline void unlockWrite() {
-		_mutex.unlock();
+		if (--_recursion > 0) {
+			return;
+		}
+		_owner.store(std::thread::id(), std::memory_order_relaxed);
+		_lock.unlockWrite();
 	}
 };
 
@@ -0,0 +1,84 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "NonCopyable.h"
+#include <type_traits>
+#include <utility>
+#include <new>
+#include <cstddef>
+
+namespace core {
+
+/**
+ * @brief Type erased functor or lambda with small buffer optimization
+ *
+ * Callables that fit into @c Task::InlineSize bytes are stored in the task itself - bigger ones
+ * are put on the heap. The task is neither copyable nor movable - it lives at the address it was
+ * constructed at until it is executed, so the callable itself only needs to be move constructible.
+ *
+ * @sa ThreadPool
+ */
+class Task : public NonCopyable {
+public:
+	static constexpr size_t InlineSize = 48u;
+private:
+	typedef std::aligned_storage<InlineSize, alignof(std::max_align_t)>::type Storage;
+	Storage _storage;
+	void* _callable;
+	void (*_invoke)(void*);
+	void (*_destroy)(void*);
+
+	template<class Func>
+	static void invoke(void* callable) {
+		(*static_cast<Func*>(callable))();
+	}
+
+	template<class Func>
+	static void destroyInline(void* callable) {
+		static_cast<Func*>(callable)->~Func();
+	}
+
+	template<class Func>
+	static void destroyHeap(void* callable) {
+		delete static_cast<Func*>(callable);
+	}
+	template<class Func, class F>
+	void construct(F&& func, std::true_type) {
+		_callable = new (&_storage) Func(std::forward<F>(func));
+		_destroy = &destroyInline<Func>;
+	}
+
+	template<class Func, class F>
+	void construct(F&& func, std::false_type) {
+		_callable = new Func(std::forward<F>(func));
+		_destroy = &destroyHeap<Func>;
+	}
+public:
+	/**
+	 * @return @c true if a callable of the given type is stored without a heap allocation
+	 */
+	template<class Func>
+	static constexpr bool isInline() {
+		return sizeof(Func) <= InlineSize && alignof(Func) <= alignof(Storage);
+	}
+
+	template<class F>
+	explicit Task(F&& func) {
+		typedef typename std::decay<F>::type Func;
+		construct<Func>(std::forward<F>(func), std::integral_constant<bool, isInline<Func>()>());
+		_invoke = &invoke<Func>;
+	}
+
+	~Task() {
+		_destroy(_callable);
+	}
+
+	inline void operator()() {
+		_invoke(_callable);
+	}
+};
+
+}
@@ -8,32 +8,105 @@
 
 namespace core {
 
+struct ThreadPool::Worker {
+	ThreadPool* pool;
+	size_t index;
+	WorkStealingQueue<Task*> queue;
+	std::thread thread;
+
+	Worker(ThreadPool* _pool, size_t _index) :
+			pool(_pool), index(_index) {
+	}
+};
+
+namespace {
+
+/**
+ * @brief The amount of released task objects that are kept per thread for reuse
+ */
+const int MaxCachedTasks = 1024;
+
+/**
+ * @brief Free list of task memory blocks. Tasks are usually allocated on one thread and
+ * released on another one - but each thread only ever touches its own cache.
+ */
+struct TaskCache {
+	struct Node {
+		Node* next;
+	};
+	Node* head = nullptr;
+	int size = 0;
+
+	~TaskCache() {
+		while (head != nullptr) {
+			Node* node = head;
+			head = node->next;
+			::operator delete(node);
+		}
+	}
+};
+
+thread_local TaskCache taskCache;
+
+}
+
+thread_local ThreadPool::Worker* ThreadPool::_currentWorker = nullptr;
+
+void* ThreadPool::allocateTask() {
+	static_assert(sizeof(Task) >= sizeof(TaskCache::Node), "Task is too small to be linked in the cache");
+	TaskCache& cache = taskCache;
+	if (cache.head == nullptr) {
+		return ::operator new(sizeof(Task));
+	}
+	TaskCache::Node* node = cache.head;
+	cache.head = node->next;
+	--cache.size;
+	return node;
+}
+
+void ThreadPool::releaseTask(Task* task) {
+	task->~Task();
+	TaskCache& cache = taskCache;
+	if (cache.size >= MaxCachedTasks) {
+		::operator delete(task);
+		return;
+	}
+	TaskCache::Node* node = reinterpret_cast<TaskCache::Node*>(task);
+	node->next = cache.head;
+	cache.head = node;
+	++cache.size;
+}
+
 ThreadPool::ThreadPool(size_t threads, const char *name) :
-		_stop(false) {
+		_stop(false), _discard(false), _queued(0), _sleeping(0) {
 	_workers.reserve(threads);
 	if (name == nullptr) {
 		name = "ThreadPool";
 	}
+	// all workers must exist before the first one starts to steal
 	for (size_t i = 0; i < threads; ++i) {
-		_workers.emplace_back([this, name, i] {
-			const std::string n = core::string::format("%s-%i", name, (int)i);
+		_workers.emplace_back(new Worker(this, i));
+	}
+	for (size_t i = 0; i < threads; ++i) {
+		Worker* w = _workers[i].get();
+		w->thread = std::thread([this, name, w] {
+			const std::string n = core::string::format("%s-%i", name, (int)w->index);
 			core_trace_thread(n.c_str());
+			_currentWorker = w;
 			for (;;) {
-				std::function<void()> task;
-				{
-					std::unique_lock<std::mutex> lock(this->_queueMutex);
-					this->_condition.wait(lock, [this] {
-						return this->_stop || !this->_tasks.empty();
-					});
-					if (this->_stop && this->_tasks.empty()) {
-						return;
-					}
-					task = std::move(this->_tasks.front());
-					this->_tasks.pop();
+				if (Task* task = take(w)) {
+					run(task);
+					continue;
 				}
-
-				core_trace_scoped(ThreadPoolWorker);
-				task();
+				if (this->_stop && (this->_discard || this->_queued.load() <= 0)) {
+					return;
+				}
+				std::unique_lock<std::mutex> lock(this->_queueMutex);
+				this->_sleeping.fetch_add(1);
+				this->_condition.wait(lock, [this] {
+					return this->_stop || this->_queued.load() > 0;
+				});
+				this->_sleeping.fetch_sub(1);
 			}
 		});
 	}
@@ -43,19 +116,112 @@ ThreadPool::~ThreadPool() {
 	shutdown();
 }
 
+ThreadPool::Worker* ThreadPool::currentWorker() const {
+	Worker* w = _currentWorker;
+	if (w != nullptr && w->pool == this) {
+		return w;
+	}
+	return nullptr;
+}
+
+void ThreadPool::push(Task* task) {
+	if (Worker* w = currentWorker()) {
+		w->queue.push(task);
+	} else {
+		std::unique_lock<std::mutex> lock(_queueMutex);
+		_tasks.push_back(task);
+	}
+	_queued.fetch_add(1);
+	if (_sleeping.load() > 0) {
+		std::unique_lock<std::mutex> lock(_queueMutex);
+		_condition.notify_one();
+	}
+}
+
+Task* ThreadPool::take(Worker* w) {
+	Task* task = nullptr;
+	if (w != nullptr && w->queue.pop(task)) {
+		_queued.fetch_sub(1);
+		return task;
+	}
+	if (_queued.load() <= 0) {
+		return nullptr;
+	}
+	{
+		std::unique_lock<std::mutex> lock(_queueMutex);
+		if (!_tasks.empty()) {
+			task = _tasks.front();
+			_tasks.pop_front();
+			_queued.fetch_sub(1);
+			return task;
+		}
+	}
+	const size_t n = _workers.size();
+	const size_t start = w != nullptr ? w->index + 1 : 0;
+	for (size_t i = 0; i < n; ++i) {
+		Worker* victim = _workers[(start + i) % n].get();
+		if (victim == w) {
+			continue;
+		}
+		if (victim->queue.steal(task)) {
+			_queued.fetch_sub(1);
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+void ThreadPool::run(Task* task) {
+	core_trace_scoped(ThreadPoolWorker);
+	(*task)();
+	releaseTask(task);
+}
+
+bool ThreadPool::executeOne() {
+	Task* task = take(currentWorker());
+	if (task == nullptr) {
+		return false;
+	}
+	run(task);
+	return true;
+}
+
 void ThreadPool::shutdown(bool wait) {
 	_stop = true;
 	if (!wait) {
+		_discard = true;
+	}
+	{
 		std::unique_lock<std::mutex> lock(_queueMutex);
-		while (!_tasks.empty()) {
-			_tasks.pop();
-		}
 		_condition.notify_all();
 	}
-	for (std::thread &worker : _workers) {
-		worker.join();
+	for (std::unique_ptr<Worker>& w : _workers) {
+		if (w->thread.joinable()) {
+			w->thread.join();
+		}
 	}
+	// the workers are gone - release everything that is still queued without executing it
+	Task* task;
+	for (std::unique_ptr<Worker>& w : _workers) {
+		while (w->queue.steal(task)) {
+			releaseTask(task);
+		}
+	}
+	std::unique_lock<std::mutex> lock(_queueMutex);
+	for (Task* t : _tasks) {
+		releaseTask(t);
+	}
+	_tasks.clear();
+	_queued = 0;
 	_workers.clear();
 }
 
+void TaskGroup::wait() {
+	while (_pending.load(std::memory_order_acquire) > 0) {
+		if (!_pool.executeOne()) {
+			std::this_thread::yield();
+		}
+	}
+}
+
 }
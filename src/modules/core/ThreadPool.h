@@ -27,8 +27,10 @@
 
 #pragma once
 
+#include "Task.h"
+#include "WorkStealingQueue.h"
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -36,10 +38,46 @@
 #include <atomic>
 #include <future>
 #include <functional>
+#include <algorithm>
 
 namespace core {
 
+/**
+ * @brief Work stealing thread pool
+ *
+ * Every worker has its own @c WorkStealingQueue. Tasks that are scheduled from within a worker
+ * end up in the queue of that worker, tasks from other threads are put into a shared queue.
+ * Idle workers take tasks from the shared queue or steal them from the other workers.
+ *
+ * @sa TaskGroup
+ */
 class ThreadPool final {
+private:
+	struct Worker;
+	friend class TaskGroup;
+
+	std::vector<std::unique_ptr<Worker>> _workers;
+	// the task queue for tasks that are scheduled from outside of the workers
+	std::deque<Task*> _tasks;
+
+	// synchronization
+	std::mutex _queueMutex;
+	std::condition_variable _condition;
+	std::atomic_bool _stop;
+	std::atomic_bool _discard;
+	// the amount of tasks that are waiting in any of the queues
+	std::atomic_int _queued;
+	std::atomic_int _sleeping;
+
+	static thread_local Worker* _currentWorker;
+
+	static void* allocateTask();
+	static void releaseTask(Task* task);
+
+	void push(Task* task);
+	Task* take(Worker* worker);
+	Worker* currentWorker() const;
+	void run(Task* task);
 public:
 	explicit ThreadPool(size_t, const char *name = nullptr);
 
@@ -49,19 +87,79 @@ public:
 	template<class F, class ... Args>
 	auto enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type>;
 
+	/**
+	 * @brief Fire-and-forget version of @c enqueue(). Small functors and lambdas don't need any allocation.
+	 * @return @c false if the pool was already shut down - the functor is not executed in this case.
+	 */
+	template<class F>
+	bool schedule(F&& f);
+
+	/**
+	 * @brief Splits the given range into chunks and executes the given functor for each of them.
+	 * The calling thread is helping until all chunks are done.
+	 * @param func Functor or lambda with the signature @code void(int start, int end) @endcode where
+	 * @c end is exclusive
+	 * @param grainSize The amount of indices per chunk - @c 0 means to pick a value based on the amount
+	 * of workers
+	 */
+	template<class F>
+	void parallelFor(int begin, int end, F&& func, int grainSize = 0);
+
+	/**
+	 * @brief Executes one pending task on the calling thread
+	 * @return @c false if no task was found
+	 */
+	bool executeOne();
+
+	/**
+	 * @return The amount of worker threads
+	 */
+	size_t size() const;
+
+	bool stopped() const;
+
 	void shutdown(bool wait = false);
 
 	~ThreadPool();
+};
+
+/**
+ * @brief Tracks a set of tasks that are executed in a @c ThreadPool
+ *
+ * @c wait() doesn't block the calling thread but executes pending tasks until all the
+ * tasks of this group are done. This makes it safe to wait for a group from within a
+ * task of the same pool.
+ */
+class TaskGroup : public NonCopyable {
 private:
-	// need to keep track of threads so we can join them
-	std::vector<std::thread> _workers;
-	// the task queue
-	std::queue<std::function<void()> > _tasks;
+	ThreadPool& _pool;
+	std::atomic_int _pending;
+public:
+	explicit TaskGroup(ThreadPool& pool) :
+			_pool(pool), _pending(0) {
+	}
 
-	// synchronization
-	std::mutex _queueMutex;
-	std::condition_variable _condition;
-	std::atomic_bool _stop;
+	~TaskGroup() {
+		wait();
+	}
+
+	/**
+	 * @note If the pool was already shut down, the functor is executed on the calling thread
+	 */
+	template<class F>
+	void run(F&& f) {
+		if (_pool.stopped()) {
+			f();
+			return;
+		}
+		_pending.fetch_add(1);
+		_pool.schedule([this, func = std::forward<F>(f)] () mutable {
+			func();
+			_pending.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	void wait();
 };
 
 // add new work item to the pool
@@ -73,18 +171,57 @@ auto ThreadPool::enqueue(F&& f, Args&&... args)
 		return std::future<return_type>();
 	}
 
-	auto task = std::make_shared<std::packaged_task<return_type()> >(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-
-	std::future<return_type> res = task->get_future();
-	{
-		std::unique_lock<std::mutex> lock(_queueMutex);
-		if (_stop) {
-			return std::future<return_type>();
-		}
-		_tasks.emplace([task]() {(*task)();});
-		_condition.notify_one();
+	std::packaged_task<return_type()> task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+	std::future<return_type> res = task.get_future();
+	if (!schedule(std::move(task))) {
+		return std::future<return_type>();
 	}
 	return res;
 }
 
+template<class F>
+bool ThreadPool::schedule(F&& f) {
+	if (_stop) {
+		return false;
+	}
+	push(new (allocateTask()) Task(std::forward<F>(f)));
+	return true;
+}
+
+template<class F>
+void ThreadPool::parallelFor(int begin, int end, F&& func, int grainSize) {
+	const int n = end - begin;
+	if (n <= 0) {
+		return;
+	}
+	if (grainSize <= 0) {
+		// a few chunks per thread to be able to balance the load
+		const int chunks = (int)(size() + 1u) * 4;
+		grainSize = (std::max)(1, (n + chunks - 1) / chunks);
+	}
+	if (grainSize >= n || _workers.empty()) {
+		func(begin, end);
+		return;
+	}
+	TaskGroup group(*this);
+	int start = begin;
+	for (; start + grainSize < end; start += grainSize) {
+		const int chunkEnd = start + grainSize;
+		group.run([&func, start, chunkEnd] () {
+			func(start, chunkEnd);
+		});
+	}
+	// the last chunk is executed by the calling thread
+	func(start, end);
+	group.wait();
+}
+
+inline size_t ThreadPool::size() const {
+	return _workers.size();
+}
+
+inline bool ThreadPool::stopped() const {
+	return _stop;
+}
+
 }
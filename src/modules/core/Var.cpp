@@ -10,7 +10,7 @@
 namespace core {
 
 Var::VarMap Var::_vars;
-ReadWriteLock Var::_lock("Var");
+ReadWriteLock Var::_lock("Var", true);
 
 MAKE_SHARED_INVIS_CTOR(Var);
 
@@ -0,0 +1,136 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "NonCopyable.h"
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+namespace core {
+
+/**
+ * @brief Chase-Lev work stealing deque
+ *
+ * The owning thread pushes and pops at the bottom, all other threads steal from the top.
+ * The buffer grows if needed - old buffers are kept until the queue is destroyed, because
+ * a thief might still read from them.
+ *
+ * @note Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê, Pop, Cohen, Zappa Nardelli)
+ * @note Only pointers should be stored here.
+ */
+template<class T>
+class WorkStealingQueue : public NonCopyable {
+private:
+	struct Buffer {
+		const int64_t capacity;
+		const int64_t mask;
+		std::unique_ptr<std::atomic<T>[]> data;
+
+		explicit Buffer(int64_t _capacity) :
+				capacity(_capacity), mask(_capacity - 1), data(new std::atomic<T>[_capacity]) {
+		}
+
+		inline T get(int64_t i) const {
+			return data[i & mask].load(std::memory_order_relaxed);
+		}
+
+		inline void put(int64_t i, T value) {
+			data[i & mask].store(value, std::memory_order_relaxed);
+		}
+
+		Buffer* grow(int64_t bottom, int64_t top) const {
+			Buffer* buffer = new Buffer(capacity * 2);
+			for (int64_t i = top; i != bottom; ++i) {
+				buffer->put(i, get(i));
+			}
+			return buffer;
+		}
+	};
+
+	std::atomic<int64_t> _top { 0 };
+	std::atomic<int64_t> _bottom { 0 };
+	std::atomic<Buffer*> _buffer;
+	// only accessed by the owner
+	std::vector<std::unique_ptr<Buffer>> _buffers;
+
+public:
+	/**
+	 * @param capacity Must be a power of two
+	 */
+	explicit WorkStealingQueue(int64_t capacity = 1024) {
+		_buffers.emplace_back(new Buffer(capacity));
+		_buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+	}
+
+	/**
+	 * @note Only to be called by the owner
+	 */
+	void push(T value) {
+		const int64_t b = _bottom.load(std::memory_order_relaxed);
+		const int64_t t = _top.load(std::memory_order_acquire);
+		Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+		if (b - t > buffer->capacity - 1) {
+			buffer = buffer->grow(b, t);
+			_buffers.emplace_back(buffer);
+			_buffer.store(buffer, std::memory_order_release);
+		}
+		buffer->put(b, value);
+		std::atomic_thread_fence(std::memory_order_release);
+		_bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @note Only to be called by the owner
+	 * @return @c false if the queue was empty
+	 */
+	bool pop(T& value) {
+		const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buffer = _buffer.load(std::memory_order_relaxed);
+		_bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = _top.load(std::memory_order_relaxed);
+		if (t > b) {
+			_bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+		value = buffer->get(b);
+		if (t == b) {
+			// last element - race against the thieves
+			const bool won = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			_bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	/**
+	 * @note Can be called by any thread
+	 * @return @c false if the queue was empty or another thread was faster
+	 */
+	bool steal(T& value) {
+		int64_t t = _top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64_t b = _bottom.load(std::memory_order_acquire);
+		if (t >= b) {
+			return false;
+		}
+		Buffer* buffer = _buffer.load(std::memory_order_acquire);
+		value = buffer->get(t);
+		return _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	/**
+	 * @note This is only a snapshot
+	 */
+	bool empty() const {
+		const int64_t b = _bottom.load(std::memory_order_relaxed);
+		const int64_t t = _top.load(std::memory_order_relaxed);
+		return b <= t;
+	}
+};
+
+}
@@ -0,0 +1,7 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN()
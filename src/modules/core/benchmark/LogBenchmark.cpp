@@ -0,0 +1,63 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/Log.h"
+#include "core/Var.h"
+#include <stdio.h>
+
+namespace {
+
+FILE* logFile = nullptr;
+
+/**
+ * @brief Writes the messages like the default SDL output function - but into a temporary file
+ */
+void fileOutputFunction(void *userdata, int category, SDL_LogPriority priority, const char *message) {
+	fprintf(logFile, "%s", message);
+}
+
+void setup(bool async) {
+	core::Var::get(cfg::CoreLogLevel, SDL_LOG_PRIORITY_INFO);
+	core::Var::get(cfg::CoreSysLog, "false");
+	core::Var::get(cfg::CoreLogFile, "");
+	core::Var::get(cfg::CoreLogAsync, "false")->setVal(async);
+	logFile = tmpfile();
+	SDL_LogSetOutputFunction(fileOutputFunction, nullptr);
+	Log::init();
+}
+
+void teardown() {
+	Log::shutdown();
+	SDL_LogSetOutputFunction(nullptr, nullptr);
+	fclose(logFile);
+	logFile = nullptr;
+}
+
+}
+
+/**
+ * @brief Measures the time the calling thread spends in @c Log::info().
+ *
+ * The argument selects the synchronous (@c 0) or the asynchronous (@c 1) backend.
+ */
+static void BM_LogInfo(benchmark::State& state) {
+	const bool async = state.range(0) != 0;
+	if (state.thread_index == 0) {
+		setup(async);
+	}
+	const uint64_t droppedBefore = Log::dropped();
+	int i = 0;
+	while (state.KeepRunning()) {
+		Log::info("Tick event %i of thread %i", ++i, state.thread_index);
+	}
+	if (state.thread_index == 0) {
+		// the writer thread counts the dropped messages while it drains the buffers
+		teardown();
+		state.counters["dropped"] = (double)(Log::dropped() - droppedBefore);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_LogInfo)->Arg(0)->Arg(1)->Threads(1)->Threads(16);
@@ -0,0 +1,117 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/ReadWriteLock.h"
+#include "core/RecursiveReadWriteLock.h"
+#include <mutex>
+
+namespace {
+
+core::ReadWriteLock sharedLock("benchmark");
+core::ReadWriteLock perCoreLock("benchmark-percore", true);
+core::RecursiveReadWriteLock recursiveLock("benchmark-recursive");
+std::mutex exclusiveLock;
+int value = 0;
+
+/**
+ * @brief Every 100th operation is a write
+ */
+inline bool isWrite(int i) {
+	return i % 100 == 0;
+}
+
+}
+
+static void BM_ReadMostlyMutex(benchmark::State& state) {
+	int i = 0;
+	while (state.KeepRunning()) {
+		std::lock_guard<std::mutex> lock(exclusiveLock);
+		if (isWrite(++i)) {
+			++value;
+		} else {
+			benchmark::DoNotOptimize(value);
+		}
+	}
+}
+
+static void BM_ReadMostlyReadWriteLock(benchmark::State& state) {
+	int i = 0;
+	while (state.KeepRunning()) {
+		if (isWrite(++i)) {
+			core::ScopedWriteLock lock(sharedLock);
+			++value;
+		} else {
+			core::ScopedReadLock lock(sharedLock);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+}
+
+static void BM_ReadMostlyPerCoreReadWriteLock(benchmark::State& state) {
+	int i = 0;
+	while (state.KeepRunning()) {
+		if (isWrite(++i)) {
+			core::ScopedWriteLock lock(perCoreLock);
+			++value;
+		} else {
+			core::ScopedReadLock lock(perCoreLock);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+}
+
+static void BM_ReadMostlyRecursiveReadWriteLock(benchmark::State& state) {
+	int i = 0;
+	while (state.KeepRunning()) {
+		if (isWrite(++i)) {
+			core::RecursiveScopedWriteLock lock(recursiveLock);
+			++value;
+		} else {
+			core::RecursiveScopedReadLock lock(recursiveLock);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+}
+
+static void BM_ReadOnlyPerCoreReadWriteLock(benchmark::State& state) {
+	while (state.KeepRunning()) {
+		core::ScopedReadLock lock(perCoreLock);
+		benchmark::DoNotOptimize(value);
+	}
+}
+
+static void BM_ReadOnlyReadWriteLock(benchmark::State& state) {
+	while (state.KeepRunning()) {
+		core::ScopedReadLock lock(sharedLock);
+		benchmark::DoNotOptimize(value);
+	}
+}
+
+static void BM_ReadWriteLockProfiled(benchmark::State& state) {
+	if (state.thread_index == 0) {
+		core::LockProfiler::setEnabled(true);
+	}
+	int i = 0;
+	while (state.KeepRunning()) {
+		if (isWrite(++i)) {
+			core::ScopedWriteLock lock(sharedLock);
+			++value;
+		} else {
+			core::ScopedReadLock lock(sharedLock);
+			benchmark::DoNotOptimize(value);
+		}
+	}
+	if (state.thread_index == 0) {
+		core::LockProfiler::setEnabled(false);
+	}
+}
+
+BENCHMARK(BM_ReadMostlyMutex)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ReadMostlyReadWriteLock)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ReadMostlyPerCoreReadWriteLock)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ReadMostlyRecursiveReadWriteLock)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ReadOnlyReadWriteLock)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ReadOnlyPerCoreReadWriteLock)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ReadWriteLockProfiled)->ThreadRange(1, 16)->UseRealTime();
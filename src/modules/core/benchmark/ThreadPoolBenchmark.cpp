@@ -0,0 +1,89 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/ThreadPool.h"
+#include <vector>
+#include <cmath>
+
+namespace {
+
+const int WorkItems = 1 << 16;
+
+inline float work(int i) {
+	return std::sqrt((float)i) * std::sin((float)i);
+}
+
+}
+
+static void BM_ThreadPoolEnqueue(benchmark::State& state) {
+	core::ThreadPool pool(state.range(0));
+	std::vector<std::future<void>> futures;
+	futures.reserve(WorkItems);
+	std::vector<float> results(WorkItems);
+	while (state.KeepRunning()) {
+		for (int i = 0; i < WorkItems; ++i) {
+			futures.emplace_back(pool.enqueue([&results, i] () {
+				results[i] = work(i);
+			}));
+		}
+		for (auto& f : futures) {
+			f.wait();
+		}
+		futures.clear();
+	}
+	state.SetItemsProcessed(state.iterations() * WorkItems);
+}
+
+static void BM_ThreadPoolTaskGroup(benchmark::State& state) {
+	core::ThreadPool pool(state.range(0));
+	std::vector<float> results(WorkItems);
+	while (state.KeepRunning()) {
+		core::TaskGroup group(pool);
+		for (int i = 0; i < WorkItems; ++i) {
+			group.run([&results, i] () {
+				results[i] = work(i);
+			});
+		}
+		group.wait();
+	}
+	state.SetItemsProcessed(state.iterations() * WorkItems);
+}
+
+static void BM_ThreadPoolParallelFor(benchmark::State& state) {
+	core::ThreadPool pool(state.range(0));
+	std::vector<float> results(WorkItems);
+	while (state.KeepRunning()) {
+		pool.parallelFor(0, WorkItems, [&results] (int start, int end) {
+			for (int i = start; i < end; ++i) {
+				results[i] = work(i);
+			}
+		});
+	}
+	state.SetItemsProcessed(state.iterations() * WorkItems);
+}
+
+static void BM_ThreadPoolNestedParallelFor(benchmark::State& state) {
+	core::ThreadPool pool(state.range(0));
+	const int outer = 64;
+	const int inner = WorkItems / outer;
+	std::vector<float> results(WorkItems);
+	while (state.KeepRunning()) {
+		pool.parallelFor(0, outer, [&] (int start, int end) {
+			for (int o = start; o < end; ++o) {
+				pool.parallelFor(0, inner, [&results, o, inner] (int innerStart, int innerEnd) {
+					for (int i = innerStart; i < innerEnd; ++i) {
+						results[o * inner + i] = work(o * inner + i);
+					}
+				});
+			}
+		}, 1);
+	}
+	state.SetItemsProcessed(state.iterations() * WorkItems);
+}
+
+BENCHMARK(BM_ThreadPoolEnqueue)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_ThreadPoolTaskGroup)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_ThreadPoolParallelFor)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_ThreadPoolNestedParallelFor)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
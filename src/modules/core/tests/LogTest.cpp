@@ -4,10 +4,35 @@
 
 #include "core/tests/AbstractTest.h"
 #include "core/Log.h"
+#include "core/Var.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 namespace core {
 
 class LogTest : public core::AbstractTest {
+protected:
+	SDL_LogOutputFunction _outputFunction = nullptr;
+	void *_outputUserData = nullptr;
+	std::atomic_int _messages { 0 };
+
+	static void countOutputFunction(void *userdata, int category, SDL_LogPriority priority, const char *message) {
+		LogTest* test = (LogTest*)userdata;
+		++test->_messages;
+	}
+
+public:
+	void SetUp() override {
+		AbstractTest::SetUp();
+		SDL_LogGetOutputFunction(&_outputFunction, &_outputUserData);
+		SDL_LogSetOutputFunction(countOutputFunction, this);
+	}
+
+	void TearDown() override {
+		SDL_LogSetOutputFunction(_outputFunction, _outputUserData);
+		AbstractTest::TearDown();
+	}
 };
 
 TEST_F(LogTest, testLogId) {
@@ -16,4 +41,31 @@ TEST_F(LogTest, testLogId) {
 	ASSERT_NE(logid1, logid2);
 }
 
+TEST_F(LogTest, testAsyncMultipleThreads) {
+	core::Var::getSafe(cfg::CoreLogAsync)->setVal(true);
+	core::Var::getSafe(cfg::CoreLogLevel)->setVal(SDL_LOG_PRIORITY_INFO);
+	Log::init();
+	Log::flush();
+	_messages = 0;
+	const uint64_t droppedBefore = Log::dropped();
+	const int threads = 4;
+	const int messagesPerThread = 1000;
+	std::vector<std::thread> producers;
+	for (int t = 0; t < threads; ++t) {
+		producers.emplace_back([t] () {
+			for (int i = 0; i < messagesPerThread; ++i) {
+				Log::info("thread %i message %i", t, i);
+			}
+			Log::debug("filtered by the log level");
+		});
+	}
+	for (std::thread& thread : producers) {
+		thread.join();
+	}
+	Log::flush();
+	// the messages of one thread fit into its buffer - nothing should get dropped
+	EXPECT_EQ(0u, Log::dropped() - droppedBefore);
+	EXPECT_EQ(threads * messagesPerThread, _messages);
+}
+
 }
@@ -4,6 +4,8 @@
 
 #include "AbstractTest.h"
 #include "core/ReadWriteLock.h"
+#include "core/RecursiveReadWriteLock.h"
+#include "core/LockProfiler.h"
 
 namespace core {
 
@@ -76,4 +78,81 @@ TEST_F(ReadWriteLockTest, testMoreWritersThanReaders) {
 	EXPECT_EQ(n1, limit);
 }
 
+TEST_F(ReadWriteLockTest, testNestedReaders) {
+	std::future<void> futureWrite;
+	{
+		core::ScopedReadLock outer(_rwLock);
+		futureWrite = std::async(std::launch::async, [=] {write(1);});
+		// a waiting writer must not block further readers
+		core::ScopedReadLock inner(_rwLock);
+		EXPECT_EQ(0, _value);
+		EXPECT_FALSE(_rwLock.tryLockWrite());
+	}
+	futureWrite.wait();
+	EXPECT_EQ(1, _value);
+}
+
+TEST_F(ReadWriteLockTest, testPerCoreReaders) {
+	core::ReadWriteLock perCoreLock("test-percore", true);
+	int n = 0;
+	auto reader = [&] () {
+		int r = 0;
+		for (int i = 0; i < limit; ++i) {
+			core::ScopedReadLock scoped(perCoreLock);
+			++r;
+		}
+		return r;
+	};
+	auto writer = [&] () {
+		for (int i = 0; i < limit; ++i) {
+			core::ScopedWriteLock scoped(perCoreLock);
+			++n;
+		}
+	};
+	auto futureRead1 = std::async(std::launch::async, reader);
+	auto futureRead2 = std::async(std::launch::async, reader);
+	auto futureWrite1 = std::async(std::launch::async, writer);
+	auto futureWrite2 = std::async(std::launch::async, writer);
+	EXPECT_EQ(limit, futureRead1.get());
+	EXPECT_EQ(limit, futureRead2.get());
+	futureWrite1.wait();
+	futureWrite2.wait();
+	EXPECT_EQ(limit * 2, n);
+}
+
+TEST_F(ReadWriteLockTest, testRecursive) {
+	core::RecursiveReadWriteLock lock("test-recursive");
+	core::RecursiveScopedWriteLock write(lock);
+	{
+		core::RecursiveScopedWriteLock nestedWrite(lock);
+		core::RecursiveScopedReadLock nestedRead(lock);
+	}
+	auto futureRead = std::async(std::launch::async, [&] () {
+		core::RecursiveScopedReadLock read(lock);
+		return _value;
+	});
+	EXPECT_EQ(std::future_status::timeout, futureRead.wait_for(std::chrono::milliseconds(10)));
+	++_value;
+	lock.unlockWrite();
+	EXPECT_EQ(1, futureRead.get());
+	lock.lockWrite();
+}
+
+TEST_F(ReadWriteLockTest, testProfiler) {
+	core::ReadWriteLock lock("test-profiler");
+	core::LockProfiler::setEnabled(true);
+	{
+		core::ScopedReadLock read(lock);
+	}
+	{
+		core::ScopedWriteLock write(lock);
+	}
+	core::LockProfiler::setEnabled(false);
+	core::ScopedReadLock read(lock);
+	const core::LockStats* stats = core::LockProfiler::stats("test-profiler");
+	EXPECT_EQ(1u, stats->readAcquisitions);
+	EXPECT_EQ(1u, stats->writeAcquisitions);
+	EXPECT_EQ(0u, stats->contended);
+}
+
 }
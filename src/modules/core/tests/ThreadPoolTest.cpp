@@ -4,6 +4,11 @@
 
 #include "AbstractTest.h"
 #include "core/ThreadPool.h"
+#include "core/Concurrency.h"
+#include "core/Log.h"
+#include <chrono>
+#include <numeric>
+#include <cmath>
 
 namespace core {
 
@@ -43,4 +48,101 @@ TEST_F(ThreadPoolTest, testMultiplePush) {
 	ASSERT_EQ(x, _count) << "Not all threads were executed";
 }
 
+TEST_F(ThreadPoolTest, testSchedule) {
+	const int x = 1000;
+	core::ThreadPool pool(2);
+	for (int i = 0; i < x; ++i) {
+		ASSERT_TRUE(pool.schedule([this] () {
+			_count++;
+		}));
+	}
+	pool.shutdown(true);
+	ASSERT_EQ(x, _count) << "Not all tasks were executed";
+	ASSERT_FALSE(pool.schedule([this] () {
+		_count++;
+	})) << "Scheduling should fail after the shutdown";
+}
+
+TEST_F(ThreadPoolTest, testInlineTaskStorage) {
+	struct Big {
+		char buf[core::Task::InlineSize * 2];
+		void operator()() {}
+	};
+	auto small = [this] () {
+		_count++;
+	};
+	EXPECT_TRUE(core::Task::isInline<decltype(small)>());
+	EXPECT_FALSE(core::Task::isInline<Big>());
+	core::ThreadPool pool(1);
+	core::TaskGroup group(pool);
+	Big big;
+	group.run([this, big] () mutable {
+		big();
+		_count++;
+	});
+	group.run(small);
+	group.wait();
+	EXPECT_EQ(2, _count);
+}
+
+TEST_F(ThreadPoolTest, testTaskGroupNested) {
+	core::ThreadPool pool(2);
+	core::TaskGroup outer(pool);
+	for (int i = 0; i < 16; ++i) {
+		outer.run([this, &pool] () {
+			// waiting inside of a task must not dead lock the pool
+			core::TaskGroup inner(pool);
+			for (int j = 0; j < 16; ++j) {
+				inner.run([this] () {
+					_count++;
+				});
+			}
+			inner.wait();
+		});
+	}
+	outer.wait();
+	EXPECT_EQ(16 * 16, _count);
+}
+
+TEST_F(ThreadPoolTest, testParallelFor) {
+	core::ThreadPool pool(3);
+	std::vector<int> values(10007, 0);
+	pool.parallelFor(0, (int)values.size(), [&] (int start, int end) {
+		for (int i = start; i < end; ++i) {
+			values[i] += i;
+		}
+	});
+	for (int i = 0; i < (int)values.size(); ++i) {
+		ASSERT_EQ(i, values[i]) << "Index " << i << " was not visited exactly once";
+	}
+	pool.parallelFor(5, 5, [this] (int, int) {
+		_count++;
+	});
+	EXPECT_EQ(0, _count);
+}
+
+TEST_F(ThreadPoolTest, testParallelForScaling) {
+	const int n = 1 << 20;
+	std::vector<double> values(n);
+	double reference = 0.0;
+	const uint32_t maxThreads = core::cpus();
+	for (uint32_t threads = 1u; threads <= maxThreads; threads *= 2u) {
+		core::ThreadPool pool(threads);
+		const auto start = std::chrono::steady_clock::now();
+		pool.parallelFor(0, n, [&] (int s, int e) {
+			for (int i = s; i < e; ++i) {
+				values[i] = std::sqrt((double)i);
+			}
+		});
+		const auto end = std::chrono::steady_clock::now();
+		const double millis = std::chrono::duration<double, std::milli>(end - start).count();
+		Log::info("parallelFor with %u threads: %f ms", threads, millis);
+		const double sum = std::accumulate(values.begin(), values.end(), 0.0);
+		if (threads == 1u) {
+			reference = sum;
+		}
+		EXPECT_DOUBLE_EQ(reference, sum);
+	}
+}
+
 }
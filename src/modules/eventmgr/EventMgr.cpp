@@ -19,44 +19,76 @@ bool EventMgr::init() {
 		return false;
 	}
 
+	const uint64_t currentMillis = _timeProvider->tickMillis();
+	for (const auto& entry : _eventProvider->eventData()) {
+		scheduleEvent(entry.second, currentMillis);
+	}
 	return true;
 }
 
-void EventMgr::update(long dt) {
-	const auto currentMillis = _timeProvider->tickMillis();
-	const EventProvider::EventData& eventData = _eventProvider->eventData();
-	for (const auto& entry : eventData) {
-		const db::EventModelPtr& data = entry.second;
-		const auto i = _events.find(data->id());
-		const persistence::Timestamp& endTime = data->enddate();
-		if (endTime.millis() < currentMillis) {
+void EventMgr::scheduleEvent(const db::EventModelPtr& model, uint64_t currentMillis) {
+	const uint64_t endMillis = model->enddate().millis();
+	if (endMillis <= currentMillis) {
+		_timeline.remove((EventId)model->id());
+		return;
+	}
+	_timeline.schedule((EventId)model->id(), model->startdate().millis(), endMillis);
+}
+
+void EventMgr::applyChanges(uint64_t currentMillis) {
+	_eventProvider->update();
+	if (!_eventProvider->consumeChanges(_changed)) {
+		return;
+	}
+	for (EventId id : _changed) {
+		const db::EventModelPtr& model = _eventProvider->get(id);
+		if (!model) {
+			_timeline.remove(id);
+			stopEvent(id);
 			continue;
 		}
-		if (i == _events.end()) {
-			const persistence::Timestamp& startTime = data->startdate();
-			const auto eventStartMillis = startTime.millis();
-			const long delta = eventStartMillis - currentMillis;
-			if (delta <= 0) {
-				startEvent(data);
-			}
-			continue;
+		scheduleEvent(model, currentMillis);
+		// the running event was moved out of the current time
+		const bool active = model->startdate().millis() <= currentMillis && currentMillis < model->enddate().millis();
+		if (!active) {
+			stopEvent(id);
 		}
+	}
+	_changed.clear();
+}
 
-		const auto eventEndMillis = endTime.millis();
-		if (eventEndMillis <= currentMillis) {
-			const EventPtr& event = i->second;
-			Log::info("Stop event of type %i", (int)data->id());
-			event->stop();
-			_events.erase(i);
-			continue;
+void EventMgr::update(long dt) {
+	const uint64_t currentMillis = _timeProvider->tickMillis();
+	applyChanges(currentMillis);
+	_timeline.update(currentMillis, [this] (const EventTimeline::Transition& transition) {
+		if (transition.type == EventTimeline::TransitionType::Stop) {
+			stopEvent(transition.id);
+			return;
 		}
-	}
+		if (_events.find(transition.id) != _events.end()) {
+			return;
+		}
+		const db::EventModelPtr& model = _eventProvider->get(transition.id);
+		if (model) {
+			startEvent(model);
+		}
+	});
 	for (auto i = _events.begin(); i != _events.end(); ++i)  {
-		Log::info("Tick event %i", (int)i->first);
+		Log::trace("Tick event %i", (int)i->first);
 		i->second->update(dt);
 	}
 }
 
+void EventMgr::stopEvent(EventId id) {
+	auto i = _events.find(id);
+	if (i == _events.end()) {
+		return;
+	}
+	Log::info("Stop event of type %i", (int)id);
+	i->second->stop();
+	_events.erase(i);
+}
+
 EventPtr EventMgr::runningEvent(EventId id) const {
 	auto i = _events.find(id);
 	if (i == _events.end()) {
@@ -70,6 +102,7 @@ void EventMgr::shutdown() {
 		e.second->shutdown();
 	}
 	_events.clear();
+	_timeline.clear();
 	_eventProvider->shutdown();
 }
 
@@ -6,6 +6,7 @@
 #include "Event.h"
 #include "EventProvider.h"
 #include "EventType.h"
+#include "EventTimeline.h"
 #include "persistence/DBHandler.h"
 #include "core/TimeProvider.h"
 #include <memory>
@@ -25,6 +26,8 @@ class EventMgr {
 private:
 	std::unordered_map<Type, EventConfigurationData> _eventData;
 	std::unordered_map<EventId, EventPtr> _events;
+	EventTimeline _timeline;
+	EventProvider::ChangedEvents _changed;
 
 	EventProviderPtr _eventProvider;
 	core::TimeProviderPtr _timeProvider;
@@ -32,6 +35,15 @@ private:
 	EventPtr createEvent(Type eventType, EventId id) const;
 
 	bool startEvent(const db::EventModelPtr& model);
+	void stopEvent(EventId id);
+	/**
+	 * @brief Puts the start and stop time of the event into the timeline - unless the event already ended
+	 */
+	void scheduleEvent(const db::EventModelPtr& model, uint64_t currentMillis);
+	/**
+	 * @brief Reschedules the events whose database rows were changed
+	 */
+	void applyChanges(uint64_t currentMillis);
 public:
 	EventMgr(const EventProviderPtr& eventProvider, const core::TimeProviderPtr& timeProvider);
 
@@ -39,6 +51,8 @@ public:
 	/**
 	 * @brief Call this in your main loop
 	 * Starts all events that are configured to run at the current time of the @c core::TimeProvider
+	 * and stops the events whose end time is reached. Only the due start and stop times of the
+	 * @c EventTimeline are looked at - not all configured events.
 	 */
 	void update(long dt);
 	/**
@@ -55,12 +69,20 @@ public:
 	 * @return The amount of currently active/running events
 	 */
 	int runningEvents() const;
+	/**
+	 * @return The amount of events that are waiting for their start or stop time
+	 */
+	int scheduledEvents() const;
 };
 
 inline int EventMgr::runningEvents() const {
 	return (int)_events.size();
 }
 
+inline int EventMgr::scheduledEvents() const {
+	return (int)_timeline.size();
+}
+
 typedef std::shared_ptr<EventMgr> EventMgrPtr;
 
 /**
@@ -31,8 +31,77 @@ bool EventProvider::init() {
 	});
 }
 
+// the channel that gets the id of every inserted, updated or deleted event row
+static const char *NotifyChannel = "event_changed";
+
+bool EventProvider::listen() {
+	const db::EventModel model;
+	const std::string& table = core::string::format("\"%s\".\"%s\"", model.schema(), model.tableName());
+	const std::string& function = core::string::format("\"%s\".\"%s_notify\"", model.schema(), model.tableName());
+	const std::string& createFunction = core::string::format("CREATE OR REPLACE FUNCTION %s() RETURNS trigger AS $$ BEGIN "
+			"IF TG_OP = 'DELETE' THEN PERFORM pg_notify('%s', OLD.id::text); RETURN OLD; END IF; "
+			"PERFORM pg_notify('%s', NEW.id::text); RETURN NEW; END; $$ LANGUAGE plpgsql;",
+			function.c_str(), NotifyChannel, NotifyChannel);
+	if (!_dbHandler->exec(createFunction)) {
+		Log::error("Failed to create the event notification function");
+		return false;
+	}
+	const std::string& createTrigger = core::string::format("DROP TRIGGER IF EXISTS \"%s_notify\" ON %s; "
+			"CREATE TRIGGER \"%s_notify\" AFTER INSERT OR UPDATE OR DELETE ON %s FOR EACH ROW EXECUTE PROCEDURE %s();",
+			model.tableName(), table.c_str(), model.tableName(), table.c_str(), function.c_str());
+	if (!_dbHandler->exec(createTrigger)) {
+		Log::error("Failed to create the event notification trigger");
+		return false;
+	}
+	if (!_dbHandler->listen(NotifyChannel)) {
+		Log::error("Failed to listen to the event notifications");
+		return false;
+	}
+	_listen = true;
+	return true;
+}
+
+void EventProvider::update() {
+	if (!_listen) {
+		return;
+	}
+	_dbHandler->notifications([this] (const char* channel, const char* payload) {
+		const EventId id = (EventId)core::string::toInt(payload);
+		refresh(id);
+	});
+}
+
+bool EventProvider::refresh(EventId id) {
+	db::EventModelPtr modelPtr;
+	const bool success = _dbHandler->select(db::EventModel(), db::DBConditionEventModelId(id), [&] (db::EventModel&& model) {
+		modelPtr = std::make_shared<db::EventModel>(std::forward<db::EventModel>(model));
+	});
+	if (!success) {
+		Log::warn("Failed to reload the event %i", (int)id);
+		return false;
+	}
+	if (modelPtr) {
+		_eventData[id] = modelPtr;
+	} else {
+		_eventData.erase(id);
+	}
+	_changed.push_back(id);
+	return true;
+}
+
+bool EventProvider::consumeChanges(ChangedEvents& changed) {
+	if (_changed.empty()) {
+		return false;
+	}
+	changed.swap(_changed);
+	_changed.clear();
+	return true;
+}
+
 void EventProvider::shutdown() {
 	_eventData.clear();
+	_changed.clear();
+	_listen = false;
 }
 
 db::EventModelPtr EventProvider::get(EventId id) const {
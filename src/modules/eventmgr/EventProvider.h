@@ -11,6 +11,7 @@
 #include "persistence/DBHandler.h"
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace eventmgr {
 
@@ -21,9 +22,12 @@ namespace eventmgr {
 class EventProvider {
 public:
 	typedef std::unordered_map<EventId, db::EventModelPtr> EventData;
+	typedef std::vector<EventId> ChangedEvents;
 private:
 	persistence::DBHandlerPtr _dbHandler;
 	EventData _eventData;
+	ChangedEvents _changed;
+	bool _listen = false;
 public:
 	EventProvider(const persistence::DBHandlerPtr& dbHandler);
 
@@ -32,6 +36,26 @@ public:
 	bool init();
 	void shutdown();
 
+	/**
+	 * @brief Installs a trigger that notifies about every change of the event table and subscribes to it.
+	 * @note Call this after @c init() - the changed rows are reloaded in @c update()
+	 */
+	bool listen();
+	/**
+	 * @brief Reloads the changed event rows if @c listen() was called
+	 */
+	void update();
+	/**
+	 * @brief Reloads a single event row from the database - or removes the event if the row doesn't exist anymore
+	 * @return @c false if the event couldn't get loaded
+	 */
+	bool refresh(EventId id);
+	/**
+	 * @brief Hands over the ids of the events that were changed by @c refresh() since the last call
+	 * @return @c false if there were no changes
+	 */
+	bool consumeChanges(ChangedEvents& changed);
+
 	db::EventModelPtr get(EventId id) const;
 };
 
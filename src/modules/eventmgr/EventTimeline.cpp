@@ -0,0 +1,46 @@
+/**
+ * @file
+ */
+
+#include "EventTimeline.h"
+
+namespace eventmgr {
+
+void EventTimeline::push(const Transition& transition) {
+	_heap.push_back(transition);
+	std::push_heap(_heap.begin(), _heap.end(), Later());
+}
+
+void EventTimeline::compact() {
+	// every scheduled event has at most two transitions in the heap
+	if (_heap.size() <= 4u * _schedules.size() + 64u) {
+		return;
+	}
+	_heap.erase(std::remove_if(_heap.begin(), _heap.end(), [this] (const Transition& transition) {
+		auto i = _schedules.find(transition.id);
+		return i == _schedules.end() || i->second.generation != transition.generation;
+	}), _heap.end());
+	std::make_heap(_heap.begin(), _heap.end(), Later());
+}
+
+void EventTimeline::schedule(EventId id, uint64_t startMillis, uint64_t endMillis) {
+	const uint32_t generation = ++_generation;
+	_schedules[id] = Schedule{startMillis, endMillis, generation};
+	push(Transition{startMillis, id, TransitionType::Start, generation});
+	push(Transition{endMillis, id, TransitionType::Stop, generation});
+	compact();
+}
+
+void EventTimeline::remove(EventId id) {
+	if (_schedules.erase(id) == 0) {
+		return;
+	}
+	compact();
+}
+
+void EventTimeline::clear() {
+	_heap.clear();
+	_schedules.clear();
+}
+
+}
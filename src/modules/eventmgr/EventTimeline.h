@@ -0,0 +1,138 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "EventId.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <stdint.h>
+
+namespace eventmgr {
+
+/**
+ * @brief The pending start and stop transitions of the scheduled events ordered by their time
+ *
+ * The transitions are stored in a min-heap - checking for due transitions only looks at the top of
+ * the heap, no matter how many events are scheduled. Rescheduling or removing an event doesn't touch
+ * the heap, the outdated transitions are skipped once they are due.
+ *
+ * @ingroup Events
+ */
+class EventTimeline {
+public:
+	enum class TransitionType : uint8_t {
+		Stop, Start
+	};
+
+	struct Transition {
+		uint64_t millis;
+		EventId id;
+		TransitionType type;
+		uint32_t generation;
+	};
+
+private:
+	struct Schedule {
+		uint64_t startMillis;
+		uint64_t endMillis;
+		uint32_t generation;
+	};
+
+	/**
+	 * @brief Orders the heap by time - stop transitions come first if they are due at the same time
+	 */
+	struct Later {
+		inline bool operator()(const Transition& a, const Transition& b) const {
+			if (a.millis != b.millis) {
+				return a.millis > b.millis;
+			}
+			return a.type > b.type;
+		}
+	};
+
+	std::vector<Transition> _heap;
+	std::unordered_map<EventId, Schedule> _schedules;
+	uint32_t _generation = 0u;
+
+	void push(const Transition& transition);
+	/**
+	 * @brief Removes the outdated transitions from the heap if they are dominating it
+	 */
+	void compact();
+
+public:
+	/**
+	 * @brief Adds the start and stop transition of the event - or replaces them if the event is already scheduled
+	 */
+	void schedule(EventId id, uint64_t startMillis, uint64_t endMillis);
+	void remove(EventId id);
+	void clear();
+
+	/**
+	 * @brief Hands all transitions that are due at the given time over to the given functor
+	 *
+	 * The start transition of an event that already ended at the given time is skipped. Once the stop
+	 * transition was handed over, the event is no longer scheduled.
+	 *
+	 * @param[in] func Gets the @c Transition
+	 * @return The amount of transitions that were handed over
+	 */
+	template<class FUNC>
+	int update(uint64_t nowMillis, FUNC&& func);
+
+	/**
+	 * @return The time of the next transition, or the max value if there is none
+	 * @note This might be the time of an outdated transition - so it's a lower bound
+	 */
+	uint64_t nextMillis() const;
+
+	/**
+	 * @return The amount of scheduled events
+	 */
+	size_t size() const;
+
+	bool scheduled(EventId id) const;
+};
+
+inline uint64_t EventTimeline::nextMillis() const {
+	if (_heap.empty()) {
+		return std::numeric_limits<uint64_t>::max();
+	}
+	return _heap.front().millis;
+}
+
+inline size_t EventTimeline::size() const {
+	return _schedules.size();
+}
+
+inline bool EventTimeline::scheduled(EventId id) const {
+	return _schedules.find(id) != _schedules.end();
+}
+
+template<class FUNC>
+int EventTimeline::update(uint64_t nowMillis, FUNC&& func) {
+	int amount = 0;
+	while (!_heap.empty() && _heap.front().millis <= nowMillis) {
+		std::pop_heap(_heap.begin(), _heap.end(), Later());
+		const Transition transition = _heap.back();
+		_heap.pop_back();
+		auto i = _schedules.find(transition.id);
+		if (i == _schedules.end() || i->second.generation != transition.generation) {
+			continue;
+		}
+		if (transition.type == TransitionType::Stop) {
+			_schedules.erase(i);
+		} else if (i->second.endMillis <= nowMillis) {
+			continue;
+		}
+		func(transition);
+		++amount;
+	}
+	return amount;
+}
+
+}
@@ -0,0 +1,114 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "eventmgr/EventTimeline.h"
+#include "eventmgr/EventProvider.h"
+#include "EventMgrModels.h"
+#include "math/Random.h"
+#include <unordered_set>
+
+namespace {
+
+const int Events = 100000;
+// the start times are spread over roughly a month
+const uint64_t PeriodSeconds = 30u * 24u * 60u * 60u;
+const uint64_t DurationSeconds = 60u * 60u;
+const uint64_t TickMillis = 100u;
+
+eventmgr::EventProvider::EventData createEvents() {
+	eventmgr::EventProvider::EventData eventData;
+	math::Random random(1);
+	for (int i = 1; i <= Events; ++i) {
+		const eventmgr::db::EventModelPtr& model = std::make_shared<eventmgr::db::EventModel>();
+		const uint64_t start = random.random(0, (int)PeriodSeconds);
+		model->setId(i);
+		model->setType(1);
+		model->setStartdate(start);
+		model->setEnddate(start + DurationSeconds);
+		eventData.insert(std::make_pair((eventmgr::EventId)i, model));
+	}
+	return eventData;
+}
+
+}
+
+/**
+ * @brief The start and stop check of the event manager before the timeline was introduced - every
+ * event is looked at in every tick
+ */
+static void BM_EventsFullScan(benchmark::State& state) {
+	const eventmgr::EventProvider::EventData& eventData = createEvents();
+	std::unordered_set<eventmgr::EventId> running;
+	uint64_t currentMillis = PeriodSeconds * 1000u / 2u;
+	while (state.KeepRunning()) {
+		currentMillis += TickMillis;
+		for (const auto& entry : eventData) {
+			const eventmgr::db::EventModelPtr& data = entry.second;
+			const eventmgr::EventId id = (eventmgr::EventId)data->id();
+			const bool isRunning = running.find(id) != running.end();
+			if (data->enddate().millis() <= currentMillis) {
+				if (isRunning) {
+					running.erase(id);
+				}
+				continue;
+			}
+			if (!isRunning && data->startdate().millis() <= currentMillis) {
+				running.insert(id);
+			}
+		}
+	}
+	state.counters["running"] = (double)running.size();
+}
+
+static void BM_EventsTimeline(benchmark::State& state) {
+	const eventmgr::EventProvider::EventData& eventData = createEvents();
+	std::unordered_set<eventmgr::EventId> running;
+	uint64_t currentMillis = PeriodSeconds * 1000u / 2u;
+	eventmgr::EventTimeline timeline;
+	for (const auto& entry : eventData) {
+		const eventmgr::db::EventModelPtr& data = entry.second;
+		if (data->enddate().millis() > currentMillis) {
+			timeline.schedule(entry.first, data->startdate().millis(), data->enddate().millis());
+		}
+	}
+	while (state.KeepRunning()) {
+		currentMillis += TickMillis;
+		timeline.update(currentMillis, [&] (const eventmgr::EventTimeline::Transition& transition) {
+			if (transition.type == eventmgr::EventTimeline::TransitionType::Start) {
+				running.insert(transition.id);
+			} else {
+				running.erase(transition.id);
+			}
+		});
+	}
+	state.counters["running"] = (double)running.size();
+}
+
+/**
+ * @brief Changes the start time of one event per tick
+ */
+static void BM_EventsTimelineReschedule(benchmark::State& state) {
+	const eventmgr::EventProvider::EventData& eventData = createEvents();
+	uint64_t currentMillis = PeriodSeconds * 1000u / 2u;
+	eventmgr::EventTimeline timeline;
+	for (const auto& entry : eventData) {
+		const eventmgr::db::EventModelPtr& data = entry.second;
+		timeline.schedule(entry.first, data->startdate().millis(), data->enddate().millis());
+	}
+	int id = 1;
+	while (state.KeepRunning()) {
+		currentMillis += TickMillis;
+		const uint64_t start = currentMillis + (uint64_t)id * 1000u;
+		timeline.schedule(id, start, start + DurationSeconds * 1000u);
+		id = id % Events + 1;
+		timeline.update(currentMillis, [] (const eventmgr::EventTimeline::Transition& transition) {
+			benchmark::DoNotOptimize(transition);
+		});
+	}
+}
+
+BENCHMARK(BM_EventsFullScan);
+BENCHMARK(BM_EventsTimeline);
+BENCHMARK(BM_EventsTimelineReschedule);
@@ -181,4 +181,38 @@ TEST_F(EventMgrTest, testEventMgrUpdateStartStop) {
 	mgr.shutdown();
 }
 
+TEST_F(EventMgrTest, testEventMgrRefresh) {
+	if (!_supported) {
+		return;
+	}
+	const core::TimeProviderPtr& timeProvider = _testApp->timeProvider();
+	timeProvider->update(1000UL);
+	const uint64_t nowSeconds = timeProvider->tickMillis() / 1000UL;
+
+	db::EventModel model;
+	createEvent(Type::GENERIC, model, nowSeconds + 100, nowSeconds + 200);
+
+	EventMgr mgr(_eventProvider, timeProvider);
+	ASSERT_TRUE(mgr.init()) << "Could not initialize eventmgr";
+	ASSERT_EQ(1, mgr.scheduledEvents());
+	mgr.update(0L);
+	ASSERT_EQ(0, mgr.runningEvents());
+
+	// move the start of the event to now
+	model.setStartdate(nowSeconds);
+	ASSERT_TRUE(_dbHandler->update(model, db::DBConditionEventModelId(model.id())));
+	ASSERT_TRUE(_eventProvider->refresh(model.id()));
+	mgr.update(0L);
+	ASSERT_EQ(1, mgr.runningEvents()) << "The changed start time should have been picked up";
+
+	// remove the event
+	ASSERT_TRUE(_dbHandler->deleteModel(db::EventModel(), db::DBConditionEventModelId(model.id())));
+	ASSERT_TRUE(_eventProvider->refresh(model.id()));
+	mgr.update(0L);
+	ASSERT_EQ(0, mgr.runningEvents()) << "The removed event should have been stopped";
+	ASSERT_EQ(0, mgr.scheduledEvents());
+
+	mgr.shutdown();
+}
+
 }
@@ -0,0 +1,91 @@
+/**
+ * @file
+ */
+
+#include "core/tests/AbstractTest.h"
+#include "eventmgr/EventTimeline.h"
+#include <vector>
+
+namespace eventmgr {
+
+class EventTimelineTest : public core::AbstractTest {
+protected:
+	EventTimeline _timeline;
+	std::vector<EventTimeline::Transition> _transitions;
+
+	int update(uint64_t nowMillis) {
+		_transitions.clear();
+		return _timeline.update(nowMillis, [this] (const EventTimeline::Transition& transition) {
+			_transitions.push_back(transition);
+		});
+	}
+};
+
+TEST_F(EventTimelineTest, testStartStop) {
+	_timeline.schedule(1, 1000u, 2000u);
+	EXPECT_EQ(1000u, _timeline.nextMillis());
+	EXPECT_EQ(0, update(999u));
+	ASSERT_EQ(1, update(1000u));
+	EXPECT_EQ(1, _transitions[0].id);
+	EXPECT_EQ(EventTimeline::TransitionType::Start, _transitions[0].type);
+	EXPECT_EQ(0, update(1999u));
+	ASSERT_EQ(1, update(2000u));
+	EXPECT_EQ(EventTimeline::TransitionType::Stop, _transitions[0].type);
+	EXPECT_EQ(0u, _timeline.size());
+	EXPECT_EQ(0, update(5000u));
+}
+
+TEST_F(EventTimelineTest, testOrder) {
+	_timeline.schedule(1, 3000u, 4000u);
+	_timeline.schedule(2, 1000u, 2000u);
+	_timeline.schedule(3, 2000u, 5000u);
+	ASSERT_EQ(1, update(1000u));
+	EXPECT_EQ(2, _transitions[0].id);
+	ASSERT_EQ(3, update(3000u));
+	EXPECT_EQ(2, _transitions[0].id);
+	EXPECT_EQ(EventTimeline::TransitionType::Stop, _transitions[0].type) << "Stop transitions come first";
+	EXPECT_EQ(3, _transitions[1].id);
+	EXPECT_EQ(EventTimeline::TransitionType::Start, _transitions[1].type);
+	EXPECT_EQ(1, _transitions[2].id);
+	EXPECT_EQ(2u, _timeline.size());
+}
+
+TEST_F(EventTimelineTest, testSkipStartOfEndedEvent) {
+	_timeline.schedule(1, 1000u, 2000u);
+	ASSERT_EQ(1, update(3000u)) << "Only the stop transition should be handed over";
+	EXPECT_EQ(EventTimeline::TransitionType::Stop, _transitions[0].type);
+}
+
+TEST_F(EventTimelineTest, testReschedule) {
+	_timeline.schedule(1, 1000u, 2000u);
+	_timeline.schedule(1, 5000u, 6000u);
+	EXPECT_EQ(1u, _timeline.size());
+	EXPECT_EQ(0, update(4000u)) << "The transitions of the first schedule are outdated";
+	ASSERT_EQ(1, update(5000u));
+	EXPECT_EQ(EventTimeline::TransitionType::Start, _transitions[0].type);
+}
+
+TEST_F(EventTimelineTest, testRemove) {
+	_timeline.schedule(1, 1000u, 2000u);
+	_timeline.schedule(2, 1000u, 2000u);
+	_timeline.remove(1);
+	EXPECT_FALSE(_timeline.scheduled(1));
+	ASSERT_EQ(1, update(1000u));
+	EXPECT_EQ(2, _transitions[0].id);
+	ASSERT_EQ(1, update(2000u));
+	EXPECT_EQ(2, _transitions[0].id);
+}
+
+TEST_F(EventTimelineTest, testManyReschedules) {
+	for (int i = 0; i < 10000; ++i) {
+		_timeline.schedule(1, 1000u + i, 2000u + i);
+	}
+	EXPECT_EQ(1u, _timeline.size());
+	EXPECT_EQ(0, update(10998u)) << "The transitions of the previous schedules are outdated";
+	ASSERT_EQ(1, update(10999u));
+	EXPECT_EQ(EventTimeline::TransitionType::Start, _transitions[0].type);
+	ASSERT_EQ(1, update(20000u));
+	EXPECT_EQ(EventTimeline::TransitionType::Stop, _transitions[0].type);
+}
+
+}
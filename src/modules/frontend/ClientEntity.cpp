@@ -7,21 +7,20 @@
 namespace frontend {
 
 ClientEntity::ClientEntity(ClientEntityId id, network::EntityType type, const glm::vec3& pos, float orientation, const video::MeshPtr& mesh) :
-		_id(id), _type(type), _orientation(orientation), _mesh(mesh) {
-	_posLerp.setStartPosition(pos);
+		_id(id), _type(type), _mesh(mesh) {
+	_interpolation.setStartPosition(pos, orientation);
 }
 
 ClientEntity::~ClientEntity() {
 	_mesh->shutdown();
 }
 
-void ClientEntity::lerpPosition(const glm::vec3& position, float orientation) {
-	_posLerp.setTargetPosition(position);
-	_orientation = orientation;
+void ClientEntity::addSnapshot(uint64_t serverMillis, const glm::vec3& position, float orientation) {
+	_interpolation.addSnapshot(serverMillis, position, orientation);
 }
 
 void ClientEntity::update(long dt) {
-	_posLerp.update(dt);
+	_interpolation.update(dt);
 	_attrib.update(dt);
 }
 
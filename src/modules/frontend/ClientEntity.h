@@ -7,7 +7,7 @@
 #include "ServerMessages_generated.h"
 #include "Shared_generated.h"
 #include "ClientEntityId.h"
-#include "util/PosLerp.h"
+#include "util/SnapshotInterpolation.h"
 #include "attrib/ShadowAttributes.h"
 #include <vector>
 #include <functional>
@@ -21,10 +21,9 @@ namespace frontend {
  */
 class ClientEntity {
 private:
-	util::PosLerp _posLerp;
+	util::SnapshotInterpolation _interpolation;
 	ClientEntityId _id;
 	network::EntityType _type;
-	float _orientation;
 	video::MeshPtr _mesh;
 	attrib::ShadowAttributes _attrib;
 public:
@@ -33,7 +32,12 @@ public:
 
 	void update(long dt);
 
-	void lerpPosition(const glm::vec3& position, float orientation);
+	/**
+	 * @brief Adds the state of the entity at the given server time - the rendered position and orientation
+	 * is interpolated between these snapshots
+	 */
+	void addSnapshot(uint64_t serverMillis, const glm::vec3& position, float orientation);
+	util::SnapshotInterpolation& interpolation();
 	const glm::vec3& position() const;
 	float orientation() const;
 	float scale() const;
@@ -61,11 +65,15 @@ inline ClientEntityId ClientEntity::id() const {
 }
 
 inline float ClientEntity::orientation() const {
-	return _orientation;
+	return _interpolation.orientation();
 }
 
 inline const glm::vec3& ClientEntity::position() const {
-	return _posLerp.position();
+	return _interpolation.position();
+}
+
+inline util::SnapshotInterpolation& ClientEntity::interpolation() {
+	return _interpolation;
 }
 
 inline float ClientEntity::scale() const {
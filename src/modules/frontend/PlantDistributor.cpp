@@ -13,7 +13,7 @@ void distributePlants(const voxel::WorldPtr& world, const glm::ivec3& pos, std::
 	const voxel::Region region(pos.x, 0, pos.z, pos.x + size.x - 1, voxel::MAX_TERRAIN_HEIGHT, pos.z + size.z - 1);
 	biomeMgr.getPlantPositions(region, positions, random, 5);
 	for (const glm::vec2& p : positions) {
-		const int y = world->findFloor(p.x, p.y, voxel::isFloor);
+		const int y = world->findFloor(p.x, p.y);
 		if (y == voxel::NO_FLOOR_FOUND || y < voxel::MAX_WATER_HEIGHT) {
 			continue;
 		}
@@ -27,8 +27,8 @@ bool ClientNetwork::packetReceived(ENetEvent& event) {
 	}
 	const ServerMessage *req = GetServerMessage(event.packet->data);
 	ServerMsgType type = req->data_type();
-	ProtocolHandlerPtr handler = _protocolHandlerRegistry->getHandler(EnumNameServerMsgType(type));
-	if (!handler) {
+	IProtocolHandler* handler = _protocolHandlerRegistry->getHandler(type);
+	if (handler == nullptr) {
 		Log::error("No handler for server msg type %s", EnumNameServerMsgType(type));
 		return false;
 	}
@@ -22,6 +22,20 @@ public:
 
 	bool isConnected() const;
 
+	/**
+	 * @return The peer of the server connection or @c nullptr if not connected
+	 */
+	ENetPeer* peer() const;
+
+	/**
+	 * @return The amount of bytes (after compression) that were sent via the current connection
+	 */
+	uint32_t sentBytes() const;
+	/**
+	 * @return The amount of bytes (after compression) that were received via the current connection
+	 */
+	uint32_t receivedBytes() const;
+
 	inline bool sendMessage(ENetPacket* packet, int channel = 0) {
 		return Super::sendMessage(_peer, packet, channel);
 	}
@@ -30,6 +44,27 @@ public:
 	void shutdown() override;
 };
 
+inline ENetPeer* ClientNetwork::peer() const {
+	if (_client == nullptr) {
+		return nullptr;
+	}
+	return _peer;
+}
+
+inline uint32_t ClientNetwork::sentBytes() const {
+	if (_client == nullptr) {
+		return 0u;
+	}
+	return _client->totalSentData;
+}
+
+inline uint32_t ClientNetwork::receivedBytes() const {
+	if (_client == nullptr) {
+		return 0u;
+	}
+	return _client->totalReceivedData;
+}
+
 typedef std::shared_ptr<ClientNetwork> ClientNetworkPtr;
 
 }
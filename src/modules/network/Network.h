@@ -49,7 +49,7 @@ public:
 
 	const ProtocolHandlerRegistryPtr& registry();
 
-	bool sendMessage(ENetPeer* peer, ENetPacket* packet, int channel = 0);
+	virtual bool sendMessage(ENetPeer* peer, ENetPacket* packet, int channel = 0);
 };
 
 inline bool Network::sendMessage(ENetPeer* peer, ENetPacket* packet, int channel) {
@@ -0,0 +1,181 @@
+/**
+ * @file
+ */
+
+#include "PacketCapture.h"
+#include "core/Log.h"
+#include <SDL_endian.h>
+#include <chrono>
+#include <algorithm>
+#include <string.h>
+
+namespace network {
+
+namespace {
+
+const uint8_t Magic[4] = { 'E', 'C', 'A', 'P' };
+const uint32_t Version = 1u;
+const size_t ChunkSize = 64u * 1024u;
+
+inline uint64_t nowMicros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template<class Type>
+inline void append(std::vector<uint8_t>& buffer, Type val) {
+	for (size_t i = 0; i < sizeof(Type); ++i) {
+		buffer.push_back(uint8_t(val >> (i * 8)));
+	}
+}
+
+}
+
+PacketCaptureWriter::~PacketCaptureWriter() {
+	close();
+}
+
+bool PacketCaptureWriter::open(const std::string& file) {
+	close();
+	_rwops = SDL_RWFromFile(file.c_str(), "wb");
+	if (_rwops == nullptr) {
+		Log::error("Could not open capture file %s: %s", file.c_str(), SDL_GetError());
+		return false;
+	}
+	_buffer.reserve(ChunkSize + 1024u);
+	_buffer.insert(_buffer.end(), Magic, Magic + sizeof(Magic));
+	append(_buffer, Version);
+	_startMicros = nowMicros();
+	_packets = 0u;
+	Log::info("Capture inbound network traffic into %s", file.c_str());
+	return true;
+}
+
+void PacketCaptureWriter::flush() {
+	if (_buffer.empty()) {
+		return;
+	}
+	if (SDL_RWwrite(_rwops, _buffer.data(), 1, _buffer.size()) != _buffer.size()) {
+		Log::error("Failed to write the capture: %s", SDL_GetError());
+	}
+	_buffer.clear();
+}
+
+void PacketCaptureWriter::close() {
+	if (_rwops == nullptr) {
+		return;
+	}
+	flush();
+	SDL_RWclose(_rwops);
+	_rwops = nullptr;
+	Log::info("Captured %u network events", _packets);
+}
+
+void PacketCaptureWriter::write(const ENetPeer* peer, ENetEventType type, uint32_t data, const ENetPacket* packet) {
+	if (_rwops == nullptr) {
+		return;
+	}
+	const uint32_t length = packet != nullptr ? (uint32_t)packet->dataLength : 0u;
+	append(_buffer, nowMicros() - _startMicros);
+	append(_buffer, (uint32_t)peer->connectID);
+	append(_buffer, (uint32_t)peer->address.host);
+	append(_buffer, (uint8_t)type);
+	append(_buffer, data);
+	append(_buffer, length);
+	if (length > 0u) {
+		_buffer.insert(_buffer.end(), packet->data, packet->data + length);
+	}
+	++_packets;
+	if (_buffer.size() >= ChunkSize) {
+		flush();
+	}
+}
+
+PacketCaptureReader::~PacketCaptureReader() {
+	close();
+}
+
+bool PacketCaptureReader::open(const std::string& file) {
+	close();
+	_rwops = SDL_RWFromFile(file.c_str(), "rb");
+	if (_rwops == nullptr) {
+		Log::error("Could not open capture file %s: %s", file.c_str(), SDL_GetError());
+		return false;
+	}
+	uint8_t magic[sizeof(Magic)];
+	uint32_t version;
+	if (!read(magic, sizeof(magic)) || memcmp(magic, Magic, sizeof(Magic)) != 0 || !read(&version, sizeof(version))) {
+		Log::error("%s is no capture file", file.c_str());
+		close();
+		return false;
+	}
+	version = SDL_SwapLE32(version);
+	if (version != Version) {
+		Log::error("Unsupported capture version %u", version);
+		close();
+		return false;
+	}
+	return true;
+}
+
+void PacketCaptureReader::close() {
+	if (_rwops == nullptr) {
+		return;
+	}
+	SDL_RWclose(_rwops);
+	_rwops = nullptr;
+	_buffer.clear();
+	_pos = 0u;
+}
+
+bool PacketCaptureReader::fill(size_t size) {
+	if (_buffer.size() - _pos >= size) {
+		return true;
+	}
+	_buffer.erase(_buffer.begin(), _buffer.begin() + _pos);
+	_pos = 0u;
+	const size_t have = _buffer.size();
+	const size_t want = (std::max)(size, ChunkSize);
+	_buffer.resize(have + want);
+	const size_t bytesRead = SDL_RWread(_rwops, _buffer.data() + have, 1, want);
+	_buffer.resize(have + bytesRead);
+	return _buffer.size() >= size;
+}
+
+bool PacketCaptureReader::read(void* target, size_t size) {
+	if (!fill(size)) {
+		return false;
+	}
+	memcpy(target, _buffer.data() + _pos, size);
+	_pos += size;
+	return true;
+}
+
+bool PacketCaptureReader::next(CapturedPacket& packet) {
+	if (_rwops == nullptr) {
+		return false;
+	}
+	uint64_t micros;
+	uint32_t connectId;
+	uint32_t host;
+	uint8_t type;
+	uint32_t data;
+	uint32_t length;
+	if (!read(&micros, sizeof(micros)) || !read(&connectId, sizeof(connectId)) || !read(&host, sizeof(host))
+			|| !read(&type, sizeof(type)) || !read(&data, sizeof(data)) || !read(&length, sizeof(length))) {
+		return false;
+	}
+	packet.micros = SDL_SwapLE64(micros);
+	packet.connectId = SDL_SwapLE32(connectId);
+	packet.host = SDL_SwapLE32(host);
+	packet.type = (ENetEventType)type;
+	packet.data = SDL_SwapLE32(data);
+	length = SDL_SwapLE32(length);
+	packet.payload.resize(length);
+	if (length > 0u && !read(packet.payload.data(), length)) {
+		Log::warn("Truncated capture");
+		return false;
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,89 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+extern "C" {
+#include <enet/enet.h>
+}
+#include <SDL_rwops.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+namespace network {
+
+/**
+ * @brief One inbound network event of a capture
+ */
+struct CapturedPacket {
+	// the time since the capture was started
+	uint64_t micros = 0u;
+	// the enet connect id - identifies the peer of the connection
+	uint32_t connectId = 0u;
+	// the address of the peer
+	uint32_t host = 0u;
+	ENetEventType type = ENET_EVENT_TYPE_NONE;
+	// the event data - e.g. the disconnect reason
+	uint32_t data = 0u;
+	std::vector<uint8_t> payload;
+};
+
+/**
+ * @brief Writes the inbound network events of the server into a file
+ *
+ * The file starts with the magic @c ECAP and a version. Every event is stored as little endian
+ * <tt>micros(8) connectId(4) host(4) type(1) data(4) length(4) payload(length)</tt>. The events are
+ * collected in a buffer and written in chunks.
+ */
+class PacketCaptureWriter {
+private:
+	SDL_RWops* _rwops = nullptr;
+	std::vector<uint8_t> _buffer;
+	uint64_t _startMicros = 0u;
+	uint32_t _packets = 0u;
+
+	void flush();
+public:
+	~PacketCaptureWriter();
+
+	bool open(const std::string& file);
+	void close();
+
+	void write(const ENetPeer* peer, ENetEventType type, uint32_t data, const ENetPacket* packet);
+
+	uint32_t packets() const;
+};
+
+inline uint32_t PacketCaptureWriter::packets() const {
+	return _packets;
+}
+
+/**
+ * @brief Reads the events that were written by the @c PacketCaptureWriter
+ */
+class PacketCaptureReader {
+private:
+	SDL_RWops* _rwops = nullptr;
+	std::vector<uint8_t> _buffer;
+	size_t _pos = 0u;
+
+	bool fill(size_t size);
+	bool read(void* target, size_t size);
+public:
+	~PacketCaptureReader();
+
+	bool open(const std::string& file);
+	void close();
+
+	/**
+	 * @return @c false if the end of the capture was reached
+	 */
+	bool next(CapturedPacket& packet);
+};
+
+typedef std::shared_ptr<PacketCaptureWriter> PacketCaptureWriterPtr;
+
+}
@@ -0,0 +1,122 @@
+/**
+ * @file
+ */
+
+#include "PacketReplay.h"
+#include "core/Log.h"
+#include <chrono>
+#include <algorithm>
+
+namespace network {
+
+namespace {
+
+inline uint64_t nowMicros() {
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+constexpr uint32_t PacketReplay::TickBuckets[];
+
+PacketReplay::PacketReplay(const ServerNetworkPtr& network) :
+		_network(network) {
+	_tickHistogram.fill(0u);
+}
+
+bool PacketReplay::init(const std::string& file, float speed) {
+	if (!_reader.open(file)) {
+		return false;
+	}
+	if (!_network->startReplay()) {
+		Log::error("Could not switch the network into the replay mode");
+		_reader.close();
+		return false;
+	}
+	_network->setHandlerProfiling(true);
+	_speed = speed;
+	_startMicros = nowMicros();
+	_hasNext = _reader.next(_next);
+	Log::info("Replay %s with speed %f", file.c_str(), speed);
+	return true;
+}
+
+void PacketReplay::shutdown() {
+	_reader.close();
+	_hasNext = false;
+	// the peers are kept - the users might still reference them
+}
+
+ENetPeer* PacketReplay::peer(const CapturedPacket& packet) {
+	auto i = _peers.find(packet.connectId);
+	if (i != _peers.end()) {
+		return i->second.get();
+	}
+	// the peer is not attached to any host - the replay mode of the network makes sure that it's
+	// never handed over to enet
+	std::unique_ptr<ENetPeer> peer(new ENetPeer());
+	peer->connectID = packet.connectId;
+	peer->address.host = packet.host;
+	peer->state = ENET_PEER_STATE_CONNECTED;
+	ENetPeer* ptr = peer.get();
+	_peers.emplace(packet.connectId, std::move(peer));
+	return ptr;
+}
+
+void PacketReplay::update() {
+	const uint64_t elapsedMicros = (uint64_t)((double)(nowMicros() - _startMicros) * _speed);
+	while (_hasNext) {
+		if (_speed > 0.0f && _next.micros > elapsedMicros) {
+			break;
+		}
+		if (!_network->replay(peer(_next), _next.type, _next.data, _next.payload)) {
+			// the inbound queue is full - try again with the next tick
+			break;
+		}
+		++_packets;
+		_hasNext = _reader.next(_next);
+	}
+}
+
+void PacketReplay::addTick(uint32_t micros) {
+	size_t bucket = 0u;
+	while (bucket < sizeof(TickBuckets) / sizeof(TickBuckets[0]) && micros >= TickBuckets[bucket]) {
+		++bucket;
+	}
+	++_tickHistogram[bucket];
+	_tickMicrosSum += micros;
+	_tickMicrosMax = (std::max)(_tickMicrosMax, micros);
+	++_ticks;
+}
+
+void PacketReplay::report() const {
+	const double seconds = (double)(nowMicros() - _startMicros) / 1000000.0;
+	Log::info("Replayed %u network events of %i peers in %.2f seconds", _packets, (int)_peers.size(), seconds);
+	if (_ticks > 0u) {
+		Log::info("ticks: %u, avg %u us, max %u us", _ticks, (uint32_t)(_tickMicrosSum / _ticks), _tickMicrosMax);
+		uint32_t lower = 0u;
+		for (size_t i = 0u; i < _tickHistogram.size(); ++i) {
+			if (_tickHistogram[i] == 0u) {
+				lower = i < _tickHistogram.size() - 1 ? TickBuckets[i] : lower;
+				continue;
+			}
+			if (i < _tickHistogram.size() - 1) {
+				Log::info("  %6u - %6u us: %u", lower, TickBuckets[i], _tickHistogram[i]);
+				lower = TickBuckets[i];
+			} else {
+				Log::info("  %6u+ us: %u", lower, _tickHistogram[i]);
+			}
+		}
+	}
+	for (int i = std::enum_value(ClientMsgType::MIN); i <= std::enum_value(ClientMsgType::MAX); ++i) {
+		const ClientMsgType type = (ClientMsgType)i;
+		const ProtocolHandlerStats& stats = _network->handlerStats(type);
+		if (stats.count == 0u) {
+			continue;
+		}
+		Log::info("handler %s: %u messages, %.2f ms total, %.2f us avg", EnumNameClientMsgType(type), stats.count,
+				(double)stats.micros / 1000.0, (double)stats.micros / (double)stats.count);
+	}
+}
+
+}
@@ -0,0 +1,77 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "ServerNetwork.h"
+#include "PacketCapture.h"
+#include <unordered_map>
+#include <array>
+#include <memory>
+
+namespace network {
+
+/**
+ * @brief Feeds a capture of the @c PacketCaptureWriter into the @c ServerNetwork
+ *
+ * Every captured connection gets its own peer that is not connected to any host - all the
+ * packets that the server is sending to the peers are dropped. The replay can run in real time or
+ * accelerated. It also collects the tick times of the server to report them together with the time
+ * that the protocol handlers needed.
+ */
+class PacketReplay {
+private:
+	ServerNetworkPtr _network;
+	PacketCaptureReader _reader;
+	CapturedPacket _next;
+	bool _hasNext = false;
+	float _speed = 1.0f;
+	uint64_t _startMicros = 0u;
+	uint32_t _packets = 0u;
+	std::unordered_map<uint32_t, std::unique_ptr<ENetPeer> > _peers;
+
+	// tick times in microseconds - the upper bound of every bucket
+	static constexpr uint32_t TickBuckets[] = { 100u, 250u, 500u, 1000u, 2500u, 5000u, 10000u, 25000u, 50000u, 100000u };
+	std::array<uint32_t, sizeof(TickBuckets) / sizeof(TickBuckets[0]) + 1> _tickHistogram;
+	uint64_t _tickMicrosSum = 0u;
+	uint32_t _tickMicrosMax = 0u;
+	uint32_t _ticks = 0u;
+
+	ENetPeer* peer(const CapturedPacket& packet);
+public:
+	PacketReplay(const ServerNetworkPtr& network);
+
+	/**
+	 * @param[in] speed The factor for the capture time - @c 0 replays the packets as fast as possible
+	 */
+	bool init(const std::string& file, float speed);
+	void shutdown();
+
+	/**
+	 * @brief Injects all packets that are due
+	 */
+	void update();
+	/**
+	 * @brief Collects the duration of one server tick
+	 */
+	void addTick(uint32_t micros);
+
+	/**
+	 * @return @c true if all packets of the capture were injected
+	 */
+	bool finished() const;
+
+	/**
+	 * @brief Logs the tick time histogram and the times of the protocol handlers
+	 */
+	void report() const;
+};
+
+inline bool PacketReplay::finished() const {
+	return !_hasNext;
+}
+
+typedef std::shared_ptr<PacketReplay> PacketReplayPtr;
+
+}
@@ -5,26 +5,54 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <array>
 #include "IProtocolHandler.h"
+#include "ClientMessages_generated.h"
+#include "ServerMessages_generated.h"
+#include "core/Common.h"
 
 namespace network {
 
+/**
+ * @brief Maps the message types to their handlers
+ *
+ * The handlers are stored in flat arrays that are indexed by the message type - the server
+ * registers handlers for the @c ClientMsgType messages, the client for the @c ServerMsgType messages.
+ */
 class ProtocolHandlerRegistry {
 private:
-	typedef std::unordered_map<const char*, ProtocolHandlerPtr> ProtocolHandlers;
-	ProtocolHandlers _registry;
+	std::array<ProtocolHandlerPtr, std::enum_value(ClientMsgType::MAX) + 1> _clientHandlers;
+	std::array<ProtocolHandlerPtr, std::enum_value(ServerMsgType::MAX) + 1> _serverHandlers;
 
 public:
 	ProtocolHandlerRegistry();
 
-	ProtocolHandlerPtr getHandler(const char* type);
+	/**
+	 * @return The handler or @c nullptr if no handler is registered for the given type
+	 */
+	IProtocolHandler* getHandler(ClientMsgType type) const;
+	IProtocolHandler* getHandler(ServerMsgType type) const;
 
-	inline void registerHandler(const char* type, const ProtocolHandlerPtr& handler) {
-		_registry.insert(std::make_pair(type, handler));
-	}
+	void registerHandler(ClientMsgType type, const ProtocolHandlerPtr& handler);
+	void registerHandler(ServerMsgType type, const ProtocolHandlerPtr& handler);
 };
 
+inline IProtocolHandler* ProtocolHandlerRegistry::getHandler(ClientMsgType type) const {
+	const size_t index = std::enum_value(type);
+	if (index >= _clientHandlers.size()) {
+		return nullptr;
+	}
+	return _clientHandlers[index].get();
+}
+
+inline IProtocolHandler* ProtocolHandlerRegistry::getHandler(ServerMsgType type) const {
+	const size_t index = std::enum_value(type);
+	if (index >= _serverHandlers.size()) {
+		return nullptr;
+	}
+	return _serverHandlers[index].get();
+}
+
 typedef std::shared_ptr<ProtocolHandlerRegistry> ProtocolHandlerRegistryPtr;
 
 }
@@ -17,10 +17,33 @@ inline ENetPacket* createServerPacket(FlatBufferBuilder& fbb, ServerMsgType type
 	return packet;
 }
 
+thread_local MessageBuffer* ServerMessageSender::_buffer = nullptr;
+
+MessageBuffer::~MessageBuffer() {
+	core_assert_msg(_messages.empty(), "The message buffer wasn't flushed");
+}
+
+ServerMessageSender::ScopedBuffer::ScopedBuffer(MessageBuffer& buffer) :
+		_previous(_buffer) {
+	_buffer = &buffer;
+}
+
+ServerMessageSender::ScopedBuffer::~ScopedBuffer() {
+	_buffer = _previous;
+}
+
 ServerMessageSender::ServerMessageSender(const ServerNetworkPtr& network) :
 		_network(network) {
 }
 
+void ServerMessageSender::flush(MessageBuffer& buffer) {
+	core_assert_msg(_buffer != &buffer, "The message buffer is still active");
+	for (const MessageBuffer::Message& msg : buffer._messages) {
+		_network->sendMessage(msg.peer, msg.packet);
+	}
+	buffer._messages.clear();
+}
+
 void ServerMessageSender::sendServerMessage(ENetPeer* peer, FlatBufferBuilder& fbb, ServerMsgType type, Offset<void> data, uint32_t flags) {
 	core_assert(peer != nullptr);
 	sendServerMessage(&peer, 1, fbb, type, data, flags);
@@ -30,8 +53,11 @@ void ServerMessageSender::sendServerMessage(ENetPeer** peers, int numPeers, Flat
 	Log::debug("Send %s", EnumNameServerMsgType(type));
 	core_assert(numPeers > 0);
 	auto packet = createServerPacket(fbb, type, data, flags);
-	{
-		// TODO: lock
+	if (_buffer != nullptr) {
+		for (int i = 0; i < numPeers; ++i) {
+			_buffer->_messages.push_back(MessageBuffer::Message{peers[i], packet});
+		}
+	} else {
 		for (int i = 0; i < numPeers; ++i) {
 			_network->sendMessage(peers[i], packet);
 		}
@@ -41,6 +67,7 @@ void ServerMessageSender::sendServerMessage(ENetPeer** peers, int numPeers, Flat
 
 void ServerMessageSender::broadcastServerMessage(FlatBufferBuilder& fbb, ServerMsgType type, Offset<void> data, int channel, uint32_t flags) {
 	Log::debug("Broadcast %s", EnumNameServerMsgType(type));
+	core_assert_msg(_buffer == nullptr, "Broadcasts can't be deferred");
 	{
 		// TODO: lock
 		_network->broadcast(createServerPacket(fbb, type, data, flags), channel);
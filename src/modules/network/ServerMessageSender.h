@@ -7,21 +7,73 @@
 #include "ServerMessages_generated.h"
 #include "ServerNetwork.h"
 #include <memory>
+#include <vector>
 
 namespace network {
 
 using namespace flatbuffers;
 
+/**
+ * @brief Collects the packets of the messages that are sent while the buffer is active for the calling thread
+ *
+ * The network queue only accepts messages from the game thread. Tasks that are executed on other threads
+ * collect their messages in one of these buffers, the game thread hands them over to the network with
+ * @c ServerMessageSender::flush() afterwards.
+ *
+ * @sa ServerMessageSender::ScopedBuffer
+ */
+class MessageBuffer {
+private:
+	friend class ServerMessageSender;
+	struct Message {
+		ENetPeer* peer;
+		ENetPacket* packet;
+	};
+	std::vector<Message> _messages;
+public:
+	~MessageBuffer();
+
+	bool empty() const;
+	size_t size() const;
+};
+
+inline bool MessageBuffer::empty() const {
+	return _messages.empty();
+}
+
+inline size_t MessageBuffer::size() const {
+	return _messages.size();
+}
+
 /**
  * @brief Send messages from the server to the client(s)
  */
 class ServerMessageSender {
 private:
 	ServerNetworkPtr _network;
+	static thread_local MessageBuffer* _buffer;
 
 public:
+	/**
+	 * @brief Messages that are sent from the calling thread end up in the given buffer as long as this
+	 * object lives
+	 */
+	class ScopedBuffer {
+	private:
+		MessageBuffer* _previous;
+	public:
+		ScopedBuffer(MessageBuffer& buffer);
+		~ScopedBuffer();
+	};
+
 	ServerMessageSender(const ServerNetworkPtr& network);
 
+	/**
+	 * @brief Hands the collected messages over to the network - in the order they were sent
+	 * @note Must be called from the game thread
+	 */
+	void flush(MessageBuffer& buffer);
+
 	void sendServerMessage(ENetPeer* peer, FlatBufferBuilder& fbb, ServerMsgType type, Offset<void> data, uint32_t flags = ENET_PACKET_FLAG_RELIABLE);
 	void sendServerMessage(std::vector<ENetPeer*> peers, FlatBufferBuilder& fbb, ServerMsgType type, Offset<void> data, uint32_t flags = ENET_PACKET_FLAG_RELIABLE);
 	void sendServerMessage(ENetPeer** peers, int numPeers, FlatBufferBuilder& fbb, ServerMsgType type, Offset<void> data, uint32_t flags = ENET_PACKET_FLAG_RELIABLE);
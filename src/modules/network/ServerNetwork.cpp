@@ -4,37 +4,61 @@
 
 #include "ClientMessages_generated.h"
 #include "ServerNetwork.h"
+#include "NetworkEvents.h"
 #include "core/Trace.h"
 #include "core/Log.h"
+#include <algorithm>
+#include <chrono>
 
 namespace network {
 
-ServerNetwork::ServerNetwork(const ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const core::EventBusPtr& eventBus) :
-		Super(protocolHandlerRegistry, eventBus) {
+ServerNetwork::ServerNetwork(const ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const core::EventBusPtr& eventBus, uint32_t queueSize) :
+		Super(protocolHandlerRegistry, eventBus), _inbound(queueSize), _outbound(queueSize) {
 }
 
-bool ServerNetwork::packetReceived(ENetEvent& event) {
-	flatbuffers::Verifier v(event.packet->data, event.packet->dataLength);
+ServerNetwork::~ServerNetwork() {
+	shutdown();
+}
 
+bool ServerNetwork::verify(const ENetPacket* packet) const {
+	flatbuffers::Verifier v(packet->data, packet->dataLength);
 	if (!VerifyClientMessageBuffer(v)) {
-		Log::error("Illegal client packet received with length: %i", (int)event.packet->dataLength);
+		Log::error("Illegal client packet received with length: %i", (int)packet->dataLength);
 		return false;
 	}
-	const ClientMessage *req = GetClientMessage(event.packet->data);
-	ClientMsgType type = req->data_type();
-	const char *clientMsgType = EnumNameClientMsgType(type);
-	ProtocolHandlerPtr handler = _protocolHandlerRegistry->getHandler(clientMsgType);
-	if (!handler) {
-		Log::error("No handler for client msg type %s", clientMsgType);
+	return true;
+}
+
+bool ServerNetwork::dispatch(ENetPeer* peer, const ENetPacket* packet) {
+	const ClientMessage *req = GetClientMessage(packet->data);
+	const ClientMsgType type = req->data_type();
+	IProtocolHandler* handler = _protocolHandlerRegistry->getHandler(type);
+	if (handler == nullptr) {
+		Log::error("No handler for client msg type %s", EnumNameClientMsgType(type));
 		return false;
 	}
-	Log::debug("Received %s", clientMsgType);
-	handler->execute(event.peer, reinterpret_cast<const flatbuffers::Table*>(req->data()));
+	Log::debug("Received %s", EnumNameClientMsgType(type));
+	if (!_handlerProfiling) {
+		handler->execute(peer, reinterpret_cast<const flatbuffers::Table*>(req->data()));
+		return true;
+	}
+	const auto start = std::chrono::steady_clock::now();
+	handler->execute(peer, reinterpret_cast<const flatbuffers::Table*>(req->data()));
+	ProtocolHandlerStats& stats = _handlerStats[std::enum_value(type)];
+	++stats.count;
+	stats.micros += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
 	return true;
 }
 
+bool ServerNetwork::packetReceived(ENetEvent& event) {
+	if (!verify(event.packet)) {
+		return false;
+	}
+	return dispatch(event.peer, event.packet);
+}
+
 bool ServerNetwork::bind(uint16_t port, const std::string& hostname, int maxPeers, int maxChannels) {
-	if (_server) {
+	if (_server || _replay) {
 		return false;
 	}
 	if (maxPeers <= 0) {
@@ -64,7 +88,267 @@ bool ServerNetwork::bind(uint16_t port, const std::string& hostname, int maxPeer
 	return true;
 }
 
+bool ServerNetwork::startThread() {
+	if (_server == nullptr || _running) {
+		return false;
+	}
+	_running = true;
+	_thread = std::thread([this] () {
+		run();
+	});
+	Log::info("Started the network thread");
+	return true;
+}
+
+bool ServerNetwork::startCapture(const std::string& file) {
+	return _capture.open(file);
+}
+
+void ServerNetwork::stopCapture() {
+	_capture.close();
+}
+
+bool ServerNetwork::startReplay() {
+	if (_server != nullptr || _replay) {
+		return false;
+	}
+	_replay = true;
+	return true;
+}
+
+bool ServerNetwork::replay(ENetPeer* peer, ENetEventType type, uint32_t data, const std::vector<uint8_t>& payload) {
+	if (!_replay) {
+		return false;
+	}
+	if (_inbound.size() >= _inbound.capacity()) {
+		return false;
+	}
+	Inbound inbound;
+	inbound.type = type;
+	inbound.peer = peer;
+	inbound.data = data;
+	if (type == ENET_EVENT_TYPE_RECEIVE) {
+		ENetPacket* packet = enet_packet_create(payload.data(), payload.size(), ENET_PACKET_FLAG_RELIABLE);
+		if (!verify(packet)) {
+			// the network thread would have dropped it, too
+			enet_packet_destroy(packet);
+			return true;
+		}
+		inbound.packet = packet;
+	}
+	_inbound.push(inbound);
+	return true;
+}
+
+void ServerNetwork::releaseReplayPackets() {
+	// the same packet might have been sent to several peers
+	std::sort(_replayPackets.begin(), _replayPackets.end());
+	_replayPackets.erase(std::unique(_replayPackets.begin(), _replayPackets.end()), _replayPackets.end());
+	for (ENetPacket* packet : _replayPackets) {
+		enet_packet_destroy(packet);
+	}
+	_replayPackets.clear();
+}
+
+void ServerNetwork::stopThread() {
+	if (!_thread.joinable()) {
+		return;
+	}
+	_running = false;
+	_thread.join();
+
+	Inbound inbound;
+	while (_inbound.pop(inbound)) {
+		if (inbound.packet != nullptr) {
+			enet_packet_destroy(inbound.packet);
+		}
+	}
+	// everything that was queued but not yet sent, is sent on the calling thread now
+	std::vector<Outbound> batch;
+	Outbound outbound;
+	while (_outbound.pop(outbound)) {
+		batch.push_back(outbound);
+	}
+	batch.insert(batch.end(), _outboundBatch.begin(), _outboundBatch.end());
+	_outboundBatch.clear();
+	for (const Outbound& o : batch) {
+		queue(o);
+	}
+}
+
+void ServerNetwork::run() {
+	while (_running) {
+		sendOutbound();
+		serviceHost(1u);
+	}
+}
+
+void ServerNetwork::sendOutbound() {
+	core_trace_scoped(NetworkSend);
+	Outbound outbound;
+	bool sent = false;
+	while (_outbound.pop(outbound)) {
+		switch (outbound.type) {
+		case OutboundType::Send:
+			if (enet_peer_send(outbound.peer, outbound.channel, outbound.packet) != 0 && outbound.packet->referenceCount == 0) {
+				enet_packet_destroy(outbound.packet);
+			}
+			break;
+		case OutboundType::Broadcast:
+			enet_host_broadcast(_server, outbound.channel, outbound.packet);
+			break;
+		case OutboundType::Disconnect:
+			disconnectPeer(outbound.peer, (DisconnectReason)outbound.data);
+			break;
+		}
+		sent = true;
+	}
+	if (sent) {
+		enet_host_flush(_server);
+	}
+}
+
+void ServerNetwork::serviceHost(uint32_t timeoutMillis) {
+	core_trace_scoped(NetworkService);
+	// don't starve the outgoing packets if there is a lot of incoming traffic
+	const int maxEvents = 256;
+	ENetEvent event;
+	for (int i = 0; i < maxEvents && enet_host_service(_server, &event, i == 0 ? timeoutMillis : 0) > 0; ++i) {
+		Inbound inbound;
+		inbound.type = event.type;
+		inbound.peer = event.peer;
+		inbound.data = event.data;
+		if (event.type == ENET_EVENT_TYPE_RECEIVE) {
+			if (!verify(event.packet)) {
+				Log::error("Failure while receiving a package - disconnecting now...");
+				disconnectPeer(event.peer, DisconnectReason::ProtocolError);
+				enet_packet_destroy(event.packet);
+				continue;
+			}
+			inbound.packet = event.packet;
+		} else if (event.type == ENET_EVENT_TYPE_NONE) {
+			continue;
+		}
+		// the game thread is too slow - wait for it instead of dropping messages
+		while (!_inbound.push(inbound)) {
+			if (!_running) {
+				if (inbound.packet != nullptr) {
+					enet_packet_destroy(inbound.packet);
+				}
+				return;
+			}
+			std::this_thread::yield();
+		}
+	}
+}
+
+void ServerNetwork::queue(const Outbound& outbound) {
+	if (_replay) {
+		if (outbound.packet != nullptr && (_replayPackets.empty() || _replayPackets.back() != outbound.packet)) {
+			_replayPackets.push_back(outbound.packet);
+		}
+		return;
+	}
+	if (_running) {
+		_outboundBatch.push_back(outbound);
+		return;
+	}
+	switch (outbound.type) {
+	case OutboundType::Send:
+		Super::sendMessage(outbound.peer, outbound.packet, outbound.channel);
+		break;
+	case OutboundType::Broadcast:
+		enet_host_broadcast(_server, outbound.channel, outbound.packet);
+		break;
+	case OutboundType::Disconnect:
+		disconnectPeer(outbound.peer, (DisconnectReason)outbound.data);
+		break;
+	}
+}
+
+bool ServerNetwork::sendMessage(ENetPeer* peer, ENetPacket* packet, int channel) {
+	if (!_running && !_replay) {
+		return Super::sendMessage(peer, packet, channel);
+	}
+	Outbound outbound;
+	outbound.type = OutboundType::Send;
+	outbound.channel = (uint8_t)channel;
+	outbound.peer = peer;
+	outbound.packet = packet;
+	queue(outbound);
+	return true;
+}
+
+void ServerNetwork::broadcast(ENetPacket* packet, int channel) {
+	Outbound outbound;
+	outbound.type = OutboundType::Broadcast;
+	outbound.channel = (uint8_t)channel;
+	outbound.packet = packet;
+	queue(outbound);
+}
+
+void ServerNetwork::disconnect(ENetPeer* peer, DisconnectReason reason) {
+	Outbound outbound;
+	outbound.type = OutboundType::Disconnect;
+	outbound.peer = peer;
+	outbound.data = std::enum_value(reason);
+	queue(outbound);
+}
+
+void ServerNetwork::flushOutbound() {
+	if (_outboundBatch.empty()) {
+		return;
+	}
+	size_t n = 0u;
+	for (; n < _outboundBatch.size(); ++n) {
+		if (!_outbound.push(_outboundBatch[n])) {
+			// try again with the next tick
+			Log::debug("Outgoing network queue is full");
+			break;
+		}
+	}
+	_outboundBatch.erase(_outboundBatch.begin(), _outboundBatch.begin() + n);
+}
+
+void ServerNetwork::dispatchInbound() {
+	// only handle what is already there - the network thread might keep on adding messages
+	uint32_t n = _inbound.size();
+	Inbound inbound;
+	while (n-- > 0u && _inbound.pop(inbound)) {
+		_capture.write(inbound.peer, inbound.type, inbound.data, inbound.packet);
+		switch (inbound.type) {
+		case ENET_EVENT_TYPE_CONNECT:
+			_eventBus->publish(NewConnectionEvent(inbound.peer));
+			break;
+		case ENET_EVENT_TYPE_RECEIVE:
+			if (!dispatch(inbound.peer, inbound.packet)) {
+				Log::error("Failure while handling a package - disconnecting now...");
+				disconnect(inbound.peer, DisconnectReason::ProtocolError);
+			}
+			enet_packet_destroy(inbound.packet);
+			break;
+		case ENET_EVENT_TYPE_DISCONNECT:
+			_eventBus->publish(DisconnectEvent(inbound.peer, (DisconnectReason)inbound.data));
+			break;
+		case ENET_EVENT_TYPE_NONE:
+			break;
+		}
+	}
+}
+
 void ServerNetwork::shutdown() {
+	stopThread();
+	stopCapture();
+	if (_replay) {
+		Inbound inbound;
+		while (_inbound.pop(inbound)) {
+			if (inbound.packet != nullptr) {
+				enet_packet_destroy(inbound.packet);
+			}
+		}
+		releaseReplayPackets();
+		_replay = false;
+	}
 	if (_server != nullptr) {
 		enet_host_flush(_server);
 		enet_host_destroy(_server);
@@ -75,7 +359,24 @@ void ServerNetwork::shutdown() {
 
 void ServerNetwork::update() {
 	core_trace_scoped(Network);
-	updateHost(_server);
+	if (_replay) {
+		dispatchInbound();
+		releaseReplayPackets();
+		return;
+	}
+	if (!_running) {
+		if (_server == nullptr) {
+			return;
+		}
+		enet_host_flush(_server);
+		// service and dispatch on the calling thread - this takes the same path as the network
+		// thread to let the capture see all the events
+		serviceHost(0u);
+		dispatchInbound();
+		return;
+	}
+	dispatchInbound();
+	flushOutbound();
 }
 
 }
@@ -5,27 +5,149 @@
 #pragma once
 
 #include "Network.h"
+#include "PacketCapture.h"
+#include "ClientMessages_generated.h"
+#include "collection/SPSCQueue.h"
+#include <array>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 namespace network {
 
+/**
+ * @brief The amount of handled messages of one type and the time the handler needed for them
+ */
+struct ProtocolHandlerStats {
+	uint32_t count = 0u;
+	uint64_t micros = 0u;
+};
+
+/**
+ * @brief The server side of the network layer
+ *
+ * By default the enet host is serviced in @c update() on the calling thread. After @c startThread()
+ * was called, a dedicated network thread owns the host: it sends the queued outgoing packets,
+ * services the host and verifies the received packets. The game thread only dispatches the
+ * verified messages to the handlers in @c update(). Both directions are connected via bounded
+ * single producer single consumer queues - the outgoing packets of a tick are collected and
+ * handed over in one batch.
+ *
+ * The inbound events can be captured into a file (see @c startCapture()) and be fed back into the
+ * server without a socket (see @c startReplay() and @c PacketReplay).
+ */
 class ServerNetwork : public Network {
 private:
-	ENetHost* _server = nullptr;
 	using Super = Network;
+	ENetHost* _server = nullptr;
+
+	struct Inbound {
+		ENetEventType type = ENET_EVENT_TYPE_NONE;
+		ENetPeer* peer = nullptr;
+		ENetPacket* packet = nullptr;
+		uint32_t data = 0u;
+	};
+
+	enum class OutboundType : uint8_t {
+		Send, Broadcast, Disconnect
+	};
+
+	struct Outbound {
+		OutboundType type = OutboundType::Send;
+		uint8_t channel = 0u;
+		ENetPeer* peer = nullptr;
+		ENetPacket* packet = nullptr;
+		uint32_t data = 0u;
+	};
+
+	core::SPSCQueue<Inbound> _inbound;
+	core::SPSCQueue<Outbound> _outbound;
+	// the outgoing packets of the current tick - filled by the game thread
+	std::vector<Outbound> _outboundBatch;
+	std::thread _thread;
+	std::atomic_bool _running { false };
+
+	PacketCaptureWriter _capture;
+	bool _replay = false;
+	// the packets that were sent during the replay - they are not handed over to enet
+	std::vector<ENetPacket*> _replayPackets;
+	void releaseReplayPackets();
+
+	bool verify(const ENetPacket* packet) const;
+	bool dispatch(ENetPeer* peer, const ENetPacket* packet);
+
+	void queue(const Outbound& outbound);
+	void flushOutbound();
+	void dispatchInbound();
+
+	bool _handlerProfiling = false;
+	std::array<ProtocolHandlerStats, std::enum_value(ClientMsgType::MAX) + 1> _handlerStats;
+
+	void run();
+	void sendOutbound();
+	void serviceHost(uint32_t timeoutMillis);
+	void stopThread();
 public:
-	ServerNetwork(const ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const core::EventBusPtr& eventBus);
+	/**
+	 * @param queueSize The capacity of the queues between the network and the game thread
+	 */
+	ServerNetwork(const ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const core::EventBusPtr& eventBus, uint32_t queueSize = 8192u);
+	~ServerNetwork();
 
 	bool bind(uint16_t port, const std::string& hostname = "", int maxPeers = 1024, int maxChannels = 1);
 	bool packetReceived(ENetEvent& event) override;
 
-	inline void broadcast(ENetPacket* packet, int channel = 0) {
-		enet_host_broadcast(_server, channel, packet);
-	}
+	/**
+	 * @brief Hands the enet host over to a dedicated network thread
+	 * @note Call this after @c bind()
+	 */
+	bool startThread();
+	bool threaded() const;
+
+	/**
+	 * @brief Writes all inbound network events into the given file
+	 */
+	bool startCapture(const std::string& file);
+	void stopCapture();
+
+	/**
+	 * @brief Switches the network into the replay mode - there is no host needed, the inbound events
+	 * are injected via @c replay() and outgoing packets are dropped
+	 * @note Can't be combined with @c bind()
+	 */
+	bool startReplay();
+	/**
+	 * @brief Injects an inbound network event - it is dispatched with the next @c update()
+	 * @return @c false if the inbound queue is full
+	 */
+	bool replay(ENetPeer* peer, ENetEventType type, uint32_t data, const std::vector<uint8_t>& payload);
+
+	/**
+	 * @brief Measure the time that the handlers of the client messages need
+	 */
+	void setHandlerProfiling(bool handlerProfiling);
+	const ProtocolHandlerStats& handlerStats(ClientMsgType type) const;
+
+	bool sendMessage(ENetPeer* peer, ENetPacket* packet, int channel = 0) override;
+	void broadcast(ENetPacket* packet, int channel = 0);
+	void disconnect(ENetPeer* peer, DisconnectReason reason);
 
 	void update();
 	void shutdown() override;
 };
 
+inline bool ServerNetwork::threaded() const {
+	return _running;
+}
+
+inline void ServerNetwork::setHandlerProfiling(bool handlerProfiling) {
+	_handlerProfiling = handlerProfiling;
+}
+
+inline const ProtocolHandlerStats& ServerNetwork::handlerStats(ClientMsgType type) const {
+	return _handlerStats[std::enum_value(type)];
+}
+
 typedef std::shared_ptr<ServerNetwork> ServerNetworkPtr;
 
 }
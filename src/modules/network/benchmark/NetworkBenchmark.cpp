@@ -0,0 +1,146 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "network/ServerNetwork.h"
+#include "network/NetworkEvents.h"
+#include "core/EventBus.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const uint16_t Port = 17901;
+const int MessagesPerIteration = 1000;
+
+typedef std::chrono::high_resolution_clock Clock;
+
+class MoveCounter : public network::IProtocolHandler {
+public:
+	std::vector<Clock::time_point> sent;
+	int received = 0;
+	double latencyMicros = 0.0;
+
+	void execute(ENetPeer* peer, const void* message) override {
+		const std::chrono::duration<double, std::micro> latency = Clock::now() - sent[received];
+		latencyMicros += latency.count();
+		++received;
+	}
+};
+
+/**
+ * @brief Loopback client that sends @c Move messages to the server
+ */
+class LoopbackClient {
+private:
+	ENetHost* _host = nullptr;
+	ENetPeer* _peer = nullptr;
+	flatbuffers::FlatBufferBuilder _fbb;
+public:
+	bool connect() {
+		_host = enet_host_create(nullptr, 1, 1, 0, 0);
+		if (_host == nullptr) {
+			return false;
+		}
+		enet_host_compress_with_range_coder(_host);
+		ENetAddress address;
+		enet_address_set_host(&address, "127.0.0.1");
+		address.port = Port;
+		_peer = enet_host_connect(_host, &address, 1, 0);
+		return _peer != nullptr;
+	}
+
+	bool connected() const {
+		return _peer != nullptr && _peer->state == ENET_PEER_STATE_CONNECTED;
+	}
+
+	void send() {
+		auto move = network::CreateMove(_fbb, network::MoveDirection::MOVEFORWARD, 0.0f, 1.0f);
+		auto msg = network::CreateClientMessage(_fbb, network::ClientMsgType::Move, move.Union());
+		network::FinishClientMessageBuffer(_fbb, msg);
+		enet_peer_send(_peer, 0, enet_packet_create(_fbb.GetBufferPointer(), _fbb.GetSize(), ENET_PACKET_FLAG_RELIABLE));
+		_fbb.Clear();
+	}
+
+	void update() {
+		ENetEvent event;
+		while (enet_host_service(_host, &event, 0) > 0) {
+			if (event.type == ENET_EVENT_TYPE_RECEIVE) {
+				enet_packet_destroy(event.packet);
+			}
+		}
+	}
+
+	void shutdown() {
+		if (_host != nullptr) {
+			enet_peer_disconnect_now(_peer, 0);
+			enet_host_destroy(_host);
+		}
+		_host = nullptr;
+		_peer = nullptr;
+	}
+};
+
+}
+
+/**
+ * @brief Sends move messages from a loopback client and waits until the server dispatched all of them
+ *
+ * The first argument is @c 1 if the server runs the network thread - the counter @c latency is the time
+ * between sending a message and the dispatch to the handler.
+ */
+static void BM_LoopbackMoveMessages(benchmark::State& state) {
+	const bool threaded = state.range(0) != 0;
+	const core::EventBusPtr eventBus = std::make_shared<core::EventBus>();
+	const network::ProtocolHandlerRegistryPtr registry = std::make_shared<network::ProtocolHandlerRegistry>();
+	const std::shared_ptr<MoveCounter> counter = std::make_shared<MoveCounter>();
+	registry->registerHandler(network::ClientMsgType::Move, counter);
+	network::ServerNetwork server(registry, eventBus);
+	if (!server.init() || !server.bind(Port, "127.0.0.1")) {
+		state.SkipWithError("Failed to bind the server");
+		return;
+	}
+	if (threaded && !server.startThread()) {
+		state.SkipWithError("Failed to start the network thread");
+		return;
+	}
+	LoopbackClient client;
+	if (!client.connect()) {
+		state.SkipWithError("Failed to connect");
+		return;
+	}
+	for (int i = 0; i < 5000 && !client.connected(); ++i) {
+		client.update();
+		server.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if (!client.connected()) {
+		state.SkipWithError("Failed to connect");
+		return;
+	}
+
+	counter->sent.reserve(MessagesPerIteration * 1024);
+	while (state.KeepRunning()) {
+		const int expected = counter->received + MessagesPerIteration;
+		for (int i = 0; i < MessagesPerIteration; ++i) {
+			counter->sent.push_back(Clock::now());
+			client.send();
+			if (i % 64 == 0) {
+				client.update();
+			}
+		}
+		while (counter->received < expected) {
+			client.update();
+			server.update();
+		}
+	}
+	state.SetItemsProcessed(counter->received);
+	state.counters["latency_us"] = counter->latencyMicros / (std::max)(1, counter->received);
+
+	client.shutdown();
+	server.shutdown();
+}
+
+BENCHMARK(BM_LoopbackMoveMessages)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
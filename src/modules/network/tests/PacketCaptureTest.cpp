@@ -0,0 +1,164 @@
+/**
+ * @file
+ */
+
+#include "core/tests/AbstractTest.h"
+#include "network/PacketCapture.h"
+#include "network/PacketReplay.h"
+#include "network/ServerNetwork.h"
+#include "network/NetworkEvents.h"
+#include "ServerMessages_generated.h"
+
+namespace network {
+
+namespace {
+
+class MoveCounter : public IProtocolHandler {
+private:
+	ServerNetwork* _network;
+public:
+	int moves = 0;
+
+	MoveCounter(ServerNetwork* network) :
+			_network(network) {
+	}
+
+	void execute(ENetPeer* peer, const void* message) override {
+		++moves;
+		// the replay must drop the answers
+		flatbuffers::FlatBufferBuilder fbb;
+		auto msg = CreateServerMessage(fbb, ServerMsgType::AuthFailed, CreateAuthFailed(fbb).Union());
+		FinishServerMessageBuffer(fbb, msg);
+		_network->sendMessage(peer, enet_packet_create(fbb.GetBufferPointer(), fbb.GetSize(), ENET_PACKET_FLAG_RELIABLE));
+	}
+};
+
+std::vector<uint8_t> createMove() {
+	flatbuffers::FlatBufferBuilder fbb;
+	auto move = CreateMove(fbb, MoveDirection::MOVEFORWARD, 0.0f, 1.0f);
+	auto msg = CreateClientMessage(fbb, ClientMsgType::Move, move.Union());
+	FinishClientMessageBuffer(fbb, msg);
+	return std::vector<uint8_t>(fbb.GetBufferPointer(), fbb.GetBufferPointer() + fbb.GetSize());
+}
+
+}
+
+class PacketCaptureTest: public core::AbstractTest,
+		public core::IEventBusHandler<NewConnectionEvent>,
+		public core::IEventBusHandler<DisconnectEvent> {
+protected:
+	int _connects = 0;
+	int _disconnects = 0;
+
+public:
+	void onEvent(const NewConnectionEvent& event) override {
+		++_connects;
+	}
+
+	void onEvent(const DisconnectEvent& event) override {
+		++_disconnects;
+	}
+
+	void writeCapture(const std::string& file, const std::vector<uint8_t>& move, int moves) {
+		PacketCaptureWriter writer;
+		ASSERT_TRUE(writer.open(file));
+		ENetPeer peer;
+		memset(&peer, 0, sizeof(peer));
+		peer.connectID = 42u;
+		peer.address.host = 0x0100007fu;
+		ENetPacket* packet = enet_packet_create(move.data(), move.size(), ENET_PACKET_FLAG_RELIABLE);
+		writer.write(&peer, ENET_EVENT_TYPE_CONNECT, 0u, nullptr);
+		for (int i = 0; i < moves; ++i) {
+			writer.write(&peer, ENET_EVENT_TYPE_RECEIVE, 0u, packet);
+		}
+		writer.write(&peer, ENET_EVENT_TYPE_DISCONNECT, 1u, nullptr);
+		EXPECT_EQ((uint32_t)moves + 2u, writer.packets());
+		writer.close();
+		enet_packet_destroy(packet);
+	}
+};
+
+TEST_F(PacketCaptureTest, testWriteRead) {
+	const std::vector<uint8_t>& move = createMove();
+	writeCapture("packetcapture.bin", move, 3);
+
+	PacketCaptureReader reader;
+	ASSERT_TRUE(reader.open("packetcapture.bin"));
+	CapturedPacket packet;
+	ASSERT_TRUE(reader.next(packet));
+	EXPECT_EQ(ENET_EVENT_TYPE_CONNECT, packet.type);
+	EXPECT_EQ(42u, packet.connectId);
+	EXPECT_EQ(0x0100007fu, packet.host);
+	EXPECT_TRUE(packet.payload.empty());
+	uint64_t micros = packet.micros;
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_TRUE(reader.next(packet));
+		EXPECT_EQ(ENET_EVENT_TYPE_RECEIVE, packet.type);
+		EXPECT_EQ(move, packet.payload);
+		EXPECT_GE(packet.micros, micros);
+		micros = packet.micros;
+	}
+	ASSERT_TRUE(reader.next(packet));
+	EXPECT_EQ(ENET_EVENT_TYPE_DISCONNECT, packet.type);
+	EXPECT_EQ(1u, packet.data);
+	EXPECT_FALSE(reader.next(packet));
+}
+
+TEST_F(PacketCaptureTest, testInvalidFile) {
+	PacketCaptureReader reader;
+	EXPECT_FALSE(reader.open("iotest.txt"));
+	EXPECT_FALSE(reader.open("does-not-exist.bin"));
+}
+
+TEST_F(PacketCaptureTest, testReplay) {
+	const int moves = 100;
+	writeCapture("packetreplay.bin", createMove(), moves);
+
+	const core::EventBusPtr eventBus = std::make_shared<core::EventBus>();
+	eventBus->subscribe<NewConnectionEvent>(*this);
+	eventBus->subscribe<DisconnectEvent>(*this);
+	const ProtocolHandlerRegistryPtr registry = std::make_shared<ProtocolHandlerRegistry>();
+	// a small queue to let the replay span several ticks
+	const ServerNetworkPtr network = std::make_shared<ServerNetwork>(registry, eventBus, 16u);
+	const std::shared_ptr<MoveCounter> counter = std::make_shared<MoveCounter>(network.get());
+	registry->registerHandler(ClientMsgType::Move, counter);
+	ASSERT_TRUE(network->init());
+	// capture the replay again to check that the capture sees all dispatched events
+	ASSERT_TRUE(network->startCapture("packetreplay-capture.bin"));
+
+	PacketReplay replay(network);
+	ASSERT_TRUE(replay.init("packetreplay.bin", 0.0f));
+	EXPECT_FALSE(network->bind(17902, "127.0.0.1"));
+	int ticks = 0;
+	while (!replay.finished() && ticks < 1000) {
+		replay.update();
+		network->update();
+		replay.addTick(1u);
+		++ticks;
+	}
+	network->update();
+	EXPECT_TRUE(replay.finished());
+	EXPECT_GT(ticks, 1);
+	EXPECT_EQ(moves, counter->moves);
+	EXPECT_EQ(1, _connects);
+	EXPECT_EQ(1, _disconnects);
+	EXPECT_EQ((uint32_t)moves, network->handlerStats(ClientMsgType::Move).count);
+	replay.report();
+	replay.shutdown();
+	network->shutdown();
+
+	PacketCaptureReader reader;
+	ASSERT_TRUE(reader.open("packetreplay-capture.bin"));
+	CapturedPacket packet;
+	int events = 0;
+	while (reader.next(packet)) {
+		EXPECT_EQ(42u, packet.connectId);
+		++events;
+	}
+	EXPECT_EQ(moves + 2, events);
+
+	eventBus->unsubscribe<NewConnectionEvent>(*this);
+	eventBus->unsubscribe<DisconnectEvent>(*this);
+}
+
+}
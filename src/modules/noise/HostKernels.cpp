@@ -0,0 +1,54 @@
+/**
+ * @file
+ */
+
+#include "HostKernels.h"
+#include "Simplex.h"
+#include "NoiseShaders.h"
+#include <glm/common.hpp>
+#include <glm/trigonometric.hpp>
+#include <glm/gtc/constants.hpp>
+
+namespace noise {
+
+static inline float norm(float noise) {
+	return (glm::clamp(noise, -1.0f, 1.0f) + 1.0f) * 0.5f;
+}
+
+void registerHostKernels() {
+	compute::NoiseShader::registerRidgedMF2Host([] (uint8_t* output, const int32_t& components,
+			const float& frequency, const float& amplitude, const float& ridgeOffset, const uint8_t& octaves,
+			const float& lacunarity, const float& gain, const compute::HostWorkRange& range) {
+		for (int i = range.begin; i < range.end; ++i) {
+			const glm::ivec3& id = range.globalId(i);
+			const int index = i * components;
+			for (int channel = 0; channel < components; ++channel) {
+				const glm::vec2 v(id.x + channel, id.y + channel);
+				const float noise = norm(ridgedMF(v, ridgeOffset, octaves, lacunarity, gain));
+				output[index + channel] = (uint8_t)(noise * 255.0f);
+			}
+		}
+	});
+	compute::NoiseShader::registerSeamlessNoiseHost([] (uint8_t* output, const int32_t& size,
+			const int32_t& components, const uint8_t& octaves, const float& lacunarity, const float& gain,
+			const compute::HostWorkRange& range) {
+		const float d = 1.0f / (float)size;
+		for (int i = range.begin; i < range.end; ++i) {
+			const glm::ivec3& id = range.globalId(i);
+			const float sTwoPi = id.x * d * glm::two_pi<float>();
+			const float tTwoPi = id.y * d * glm::two_pi<float>();
+			const float nx = glm::cos(sTwoPi);
+			const float nz = glm::sin(sTwoPi);
+			const float ny = glm::cos(tTwoPi);
+			const float nw = glm::sin(tTwoPi);
+			const int index = (id.x + id.y * size) * components;
+			for (int channel = 0; channel < components; ++channel) {
+				const glm::vec4 v(nx + channel, ny + channel, nz + channel, nw + channel);
+				const float noise = norm(fBm(v, octaves, lacunarity, gain));
+				output[index + channel] = (uint8_t)(noise * 255.0f);
+			}
+		}
+	});
+}
+
+}
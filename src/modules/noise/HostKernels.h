@@ -0,0 +1,15 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+namespace noise {
+
+/**
+ * @brief Registers the native implementations of the kernels in @c noise.cl for the host
+ * compute backend. Call this before setting up the @c compute::NoiseShader.
+ */
+extern void registerHostKernels();
+
+}
@@ -5,6 +5,7 @@
 #include "core/tests/AbstractTest.h"
 #include "image/Image.h"
 #include "NoiseShaders.h"
+#include "noise/HostKernels.h"
 
 namespace noise {
 
@@ -16,6 +17,7 @@ protected:
 public:
 	void SetUp() override {
 		Super::SetUp();
+		registerHostKernels();
 		_supported = compute::init();
 	}
 
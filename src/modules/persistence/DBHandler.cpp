@@ -7,6 +7,11 @@
 #include "core/Assert.h"
 #include "ConnectionPool.h"
 #include "core/Log.h"
+#include "State.h"
+#include "engine-config.h"
+#ifdef HAVE_POSTGRES
+#include <libpq-fe.h>
+#endif
 
 namespace persistence {
 
@@ -31,6 +36,12 @@ bool DBHandler::init() {
 }
 
 void DBHandler::shutdown() {
+	if (_listenConnection != nullptr) {
+		State s(_listenConnection);
+		s.exec("UNLISTEN *;");
+		_listenConnection->close();
+		_listenConnection = nullptr;
+	}
 	_initialized = false;
 	core::Singleton<ConnectionPool>::getInstance().shutdown();
 }
@@ -154,6 +165,44 @@ bool DBHandler::createTable(Model&& model) const {
 	return true;
 }
 
+bool DBHandler::listen(const std::string& channel) {
+	if (_listenConnection == nullptr) {
+		_listenConnection = connection();
+		if (_listenConnection == nullptr) {
+			Log::error(logid, "Could not listen to channel '%s' - could not acquire connection", channel.c_str());
+			return false;
+		}
+	}
+	const std::string& query = core::string::format("LISTEN \"%s\";", channel.c_str());
+	State s(_listenConnection);
+	if (!s.exec(query.c_str())) {
+		Log::warn(logid, "Failed to execute query: '%s'", query.c_str());
+		return false;
+	}
+	Log::debug(logid, "Listen to channel '%s'", channel.c_str());
+	return true;
+}
+
+int DBHandler::notifications(const std::function<void(const char* channel, const char* payload)>& func) {
+	if (_listenConnection == nullptr) {
+		return 0;
+	}
+	int amount = 0;
+#ifdef HAVE_POSTGRES
+	ConnectionType* conn = _listenConnection->connection();
+	if (PQconsumeInput(conn) == 0) {
+		Log::warn(logid, "Failed to read the notifications: %s", PQerrorMessage(conn));
+		return 0;
+	}
+	while (PGnotify* notify = PQnotifies(conn)) {
+		func(notify->relname, notify->extra);
+		PQfreemem(notify);
+		++amount;
+	}
+#endif
+	return amount;
+}
+
 bool DBHandler::exec(const std::string& query) const {
 	return execInternal(query).result;
 }
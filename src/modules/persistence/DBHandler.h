@@ -21,6 +21,7 @@
 #include "DBCondition.h"
 #include "OrderBy.h"
 #include <memory>
+#include <functional>
 
 namespace persistence {
 
@@ -54,6 +55,7 @@ private:
 			return false;
 		}
 		State s(scoped.connection());
+		bool sent;
 		if (conditionAmount > 0) {
 			BindParam params(conditionAmount);
 			for (int i = 0; i < conditionAmount; ++i) {
@@ -62,22 +64,34 @@ private:
 				Log::debug(logid, "Parameter %i: '%s'", index + 1, value);
 				params.values[index] = value;
 			}
-			if (!s.exec(query.c_str(), conditionAmount, &params.values[0])) {
-				Log::error("Failed to execute query '%s' with %i parameters", query.c_str(), conditionAmount);
+			sent = s.sendQuery(query.c_str(), conditionAmount, &params.values[0]);
+		} else {
+			sent = s.sendQuery(query.c_str());
+		}
+		if (!sent) {
+			Log::error("Failed to execute query '%s' with %i parameters", query.c_str(), conditionAmount);
+			return false;
+		}
+		// the rows are decoded and handed to the callback as they arrive
+		while (s.nextRow()) {
+			while (s.currentRow < s.affectedRows) {
+				typename std::remove_reference<MODEL>::type selectedModel;
+				if (!selectedModel.fillModelValues(s)) {
+					return false;
+				}
+				func(std::move(selectedModel));
 			}
-		} else if (!s.exec(query.c_str())) {
-			Log::error("Failed to execute query '%s'", query.c_str());
 		}
-		for (int i = 0; i < s.affectedRows; ++i) {
-			typename std::remove_reference<MODEL>::type selectedModel;
-			selectedModel.fillModelValues(s);
-			func(std::move(selectedModel));
+		if (!s.result) {
+			Log::error("Failed to execute query '%s'", query.c_str());
 		}
 		return s.result;
 	}
 
 	bool _initialized = false;
 	const bool _useForeignKeys;
+	// the connection that receives the notifications of the subscribed channels
+	Connection* _listenConnection = nullptr;
 
 public:
 	DBHandler(bool useForeignKeys = true);
@@ -261,6 +275,21 @@ public:
 	 */
 	bool exec(const std::string& query) const;
 
+	/**
+	 * @brief Subscribes to the given notification channel (see postgres @c LISTEN and @c NOTIFY).
+	 * @note One connection of the pool is reserved for the notifications until @c shutdown() is called.
+	 * @return @c true if the statement was executed successfully, @c false otherwise.
+	 */
+	bool listen(const std::string& channel);
+
+	/**
+	 * @brief Polls the notifications of the subscribed channels without blocking
+	 * @param[in] func Gets the channel and the payload of every notification that arrived since the last call
+	 * @return The amount of notifications
+	 * @sa listen()
+	 */
+	int notifications(const std::function<void(const char* channel, const char* payload)>& func);
+
 	// transactions
 	bool begin();
 	bool commit();
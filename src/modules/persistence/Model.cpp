@@ -15,6 +15,8 @@
 
 #ifdef HAVE_POSTGRES
 #include <libpq-fe.h>
+#include <SDL_endian.h>
+#include <string.h>
 #endif
 
 namespace persistence {
@@ -44,18 +46,86 @@ const Field& Model::getField(const char* name) const {
 	return emptyField;
 }
 
-bool Model::fillModelValues(State& state) {
+#ifdef HAVE_POSTGRES
+/**
+ * @brief Integers are sent in network byte order in the binary format
+ */
+static int64_t binaryToLong(const char* value, int length) {
+	switch (length) {
+	case 1:
+		return (int8_t)value[0];
+	case 2: {
+		uint16_t v;
+		memcpy(&v, value, sizeof(v));
+		return (int16_t)SDL_SwapBE16(v);
+	}
+	case 4: {
+		uint32_t v;
+		memcpy(&v, value, sizeof(v));
+		return (int32_t)SDL_SwapBE32(v);
+	}
+	case 8: {
+		uint64_t v;
+		memcpy(&v, value, sizeof(v));
+		return (int64_t)SDL_SwapBE64(v);
+	}
+	default:
+		break;
+	}
+	return 0l;
+}
+
+static double binaryToDouble(const char* value, int length) {
+	if (length == 8) {
+		uint64_t v;
+		memcpy(&v, value, sizeof(v));
+		v = SDL_SwapBE64(v);
+		double d;
+		memcpy(&d, &v, sizeof(d));
+		return d;
+	}
+	if (length == 4) {
+		uint32_t v;
+		memcpy(&v, value, sizeof(v));
+		v = SDL_SwapBE32(v);
+		float f;
+		memcpy(&f, &v, sizeof(f));
+		return f;
+	}
+	return 0.0;
+}
+#endif
+
+bool Model::resolveColumns(State& state) const {
 #ifdef HAVE_POSTGRES
 	const int cols = state.cols;
-	Log::debug("Query has values for %i cols", cols);
+	state.columns.resize(cols);
 	for (int i = 0; i < cols; ++i) {
 		const char* name = PQfname(state.res, i);
 		const Field& f = getField(name);
 		if (f.name != name) {
 			Log::error("Unknown field name for '%s'", name);
+			state.columns.clear();
 			state.result = false;
 			return false;
 		}
+		state.columns[i] = &f;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool Model::fillModelValues(State& state) {
+#ifdef HAVE_POSTGRES
+	const int cols = state.cols;
+	Log::debug("Query has values for %i cols", cols);
+	if ((int)state.columns.size() != cols && !resolveColumns(state)) {
+		return false;
+	}
+	for (int i = 0; i < cols; ++i) {
+		const Field& f = *state.columns[i];
 		const bool isNull = PQgetisnull(state.res, state.currentRow, i);
 		const char* value = isNull ? nullptr : PQgetvalue(state.res, state.currentRow, i);
 		int length = PQgetlength(state.res, state.currentRow, i);
@@ -63,39 +133,45 @@ bool Model::fillModelValues(State& state) {
 			value = "";
 			length = 0;
 		}
-		Log::debug("Try to set '%s' to '%s' (length: %i)", name, value, length);
+		const bool binary = PQfformat(state.res, i) == 1;
+		if (binary) {
+			Log::trace("Try to set '%s' (binary length: %i)", f.name.c_str(), length);
+		} else {
+			Log::trace("Try to set '%s' to '%s' (length: %i)", f.name.c_str(), value, length);
+		}
 		switch (f.type) {
 		case FieldType::PASSWORD:
 		case FieldType::TEXT:
-			setValue(f, std::string(value, length));
+			setValue(f, value, length, false);
 			break;
 		case FieldType::STRING:
-			if (f.isLower()) {
-				setValue(f, core::string::toLower(std::string(value, length)));
-			} else {
-				setValue(f, std::string(value, length));
-			}
+			setValue(f, value, length, f.isLower());
 			break;
 		case FieldType::BOOLEAN:
-			setValue(f, *value == '1' || *value == 't' || *value == 'y' || *value == 'o' || *value == 'T');
+			if (binary) {
+				setValue(f, length > 0 && *value != '\0');
+			} else {
+				setValue(f, *value == '1' || *value == 't' || *value == 'y' || *value == 'o' || *value == 'T');
+			}
 			break;
 		case FieldType::INT:
-			setValue(f, core::string::toInt(value));
+			setValue(f, (int32_t)(binary ? binaryToLong(value, length) : core::string::toInt(value)));
 			break;
 		case FieldType::SHORT:
-			setValue(f, (int16_t)core::string::toInt(value));
+			setValue(f, (int16_t)(binary ? binaryToLong(value, length) : core::string::toInt(value)));
 			break;
 		case FieldType::BYTE:
-			setValue(f, (uint8_t)core::string::toInt(value));
+			setValue(f, (int8_t)(binary ? binaryToLong(value, length) : core::string::toInt(value)));
 			break;
 		case FieldType::LONG:
-			setValue(f, core::string::toLong(value));
+			setValue(f, binary ? binaryToLong(value, length) : (int64_t)core::string::toLong(value));
 			break;
 		case FieldType::DOUBLE:
-			setValue(f, core::string::toFloat(value));
+			setValue(f, binary ? binaryToDouble(value, length) : (double)core::string::toFloat(value));
 			break;
 		case FieldType::TIMESTAMP: {
-			setValue(f, Timestamp(core::string::toLong(value)));
+			// selected as epoch seconds - see createSelect()
+			setValue(f, Timestamp(binary ? binaryToLong(value, length) : core::string::toLong(value)));
 			break;
 		}
 		case FieldType::MAX:
@@ -110,6 +186,17 @@ bool Model::fillModelValues(State& state) {
 #endif
 }
 
+void Model::setValue(const Field& f, const char* value, int length, bool lower) {
+	core_assert(f.offset >= 0);
+	uint8_t* target = (uint8_t*)(_membersPointer + f.offset);
+	std::string* targetValue = (std::string*)target;
+	targetValue->assign(value, length);
+	if (lower) {
+		std::transform(targetValue->begin(), targetValue->end(), targetValue->begin(), (int (*)(int)) std::tolower);
+	}
+	setValid(f, true);
+}
+
 void Model::setValue(const Field& f, const std::string& value) {
 	core_assert(f.offset >= 0);
 	uint8_t* target = (uint8_t*)(_membersPointer + f.offset);
@@ -49,17 +49,25 @@ protected:
 	const ForeignKeysPtr _foreignKeys;
 	const PrimaryKeysPtr _primaryKeys;
 
+	bool resolveColumns(State& state) const;
 	/**
-	 * @brief Put the current row into this model instance.
-	 * @param[in,out] state The State of the query. Increases the current row for
-	 * each new model that calls this
+	 * @brief Assigns the string value without a temporary copy
 	 */
-	bool fillModelValues(State& state);
+	void setValue(const Field& f, const char* value, int length, bool lower);
 public:
 	Model(const char* schema, const char*tableName, const FieldsPtr fields, const ConstraintsPtr constraints,
 			const UniqueKeysPtr uniqueKeys, const ForeignKeysPtr foreignKeys, const PrimaryKeysPtr primaryKeys);
 	virtual ~Model();
 
+	/**
+	 * @brief Put the current row into this model instance.
+	 * @param[in,out] state The State of the query. Increases the current row for
+	 * each new model that calls this
+	 * @note The values can be in text or in binary format (see @c State::sendQuery()). The columns are mapped
+	 * to the fields only once per statement.
+	 */
+	bool fillModelValues(State& state);
+
 	/**
 	 * @return The table name without schema
 	 * @see schema()
@@ -18,21 +18,41 @@ State::State(Connection* connection) :
 }
 
 State::State(State&& other) :
-		res(other.res), lastErrorMsg(other.lastErrorMsg), affectedRows(
-				other.affectedRows), result(other.result) {
+		_connection(other._connection), _streaming(other._streaming), res(other.res), lastErrorMsg(other.lastErrorMsg), affectedRows(
+				other.affectedRows), cols(other.cols), currentRow(other.currentRow), columns(std::move(other.columns)), result(other.result) {
 	other.res = nullptr;
 	other._connection = nullptr;
+	other._streaming = false;
 	other.lastErrorMsg = nullptr;
 }
 
 State::~State() {
+	clearResult();
+	// the connection goes back into the pool - it must not have pending results
+	drain();
+	lastErrorMsg = nullptr;
+}
+
+void State::clearResult() {
 	if (res != nullptr) {
 #ifdef HAVE_POSTGRES
 		PQclear(res);
 #endif
 		res = nullptr;
 	}
-	lastErrorMsg = nullptr;
+}
+
+void State::drain() {
+	if (!_streaming) {
+		return;
+	}
+	_streaming = false;
+#ifdef HAVE_POSTGRES
+	ConnectionType* c = _connection->connection();
+	while (ResultType* r = PQgetResult(c)) {
+		PQclear(r);
+	}
+#endif
 }
 
 bool State::exec(const char *statement, int parameterCount, const char *const *paramValues) {
@@ -73,6 +93,69 @@ bool State::execPrepared(const char *name, int parameterCount, const char *const
 	return result;
 }
 
+bool State::sendQuery(const char *statement, int parameterCount, const char *const *paramValues, bool binary) {
+	core_assert_msg(parameterCount <= 0 || paramValues != nullptr, "Parameters don't match");
+	core_assert_msg(!_streaming, "There are still pending results");
+	clearResult();
+	columns.clear();
+	affectedRows = 0;
+	currentRow = 0;
+	result = false;
+#ifdef HAVE_POSTGRES
+	ConnectionType* c = _connection->connection();
+	if (PQsendQueryParams(c, statement, parameterCount, nullptr, paramValues, nullptr, nullptr, binary ? 1 : 0) == 0) {
+		lastErrorMsg = PQerrorMessage(c);
+		Log::error("Failed to send query: %s", lastErrorMsg);
+		return false;
+	}
+	_streaming = true;
+	if (PQsetSingleRowMode(c) == 0) {
+		Log::warn("Could not switch into single row mode - the whole result set is fetched at once");
+	}
+	result = true;
+#endif
+	return result;
+}
+
+bool State::nextRow() {
+	if (!_streaming) {
+		return false;
+	}
+	clearResult();
+#ifdef HAVE_POSTGRES
+	ConnectionType* c = _connection->connection();
+	for (;;) {
+		res = PQgetResult(c);
+		if (res == nullptr) {
+			_streaming = false;
+			affectedRows = 0;
+			return false;
+		}
+		const ExecStatusType lastState = PQresultStatus(res);
+		if (lastState == PGRES_SINGLE_TUPLE || lastState == PGRES_TUPLES_OK) {
+			affectedRows = PQntuples(res);
+			cols = PQnfields(res);
+			currentRow = 0;
+			if (affectedRows > 0) {
+				return true;
+			}
+			// the final (empty) result of the single row mode
+			clearResult();
+			continue;
+		}
+		checkLastResult(c);
+		clearResult();
+		affectedRows = 0;
+		if (!result) {
+			drain();
+			return false;
+		}
+	}
+#else
+	return false;
+#endif
+}
+
 void State::checkLastResult(ConnectionType* connection) {
 	affectedRows = 0;
 	if (res == nullptr) {
@@ -101,6 +184,7 @@ void State::checkLastResult(ConnectionType* connection) {
 	case PGRES_EMPTY_QUERY:
 	case PGRES_COMMAND_OK:
 	case PGRES_TUPLES_OK:
+	case PGRES_SINGLE_TUPLE:
 		affectedRows = PQntuples(res);
 		cols = PQnfields(res);
 		currentRow = 0;
@@ -7,15 +7,22 @@
 #include "ForwardDecl.h"
 #include "core/NonCopyable.h"
 #include <string>
+#include <vector>
 
 namespace persistence {
 
+struct Field;
+
 class State : public core::NonCopyable {
 private:
 	Connection* _connection = nullptr;
+	// a query was sent with sendQuery() and not all results were fetched yet
+	bool _streaming = false;
 	void checkLastResult(ConnectionType* connection);
+	void clearResult();
+	void drain();
 public:
-	constexpr State() {
+	State() {
 	}
 
 	State(Connection* connection);
@@ -26,12 +33,31 @@ public:
 	bool prepare(const char *name, const char* statement, int parameterCount);
 	bool execPrepared(const char *name, int parameterCount, const char *const *paramValues);
 
+	/**
+	 * @brief Sends the statement without waiting for the result. The rows are handed out one by one by
+	 * @c nextRow() as they arrive - the result set is never fully held in memory.
+	 * @param[in] binary Request the values in the binary format - this saves the string parsing on
+	 * decoding the values
+	 * @return @c false if the statement could not be sent
+	 */
+	bool sendQuery(const char* statement, int parameterCount = 0, const char *const *paramValues = nullptr, bool binary = true);
+	/**
+	 * @brief Fetches the next row of the statement that was sent with @c sendQuery()
+	 * @return @c true if a new row is available in @c res. @c false if all rows were fetched or an error
+	 * occurred - check @c result in that case.
+	 * @note In case the connection could not be switched into the single row mode, @c res contains all rows
+	 * of the result set - @c affectedRows is more than one then.
+	 */
+	bool nextRow();
+
 	ResultType* res = nullptr;
 
 	char* lastErrorMsg = nullptr;
 	int affectedRows = -1;
 	int cols = -1;
 	int currentRow = -1;
+	// the fields of the model the result columns are mapped to - resolved once per statement
+	std::vector<const Field*> columns;
 	// false on error, true on success
 	bool result = false;
 };
@@ -0,0 +1,217 @@
+/**
+ * @file
+ */
+
+#include "core/benchmark/AbstractBenchmark.h"
+#include "core/Var.h"
+#include "core/GameConfig.h"
+#include "core/Singleton.h"
+#include "persistence/DBHandler.h"
+#include "persistence/ConnectionPool.h"
+#include "persistence/State.h"
+#include "persistence/ScopedConnection.h"
+#include "TestModels.h"
+#include <libpq-fe.h>
+#include <string.h>
+
+namespace {
+
+const int DecodeRows = 10000;
+const int SelectRows = 1000000;
+
+template<class T>
+std::string toBigEndian(T value) {
+	std::string data(sizeof(T), '\0');
+	uint8_t* p = (uint8_t*)&data[0];
+	for (size_t i = 0; i < sizeof(T); ++i) {
+		p[i] = (uint8_t)((uint64_t)value >> (8 * (sizeof(T) - 1 - i)));
+	}
+	return data;
+}
+
+/**
+ * @brief Builds a select result for the test model without a database connection
+ */
+PGresult* createResult(bool binary, int rows) {
+	const char* names[] = { "id", "email", "name", "points", "someboolean", "somedouble", "someshort",
+			"somebyte", "registrationdate" };
+	const int cols = (int)SDL_arraysize(names);
+	PGresAttDesc attrs[SDL_arraysize(names)];
+	memset(attrs, 0, sizeof(attrs));
+	for (int i = 0; i < cols; ++i) {
+		attrs[i].name = (char*)names[i];
+		attrs[i].format = binary ? 1 : 0;
+	}
+	PGresult* res = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+	PQsetResultAttrs(res, cols, attrs);
+	const double somedouble = 1.5;
+	uint64_t somedoubleBits;
+	memcpy(&somedoubleBits, &somedouble, sizeof(somedoubleBits));
+	for (int row = 0; row < rows; ++row) {
+		std::string values[SDL_arraysize(names)];
+		const std::string& mail = core::string::format("Mail%i@example.com", row);
+		if (binary) {
+			values[0] = toBigEndian<int64_t>(row);
+			values[3] = toBigEndian<int32_t>(row);
+			values[4] = std::string(1, '\1');
+			values[5] = toBigEndian<uint64_t>(somedoubleBits);
+			values[6] = toBigEndian<int16_t>(row & 0x7fff);
+			values[7] = toBigEndian<int16_t>(row & 0x7f);
+			values[8] = toBigEndian<int64_t>(1500000000l + row);
+		} else {
+			values[0] = std::to_string(row);
+			values[3] = std::to_string(row);
+			values[4] = "t";
+			values[5] = "1.5";
+			values[6] = std::to_string(row & 0x7fff);
+			values[7] = std::to_string(row & 0x7f);
+			values[8] = std::to_string(1500000000l + row);
+		}
+		values[1] = mail;
+		values[2] = mail;
+		for (int i = 0; i < cols; ++i) {
+			PQsetvalue(res, row, i, (char*)values[i].data(), (int)values[i].size());
+		}
+	}
+	return res;
+}
+
+}
+
+namespace persistence {
+
+class PersistenceBenchmark: public core::AbstractBenchmark {
+protected:
+	DBHandler _dbHandler;
+
+	bool onInitApp() override {
+		core::Var::get(cfg::DatabaseMinConnections, "1");
+		core::Var::get(cfg::DatabaseMaxConnections, "2");
+		core::Var::get(cfg::DatabaseName, "enginetest");
+		core::Var::get(cfg::DatabaseHost, "localhost");
+		core::Var::get(cfg::DatabaseUser, "engine");
+		core::Var::get(cfg::DatabasePassword, "engine");
+		return true;
+	}
+
+	void onCleanupApp() override {
+		_dbHandler.shutdown();
+	}
+
+	int64_t count() const {
+		ScopedConnection scoped(core::Singleton<ConnectionPool>::getInstance().connection());
+		if (!scoped) {
+			return -1;
+		}
+		State s(scoped.connection());
+		if (!s.exec(R"(SELECT COUNT(*) FROM "public"."test")") || s.affectedRows != 1) {
+			return -1;
+		}
+		return core::string::toLong(PQgetvalue(s.res, 0, 0));
+	}
+
+	/**
+	 * @brief Fills the test table with @c SelectRows entries - only done once
+	 */
+	bool prepareTable() {
+		if (!_dbHandler.init()) {
+			return false;
+		}
+		if (!_dbHandler.createOrUpdateTable(db::TestModel())) {
+			return false;
+		}
+		if (count() == SelectRows) {
+			return true;
+		}
+		if (!_dbHandler.truncate(db::TestModel())) {
+			return false;
+		}
+		const int batchSize = 1000;
+		std::vector<db::TestModel> models(batchSize);
+		for (int row = 0; row < SelectRows; row += batchSize) {
+			for (int i = 0; i < batchSize; ++i) {
+				db::TestModel& mdl = models[i];
+				mdl = db::TestModel();
+				const std::string& mail = core::string::format("mail%i@example.com", row + i);
+				mdl.setEmail(mail);
+				mdl.setName(mail);
+				mdl.setPassword("secret");
+				mdl.setPoints(row + i);
+				mdl.setSomedouble(1.5);
+				mdl.setRegistrationdate(Timestamp::now());
+			}
+			if (!_dbHandler.insert(models)) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+/**
+ * Decodes @c DecodeRows rows into the model - text (0) and binary (1) result format
+ */
+BENCHMARK_DEFINE_F(PersistenceBenchmark, decode)(benchmark::State& state) {
+	const bool binary = state.range(0) != 0;
+	State result;
+	result.res = createResult(binary, DecodeRows);
+	result.cols = PQnfields(result.res);
+	result.affectedRows = DecodeRows;
+	while (state.KeepRunning()) {
+		result.currentRow = 0;
+		result.columns.clear();
+		for (int i = 0; i < DecodeRows; ++i) {
+			db::TestModel model;
+			if (!model.fillModelValues(result)) {
+				state.SkipWithError("Failed to decode the row");
+				return;
+			}
+			benchmark::DoNotOptimize(model);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * DecodeRows);
+}
+
+/**
+ * Select @c SelectRows rows from a local postgres - the complete result set in text format (0) or
+ * the streamed binary rows of the @c DBHandler (1)
+ */
+BENCHMARK_DEFINE_F(PersistenceBenchmark, select)(benchmark::State& state) {
+	if (!prepareTable()) {
+		state.SkipWithError("No database available");
+		return;
+	}
+	const bool stream = state.range(0) != 0;
+	BindParam params(10);
+	const std::string& query = createSelect(db::TestModel(), &params);
+	int64_t rows = 0;
+	while (state.KeepRunning()) {
+		if (stream) {
+			_dbHandler.select(db::TestModel(), DBConditionOne(), [&rows] (db::TestModel&& model) {
+				benchmark::DoNotOptimize(model);
+				++rows;
+			});
+			continue;
+		}
+		ScopedConnection scoped(core::Singleton<ConnectionPool>::getInstance().connection());
+		State s(scoped.connection());
+		if (!s.exec(query.c_str())) {
+			state.SkipWithError("Failed to execute the select");
+			return;
+		}
+		for (int i = 0; i < s.affectedRows; ++i) {
+			db::TestModel model;
+			model.fillModelValues(s);
+			benchmark::DoNotOptimize(model);
+			++rows;
+		}
+	}
+	state.SetItemsProcessed(rows);
+}
+
+BENCHMARK_REGISTER_F(PersistenceBenchmark, decode)->Arg(0)->Arg(1);
+BENCHMARK_REGISTER_F(PersistenceBenchmark, select)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+}
+
+BENCHMARK_MAIN()
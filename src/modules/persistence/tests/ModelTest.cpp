@@ -0,0 +1,112 @@
+/**
+ * @file
+ */
+
+#include "core/tests/AbstractTest.h"
+#include "persistence/Model.h"
+#include "persistence/State.h"
+#include "TestModels.h"
+#include <libpq-fe.h>
+#include <string.h>
+
+namespace persistence {
+
+class ModelTest : public core::AbstractTest {
+protected:
+	struct Column {
+		const char* name;
+		std::string value;
+	};
+
+	/**
+	 * @brief Creates the result of a select without a database connection
+	 */
+	void fill(State& state, const std::vector<Column>& columns, bool binary) {
+		std::vector<PGresAttDesc> attrs(columns.size());
+		memset(&attrs[0], 0, attrs.size() * sizeof(PGresAttDesc));
+		for (size_t i = 0; i < columns.size(); ++i) {
+			attrs[i].name = (char*)columns[i].name;
+			attrs[i].format = binary ? 1 : 0;
+		}
+		state.res = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+		ASSERT_NE(nullptr, state.res);
+		ASSERT_EQ(1, PQsetResultAttrs(state.res, (int)attrs.size(), &attrs[0]));
+		for (size_t i = 0; i < columns.size(); ++i) {
+			ASSERT_EQ(1, PQsetvalue(state.res, 0, (int)i, (char*)columns[i].value.data(), (int)columns[i].value.size()));
+		}
+		state.cols = (int)columns.size();
+		state.affectedRows = 1;
+		state.currentRow = 0;
+	}
+
+	template<class T>
+	static std::string be(T value) {
+		std::string data(sizeof(T), '\0');
+		uint8_t* p = (uint8_t*)&data[0];
+		for (size_t i = 0; i < sizeof(T); ++i) {
+			p[i] = (uint8_t)((uint64_t)value >> (8 * (sizeof(T) - 1 - i)));
+		}
+		return data;
+	}
+
+	void check(const db::TestModel& model) {
+		EXPECT_EQ(42, model.id());
+		EXPECT_EQ("mail@example.com", model.email());
+		EXPECT_EQ("Name", model.name());
+		ASSERT_NE(nullptr, model.points());
+		EXPECT_EQ(-5, *model.points());
+		ASSERT_NE(nullptr, model.someboolean());
+		EXPECT_TRUE(*model.someboolean());
+		ASSERT_NE(nullptr, model.somedouble());
+		EXPECT_DOUBLE_EQ(1.5, *model.somedouble());
+		ASSERT_NE(nullptr, model.someshort());
+		EXPECT_EQ(-300, *model.someshort());
+		ASSERT_NE(nullptr, model.somebyte());
+		EXPECT_EQ(7, *model.somebyte());
+		EXPECT_EQ(1500000000u, model.registrationdate().seconds());
+	}
+};
+
+TEST_F(ModelTest, testFillText) {
+	State state;
+	fill(state, {{"id", "42"}, {"email", "MAIL@example.com"}, {"name", "Name"}, {"points", "-5"},
+			{"someboolean", "t"}, {"somedouble", "1.5"}, {"someshort", "-300"}, {"somebyte", "7"},
+			{"registrationdate", "1500000000"}}, false);
+	db::TestModel model;
+	ASSERT_TRUE(model.fillModelValues(state));
+	EXPECT_EQ(1, state.currentRow);
+	check(model);
+}
+
+TEST_F(ModelTest, testFillBinary) {
+	uint64_t doubleBits;
+	const double doubleValue = 1.5;
+	memcpy(&doubleBits, &doubleValue, sizeof(doubleBits));
+	State state;
+	fill(state, {{"id", be<int64_t>(42)}, {"email", "MAIL@example.com"}, {"name", "Name"}, {"points", be<int32_t>(-5)},
+			{"someboolean", std::string(1, '\1')}, {"somedouble", be<uint64_t>(doubleBits)}, {"someshort", be<int16_t>(-300)},
+			{"somebyte", be<int16_t>(7)}, {"registrationdate", be<int64_t>(1500000000)}}, true);
+	db::TestModel model;
+	ASSERT_TRUE(model.fillModelValues(state));
+	EXPECT_EQ(1, state.currentRow);
+	check(model);
+}
+
+TEST_F(ModelTest, testFillNull) {
+	State state;
+	fill(state, {{"id", be<int64_t>(1)}, {"points", ""}}, true);
+	PQsetvalue(state.res, 0, 1, nullptr, -1);
+	db::TestModel model;
+	ASSERT_TRUE(model.fillModelValues(state));
+	EXPECT_EQ(nullptr, model.points());
+}
+
+TEST_F(ModelTest, testFillUnknownColumn) {
+	State state;
+	fill(state, {{"unknown", "1"}}, false);
+	db::TestModel model;
+	EXPECT_FALSE(model.fillModelValues(state));
+	EXPECT_FALSE(state.result);
+}
+
+}
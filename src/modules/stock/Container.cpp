@@ -8,11 +8,56 @@
 
 namespace stock {
 
-void Container::init(const ContainerShape& shape) {
+void Container::init(const ContainerShape& shape, uint32_t flags) {
+	clear();
 	_shape = shape;
+	_flags = flags;
 	_items.reserve(64);
 }
 
+void Container::clear() {
+	_items.clear();
+	_itemIndex.clear();
+	_cellIndex.clear();
+	_idCount.clear();
+	_typeCount.clear();
+	_shape.clearShapes();
+	for (int row = 0; row < ContainerMaxHeight; ++row) {
+		_origins[row] = (ContainerShapeType)0;
+	}
+}
+
+void Container::index(size_t i) {
+	const ContainerItem& ci = _items[i];
+	_itemIndex[ci.item.get()] = i;
+	if ((_flags & Scrollable) == 0) {
+		_cellIndex[cell(ci.x, ci.y)] = i;
+	}
+}
+
+void Container::removeAt(size_t i) {
+	const ContainerItem& ci = _items[i];
+	const ItemPtr& item = ci.item;
+	_itemIndex.erase(item.get());
+	if (--_idCount[item->id()] <= 0) {
+		_idCount.erase(item->id());
+	}
+	if (--_typeCount[item->type()] <= 0) {
+		_typeCount.erase(item->type());
+	}
+	if ((_flags & Scrollable) == 0) {
+		_cellIndex.erase(cell(ci.x, ci.y));
+		_origins[ci.y] &= ~((ContainerShapeType)1 << ci.x);
+		_shape.removeShape(static_cast<ItemShapeType>(item->shape()), ci.x, ci.y);
+	}
+	const size_t last = _items.size() - 1;
+	if (i != last) {
+		_items[i] = std::move(_items[last]);
+		index(i);
+	}
+	_items.pop_back();
+}
+
 bool Container::canAdd(const ItemPtr& item, uint8_t x, uint8_t y) const {
 	if (item == nullptr) {
 		return false;
@@ -38,42 +83,94 @@ bool Container::add(const ItemPtr& item) {
 	if (!findSpace(item, x, y)) {
 		return false;
 	}
-	if (!canAdd(item, x, y)) {
+	return add(item, x, y);
+}
+
+int Container::add(const std::vector<ItemPtr>& items) {
+	std::vector<ItemPtr> sorted(items);
+	sortBySize(sorted);
+	int added = 0;
+	for (const ItemPtr& item : sorted) {
+		if (add(item)) {
+			++added;
+		}
+	}
+	return added;
+}
+
+void Container::sortBySize(std::vector<ItemPtr>& items) {
+	std::stable_sort(items.begin(), items.end(), [] (const ItemPtr& a, const ItemPtr& b) {
+		if (a == nullptr || b == nullptr) {
+			return b == nullptr && a != nullptr;
+		}
+		return a->shape().size() > b->shape().size();
+	});
+}
+
+bool Container::sort() {
+	if ((_flags & Scrollable) != 0 || _items.size() <= 1) {
+		return true;
+	}
+	const ContainerItems previous = _items;
+	std::vector<ItemPtr> sorted;
+	sorted.reserve(previous.size());
+	for (const ContainerItem& ci : previous) {
+		sorted.push_back(ci.item);
+	}
+	sortBySize(sorted);
+	clear();
+	for (const ItemPtr& item : sorted) {
+		if (add(item)) {
+			continue;
+		}
+		clear();
+		for (const ContainerItem& ci : previous) {
+			add(ci.item, ci.x, ci.y);
+		}
 		return false;
 	}
-	return add(item, x, y);
+	return true;
 }
 
 auto Container::findById(ItemId id) const {
 	return std::find_if(_items.begin(), _items.end(), [id] (const ContainerItem& item) { return item.item->id() == id; });
 }
 
-auto Container::findByType(const ItemType& type) const {
-	return std::find_if(_items.begin(), _items.end(), [type] (const ContainerItem& item) { return item.item->type() == type; });
-}
-
 bool Container::hasItemOfType(const ItemType& itemType) const {
-	return findByType(itemType) != _items.end();
+	return _typeCount.find(itemType) != _typeCount.end();
 }
 
 bool Container::add(const ItemPtr& item, uint8_t x, uint8_t y) {
 	if (!canAdd(item, x, y)) {
 		return false;
 	}
+	if (_itemIndex.find(item.get()) != _itemIndex.end()) {
+		return false;
+	}
 	const ContainerItem ci = {item, x, y};
 	_items.push_back(ci);
-	_shape.addShape(static_cast<ItemShapeType>(item->shape()), x, y);
+	index(_items.size() - 1);
+	++_idCount[item->id()];
+	++_typeCount[item->type()];
+	if ((_flags & Scrollable) == 0) {
+		_origins[y] |= (ContainerShapeType)1 << x;
+		_shape.addShape(static_cast<ItemShapeType>(item->shape()), x, y);
+	}
 	return true;
 }
 
 bool Container::notifyRemove(const ItemPtr& item) {
+	auto i = _itemIndex.find(item.get());
+	if (i != _itemIndex.end()) {
+		removeAt(i->second);
+		return true;
+	}
+	// another instance with the same id
 	const ItemId id = item->id();
-	auto i = findById(id);
-	if (i == _items.end()) {
+	if (_idCount.find(id) == _idCount.end()) {
 		return false;
 	}
-	_shape.removeShape(static_cast<ItemShapeType>(item->shape()), i->x, i->y);
-	_items.erase(i);
+	removeAt(std::distance(_items.cbegin(), findById(id)));
 	return true;
 }
 
@@ -98,16 +195,35 @@ ItemPtr Container::get(uint8_t x, uint8_t y) const {
 		}
 		return _items.front().item;
 	}
-	for (const ContainerItem& item : _items) {
-		const ItemShape& shape = item.item->shape();
-		if (shape.isInShape(x - item.x, y - y)) {
-			return item.item;
+	if ((_flags & Scrollable) != 0) {
+		for (const ContainerItem& item : _items) {
+			if (x >= item.x && y >= item.y && x - item.x < ItemMaxWidth && y - item.y < ItemMaxHeight
+					&& item.item->shape().isInShape(x - item.x, y - item.y)) {
+				return item.item;
+			}
+		}
+		return ItemPtr();
+	}
+	// only the origins in the item sized area left and above of the given cell can cover it
+	const uint8_t minX = x >= ItemMaxWidth - 1 ? x - (ItemMaxWidth - 1) : 0;
+	const uint8_t minY = y >= ItemMaxHeight - 1 ? y - (ItemMaxHeight - 1) : 0;
+	const ContainerShapeType columns = (~(ContainerShapeType)0 >> (ContainerBitsPerRow - 1 - x)) & (~(ContainerShapeType)0 << minX);
+	for (int originY = y; originY >= minY; --originY) {
+		for (ContainerShapeType origins = _origins[originY] & columns; origins != (ContainerShapeType)0; origins &= origins - 1) {
+			const uint8_t originX = (uint8_t)firstBit(origins);
+			const ContainerItem& item = _items[_cellIndex.find(cell(originX, originY))->second];
+			if (item.item->shape().isInShape(x - originX, y - originY)) {
+				return item.item;
+			}
 		}
 	}
 	return ItemPtr();
 }
 
 bool Container::findSpace(const ItemPtr& item, uint8_t& targetX, uint8_t& targetY) const {
+	if (item == nullptr) {
+		return false;
+	}
 	// always fits into scrollable container
 	if ((_flags & Scrollable) != 0) {
 		targetX = targetY = 0u;
@@ -118,18 +234,10 @@ bool Container::findSpace(const ItemPtr& item, uint8_t& targetX, uint8_t& target
 	if ((_flags & Single) != 0 && !_items.empty()) {
 		return false;
 	}
-	for (uint8_t y = 0; y < ContainerMaxHeight; ++y) {
-		for (uint8_t x = 0; x < ContainerMaxWidth; ++x) {
-			if (!canAdd(item, x, y)) {
-				continue;
-			}
-			targetX = x;
-			targetY = y;
-			return true;
-		}
+	if ((_flags & Unique) != 0 && hasItemOfType(item->type())) {
+		return false;
 	}
-
-	return false;
+	return _shape.findFree(item->shape(), targetX, targetY);
 }
 
 }
@@ -6,6 +6,9 @@
 
 #include "Shape.h"
 #include "ItemData.h"
+#include "core/Common.h"
+#include <unordered_map>
+#include <vector>
 
 namespace stock {
 
@@ -13,10 +16,21 @@ class Item;
 typedef std::shared_ptr<Item> ItemPtr;
 
 /**
+ * @brief A container holds items at positions of its @c ContainerShape.
+ *
+ * The items are indexed by their instance, their @c ItemType and their origin cell - this keeps
+ * the lookups independent of the amount of items in the container.
  * @ingroup Stock
  */
 class Container {
 public:
+	/** each item can only be in here once */
+	static constexpr uint32_t Unique     = 1 << 0;
+	/** only a single item can be in this container */
+	static constexpr uint32_t Single     = 1 << 1;
+	/** a scrollable container can hold as many items as wanted */
+	static constexpr uint32_t Scrollable = 1 << 2;
+
 	struct ContainerItem {
 		ItemPtr item;
 		uint8_t x;
@@ -24,8 +38,11 @@ public:
 	};
 	typedef std::vector<ContainerItem> ContainerItems;
 
-	void init(const ContainerShape& shape);
+	void init(const ContainerShape& shape, uint32_t flags = 0u);
 
+	/**
+	 * @brief Removes all items from the container
+	 */
 	void clear();
 
 	const ContainerItems& items() const;
@@ -45,6 +62,26 @@ public:
 
 	bool add(const ItemPtr& item);
 
+	/**
+	 * @brief Adds the given items - the largest items are placed first to keep the free space together.
+	 * @return The amount of items that were added. The items that don't fit are skipped.
+	 */
+	int add(const std::vector<ItemPtr>& items);
+
+	/**
+	 * @brief Places all items again - ordered by their size, the largest first.
+	 * @return @c false if the items didn't fit with the new order. The previous positions are restored in this case.
+	 */
+	bool sort();
+
+	/**
+	 * @brief Orders the given items by the size of their shape - the largest first.
+	 */
+	static void sortBySize(std::vector<ItemPtr>& items);
+
+	/**
+	 * @brief Removes the given item instance - or the first item with the same @c ItemId
+	 */
 	bool notifyRemove(const ItemPtr& item);
 
 	ItemPtr remove(uint8_t x, uint8_t y);
@@ -57,18 +94,24 @@ public:
 private:
 	auto findById(ItemId id) const;
 
-	auto findByType(const ItemType& type) const;
+	static inline uint16_t cell(uint8_t x, uint8_t y) {
+		return (uint16_t)(y * ContainerMaxWidth + x);
+	}
 
-	/** each item can only be in here once */
-	static constexpr uint32_t Unique     = 1 << 0;
-	/** only a single item can be in this container */
-	static constexpr uint32_t Single     = 1 << 1;
-	/** a scrollable container can hold as many items as wanted */
-	static constexpr uint32_t Scrollable = 1 << 2;
+	void index(size_t i);
+	void removeAt(size_t i);
 
 	ContainerShape _shape;
 	uint32_t _flags = 0u;
 	ContainerItems _items;
+	/** item instance to the index in @c _items */
+	std::unordered_map<const Item*, size_t> _itemIndex;
+	/** the origin cell of an item to the index in @c _items */
+	std::unordered_map<uint16_t, size_t> _cellIndex;
+	std::unordered_map<ItemId, int> _idCount;
+	std::unordered_map<ItemType, int, EnumClassHash> _typeCount;
+	/** a bit is set for every cell that is the origin of an item */
+	ContainerShapeType _origins[ContainerMaxHeight] {};
 };
 
 inline int Container::size() const {
@@ -79,10 +122,6 @@ inline int Container::free() const {
 	return _shape.free();
 }
 
-inline void Container::clear() {
-	_items.clear();
-}
-
 inline size_t Container::itemCount() const {
 	return items().size();
 }
@@ -16,7 +16,7 @@ bool Inventory::initContainer(uint8_t containerId, const ContainerShape& shape,
 		return false;
 	}
 	Container& c = _containers[containerId];
-	c.init(shape);
+	c.init(shape, flags);
 	return true;
 }
 
@@ -51,6 +51,40 @@ bool Inventory::add(uint8_t containerId, const ItemPtr& item, uint8_t x, uint8_t
 	return c.add(item, x, y);
 }
 
+bool Inventory::sort(uint8_t containerId) {
+	if (containerId >= maxContainers()) {
+		return false;
+	}
+	Container& c = _containers[containerId];
+	return c.sort();
+}
+
+int Inventory::move(uint8_t fromContainerId, uint8_t toContainerId) {
+	if (fromContainerId >= maxContainers() || toContainerId >= maxContainers()) {
+		return 0;
+	}
+	if (fromContainerId == toContainerId) {
+		return 0;
+	}
+	Container& from = _containers[fromContainerId];
+	Container& to = _containers[toContainerId];
+	std::vector<ItemPtr> items;
+	items.reserve(from.items().size());
+	for (const Container::ContainerItem& ci : from.items()) {
+		items.push_back(ci.item);
+	}
+	Container::sortBySize(items);
+	int moved = 0;
+	for (const ItemPtr& item : items) {
+		if (!to.add(item)) {
+			continue;
+		}
+		from.notifyRemove(item);
+		++moved;
+	}
+	return moved;
+}
+
 ItemPtr Inventory::remove(uint8_t containerId, uint8_t x, uint8_t y) {
 	if (containerId >= maxContainers()) {
 		return ItemPtr();
@@ -35,6 +35,18 @@ public:
 
 	ItemPtr remove(uint8_t containerId, uint8_t x, uint8_t y);
 
+	/**
+	 * @brief Places the items of the given container again - the largest items first.
+	 * @see Container::sort()
+	 */
+	bool sort(uint8_t containerId);
+
+	/**
+	 * @brief Moves as many items as possible from one container into another one.
+	 * @return The amount of items that were moved
+	 */
+	int move(uint8_t fromContainerId, uint8_t toContainerId);
+
 	const Container* container(uint8_t containerId) const;
 
 	int id() const;
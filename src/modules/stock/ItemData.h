@@ -29,6 +29,10 @@ inline ItemType getItemType(const std::string& name) {
 }
 
 using ItemId = uint32_t;
+/**
+ * @brief Identifies the owner of a @c Stock - e.g. the user id
+ */
+using StockOwner = int64_t;
 
 /**
  * @brief Blueprint that describes a thing that can be managed by the Stock class.
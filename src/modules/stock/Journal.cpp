@@ -0,0 +1,158 @@
+/**
+ * @file
+ */
+
+#include "Journal.h"
+#include "core/Log.h"
+#include <unordered_map>
+#include <algorithm>
+#include <string.h>
+
+namespace stock {
+
+namespace {
+
+struct RecordHeader {
+	uint64_t transaction;
+	uint32_t entries;
+	uint32_t checksum;
+};
+
+struct RecordEntry {
+	int64_t owner;
+	int64_t delta;
+	uint32_t itemId;
+	uint32_t padding;
+};
+
+struct EntryKey {
+	StockOwner owner;
+	ItemId itemId;
+
+	inline bool operator==(const EntryKey& other) const {
+		return owner == other.owner && itemId == other.itemId;
+	}
+};
+
+struct EntryKeyHash {
+	inline size_t operator()(const EntryKey& key) const {
+		return std::hash<int64_t>()(key.owner) ^ (std::hash<uint32_t>()(key.itemId) << 1);
+	}
+};
+
+}
+
+Journal::Journal() :
+		_lock("stockjournal") {
+}
+
+uint32_t Journal::checksum(const uint8_t* data, size_t size) {
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0u; i < size; ++i) {
+		hash ^= data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+uint64_t Journal::append(const std::vector<JournalEntry>& entries) {
+	core::ScopedWriteLock lock(_lock);
+	const uint64_t transaction = ++_transactions;
+	const size_t start = _log.size();
+	const size_t entriesSize = entries.size() * sizeof(RecordEntry);
+	_log.resize(start + sizeof(RecordHeader) + entriesSize);
+	uint8_t* entriesData = &_log[start + sizeof(RecordHeader)];
+	for (const JournalEntry& entry : entries) {
+		const RecordEntry record = { entry.owner, entry.delta, entry.itemId, 0u };
+		memcpy(entriesData, &record, sizeof(record));
+		entriesData += sizeof(record);
+	}
+	const RecordHeader header = { transaction, (uint32_t)entries.size(), checksum(&_log[start + sizeof(RecordHeader)], entriesSize) };
+	memcpy(&_log[start], &header, sizeof(header));
+	_pending.insert(_pending.end(), entries.begin(), entries.end());
+	return transaction;
+}
+
+size_t Journal::coalesce(std::vector<JournalEntry>& entries) {
+	std::vector<JournalEntry> pending;
+	size_t position;
+	{
+		core::ScopedWriteLock lock(_lock);
+		pending.swap(_pending);
+		position = _log.size();
+	}
+	std::unordered_map<EntryKey, size_t, EntryKeyHash> index;
+	index.reserve(pending.size());
+	const size_t start = entries.size();
+	for (const JournalEntry& entry : pending) {
+		const EntryKey key = { entry.owner, entry.itemId };
+		auto i = index.find(key);
+		if (i == index.end()) {
+			index.insert(std::make_pair(key, entries.size()));
+			entries.push_back(entry);
+			continue;
+		}
+		entries[i->second].delta += entry.delta;
+	}
+	entries.erase(std::remove_if(entries.begin() + start, entries.end(), [] (const JournalEntry& entry) {
+		return entry.delta == 0;
+	}), entries.end());
+	return position;
+}
+
+void Journal::requeue(const std::vector<JournalEntry>& entries) {
+	core::ScopedWriteLock lock(_lock);
+	_pending.insert(_pending.begin(), entries.begin(), entries.end());
+}
+
+void Journal::checkpoint(size_t position) {
+	core::ScopedWriteLock lock(_lock);
+	if (position > _log.size()) {
+		Log::error("Invalid journal checkpoint %i", (int)position);
+		return;
+	}
+	_log.erase(_log.begin(), _log.begin() + position);
+}
+
+std::vector<uint8_t> Journal::data() const {
+	core::ScopedReadLock lock(_lock);
+	return _log;
+}
+
+uint64_t Journal::transactions() const {
+	core::ScopedReadLock lock(_lock);
+	return _transactions;
+}
+
+uint64_t Journal::replay(const uint8_t* data, size_t size, const ReplayFunc& func) {
+	uint64_t replayed = 0u;
+	size_t offset = 0u;
+	std::vector<JournalEntry> entries;
+	while (offset + sizeof(RecordHeader) <= size) {
+		RecordHeader header;
+		memcpy(&header, data + offset, sizeof(header));
+		const size_t entriesSize = (size_t)header.entries * sizeof(RecordEntry);
+		const uint8_t* entriesData = data + offset + sizeof(RecordHeader);
+		if (offset + sizeof(RecordHeader) + entriesSize > size) {
+			Log::warn("Incomplete journal record for transaction %u", (unsigned int)header.transaction);
+			break;
+		}
+		if (checksum(entriesData, entriesSize) != header.checksum) {
+			Log::warn("Corrupted journal record for transaction %u", (unsigned int)header.transaction);
+			break;
+		}
+		entries.clear();
+		for (uint32_t i = 0u; i < header.entries; ++i) {
+			RecordEntry record;
+			memcpy(&record, entriesData + i * sizeof(RecordEntry), sizeof(record));
+			entries.push_back(JournalEntry { record.owner, record.itemId, record.delta });
+		}
+		func(header.transaction, entries);
+		offset += sizeof(RecordHeader) + entriesSize;
+		++replayed;
+	}
+	return replayed;
+}
+
+}
@@ -0,0 +1,100 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "Item.h"
+#include "core/ReadWriteLock.h"
+#include <vector>
+#include <functional>
+#include <memory>
+#include <stdint.h>
+
+namespace stock {
+
+/**
+ * @brief One item amount change of a committed @c Transaction
+ * @ingroup Stock
+ */
+struct JournalEntry {
+	StockOwner owner;
+	ItemId itemId;
+	ItemAmount delta;
+};
+
+/**
+ * @brief Append-only journal of the committed @c Transaction instances.
+ *
+ * Every transaction is serialized as one record - a header with the amount of entries and a checksum
+ * over the record. A record that was only written partially (e.g. because the process crashed) is
+ * detected and skipped by @c replay().
+ *
+ * The entries that are not yet persisted are collected separately. @c coalesce() sums them up per owner
+ * and item - this is what is flushed to the database once per persistence tick. After the flush was
+ * successful, @c checkpoint() drops the records that are now part of the database state.
+ *
+ * @note All methods are thread safe - transactions are committed in the main loop while the persistence
+ * is done in a worker thread.
+ * @ingroup Stock
+ */
+class Journal {
+public:
+	/**
+	 * @param[in] transaction The sequence number of the transaction
+	 */
+	typedef std::function<void(uint64_t transaction, const std::vector<JournalEntry>& entries)> ReplayFunc;
+private:
+	core::ReadWriteLock _lock;
+	std::vector<uint8_t> _log;
+	std::vector<JournalEntry> _pending;
+	uint64_t _transactions = 0u;
+
+	static uint32_t checksum(const uint8_t* data, size_t size);
+public:
+	Journal();
+
+	/**
+	 * @brief Records the entries of one committed transaction
+	 * @return The sequence number of the transaction
+	 */
+	uint64_t append(const std::vector<JournalEntry>& entries);
+
+	/**
+	 * @brief Sums up the not yet persisted entries per owner and item. Entries that sum up to zero are dropped.
+	 * @param[out] entries The coalesced entries
+	 * @return The position in the journal log that is covered by the coalesced entries - see @c checkpoint()
+	 */
+	size_t coalesce(std::vector<JournalEntry>& entries);
+
+	/**
+	 * @brief Puts coalesced entries back if they could not get persisted
+	 */
+	void requeue(const std::vector<JournalEntry>& entries);
+
+	/**
+	 * @brief Drops the log records up to the given position - they are persisted now
+	 * @param[in] position The value that was returned by @c coalesce()
+	 */
+	void checkpoint(size_t position);
+
+	/**
+	 * @return A copy of the serialized records since the last checkpoint
+	 */
+	std::vector<uint8_t> data() const;
+
+	/**
+	 * @return The amount of transactions that were appended
+	 */
+	uint64_t transactions() const;
+
+	/**
+	 * @brief Calls the given function for every complete record in the serialized journal data.
+	 * @return The amount of transactions that were replayed. Stops at the first incomplete or corrupted record.
+	 */
+	static uint64_t replay(const uint8_t* data, size_t size, const ReplayFunc& func);
+};
+
+typedef std::shared_ptr<Journal> JournalPtr;
+
+}
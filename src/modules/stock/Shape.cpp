@@ -70,16 +70,44 @@ bool ContainerShape::isFree(const ItemShape& itemShape, uint8_t x, uint8_t y) co
 	return true;
 }
 
+bool ContainerShape::findFree(const ItemShape& itemShape, uint8_t& targetX, uint8_t& targetY) const {
+	const ItemShapeType shape = static_cast<ItemShapeType>(itemShape);
+	ContainerShapeType itemRows[ItemMaxHeight];
+	for (uint8_t row = 0; row < ItemMaxHeight; ++row) {
+		itemRows[row] = (shape >> (row * ItemMaxWidth)) & ItemRowLength;
+	}
+	for (uint8_t y = 0; y < ContainerMaxHeight; ++y) {
+		// the origin of the item must be part of the container shape
+		ContainerShapeType candidates = _containerShape[y];
+		for (uint8_t row = 0; row < ItemMaxHeight && candidates != (ContainerShapeType)0; ++row) {
+			ContainerShapeType itemRow = itemRows[row];
+			if (itemRow == (ContainerShapeType)0) {
+				continue;
+			}
+			if (y + row >= ContainerMaxHeight) {
+				candidates = (ContainerShapeType)0;
+				break;
+			}
+			const ContainerShapeType freeRow = _containerShape[y + row] & ~_itemShape[y + row];
+			/* A bit in the candidates survives if the cell for each bit of the item row is free.
+			 * Shifting to the right also drops the positions where the item would leave the row. */
+			for (; itemRow != (ContainerShapeType)0; itemRow &= itemRow - 1) {
+				candidates &= freeRow >> firstBit(itemRow);
+			}
+		}
+		if (candidates != (ContainerShapeType)0) {
+			targetX = (uint8_t)firstBit(candidates);
+			targetY = y;
+			return true;
+		}
+	}
+	return false;
+}
+
 int ContainerShape::free() const {
 	int bitCounter = 0;
 	for (int row = 0; row < ContainerMaxHeight; ++row) {
-		for (uint8_t i = 0; i < ContainerBitsPerRow; ++i) {
-			if ((_containerShape[row] & ((ItemShapeType)1 << i)) != 0) {
-				if ((_itemShape[row] & ((ItemShapeType)1 << i)) == 0) {
-					++bitCounter;
-				}
-			}
-		}
+		bitCounter += countBits(_containerShape[row] & ~_itemShape[row]);
 	}
 	return bitCounter;
 }
@@ -87,11 +115,7 @@ int ContainerShape::free() const {
 int ContainerShape::size() const {
 	int bitCounter = 0;
 	for (int row = 0; row < ContainerMaxHeight; ++row) {
-		for (uint8_t i = 0; i < ContainerBitsPerRow; ++i) {
-			if ((_containerShape[row] & ((ItemShapeType)1 << i)) != 0) {
-				++bitCounter;
-			}
-		}
+		bitCounter += countBits(_containerShape[row]);
 	}
 	return bitCounter;
 }
@@ -126,13 +150,7 @@ ItemShapeType ItemShape::set(uint8_t x, uint8_t y) {
 }
 
 int ItemShape::size() const {
-	int bitCounter = 0;
-	for (uint8_t i = 0; i < ItemBits; ++i) {
-		if ((_shape & ((ItemShapeType)1 << i)) != 0) {
-			++bitCounter;
-		}
-	}
-	return bitCounter;
+	return countBits(_shape);
 }
 
 static inline constexpr uint64_t calcItemShapeHeightMask() {
@@ -24,6 +24,37 @@ static constexpr uint8_t ItemMaxWidth = 8;
 static constexpr ItemShapeType ItemRowLength = 0xff; /* ItemMaxWidth bits */
 static_assert(ItemMaxWidth * ItemMaxHeight <= ItemBits, "width and height doesn't fit into the shapetype");
 
+/**
+ * @return The amount of bits that are set in the given row mask
+ */
+inline int countBits(uint64_t mask) {
+#ifdef _MSC_VER
+	int n = 0;
+	for (; mask != 0u; mask &= mask - 1u) {
+		++n;
+	}
+	return n;
+#else
+	return __builtin_popcountll(mask);
+#endif
+}
+
+/**
+ * @return The index of the lowest bit that is set in the given row mask
+ * @note The mask must not be @c 0
+ */
+inline int firstBit(uint64_t mask) {
+#ifdef _MSC_VER
+	int n = 0;
+	for (; (mask & 1u) == 0u; mask >>= 1) {
+		++n;
+	}
+	return n;
+#else
+	return __builtin_ctzll(mask);
+#endif
+}
+
 /**
  * @ingroup Stock
  */
@@ -104,11 +135,31 @@ public:
 
 	bool isFree(uint8_t x, uint8_t y) const;
 
+	/**
+	 * @brief Searches the first position (row by row) where the given item shape can be placed.
+	 *
+	 * The whole container rows are tested at once - the free cells of a row are shifted by every bit
+	 * of the item row and combined, the remaining bits are the valid x coordinates for the item.
+	 * @return @c false if there is no free space for the shape
+	 */
+	bool findFree(const ItemShape& shape, uint8_t& x, uint8_t& y) const;
+
+	/**
+	 * @brief Removes all item shapes - the container shape itself is kept
+	 */
+	void clearShapes();
+
 	int free() const;
 
 	int size() const;
 };
 
+inline void ContainerShape::clearShapes() {
+	for (int row = 0; row < ContainerMaxHeight; ++row) {
+		_itemShape[row] = (ContainerShapeType)0;
+	}
+}
+
 inline bool ContainerShape::isInShape(uint8_t x, uint8_t y) const {
 	core_assert_always(y < ContainerMaxHeight && x < ContainerMaxWidth);
 	return (_containerShape[y] & ((ContainerShapeType)1 << x)) != 0;
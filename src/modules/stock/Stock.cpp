@@ -10,8 +10,8 @@
 
 namespace stock {
 
-Stock::Stock(const StockDataProviderPtr& stockDataProvider) :
-		_inventory(), _stockDataProvider(stockDataProvider) {
+Stock::Stock(const StockDataProviderPtr& stockDataProvider, StockOwner owner) :
+		_inventory(), _stockDataProvider(stockDataProvider), _owner(owner) {
 }
 
 bool Stock::init() {
@@ -52,9 +52,10 @@ int Stock::remove(const ItemPtr& item) {
 	const ItemAmount amount = i->second->changeAmount(-item->amount());
 	if (amount <= 0) {
 		_items.erase(i);
+		_inventory.notifyRemove(item);
+		return 0;
 	}
-	_inventory.notifyRemove(item);
-	return i->second->amount();
+	return amount;
 }
 
 int Stock::count(const ItemType& itemType) const {
@@ -68,6 +69,39 @@ int Stock::count(const ItemType& itemType) const {
 	return n;
 }
 
+bool Stock::change(ItemId itemId, ItemAmount delta) {
+	if (delta == 0) {
+		return true;
+	}
+	auto i = find(itemId);
+	if (delta < 0) {
+		if (i == _items.end() || i->second->amount() < -delta) {
+			return false;
+		}
+		const ItemPtr& item = i->second;
+		if (item->changeAmount(delta) <= 0) {
+			_inventory.notifyRemove(item);
+			_items.erase(i);
+		}
+		return true;
+	}
+	if (i != _items.end()) {
+		i->second->changeAmount(delta);
+		return true;
+	}
+	const ItemPtr& item = _stockDataProvider->createItem(itemId);
+	if (!item) {
+		return false;
+	}
+	item->changeAmount(delta);
+	_items.insert(std::make_pair(itemId, item));
+	return true;
+}
+
+bool Stock::hasItemData(ItemId itemId) const {
+	return _stockDataProvider->itemData(itemId) != nullptr;
+}
+
 int Stock::count(ItemId itemId) const {
 	auto i = find(itemId);
 	if (i == _items.end()) {
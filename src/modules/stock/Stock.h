@@ -33,6 +33,7 @@ private:
 	/** The inventory has pointers to all the items distributed over all the Container instances in the Inventory. */
 	Inventory _inventory;
 	StockDataProviderPtr _stockDataProvider;
+	StockOwner _owner;
 
 	inline auto find(const ItemId& itemId) const {
 		return _items.find(itemId);
@@ -42,7 +43,7 @@ private:
 		return _items.find(itemId);
 	}
 public:
-	Stock(const StockDataProviderPtr& stockDataProvider);
+	Stock(const StockDataProviderPtr& stockDataProvider, StockOwner owner = 0);
 
 	/**
 	 * @brief Initializes the stock and the inventory.
@@ -72,10 +73,28 @@ public:
 	 */
 	int count(ItemId itemId) const;
 
+	/**
+	 * @brief Changes the amount of the item with the given id - a new item is created if needed
+	 * @return @c false if the item id is unknown or there are not enough items to remove
+	 * @see Transaction
+	 */
+	bool change(ItemId itemId, ItemAmount delta);
+
+	/**
+	 * @return @c true if there is an @c ItemData entry for the given item id
+	 */
+	bool hasItemData(ItemId itemId) const;
+
+	StockOwner owner() const;
+
 	const Inventory& inventory() const;
 	Inventory& inventory();
 };
 
+inline StockOwner Stock::owner() const {
+	return _owner;
+}
+
 inline const Inventory& Stock::inventory() const {
 	return _inventory;
 }
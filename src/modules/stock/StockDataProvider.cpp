@@ -86,7 +86,7 @@ bool StockDataProvider::init(const std::string& luaScript) {
 }
 
 ItemPtr StockDataProvider::createItem(ItemId itemId) {
-	if (itemId > _itemData.size()) {
+	if (itemId >= _itemData.size()) {
 		Log::error("Invalid item id %i", (int)itemId);
 		return ItemPtr();
 	}
@@ -110,13 +110,10 @@ bool StockDataProvider::addItemData(ItemData* data) {
 }
 
 const ItemData* StockDataProvider::itemData(ItemId itemId) const {
-	if (itemId > _itemData.size()) {
+	if (itemId >= _itemData.size()) {
 		Log::error("Invalid item id %i", (int)itemId);
 		return nullptr;
 	}
-	if (itemId > _itemData.size()) {
-		return nullptr;
-	}
 	const ItemData* data = _itemData[itemId];
 	return data;
 }
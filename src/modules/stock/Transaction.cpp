@@ -0,0 +1,91 @@
+/**
+ * @file
+ */
+
+#include "Transaction.h"
+#include "Stock.h"
+#include "Journal.h"
+#include "core/Log.h"
+#include "core/Assert.h"
+
+namespace stock {
+
+Transaction& Transaction::change(Stock& stock, ItemId itemId, ItemAmount delta) {
+	for (Operation& op : _operations) {
+		if (op.stock == &stock && op.itemId == itemId) {
+			op.delta += delta;
+			return *this;
+		}
+	}
+	_operations.push_back(Operation { &stock, itemId, delta });
+	return *this;
+}
+
+Transaction& Transaction::add(Stock& stock, ItemId itemId, ItemAmount amount) {
+	if (amount <= 0) {
+		_valid = false;
+		return *this;
+	}
+	return change(stock, itemId, amount);
+}
+
+Transaction& Transaction::remove(Stock& stock, ItemId itemId, ItemAmount amount) {
+	if (amount <= 0) {
+		_valid = false;
+		return *this;
+	}
+	return change(stock, itemId, -amount);
+}
+
+Transaction& Transaction::transfer(Stock& from, Stock& to, ItemId itemId, ItemAmount amount) {
+	if (&from == &to) {
+		_valid = false;
+		return *this;
+	}
+	remove(from, itemId, amount);
+	return add(to, itemId, amount);
+}
+
+void Transaction::clear() {
+	_operations.clear();
+	_valid = true;
+}
+
+bool Transaction::commit(Journal* journal) {
+	if (!_valid) {
+		Log::debug("Invalid operation in transaction");
+		clear();
+		return false;
+	}
+	// the operations are already merged per stock and item - so each of them can be checked on its own
+	for (const Operation& op : _operations) {
+		if (!op.stock->hasItemData(op.itemId)) {
+			Log::debug("Unknown item %i in transaction", (int)op.itemId);
+			clear();
+			return false;
+		}
+		if (op.delta < 0 && op.stock->count(op.itemId) < -op.delta) {
+			Log::debug("Not enough items of %i in stock for transaction", (int)op.itemId);
+			clear();
+			return false;
+		}
+	}
+	std::vector<JournalEntry> entries;
+	entries.reserve(_operations.size());
+	for (const Operation& op : _operations) {
+		if (op.delta == 0) {
+			continue;
+		}
+		const bool applied = op.stock->change(op.itemId, op.delta);
+		core_assert_msg(applied, "Failed to apply a validated transaction operation");
+		(void)applied;
+		entries.push_back(JournalEntry { op.stock->owner(), op.itemId, op.delta });
+	}
+	if (journal != nullptr && !entries.empty()) {
+		journal->append(entries);
+	}
+	clear();
+	return true;
+}
+
+}
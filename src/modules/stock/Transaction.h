@@ -0,0 +1,76 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "Item.h"
+#include <vector>
+
+namespace stock {
+
+class Stock;
+class Journal;
+
+/**
+ * @brief Changes the item amounts of one or more @c Stock instances as one unit - e.g. a trade
+ * between two users or the loot transfer from a corpse.
+ *
+ * The operations are collected first. On @c commit() all of them are validated before the first one
+ * is applied - either all of them are applied or none.
+ *
+ * @code
+ * Transaction tx;
+ * tx.transfer(seller, buyer, swordId, 1).transfer(buyer, seller, goldId, 100);
+ * if (!tx.commit(journal)) {
+ *   // nothing was changed
+ * }
+ * @endcode
+ * @ingroup Stock
+ */
+class Transaction {
+private:
+	struct Operation {
+		Stock* stock;
+		ItemId itemId;
+		ItemAmount delta;
+	};
+	std::vector<Operation> _operations;
+	bool _valid = true;
+
+	Transaction& change(Stock& stock, ItemId itemId, ItemAmount delta);
+public:
+	/**
+	 * @brief Adds the given amount of items to the stock
+	 */
+	Transaction& add(Stock& stock, ItemId itemId, ItemAmount amount);
+
+	/**
+	 * @brief Removes the given amount of items from the stock
+	 */
+	Transaction& remove(Stock& stock, ItemId itemId, ItemAmount amount);
+
+	/**
+	 * @brief Moves the given amount of items from one stock to another one
+	 */
+	Transaction& transfer(Stock& from, Stock& to, ItemId itemId, ItemAmount amount);
+
+	/**
+	 * @brief Validates and applies all operations.
+	 * @param[in] journal Records the applied changes - might be @c nullptr
+	 * @return @c false if any of the operations is invalid - e.g. a stock doesn't have enough items. In this
+	 * case none of the operations is applied.
+	 * @note The operations are removed after this call.
+	 */
+	bool commit(Journal* journal = nullptr);
+
+	void clear();
+
+	bool empty() const;
+};
+
+inline bool Transaction::empty() const {
+	return _operations.empty();
+}
+
+}
@@ -0,0 +1,128 @@
+/**
+ * @file
+ */
+
+#include <benchmark/benchmark.h>
+#include "stock/StockDataProvider.h"
+#include "stock/Container.h"
+#include "stock/Item.h"
+#include "math/Random.h"
+#include <vector>
+
+namespace {
+
+const int Users = 10000;
+const int Items = 256;
+const uint8_t ContainerWidth = 24;
+const uint8_t ContainerHeight = 16;
+
+struct Sizes {
+	uint8_t width;
+	uint8_t height;
+};
+
+class StockFixture {
+public:
+	stock::StockDataProvider provider;
+	stock::ContainerShape shape;
+	// the items of different sizes in a random order
+	std::vector<stock::ItemPtr> items;
+	// single cell items that close the remaining gaps
+	std::vector<stock::ItemPtr> fillers;
+	std::vector<stock::Container> containers;
+
+	StockFixture() :
+			containers(Users) {
+		const Sizes sizes[] = { {1, 1}, {1, 2}, {2, 1}, {2, 2}, {1, 3}, {2, 3} };
+		stock::ItemId id = 1;
+		for (const Sizes& s : sizes) {
+			stock::ItemData* data = new stock::ItemData(id++, stock::ItemType::WEAPON);
+			data->setSize(s.width, s.height);
+			provider.addItemData(data);
+		}
+		math::Random random(1);
+		for (int i = 0; i < Items; ++i) {
+			items.push_back(provider.createItem(random.random(1, (int)(id - 1))));
+		}
+		for (int i = 0; i < ContainerWidth * ContainerHeight; ++i) {
+			fillers.push_back(provider.createItem(1));
+		}
+		shape.addRect(0, 0, ContainerWidth, ContainerHeight);
+		for (stock::Container& c : containers) {
+			c.init(shape);
+		}
+	}
+
+	/**
+	 * @return The amount of items that were added
+	 */
+	int fill(stock::Container& c) const {
+		int added = 0;
+		for (const stock::ItemPtr& item : items) {
+			if (c.add(item)) {
+				++added;
+			}
+		}
+		for (const stock::ItemPtr& item : fillers) {
+			if (!c.add(item)) {
+				break;
+			}
+			++added;
+		}
+		return added;
+	}
+};
+
+}
+
+/**
+ * @brief Fills the containers of all users until there is no free cell left
+ */
+static void BM_FillInventories(benchmark::State& state) {
+	StockFixture fixture;
+	int64_t items = 0;
+	while (state.KeepRunning()) {
+		for (stock::Container& c : fixture.containers) {
+			items += fixture.fill(c);
+			c.clear();
+		}
+	}
+	state.SetItemsProcessed(items);
+}
+
+/**
+ * @brief Removes every third item from the full containers and sorts the remaining items
+ */
+static void BM_RepackInventories(benchmark::State& state) {
+	StockFixture fixture;
+	int64_t repacked = 0;
+	std::vector<stock::ItemPtr> removed;
+	while (state.KeepRunning()) {
+		state.PauseTiming();
+		for (stock::Container& c : fixture.containers) {
+			fixture.fill(c);
+			removed.clear();
+			for (size_t i = 0u; i < c.items().size(); i += 3u) {
+				removed.push_back(c.items()[i].item);
+			}
+			for (const stock::ItemPtr& item : removed) {
+				c.notifyRemove(item);
+			}
+		}
+		state.ResumeTiming();
+		for (stock::Container& c : fixture.containers) {
+			if (c.sort()) {
+				++repacked;
+			}
+		}
+		state.PauseTiming();
+		for (stock::Container& c : fixture.containers) {
+			c.clear();
+		}
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(repacked);
+}
+
+BENCHMARK(BM_FillInventories)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RepackInventories)->Unit(benchmark::kMillisecond);
@@ -26,4 +26,87 @@ TEST_F(ContainerTest, testAddAndRemove) {
 	ASSERT_EQ(0, c.free());
 }
 
+TEST_F(ContainerTest, testFindSpace) {
+	Container c;
+	ContainerShape shape;
+	shape.addRect(0, 0, 3, 3);
+	c.init(shape);
+	// the 1x2 item doesn't fit into the last column of the first rows if the first column is occupied
+	ASSERT_TRUE(c.add(_item2, 0, 0));
+	ASSERT_TRUE(c.add(_provider->createItem(_itemData2->id()), 1, 0));
+	ASSERT_TRUE(c.add(_provider->createItem(_itemData2->id()), 0, 1));
+	uint8_t x = 0xff;
+	uint8_t y = 0xff;
+	ASSERT_TRUE(c.findSpace(_item1, x, y));
+	ASSERT_EQ(2, x);
+	ASSERT_EQ(0, y);
+	ASSERT_TRUE(c.add(_item1));
+	ASSERT_EQ(_item1, c.get(2, 1));
+	ASSERT_EQ(4, c.free());
+}
+
+TEST_F(ContainerTest, testFindSpaceNoRoom) {
+	Container c;
+	ContainerShape shape;
+	shape.addRect(0, 31, 8, 1);
+	c.init(shape);
+	uint8_t x;
+	uint8_t y;
+	ASSERT_FALSE(c.findSpace(_item1, x, y)) << "The item leaves the container at the last row";
+	ASSERT_TRUE(c.findSpace(_item2, x, y));
+	ASSERT_EQ(0, x);
+	ASSERT_EQ(31, y);
+}
+
+TEST_F(ContainerTest, testGetCoveredCell) {
+	Container c;
+	ContainerShape shape;
+	shape.addRect(0, 0, 4, 4);
+	c.init(shape);
+	ASSERT_TRUE(c.add(_item1, 1, 1));
+	ASSERT_TRUE(c.add(_item2, 2, 2));
+	ASSERT_EQ(_item1, c.get(1, 1));
+	ASSERT_EQ(_item1, c.get(1, 2));
+	ASSERT_EQ(_item2, c.get(2, 2));
+	ASSERT_EQ(nullptr, c.get(2, 1));
+	ASSERT_EQ(nullptr, c.get(1, 3));
+}
+
+TEST_F(ContainerTest, testUnique) {
+	Container c;
+	ContainerShape shape;
+	shape.addRect(0, 0, 4, 4);
+	c.init(shape, Container::Unique);
+	ASSERT_TRUE(c.add(_item1));
+	ASSERT_FALSE(c.add(_item2)) << "Both items are of the same type";
+	ASSERT_TRUE(c.notifyRemove(_item1));
+	ASSERT_FALSE(c.hasItemOfType(_itemData1->type()));
+	ASSERT_TRUE(c.add(_item2));
+}
+
+TEST_F(ContainerTest, testBatchAddAndSort) {
+	Container c;
+	ContainerShape shape;
+	shape.addRect(0, 0, 2, 2);
+	c.init(shape);
+	std::vector<ItemPtr> items;
+	items.push_back(_item2);
+	items.push_back(_provider->createItem(_itemData2->id()));
+	items.push_back(_item1);
+	// the 1x2 item is placed first - otherwise the small items would block both columns
+	ASSERT_EQ(3, c.add(items));
+	ASSERT_EQ(0, c.free());
+	ASSERT_EQ(_item1, c.get(0, 1));
+
+	c.clear();
+	ASSERT_EQ(4, c.free());
+	ASSERT_TRUE(c.add(_item2, 0, 1));
+	ASSERT_TRUE(c.add(_item1, 1, 0));
+	ASSERT_TRUE(c.sort());
+	ASSERT_EQ(_item1, c.get(0, 1));
+	ASSERT_EQ(_item2, c.get(1, 0));
+	ASSERT_EQ(nullptr, c.get(1, 1));
+	ASSERT_EQ(2u, c.itemCount());
+}
+
 }
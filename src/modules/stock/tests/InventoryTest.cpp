@@ -37,4 +37,17 @@ TEST_F(InventoryTest, testRemoveFromInvalidLocation) {
 	ASSERT_EQ(15, _container->free());
 }
 
+TEST_F(InventoryTest, testMove) {
+	const uint8_t targetId = _containerId + 1;
+	ContainerShape shape;
+	shape.addRect(0, 0, 1, 2);
+	ASSERT_TRUE(_inv.initContainer(targetId, shape));
+	ASSERT_TRUE(_inv.add(_containerId, _item2, 1, 1));
+	ASSERT_TRUE(_inv.add(_containerId, _item1, 2, 1));
+	ASSERT_EQ(1, _inv.move(_containerId, targetId)) << "Only the larger item should fit into the target container";
+	ASSERT_EQ(_item1, _inv.container(targetId)->get(0, 1));
+	ASSERT_EQ(_item2, _inv.container(_containerId)->get(1, 1));
+	ASSERT_EQ(1u, _inv.container(_containerId)->itemCount());
+}
+
 }
@@ -0,0 +1,196 @@
+/**
+ * @file
+ */
+
+#include "stock/tests/AbstractStockTest.h"
+#include "stock/Stock.h"
+#include "stock/Transaction.h"
+#include "stock/Journal.h"
+#include "math/Random.h"
+#include <map>
+
+namespace stock {
+
+class TransactionTest: public AbstractStockTest {
+protected:
+	typedef std::map<std::pair<StockOwner, ItemId>, ItemAmount> Amounts;
+
+	void collect(const Stock& stock, ItemId itemId, Amounts& amounts) const {
+		const int amount = stock.count(itemId);
+		if (amount != 0) {
+			amounts[std::make_pair(stock.owner(), itemId)] = amount;
+		}
+	}
+
+	static void apply(const std::vector<JournalEntry>& entries, Amounts& amounts) {
+		for (const JournalEntry& entry : entries) {
+			const auto key = std::make_pair(entry.owner, entry.itemId);
+			amounts[key] += entry.delta;
+			if (amounts[key] == 0) {
+				amounts.erase(key);
+			}
+		}
+	}
+};
+
+TEST_F(TransactionTest, testTransfer) {
+	Stock seller(_provider, 1);
+	Stock buyer(_provider, 2);
+	Journal journal;
+	ASSERT_TRUE(seller.change(_itemData1->id(), 1));
+	ASSERT_TRUE(buyer.change(_itemData2->id(), 100));
+
+	Transaction tx;
+	tx.transfer(seller, buyer, _itemData1->id(), 1).transfer(buyer, seller, _itemData2->id(), 100);
+	ASSERT_TRUE(tx.commit(&journal));
+	ASSERT_TRUE(tx.empty());
+	EXPECT_EQ(0, seller.count(_itemData1->id()));
+	EXPECT_EQ(100, seller.count(_itemData2->id()));
+	EXPECT_EQ(1, buyer.count(_itemData1->id()));
+	EXPECT_EQ(0, buyer.count(_itemData2->id()));
+	EXPECT_EQ(1u, journal.transactions());
+}
+
+TEST_F(TransactionTest, testTransferNotEnoughItems) {
+	Stock seller(_provider, 1);
+	Stock buyer(_provider, 2);
+	Journal journal;
+	ASSERT_TRUE(seller.change(_itemData1->id(), 1));
+	ASSERT_TRUE(buyer.change(_itemData2->id(), 50));
+
+	Transaction tx;
+	tx.transfer(seller, buyer, _itemData1->id(), 1).transfer(buyer, seller, _itemData2->id(), 100);
+	ASSERT_FALSE(tx.commit(&journal)) << "The buyer doesn't have enough items";
+	EXPECT_EQ(1, seller.count(_itemData1->id()));
+	EXPECT_EQ(0, seller.count(_itemData2->id()));
+	EXPECT_EQ(0, buyer.count(_itemData1->id()));
+	EXPECT_EQ(50, buyer.count(_itemData2->id()));
+	EXPECT_EQ(0u, journal.transactions());
+	EXPECT_TRUE(journal.data().empty());
+}
+
+TEST_F(TransactionTest, testUnknownItem) {
+	Stock stock(_provider, 1);
+	Transaction tx;
+	tx.add(stock, _itemData1->id(), 1).add(stock, 1000, 1);
+	ASSERT_FALSE(tx.commit());
+	EXPECT_EQ(0, stock.count(_itemData1->id()));
+}
+
+TEST_F(TransactionTest, testJournalCoalesce) {
+	Stock a(_provider, 1);
+	Stock b(_provider, 2);
+	Journal journal;
+	ASSERT_TRUE(a.change(_itemData2->id(), 10));
+	for (int i = 0; i < 5; ++i) {
+		Transaction tx;
+		ASSERT_TRUE(tx.transfer(a, b, _itemData2->id(), 2).commit(&journal));
+	}
+	Transaction tx;
+	ASSERT_TRUE(tx.transfer(b, a, _itemData2->id(), 10).commit(&journal));
+	Transaction loot;
+	ASSERT_TRUE(loot.add(b, _itemData1->id(), 1).commit(&journal));
+
+	std::vector<JournalEntry> entries;
+	const size_t position = journal.coalesce(entries);
+	ASSERT_EQ(1u, entries.size()) << "The trades are cancelling each other out - only the loot is left";
+	EXPECT_EQ(2, entries[0].owner);
+	EXPECT_EQ(_itemData1->id(), entries[0].itemId);
+	EXPECT_EQ(1, entries[0].delta);
+
+	entries.clear();
+	journal.coalesce(entries);
+	EXPECT_TRUE(entries.empty());
+	EXPECT_FALSE(journal.data().empty());
+	journal.checkpoint(position);
+	EXPECT_TRUE(journal.data().empty());
+}
+
+/**
+ * @brief 5000 trades per second between 500 users - the persistence runs every 100 millis. After
+ * the simulated crash, the state is restored from the persisted amounts and the journal.
+ */
+TEST_F(TransactionTest, testStressCrashReplay) {
+	const int Users = 500;
+	const int TradesPerSecond = 5000;
+	const int Seconds = 10;
+	const int TicksPerSecond = 10;
+	const ItemId sword = _itemData1->id();
+	const ItemId gold = _itemData2->id();
+
+	std::vector<std::unique_ptr<Stock>> stocks;
+	Journal journal;
+	for (int i = 0; i < Users; ++i) {
+		stocks.emplace_back(new Stock(_provider, 1000 + i));
+		Transaction tx;
+		ASSERT_TRUE(tx.add(*stocks.back(), sword, 5).add(*stocks.back(), gold, 1000).commit(&journal));
+	}
+
+	Amounts persisted;
+	math::Random random(1);
+	int committed = 0;
+	for (int tick = 0; tick < Seconds * TicksPerSecond; ++tick) {
+		for (int i = 0; i < TradesPerSecond / TicksPerSecond; ++i) {
+			Stock& seller = *stocks[random.random(0, Users - 1)];
+			Stock& buyer = *stocks[random.random(0, Users - 1)];
+			if (&seller == &buyer) {
+				continue;
+			}
+			Transaction tx;
+			tx.transfer(seller, buyer, sword, random.random(1, 3));
+			tx.transfer(buyer, seller, gold, random.random(1, 400));
+			if (tx.commit(&journal)) {
+				++committed;
+			}
+		}
+		// the last tick is not persisted - it is only in the journal when the crash happens
+		if (tick == Seconds * TicksPerSecond - 1) {
+			break;
+		}
+		std::vector<JournalEntry> entries;
+		const size_t position = journal.coalesce(entries);
+		apply(entries, persisted);
+		journal.checkpoint(position);
+	}
+	ASSERT_GT(committed, Seconds * TradesPerSecond / 2);
+
+	Amounts live;
+	ItemAmount swords = 0;
+	ItemAmount golds = 0;
+	for (const std::unique_ptr<Stock>& stock : stocks) {
+		collect(*stock, sword, live);
+		collect(*stock, gold, live);
+		ASSERT_GE(stock->count(sword), 0);
+		ASSERT_GE(stock->count(gold), 0);
+		swords += stock->count(sword);
+		golds += stock->count(gold);
+	}
+	ASSERT_EQ(5 * Users, swords) << "Trades must not create or destroy items";
+	ASSERT_EQ(1000 * Users, golds) << "Trades must not create or destroy items";
+
+	const std::vector<uint8_t>& data = journal.data();
+	ASSERT_FALSE(data.empty());
+
+	// the complete journal restores the live state
+	Amounts restored = persisted;
+	const uint64_t replayed = Journal::replay(data.data(), data.size(), [&] (uint64_t, const std::vector<JournalEntry>& entries) {
+		apply(entries, restored);
+	});
+	ASSERT_GT(replayed, 0u);
+	ASSERT_EQ(live, restored);
+
+	// the last record was only written partially - the transaction is dropped as a whole
+	Amounts torn = persisted;
+	std::vector<JournalEntry> lastEntries;
+	const uint64_t tornReplayed = Journal::replay(data.data(), data.size() - 1, [&] (uint64_t, const std::vector<JournalEntry>& entries) {
+		apply(entries, torn);
+	});
+	ASSERT_EQ(replayed - 1, tornReplayed);
+	Journal::replay(data.data(), data.size(), [&] (uint64_t transaction, const std::vector<JournalEntry>& entries) {
+		lastEntries = entries;
+	});
+	apply(lastEntries, torn);
+	ASSERT_EQ(live, torn);
+}
+
+}
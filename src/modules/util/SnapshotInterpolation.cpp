@@ -0,0 +1,167 @@
+/**
+ * @file
+ */
+
+#include "SnapshotInterpolation.h"
+#include "core/Common.h"
+#include "core/Assert.h"
+
+namespace util {
+
+namespace {
+// the weight of a new sample for the running averages of the clock offset, the jitter and the interval
+const double OffsetWeight = 1.0 / 16.0;
+const double JitterWeight = 1.0 / 16.0;
+const double IntervalWeight = 1.0 / 8.0;
+// the jitter is compensated with this multiple of the mean deviation
+const double JitterFactor = 2.0;
+// the render time is moved smoothly towards the target time - unless it's off by more than this
+const double SnapMillis = 500.0;
+const double CorrectionWeight = 0.1;
+}
+
+SnapshotInterpolation::SnapshotInterpolation() :
+		_position(0.0f) {
+}
+
+void SnapshotInterpolation::setStartPosition(const glm::vec3& position, float orientation) {
+	_count = 0;
+	_synced = false;
+	_jitter = 0.0;
+	_interval = 0.0;
+	_position = position;
+	_orientation = orientation;
+}
+
+long SnapshotInterpolation::delay() const {
+	return (long)(glm::max((double)_delayMillis, _interval) + JitterFactor * _jitter);
+}
+
+void SnapshotInterpolation::insert(const Snapshot& snapshot) {
+	int index = _count;
+	while (index > 0 && _snapshots[index - 1].serverMillis > snapshot.serverMillis) {
+		--index;
+	}
+	if (index > 0 && _snapshots[index - 1].serverMillis == snapshot.serverMillis) {
+		// duplicate
+		return;
+	}
+	if (_count == MaxSnapshots) {
+		if (index == 0) {
+			return;
+		}
+		for (int i = 1; i < _count; ++i) {
+			_snapshots[i - 1] = _snapshots[i];
+		}
+		--_count;
+		--index;
+	}
+	for (int i = _count; i > index; --i) {
+		_snapshots[i] = _snapshots[i - 1];
+	}
+	_snapshots[index] = snapshot;
+	++_count;
+}
+
+void SnapshotInterpolation::addSnapshot(uint64_t serverMillis, const glm::vec3& position, float orientation) {
+	const double sample = (double)serverMillis - (double)_now;
+	if (!_synced) {
+		_synced = true;
+		_offset = sample;
+		_renderMillis = (double)serverMillis - (double)delay();
+	} else {
+		if ((double)serverMillis <= _renderMillis) {
+			// arrived too late to be rendered
+			return;
+		}
+		const double deviation = sample - _offset;
+		_jitter += (glm::abs(deviation) - _jitter) * JitterWeight;
+		_offset += deviation * OffsetWeight;
+	}
+	if (_count > 0 && serverMillis > _snapshots[_count - 1].serverMillis) {
+		const double interval = (double)(serverMillis - _snapshots[_count - 1].serverMillis);
+		if (_interval <= 0.0) {
+			_interval = interval;
+		} else {
+			_interval += (interval - _interval) * IntervalWeight;
+		}
+	}
+	insert(Snapshot{serverMillis, position, orientation});
+}
+
+void SnapshotInterpolation::update(long dt) {
+	_now += dt;
+	if (!_synced) {
+		return;
+	}
+	_renderMillis += (double)dt;
+	const double target = (double)_now + _offset - (double)delay();
+	const double error = target - _renderMillis;
+	if (glm::abs(error) > SnapMillis) {
+		_renderMillis = target;
+	} else {
+		// don't let the entity jump - speed up or slow down the time a little bit instead
+		const double maxCorrection = (double)dt * 0.5;
+		_renderMillis += glm::clamp(error * CorrectionWeight, -maxCorrection, maxCorrection);
+	}
+	sample(_renderMillis);
+}
+
+static float lerpAngle(float a, float b, float f) {
+	float diff = b - a;
+	while (diff > glm::pi<float>()) {
+		diff -= glm::two_pi<float>();
+	}
+	while (diff < -glm::pi<float>()) {
+		diff += glm::two_pi<float>();
+	}
+	return a + diff * f;
+}
+
+void SnapshotInterpolation::sample(double renderMillis) {
+	if (_count == 0) {
+		return;
+	}
+	// the snapshots before the render time are not needed anymore - but the last two are
+	// kept to be able to extrapolate
+	int drop = 0;
+	while (_count - drop > 2 && (double)_snapshots[drop + 1].serverMillis <= renderMillis) {
+		++drop;
+	}
+	if (drop > 0) {
+		for (int i = drop; i < _count; ++i) {
+			_snapshots[i - drop] = _snapshots[i];
+		}
+		_count -= drop;
+	}
+
+	const Snapshot& first = _snapshots[0];
+	if (_count == 1 || renderMillis <= (double)first.serverMillis) {
+		_position = first.position;
+		_orientation = first.orientation;
+		return;
+	}
+	const Snapshot& last = _snapshots[_count - 1];
+	if (renderMillis >= (double)last.serverMillis) {
+		const Snapshot& prev = _snapshots[_count - 2];
+		const double extrapolate = glm::min(renderMillis - (double)last.serverMillis, (double)_maxExtrapolationMillis);
+		const glm::vec3 velocity = (last.position - prev.position) / (float)(last.serverMillis - prev.serverMillis);
+		_position = last.position + velocity * (float)extrapolate;
+		_orientation = last.orientation;
+		return;
+	}
+	for (int i = 0; i < _count - 1; ++i) {
+		const Snapshot& from = _snapshots[i];
+		const Snapshot& to = _snapshots[i + 1];
+		if (renderMillis >= (double)to.serverMillis) {
+			continue;
+		}
+		const float f = (float)((renderMillis - (double)from.serverMillis) / (double)(to.serverMillis - from.serverMillis));
+		_position = glm::mix(from.position, to.position, f);
+		_orientation = lerpAngle(from.orientation, to.orientation, f);
+		return;
+	}
+	core_assert_msg(false, "No snapshots found for the render time %f", renderMillis);
+}
+
+}
@@ -0,0 +1,124 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "core/GLM.h"
+#include <stdint.h>
+
+namespace util {
+
+/**
+ * @brief Interpolates the position and orientation of a remote entity between the snapshots the server sent
+ *
+ * The snapshots carry the server time they were taken at. The entity is rendered a little bit in the past
+ * (the interpolation delay) - so that there are usually two snapshots to interpolate between even if the
+ * server only sends them at a low rate and the packets arrive with jitter. The delay grows with the measured
+ * jitter and the snapshot interval. If no newer snapshot arrived in time, the movement is extrapolated for a
+ * short time before the entity stops at the last known position.
+ *
+ * @sa PosLerp
+ */
+class SnapshotInterpolation {
+public:
+	struct Snapshot {
+		uint64_t serverMillis;
+		glm::vec3 position;
+		float orientation;
+	};
+	static constexpr int MaxSnapshots = 32;
+
+private:
+	Snapshot _snapshots[MaxSnapshots];
+	int _count = 0;
+
+	long _delayMillis = 100l;
+	long _maxExtrapolationMillis = 200l;
+
+	// the local clock - advanced by update()
+	int64_t _now = 0;
+	// the estimated difference between the server clock and the local clock (including the latency)
+	double _offset = 0.0;
+	// the mean deviation of the arrival times
+	double _jitter = 0.0;
+	// the mean time between two snapshots
+	double _interval = 0.0;
+	double _renderMillis = 0.0;
+	bool _synced = false;
+
+	glm::vec3 _position;
+	float _orientation = 0.0f;
+
+	void insert(const Snapshot& snapshot);
+	void sample(double renderMillis);
+public:
+	SnapshotInterpolation();
+
+	/**
+	 * @brief Resets the buffer - the entity is placed at the given position
+	 */
+	void setStartPosition(const glm::vec3& position, float orientation);
+
+	/**
+	 * @brief Adds the state of the entity at the given server time
+	 * @note Snapshots may arrive out of order - duplicates and snapshots that are older than the
+	 * currently rendered time are ignored
+	 */
+	void addSnapshot(uint64_t serverMillis, const glm::vec3& position, float orientation);
+
+	/**
+	 * @brief Advances the local clock and updates the interpolated position and orientation
+	 */
+	void update(long dt);
+
+	/**
+	 * @brief The minimum time in millis the entity is rendered behind the server
+	 */
+	void setDelay(long millis);
+	/**
+	 * @brief The maximum time in millis the movement is continued after the last snapshot
+	 */
+	void setMaxExtrapolation(long millis);
+
+	/**
+	 * @return The interpolation delay in millis - including the jitter compensation
+	 */
+	long delay() const;
+
+	/**
+	 * @return The server time in millis the current position belongs to
+	 */
+	uint64_t renderMillis() const;
+
+	int snapshots() const;
+
+	const glm::vec3& position() const;
+	float orientation() const;
+};
+
+inline void SnapshotInterpolation::setDelay(long millis) {
+	_delayMillis = millis;
+}
+
+inline void SnapshotInterpolation::setMaxExtrapolation(long millis) {
+	_maxExtrapolationMillis = millis;
+}
+
+inline uint64_t SnapshotInterpolation::renderMillis() const {
+	return (uint64_t)_renderMillis;
+}
+
+inline int SnapshotInterpolation::snapshots() const {
+	return _count;
+}
+
+inline const glm::vec3& SnapshotInterpolation::position() const {
+	return _position;
+}
+
+inline float SnapshotInterpolation::orientation() const {
+	return _orientation;
+}
+
+}
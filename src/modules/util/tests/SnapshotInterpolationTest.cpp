@@ -0,0 +1,170 @@
+/**
+ * @file
+ */
+
+#include <gtest/gtest.h>
+#include "util/SnapshotInterpolation.h"
+#include "math/Random.h"
+#include "core/Log.h"
+#include <vector>
+#include <algorithm>
+
+namespace util {
+
+namespace {
+
+const long ServerTick = 20l;
+const long ClientFrame = 16l;
+const long Latency = 50l;
+
+/**
+ * @brief A recorded movement stream of a user that walks with 5 units per second and changes
+ * the direction every 730 millis - one entry per server tick
+ */
+std::vector<SnapshotInterpolation::Snapshot> record(int seconds) {
+	const glm::vec3 directions[] = { glm::vec3(1, 0, 0), glm::vec3(0, 0, 1), glm::vec3(-1, 0, 0), glm::vec3(0, 0, 1) };
+	const float speed = 5.0f / 1000.0f;
+	std::vector<SnapshotInterpolation::Snapshot> stream;
+	glm::vec3 pos(0.0f);
+	const uint64_t start = 100000u;
+	for (long t = 0; t <= seconds * 1000l; t += ServerTick) {
+		const int dir = (int)(t / 730l) % (int)SDL_arraysize(directions);
+		stream.push_back({start + t, pos, (float)dir});
+		pos += directions[dir] * speed * (float)ServerTick;
+	}
+	return stream;
+}
+
+glm::vec3 truth(const std::vector<SnapshotInterpolation::Snapshot>& stream, uint64_t serverMillis) {
+	if (serverMillis <= stream.front().serverMillis) {
+		return stream.front().position;
+	}
+	const size_t i = (serverMillis - stream.front().serverMillis) / ServerTick;
+	if (i + 1 >= stream.size()) {
+		return stream.back().position;
+	}
+	const float f = (float)(serverMillis - stream[i].serverMillis) / (float)ServerTick;
+	return glm::mix(stream[i].position, stream[i + 1].position, f);
+}
+
+struct Result {
+	int packets;
+	float meanError;
+	float maxError;
+	long delay;
+};
+
+/**
+ * @brief Replays the stream with the given send interval and a random jitter on top of the latency
+ */
+Result replay(const std::vector<SnapshotInterpolation::Snapshot>& stream, long sendInterval, int jitter) {
+	struct Packet {
+		long arrival;
+		const SnapshotInterpolation::Snapshot* snapshot;
+	};
+	math::Random random(1);
+	std::vector<Packet> packets;
+	const long sendEvery = sendInterval / ServerTick;
+	for (size_t i = 0; i < stream.size(); i += sendEvery) {
+		const long sent = (long)i * ServerTick;
+		packets.push_back({sent + Latency + random.random(0, jitter), &stream[i]});
+	}
+	std::stable_sort(packets.begin(), packets.end(), [] (const Packet& a, const Packet& b) {
+		return a.arrival < b.arrival;
+	});
+
+	SnapshotInterpolation interpolation;
+	interpolation.setStartPosition(stream.front().position, stream.front().orientation);
+	const long end = (long)(stream.size() - 1) * ServerTick;
+	// skip the first second to let the jitter estimation settle
+	const long warmup = 1000l;
+	size_t next = 0;
+	double errorSum = 0.0;
+	float maxError = 0.0f;
+	int samples = 0;
+	for (long now = 0; now < end; now += ClientFrame) {
+		while (next < packets.size() && packets[next].arrival <= now) {
+			const SnapshotInterpolation::Snapshot* s = packets[next].snapshot;
+			interpolation.addSnapshot(s->serverMillis, s->position, s->orientation);
+			++next;
+		}
+		interpolation.update(ClientFrame);
+		if (now < warmup) {
+			continue;
+		}
+		const float error = glm::distance(truth(stream, interpolation.renderMillis()), interpolation.position());
+		errorSum += error;
+		maxError = glm::max(maxError, error);
+		++samples;
+	}
+	return Result{(int)packets.size(), (float)(errorSum / samples), maxError, interpolation.delay()};
+}
+
+}
+
+TEST(SnapshotInterpolationTest, testInterpolate) {
+	SnapshotInterpolation interpolation;
+	interpolation.setDelay(100l);
+	interpolation.setStartPosition(glm::vec3(0.0f), 0.0f);
+	interpolation.addSnapshot(1000u, glm::vec3(0.0f), 0.0f);
+	interpolation.addSnapshot(1100u, glm::vec3(10.0f, 0.0f, 0.0f), 1.0f);
+	EXPECT_EQ(2, interpolation.snapshots());
+	// the entity is rendered in the past - start at the first snapshot
+	EXPECT_LT(interpolation.renderMillis(), 1000u);
+	interpolation.update(150l);
+	const float expected = (float)(interpolation.renderMillis() - 1000u) / 10.0f;
+	ASSERT_GT(expected, 0.0f);
+	ASSERT_LT(expected, 10.0f);
+	EXPECT_NEAR(expected, interpolation.position().x, 0.2f);
+	EXPECT_NEAR(expected / 10.0f, interpolation.orientation(), 0.02f);
+}
+
+TEST(SnapshotInterpolationTest, testOutOfOrder) {
+	SnapshotInterpolation interpolation;
+	interpolation.addSnapshot(1000u, glm::vec3(0.0f), 0.0f);
+	interpolation.addSnapshot(1200u, glm::vec3(20.0f, 0.0f, 0.0f), 0.0f);
+	interpolation.addSnapshot(1100u, glm::vec3(10.0f, 0.0f, 0.0f), 0.0f);
+	interpolation.addSnapshot(1100u, glm::vec3(10.0f, 0.0f, 0.0f), 0.0f);
+	EXPECT_EQ(3, interpolation.snapshots());
+}
+
+TEST(SnapshotInterpolationTest, testExtrapolate) {
+	SnapshotInterpolation interpolation;
+	interpolation.setDelay(100l);
+	interpolation.setMaxExtrapolation(200l);
+	interpolation.addSnapshot(1000u, glm::vec3(0.0f), 0.0f);
+	interpolation.addSnapshot(1100u, glm::vec3(10.0f, 0.0f, 0.0f), 0.0f);
+	for (int i = 0; i < 30; ++i) {
+		interpolation.update(10l);
+	}
+	ASSERT_GT(interpolation.renderMillis(), 1150u);
+	EXPECT_NEAR((float)(interpolation.renderMillis() - 1000u) / 10.0f, interpolation.position().x, 0.2f) << "The movement should be continued";
+	for (int i = 0; i < 100; ++i) {
+		interpolation.update(10l);
+	}
+	EXPECT_NEAR(30.0f, interpolation.position().x, 0.001f) << "The extrapolation should stop after 200 millis";
+}
+
+TEST(SnapshotInterpolationTest, testJitterIncreasesDelay) {
+	const std::vector<SnapshotInterpolation::Snapshot>& stream = record(5);
+	const Result steady = replay(stream, 100l, 0);
+	const Result jittery = replay(stream, 100l, 80);
+	EXPECT_GT(jittery.delay, steady.delay);
+}
+
+TEST(SnapshotInterpolationTest, testReplayWithJitter) {
+	const std::vector<SnapshotInterpolation::Snapshot>& stream = record(20);
+	const Result full = replay(stream, ServerTick, 40);
+	const Result reduced = replay(stream, 100l, 40);
+	const float saved = 1.0f - (float)reduced.packets / (float)full.packets;
+	Log::info("every tick: %i packets, mean error %f, max error %f, delay %li", full.packets, full.meanError, full.maxError, full.delay);
+	Log::info("every 100ms: %i packets, mean error %f, max error %f, delay %li", reduced.packets, reduced.meanError, reduced.maxError, reduced.delay);
+	Log::info("bandwidth saved: %f", saved);
+	EXPECT_GT(saved, 0.75f);
+	// the user walks 0.5 units between two snapshots - only the corners are cut
+	EXPECT_LT(full.meanError, 0.01f);
+	EXPECT_LT(reduced.meanError, 0.05f);
+	EXPECT_LT(reduced.maxError, 0.5f);
+}
+
+}
@@ -58,7 +58,7 @@ MeshPtr MeshPool::getMesh(std::string_view id, bool async) {
 
 	const MeshPtr& mesh = std::make_shared<Mesh>();
 	if (async) {
-		core::App::getInstance()->threadPool().enqueue([=]() {mesh->loadMesh(name);});
+		core::App::getInstance()->threadPool().schedule([=]() {mesh->loadMesh(name);});
 	} else {
 		mesh->loadMesh(name);
 	}
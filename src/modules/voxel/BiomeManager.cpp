@@ -47,6 +47,8 @@ void BiomeManager::shutdown() {
 		}
 		_zones[i].clear();
 	}
+	core::ScopedWriteLock lock(_climateLock);
+	_climateMaps.clear();
 }
 
 bool BiomeManager::init(const std::string& luaString) {
@@ -89,48 +91,83 @@ Biome* BiomeManager::addBiome(int lower, int upper, float humidity, float temper
 	return biome;
 }
 
+ClimateMap::ClimateMap(const glm::ivec2& column) :
+		_column(column) {
+	core_trace_scoped(BiomeClimateMap);
+	const float humidityFrequency = 0.001f;
+	const float temperatureFrequency = 0.0001f;
+	// TODO: apply y value to the temperature
+	const glm::ivec2 origin = column * Size;
+	for (int sz = 0, i = 0; sz < Samples; ++sz) {
+		const int z = origin.y + sz * SampleStep;
+		for (int sx = 0; sx < Samples; ++sx, ++i) {
+			const int x = origin.x + sx * SampleStep;
+			_humidity[i] = noise::norm(noise::noise(glm::vec2(x * humidityFrequency, z * humidityFrequency)));
+			_temperature[i] = noise::norm(noise::noise(glm::vec2(x * temperatureFrequency, z * temperatureFrequency)));
+		}
+	}
+}
+
+ClimateMapPtr BiomeManager::getClimateMap(int x, int z) const {
+	const glm::ivec2& column = ClimateMap::column(x, z);
+	{
+		core::ScopedReadLock lock(_climateLock);
+		auto i = _climateMaps.find(column);
+		if (i != _climateMaps.end()) {
+			return i->second;
+		}
+	}
+	// evaluate the noise without holding the lock - another thread might do the same for this column
+	const ClimateMapPtr map = std::make_shared<ClimateMap>(column);
+	core::ScopedWriteLock lock(_climateLock);
+	if (_climateMaps.size() >= MaxClimateMaps) {
+		_climateMaps.clear();
+	}
+	return _climateMaps.insert(std::make_pair(column, map)).first->second;
+}
+
+/**
+ * @brief The climate map that was used last by this thread
+ * @note The climate maps only depend on the position - they can be shared between the manager instances
+ */
+static const ClimateMap& climateMap(const BiomeManager& mgr, int x, int z) {
+	thread_local ClimateMapPtr last;
+	if (!last || last->column() != ClimateMap::column(x, z)) {
+		last = mgr.getClimateMap(x, z);
+	}
+	return *last;
+}
+
 float BiomeManager::getHumidity(int x, int z) const {
 	core_trace_scoped(BiomeGetHumidity);
-	const float frequency = 0.001f;
-	const glm::vec2 noisePos(x * frequency, z * frequency);
-	const float n = noise::noise(noisePos);
-	return noise::norm(n);
+	return climateMap(*this, x, z).humidity(x, z);
 }
 
 float BiomeManager::getTemperature(int x, int z) const {
 	core_trace_scoped(BiomeGetTemperature);
-	const float frequency = 0.0001f;
-	// TODO: apply y value
-	// const float scaleY = pos.y / (float)MAX_HEIGHT;
-	const glm::vec2 noisePos(x * frequency, z * frequency);
-	const float n = noise::noise(noisePos);
-	return noise::norm(n);
+	return climateMap(*this, x, z).temperature(x, z);
 }
 
 const Biome* BiomeManager::getBiome(const glm::ivec3& pos, bool underground) const {
 	core_assert_msg(_defaultBiome != nullptr, "BiomeManager is not yet initialized");
 	core_trace_scoped(BiomeGetBiome);
 
+	// the climate doesn't depend on the height - the values are reused while iterating in y direction
 	struct Last {
-		glm::ivec3 pos;
+		glm::ivec2 pos;
 		float humidity = -1.0f;
 		float temperature = -1.0f;
-		bool underground = false;
 	};
 
 	thread_local Last last;
-	float humidity;
-	float temperature;
-
-	if (last.humidity > -1.0f && last.pos.x == pos.x && last.pos.z == pos.z && last.underground == underground) {
-		humidity = last.humidity;
-		temperature = last.temperature;
-	} else {
-		last.humidity = humidity = getHumidity(pos.x, pos.z);
-		last.temperature = temperature = getTemperature(pos.x, pos.z);
-		last.pos = pos;
-		last.underground = underground;
+	if (last.humidity < 0.0f || last.pos.x != pos.x || last.pos.y != pos.z) {
+		const ClimateMap& climate = climateMap(*this, pos.x, pos.z);
+		last.humidity = climate.humidity(pos.x, pos.z);
+		last.temperature = climate.temperature(pos.x, pos.z);
+		last.pos = glm::ivec2(pos.x, pos.z);
 	}
+	const float humidity = last.humidity;
+	const float temperature = last.temperature;
 
 	const Biome *biomeBestMatch = _defaultBiome;
 	float distMin = std::numeric_limits<float>::max();
@@ -5,9 +5,13 @@
 #pragma once
 
 #include "core/Trace.h"
+#include "core/GLM.h"
+#include "core/ReadWriteLock.h"
 #include "Biome.h"
 #include "TreeContext.h"
 #include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
 
 namespace core {
 class Random;
@@ -50,11 +54,84 @@ inline float Zone::radius() const {
 	return _radius;
 }
 
+/**
+ * @brief Humidity and temperature of a column of the world with a side length of @c ClimateMap::Size voxels
+ *
+ * The climate noise is only evaluated at every @c SampleStep voxel - the values in between are bilinearly
+ * interpolated. This blends the biomes smoothly into each other. The samples on the borders are shared with
+ * the neighbouring columns.
+ */
+class ClimateMap {
+public:
+	static constexpr int SizeShift = 6;
+	static constexpr int Size = 1 << SizeShift;
+	static constexpr int SampleShift = 3;
+	static constexpr int SampleStep = 1 << SampleShift;
+	static constexpr int Samples = Size / SampleStep + 1;
+private:
+	glm::ivec2 _column;
+	float _humidity[Samples * Samples];
+	float _temperature[Samples * Samples];
+
+	static float interpolate(const float* samples, int x, int z);
+public:
+	/**
+	 * @param column The column as returned by @c column()
+	 */
+	ClimateMap(const glm::ivec2& column);
+
+	/**
+	 * @return The column that contains the given world position
+	 */
+	static inline glm::ivec2 column(int x, int z) {
+		return glm::ivec2(x >> SizeShift, z >> SizeShift);
+	}
+
+	inline const glm::ivec2& column() const {
+		return _column;
+	}
+
+	/**
+	 * @param x,z World position that must be part of this column
+	 * @return Humidity in the range [0-1]
+	 */
+	inline float humidity(int x, int z) const {
+		return interpolate(_humidity, x, z);
+	}
+
+	/**
+	 * @param x,z World position that must be part of this column
+	 * @return Temperature in the range [0-1]
+	 */
+	inline float temperature(int x, int z) const {
+		return interpolate(_temperature, x, z);
+	}
+};
+
+inline float ClimateMap::interpolate(const float* samples, int x, int z) {
+	const int lx = x & (Size - 1);
+	const int lz = z & (Size - 1);
+	const int sx = lx >> SampleShift;
+	const int sz = lz >> SampleShift;
+	const float fx = (lx & (SampleStep - 1)) / (float)SampleStep;
+	const float fz = (lz & (SampleStep - 1)) / (float)SampleStep;
+	const float* row = samples + sz * Samples + sx;
+	const float top = glm::mix(row[0], row[1], fx);
+	const float bottom = glm::mix(row[Samples], row[Samples + 1], fx);
+	return glm::mix(top, bottom, fz);
+}
+
+typedef std::shared_ptr<const ClimateMap> ClimateMapPtr;
+
 class BiomeManager {
 private:
 	std::vector<Biome*> _bioms;
 	std::vector<Zone*> _zones[int(ZoneType::Max)];
 	const Biome* _defaultBiome = nullptr;
+	// the climate maps are dropped all at once if there are too many of them
+	static constexpr size_t MaxClimateMaps = 4096;
+	mutable std::unordered_map<glm::ivec2, ClimateMapPtr, std::hash<glm::ivec2> > _climateMaps;
+	mutable core::ReadWriteLock _climateLock {"climate", true};
 	void distributePointsInRegion(const char *type, const Region& region, std::vector<glm::vec2>& positions, math::Random& random, int border, float distribution) const;
 
 public:
@@ -69,7 +146,7 @@ public:
 	Biome* addBiome(int lower, int upper, float humidity, float temperature, VoxelType type, bool underGround = false);
 
 	// this lookup must be really really fast - it is executed once per generated voxel
-	// iterating in y direction is fastest, because the last biome is cached on a per-thread-basis
+	// iterating in y direction and staying in one column is fastest, because the last climate map is cached on a per-thread-basis
 	inline Voxel getVoxel(const glm::ivec3& pos, bool underground = false) const {
 		core_trace_scoped(BiomeGetVoxel);
 		const Biome* biome = getBiome(pos, underground);
@@ -97,11 +174,17 @@ public:
 	void getCloudPositions(const Region& region, std::vector<glm::vec2>& positions, math::Random& random, int border) const;
 
 	/**
-	 * @return Humidity noise in the range [0-1]
+	 * @return The climate map of the column that contains the given world position - it is created if needed
+	 * @note This is thread safe
+	 */
+	ClimateMapPtr getClimateMap(int x, int z) const;
+
+	/**
+	 * @return Humidity noise in the range [0-1] - interpolated by the @c ClimateMap
 	 */
 	float getHumidity(int x, int z) const;
 	/**
-	 * @return Temperature noise in the range [0-1]
+	 * @return Temperature noise in the range [0-1] - interpolated by the @c ClimateMap
 	 */
 	float getTemperature(int x, int z) const;
 
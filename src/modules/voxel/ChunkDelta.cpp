@@ -0,0 +1,187 @@
+/**
+ * @file
+ */
+
+#include "ChunkDelta.h"
+#include "core/Assert.h"
+#include <algorithm>
+
+namespace voxel {
+
+namespace {
+
+inline int floorDiv(int value, int divisor) {
+	return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+}
+
+inline void writeVarInt(uint32_t value, std::vector<uint8_t>& out) {
+	while (value >= 0x80u) {
+		out.push_back((uint8_t)(value | 0x80u));
+		value >>= 7;
+	}
+	out.push_back((uint8_t)value);
+}
+
+inline bool readVarInt(const uint8_t*& data, const uint8_t* end, uint32_t& value) {
+	value = 0u;
+	for (int shift = 0; shift < 35; shift += 7) {
+		if (data >= end) {
+			return false;
+		}
+		const uint8_t byte = *data++;
+		value |= (uint32_t)(byte & 0x7fu) << shift;
+		if ((byte & 0x80u) == 0u) {
+			return true;
+		}
+	}
+	return false;
+}
+
+inline uint16_t paletteKey(const Voxel& voxel) {
+	return (uint16_t)(((uint16_t)voxel.getMaterial() << 8) | voxel.getColor());
+}
+
+const uint32_t MaxIndex = DeltaChunkSize * DeltaChunkSize * DeltaChunkSize;
+
+}
+
+glm::ivec3 deltaChunkPos(const glm::ivec3& pos) {
+	return glm::ivec3(floorDiv(pos.x, DeltaChunkSize), floorDiv(pos.y, DeltaChunkSize), floorDiv(pos.z, DeltaChunkSize));
+}
+
+uint32_t deltaIndex(const glm::ivec3& pos) {
+	const glm::ivec3 local = pos - deltaChunkPos(pos) * DeltaChunkSize;
+	return (uint32_t)(local.x + DeltaChunkSize * (local.z + DeltaChunkSize * local.y));
+}
+
+glm::ivec3 deltaPosition(const glm::ivec3& chunkPos, uint32_t index) {
+	const int x = index % DeltaChunkSize;
+	const int z = (index / DeltaChunkSize) % DeltaChunkSize;
+	const int y = index / (DeltaChunkSize * DeltaChunkSize);
+	return chunkPos * DeltaChunkSize + glm::ivec3(x, y, z);
+}
+
+bool encodeChunkDelta(const std::vector<VoxelChange>& changes, std::vector<uint8_t>& out) {
+	// the palette index of every change - the palette is ordered by first appearance
+	std::vector<uint16_t> palette;
+	std::vector<uint32_t> paletteIndices;
+	paletteIndices.reserve(changes.size());
+	for (size_t i = 0; i < changes.size(); ++i) {
+		if (changes[i].index >= MaxIndex) {
+			return false;
+		}
+		if (i > 0 && changes[i].index <= changes[i - 1].index) {
+			return false;
+		}
+		const uint16_t key = paletteKey(changes[i].voxel);
+		auto iter = std::find(palette.begin(), palette.end(), key);
+		if (iter == palette.end()) {
+			paletteIndices.push_back((uint32_t)palette.size());
+			palette.push_back(key);
+		} else {
+			paletteIndices.push_back((uint32_t)std::distance(palette.begin(), iter));
+		}
+	}
+
+	writeVarInt((uint32_t)palette.size(), out);
+	for (uint16_t key : palette) {
+		out.push_back((uint8_t)(key >> 8));
+		out.push_back((uint8_t)(key & 0xffu));
+	}
+
+	uint32_t previousEnd = 0u;
+	size_t i = 0;
+	while (i < changes.size()) {
+		const uint32_t start = changes[i].index;
+		const uint32_t paletteIndex = paletteIndices[i];
+		size_t runEnd = i + 1;
+		while (runEnd < changes.size() && changes[runEnd].index == changes[runEnd - 1].index + 1u
+				&& paletteIndices[runEnd] == paletteIndex) {
+			++runEnd;
+		}
+		const uint32_t length = (uint32_t)(runEnd - i);
+		writeVarInt(start - previousEnd, out);
+		writeVarInt(length, out);
+		writeVarInt(paletteIndex, out);
+		previousEnd = start + length;
+		i = runEnd;
+	}
+	return true;
+}
+
+bool decodeChunkDelta(const uint8_t* data, size_t size, std::vector<VoxelChange>& out) {
+	const uint8_t* end = data + size;
+	uint32_t paletteSize;
+	if (!readVarInt(data, end, paletteSize)) {
+		return false;
+	}
+	if ((size_t)(end - data) < (size_t)paletteSize * 2u) {
+		return false;
+	}
+	std::vector<Voxel> palette;
+	palette.reserve(paletteSize);
+	for (uint32_t i = 0; i < paletteSize; ++i) {
+		const VoxelType material = (VoxelType)data[0];
+		if (material >= VoxelType::Max) {
+			return false;
+		}
+		palette.push_back(createVoxel(material, data[1]));
+		data += 2;
+	}
+
+	uint32_t index = 0u;
+	while (data < end) {
+		uint32_t gap;
+		uint32_t length;
+		uint32_t paletteIndex;
+		if (!readVarInt(data, end, gap) || !readVarInt(data, end, length) || !readVarInt(data, end, paletteIndex)) {
+			return false;
+		}
+		if (paletteIndex >= paletteSize || length == 0u) {
+			return false;
+		}
+		index += gap;
+		if (index >= MaxIndex || length > MaxIndex - index) {
+			return false;
+		}
+		for (uint32_t i = 0; i < length; ++i) {
+			out.push_back(VoxelChange { index++, palette[paletteIndex] });
+		}
+	}
+	return true;
+}
+
+void ChunkDeltaTracker::track(const glm::ivec3& pos, const Voxel& voxel) {
+	const glm::ivec3& chunkPos = deltaChunkPos(pos);
+	Chunk& chunk = _chunks[chunkPos];
+	++chunk.version;
+	chunk.voxels[deltaIndex(pos)] = TrackedVoxel { voxel, chunk.version };
+	_dirty.insert(chunkPos);
+}
+
+uint32_t ChunkDeltaTracker::version(const glm::ivec3& chunkPos) const {
+	auto i = _chunks.find(chunkPos);
+	if (i == _chunks.end()) {
+		return 0u;
+	}
+	return i->second.version;
+}
+
+bool ChunkDeltaTracker::changes(const glm::ivec3& chunkPos, uint32_t sinceVersion, std::vector<VoxelChange>& out) const {
+	auto i = _chunks.find(chunkPos);
+	if (i == _chunks.end() || i->second.version <= sinceVersion) {
+		return false;
+	}
+	const size_t offset = out.size();
+	for (const auto& e : i->second.voxels) {
+		if (e.second.version > sinceVersion) {
+			out.push_back(VoxelChange { e.first, e.second.voxel });
+		}
+	}
+	std::sort(out.begin() + offset, out.end(), [] (const VoxelChange& a, const VoxelChange& b) {
+		return a.index < b.index;
+	});
+	return out.size() > offset;
+}
+
+}
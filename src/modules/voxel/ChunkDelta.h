@@ -0,0 +1,135 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "voxel/polyvox/Voxel.h"
+#include "core/GLM.h"
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <stdint.h>
+#include <stddef.h>
+
+namespace voxel {
+
+/**
+ * @brief Side length of the cubic chunks that voxel changes are tracked and replicated in
+ */
+constexpr int DeltaChunkSize = 32;
+
+/**
+ * @brief A single modified voxel inside of a delta chunk
+ */
+struct VoxelChange {
+	/**
+	 * @brief The index of the voxel inside of the delta chunk
+	 * @sa deltaIndex()
+	 */
+	uint32_t index;
+	Voxel voxel;
+};
+
+/**
+ * @brief Converts a world position into the position of the delta chunk it is part of
+ */
+glm::ivec3 deltaChunkPos(const glm::ivec3& pos);
+
+/**
+ * @brief Converts a world position into the index inside of its delta chunk. Consecutive
+ * indices are neighbours on the x axis.
+ */
+uint32_t deltaIndex(const glm::ivec3& pos);
+
+/**
+ * @brief Converts a delta chunk position and an index back into a world position
+ */
+glm::ivec3 deltaPosition(const glm::ivec3& chunkPos, uint32_t index);
+
+/**
+ * @brief Run-length and palette encodes the changes of one delta chunk
+ *
+ * The output starts with the palette of distinct voxels (material and color), followed by the
+ * runs. Each run stores the gap to the end of the previous run, the length of the run and
+ * the palette index. All numbers are varints.
+ *
+ * @param[in] changes The changes sorted by their index - every index may only appear once.
+ * @param[out] out The encoded bytes are appended here
+ * @return @c false if the changes are not sorted or contain duplicates
+ */
+bool encodeChunkDelta(const std::vector<VoxelChange>& changes, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decodes the output of @c encodeChunkDelta()
+ * @param[out] out The decoded changes are appended here
+ * @return @c false if the data is truncated or corrupted
+ */
+bool decodeChunkDelta(const uint8_t* data, size_t size, std::vector<VoxelChange>& out);
+
+/**
+ * @brief Tracks voxel modifications per delta chunk
+ *
+ * Every chunk has a version that is incremented with each modification. Only the latest
+ * voxel of every position is kept - together with the version it was modified in - so
+ * the changes since any older version can be computed.
+ */
+class ChunkDeltaTracker {
+public:
+	struct TrackedVoxel {
+		Voxel voxel;
+		uint32_t version;
+	};
+
+	struct Chunk {
+		uint32_t version = 0u;
+		std::unordered_map<uint32_t, TrackedVoxel> voxels;
+	};
+
+	typedef std::unordered_map<glm::ivec3, Chunk, std::hash<glm::ivec3> > Chunks;
+	typedef std::unordered_set<glm::ivec3, std::hash<glm::ivec3> > ChunkPositions;
+
+private:
+	Chunks _chunks;
+	ChunkPositions _dirty;
+
+public:
+	/**
+	 * @param[in] pos The world position of the voxel that was modified
+	 */
+	void track(const glm::ivec3& pos, const Voxel& voxel);
+
+	/**
+	 * @return The version of the given delta chunk - @c 0 if it was never modified
+	 */
+	uint32_t version(const glm::ivec3& chunkPos) const;
+
+	/**
+	 * @brief Collects the changes of the given delta chunk that are newer than the given version
+	 * @param[out] out The changes sorted by their index
+	 * @return @c false if there are no newer changes
+	 */
+	bool changes(const glm::ivec3& chunkPos, uint32_t sinceVersion, std::vector<VoxelChange>& out) const;
+
+	const Chunks& chunks() const;
+
+	/**
+	 * @brief The delta chunks that were modified since the last call to @c clearDirty()
+	 */
+	const ChunkPositions& dirty() const;
+	void clearDirty();
+};
+
+inline const ChunkDeltaTracker::Chunks& ChunkDeltaTracker::chunks() const {
+	return _chunks;
+}
+
+inline const ChunkDeltaTracker::ChunkPositions& ChunkDeltaTracker::dirty() const {
+	return _dirty;
+}
+
+inline void ChunkDeltaTracker::clearDirty() {
+	_dirty.clear();
+}
+
+}
@@ -0,0 +1,278 @@
+/**
+ * @file
+ */
+
+#include "LodPyramid.h"
+#include "MaterialColor.h"
+#include "polyvox/PagedVolume.h"
+#include "polyvox/RawVolume.h"
+#include "core/Color.h"
+#include "core/Trace.h"
+#include "core/Assert.h"
+
+namespace voxel {
+
+namespace {
+
+inline int floorDiv(int value, int divisor) {
+	return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+}
+
+inline glm::ivec3 floorDiv(const glm::ivec3& value, int divisor) {
+	return glm::ivec3(floorDiv(value.x, divisor), floorDiv(value.y, divisor), floorDiv(value.z, divisor));
+}
+
+inline int index(int x, int y, int z, int size) {
+	return x + size * (y + size * z);
+}
+
+}
+
+LodPyramid::LodPyramid(PagedVolume* volume, const glm::ivec3& origin, int brickSize) :
+		_volume(volume), _origin(origin), _brickSize(brickSize) {
+	core_assert(brickSize > 0);
+}
+
+Region LodPyramid::levelRegion(const Region& region, int level) const {
+	const int scale = 1 << level;
+	const glm::ivec3& mins = floorDiv(region.getLowerCorner() - _origin, scale);
+	const glm::ivec3& maxs = floorDiv(region.getUpperCorner() + 1 - _origin, scale) - 1;
+	return Region(mins, maxs);
+}
+
+LodPyramid::BrickPtr LodPyramid::brick(int level, const glm::ivec3& brickPos) {
+	core_assert(level > 0);
+	const glm::ivec4 key(brickPos, level);
+	uint32_t generation;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto i = _bricks.find(key);
+		if (i != _bricks.end()) {
+			return i->second;
+		}
+		generation = _generation;
+	}
+	// build without holding the lock - the lower levels are fetched recursively
+	const BrickPtr& brick = build(level, brickPos);
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (generation == _generation) {
+		_bricks.emplace(key, brick);
+		_maxLevel = (std::max)(_maxLevel, level);
+	}
+	return brick;
+}
+
+LodPyramid::BrickPtr LodPyramid::build(int level, const glm::ivec3& brickPos) {
+	core_trace_scoped(LodPyramidBuild);
+	const int size = _brickSize;
+	const int srcSize = size * 2;
+
+	// gather the voxels of the level below
+	std::vector<Voxel> src(srcSize * srcSize * srcSize);
+	if (level == 1) {
+		PagedVolume::Sampler sampler(_volume);
+		const glm::ivec3& srcMins = _origin + brickPos * srcSize;
+		for (int z = 0; z < srcSize; ++z) {
+			for (int y = 0; y < srcSize; ++y) {
+				sampler.setPosition(srcMins + glm::ivec3(0, y, z));
+				Voxel* row = &src[index(0, y, z, srcSize)];
+				for (int x = 0; x < srcSize; ++x) {
+					row[x] = sampler.voxel();
+					sampler.movePositiveX();
+				}
+			}
+		}
+	} else {
+		for (int cz = 0; cz < 2; ++cz) {
+			for (int cy = 0; cy < 2; ++cy) {
+				for (int cx = 0; cx < 2; ++cx) {
+					const BrickPtr& child = brick(level - 1, brickPos * 2 + glm::ivec3(cx, cy, cz));
+					for (int z = 0; z < size; ++z) {
+						for (int y = 0; y < size; ++y) {
+							const Voxel* from = &(*child)[index(0, y, z, size)];
+							Voxel* to = &src[index(cx * size, cy * size + y, cz * size + z, srcSize)];
+							std::copy(from, from + size, to);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	const MaterialColorArray& colors = getMaterialColors();
+	std::vector<Voxel>* dst = new std::vector<Voxel>(size * size * size);
+
+	// a voxel is only solid if all eight corresponding voxels of the level below are solid. This
+	// means that the coarser meshes shrink away which ensures that cracks aren't visible. The color
+	// is the average color of the eight voxels.
+	for (int z = 0; z < size; ++z) {
+		for (int y = 0; y < size; ++y) {
+			for (int x = 0; x < size; ++x) {
+				glm::vec3 color(0.0f);
+				VoxelType material = VoxelType::Air;
+				bool sameMaterial = true;
+				int solidVoxels = 0;
+				for (int cz = 0; cz < 2; ++cz) {
+					for (int cy = 0; cy < 2; ++cy) {
+						for (int cx = 0; cx < 2; ++cx) {
+							const Voxel& child = src[index(x * 2 + cx, y * 2 + cy, z * 2 + cz, srcSize)];
+							if (!isBlocked(child.getMaterial())) {
+								continue;
+							}
+							++solidVoxels;
+							color += glm::vec3(colors[child.getColor()]);
+							if (material == VoxelType::Air) {
+								material = child.getMaterial();
+							} else if (material != child.getMaterial()) {
+								sameMaterial = false;
+							}
+						}
+					}
+				}
+				if (solidVoxels < 8) {
+					continue;
+				}
+				const int colorIndex = core::Color::getClosestMatch(glm::vec4(color / 8.0f, 1.0f), colors);
+				(*dst)[index(x, y, z, size)] = createVoxel(sameMaterial ? material : VoxelType::Generic, colorIndex);
+			}
+		}
+	}
+
+	// thin structures would change the color of the surface, so those voxels that are on a
+	// material-air boundary are colored again with a larger neighbourhood (4x4x4) of the level
+	// below - weighted by how visible the voxels are. Only voxels of this brick are taken into
+	// account to keep the bricks independent from their neighbours.
+	auto isAirAt = [] (const std::vector<Voxel>& voxels, int x, int y, int z, int side) {
+		if (x < 0 || y < 0 || z < 0 || x >= side || y >= side || z >= side) {
+			return false;
+		}
+		return isAir(voxels[index(x, y, z, side)].getMaterial());
+	};
+	static const glm::ivec3 neighbours[] = { glm::ivec3(-1, 0, 0), glm::ivec3(1, 0, 0), glm::ivec3(0, -1, 0),
+			glm::ivec3(0, 1, 0), glm::ivec3(0, 0, -1), glm::ivec3(0, 0, 1) };
+	for (int z = 0; z < size; ++z) {
+		for (int y = 0; y < size; ++y) {
+			for (int x = 0; x < size; ++x) {
+				Voxel& voxel = (*dst)[index(x, y, z, size)];
+				if (isAir(voxel.getMaterial())) {
+					continue;
+				}
+				bool boundary = false;
+				for (const glm::ivec3& n : neighbours) {
+					if (isAirAt(*dst, x + n.x, y + n.y, z + n.z, size)) {
+						boundary = true;
+						break;
+					}
+				}
+				if (!boundary) {
+					continue;
+				}
+				glm::vec3 color(0.0f);
+				int exposedFaces = 0;
+				for (int cz = -1; cz < 3; ++cz) {
+					for (int cy = -1; cy < 3; ++cy) {
+						for (int cx = -1; cx < 3; ++cx) {
+							const int sx = x * 2 + cx;
+							const int sy = y * 2 + cy;
+							const int sz = z * 2 + cz;
+							if (sx < 0 || sy < 0 || sz < 0 || sx >= srcSize || sy >= srcSize || sz >= srcSize) {
+								continue;
+							}
+							const Voxel& child = src[index(sx, sy, sz, srcSize)];
+							if (isAir(child.getMaterial())) {
+								continue;
+							}
+							int faces = 0;
+							for (const glm::ivec3& n : neighbours) {
+								if (isAirAt(src, sx + n.x, sy + n.y, sz + n.z, srcSize)) {
+									++faces;
+								}
+							}
+							color += glm::vec3(colors[child.getColor()]) * (float)faces;
+							exposedFaces += faces;
+						}
+					}
+				}
+				if (exposedFaces == 0) {
+					continue;
+				}
+				const glm::vec4 avgColor(color / (float)exposedFaces, 1.0f);
+				voxel.setColor(core::Color::getClosestMatch(avgColor, colors));
+			}
+		}
+	}
+	++_builtBricks;
+	return BrickPtr(dst);
+}
+
+void LodPyramid::copy(int level, const Region& region, RawVolume& volume) {
+	core_trace_scoped(LodPyramidCopy);
+	const glm::ivec3& mins = region.getLowerCorner();
+	const glm::ivec3& maxs = region.getUpperCorner();
+	if (level == 0) {
+		PagedVolume::Sampler sampler(_volume);
+		for (int z = mins.z; z <= maxs.z; ++z) {
+			for (int y = mins.y; y <= maxs.y; ++y) {
+				sampler.setPosition(_origin + glm::ivec3(mins.x, y, z));
+				for (int x = mins.x; x <= maxs.x; ++x) {
+					volume.setVoxel(x, y, z, sampler.voxel());
+					sampler.movePositiveX();
+				}
+			}
+		}
+		return;
+	}
+	const int size = _brickSize;
+	const glm::ivec3& brickMins = floorDiv(mins, size);
+	const glm::ivec3& brickMaxs = floorDiv(maxs, size);
+	for (int bz = brickMins.z; bz <= brickMaxs.z; ++bz) {
+		for (int by = brickMins.y; by <= brickMaxs.y; ++by) {
+			for (int bx = brickMins.x; bx <= brickMaxs.x; ++bx) {
+				const glm::ivec3 brickPos(bx, by, bz);
+				const BrickPtr& b = brick(level, brickPos);
+				const glm::ivec3& base = brickPos * size;
+				const glm::ivec3& lower = glm::max(mins, base);
+				const glm::ivec3& upper = glm::min(maxs, base + size - 1);
+				for (int z = lower.z; z <= upper.z; ++z) {
+					for (int y = lower.y; y <= upper.y; ++y) {
+						for (int x = lower.x; x <= upper.x; ++x) {
+							volume.setVoxel(x, y, z, (*b)[index(x - base.x, y - base.y, z - base.z, size)]);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void LodPyramid::erase(const glm::ivec3& levelMins, const glm::ivec3& levelMaxs, int level) {
+	const glm::ivec3& brickMins = floorDiv(levelMins, _brickSize);
+	const glm::ivec3& brickMaxs = floorDiv(levelMaxs, _brickSize);
+	for (int bz = brickMins.z; bz <= brickMaxs.z; ++bz) {
+		for (int by = brickMins.y; by <= brickMaxs.y; ++by) {
+			for (int bx = brickMins.x; bx <= brickMaxs.x; ++bx) {
+				_bricks.erase(glm::ivec4(bx, by, bz, level));
+			}
+		}
+	}
+}
+
+void LodPyramid::markAsModified(const glm::ivec3& pos) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	++_generation;
+	for (int level = 1; level <= _maxLevel; ++level) {
+		const glm::ivec3& levelPos = floorDiv(pos - _origin, 1 << level);
+		erase(levelPos, levelPos, level);
+	}
+}
+
+void LodPyramid::markAsModified(const Region& region) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	++_generation;
+	for (int level = 1; level <= _maxLevel; ++level) {
+		const int scale = 1 << level;
+		erase(floorDiv(region.getLowerCorner() - _origin, scale), floorDiv(region.getUpperCorner() - _origin, scale), level);
+	}
+}
+
+}
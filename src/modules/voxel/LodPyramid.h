@@ -0,0 +1,105 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "voxel/polyvox/Voxel.h"
+#include "voxel/polyvox/Region.h"
+#include "core/GLM.h"
+#include "core/NonCopyable.h"
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <unordered_map>
+
+namespace voxel {
+
+class PagedVolume;
+class RawVolume;
+
+/**
+ * @brief Mip pyramid of downsampled voxel data for the level of detail extraction of the @c Octree
+ *
+ * Level 0 is the @c PagedVolume itself, every further level halves the resolution of the level below.
+ * The levels are stored in cubic bricks with a side length of @c brickSize() voxels. A brick is built
+ * on demand from the 8 bricks of the level below and is cached until the data it covers is modified.
+ * This means that each level is only built once and reused for the next coarser level.
+ *
+ * Level coordinates are relative to the origin of the pyramid:
+ * @code world = origin + levelPos * (1 << level) @endcode
+ *
+ * @note Thread safe - the bricks are accessed from the extraction threads.
+ */
+class LodPyramid : public core::NonCopyable {
+private:
+	typedef std::shared_ptr<const std::vector<Voxel> > BrickPtr;
+	typedef std::unordered_map<glm::ivec4, BrickPtr, std::hash<glm::ivec4> > Bricks;
+
+	PagedVolume* _volume;
+	const glm::ivec3 _origin;
+	const int _brickSize;
+
+	std::mutex _mutex;
+	// the key is the brick position and the level in w
+	Bricks _bricks;
+	// incremented with each modification - bricks that were built in the meantime are not cached
+	uint32_t _generation = 0u;
+	int _maxLevel = 0;
+	std::atomic_int _builtBricks { 0 };
+
+	BrickPtr brick(int level, const glm::ivec3& brickPos);
+	BrickPtr build(int level, const glm::ivec3& brickPos);
+	void erase(const glm::ivec3& levelMins, const glm::ivec3& levelMaxs, int level);
+public:
+	/**
+	 * @param[in] origin The world position of the level coordinate origin - every brick of every level
+	 * is aligned to this position
+	 * @param[in] brickSize The side length of the bricks
+	 */
+	LodPyramid(PagedVolume* volume, const glm::ivec3& origin, int brickSize);
+
+	/**
+	 * @brief Converts a world region into the coordinates of the given level
+	 * @note The region must be aligned to the voxel size of the level
+	 */
+	Region levelRegion(const Region& region, int level) const;
+
+	/**
+	 * @brief Fills the given volume with the voxels of the given level
+	 * @param[in] region The region in level coordinates - the volume must contain it
+	 */
+	void copy(int level, const Region& region, RawVolume& volume);
+
+	/**
+	 * @brief Drops all cached bricks that contain the given world position
+	 */
+	void markAsModified(const glm::ivec3& pos);
+	/**
+	 * @brief Drops all cached bricks that intersect the given world region
+	 */
+	void markAsModified(const Region& region);
+
+	const glm::ivec3& origin() const;
+	int brickSize() const;
+
+	/**
+	 * @return The amount of bricks that were built since the pyramid was created
+	 */
+	int builtBricks() const;
+};
+
+inline const glm::ivec3& LodPyramid::origin() const {
+	return _origin;
+}
+
+inline int LodPyramid::brickSize() const {
+	return _brickSize;
+}
+
+inline int LodPyramid::builtBricks() const {
+	return _builtBricks;
+}
+
+}
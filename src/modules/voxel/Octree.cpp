@@ -134,6 +134,10 @@ Octree::Octree(OctreeVolume* volume, uint32_t baseNodeSize) :
 
 	octreeRegion.grow(widthIncrease / 2, heightIncrease / 2, depthIncrease / 2);
 
+	// the bricks of the pyramid have the size of the leaf nodes - this way every node of every
+	// height maps to exactly one brick of the level that equals its height
+	_lodPyramid = std::unique_ptr<LodPyramid>(new LodPyramid(_volume->pagedVolume(), octreeRegion.getLowerCorner(), _baseNodeSize));
+
 	_rootNodeIndex = createNode(octreeRegion, InvalidNodeIndex);
 	rootNode()->_height = maxHeightOfTree - 1;
 
@@ -203,10 +207,12 @@ int Octree::update(TimeStamp dt, const glm::vec3& viewPosition, float lodThresho
 }
 
 void Octree::markDataAsModified(int32_t x, int32_t y, int32_t z, TimeStamp newTimeStamp) {
+	_lodPyramid->markAsModified(glm::ivec3(x, y, z));
 	markAsModified(_rootNodeIndex, x, y, z, newTimeStamp);
 }
 
 void Octree::markDataAsModified(const Region& region, TimeStamp newTimeStamp) {
+	_lodPyramid->markAsModified(region);
 	markAsModified(_rootNodeIndex, region, newTimeStamp);
 }
 
@@ -7,9 +7,11 @@
 #include "SurfaceExtractionTask.h"
 #include "collection/ConcurrentQueue.h"
 #include "OctreeNode.h"
+#include "LodPyramid.h"
 
 #include <vector>
 #include <list>
+#include <memory>
 
 namespace voxel {
 
@@ -33,6 +35,11 @@ public:
 
 	OctreeVolume* volume() const;
 
+	/**
+	 * @brief The downsampled voxel data for the nodes that are above the leaf level
+	 */
+	LodPyramid& lodPyramid() const;
+
 	/**
 	 * @param lodThreshold Controls the point at which we switch to a different level of detail.
 	 * @return the amount of active nodes
@@ -120,6 +127,7 @@ private:
 	int32_t _minimumLOD = 2;
 
 	OctreeVolume* _volume;
+	std::unique_ptr<LodPyramid> _lodPyramid;
 
 	core::ConcurrentQueue<SurfaceExtractionTask*> _finishedExtractionTasks;
 
@@ -155,4 +163,8 @@ inline OctreeVolume* Octree::volume() const {
 	return _volume;
 }
 
+inline LodPyramid& Octree::lodPyramid() const {
+	return *_lodPyramid;
+}
+
 }
@@ -0,0 +1,66 @@
+/**
+ * @file
+ */
+
+#include "PendingEdits.h"
+#include "voxel/polyvox/Utility.h"
+
+namespace voxel {
+
+PendingEdits::PendingEdits() :
+		_lock("pendingedits") {
+}
+
+void PendingEdits::init(uint16_t chunkSideLength) {
+	core::ScopedWriteLock lock(_lock);
+	_chunkSideLengthPower = logBase2(chunkSideLength);
+}
+
+void PendingEdits::add(const std::vector<VoxelEdit>& edits, std::vector<VoxelEdit>& pagedIn) {
+	if (edits.empty()) {
+		return;
+	}
+	core::ScopedWriteLock lock(_lock);
+	for (const VoxelEdit& edit : edits) {
+		const glm::ivec3& pos = chunkPos(edit.pos);
+		if (_pagedIn.find(pos) != _pagedIn.end()) {
+			pagedIn.push_back(edit);
+			continue;
+		}
+		_edits[pos].push_back(edit);
+		++_size;
+	}
+}
+
+void PendingEdits::pageIn(const Region& region, std::vector<VoxelEdit>& edits) {
+	const glm::ivec3& pos = chunkPos(region.getLowerCorner());
+	core::ScopedWriteLock lock(_lock);
+	_pagedIn.insert(pos);
+	auto i = _edits.find(pos);
+	if (i == _edits.end()) {
+		return;
+	}
+	_size -= i->second.size();
+	edits.insert(edits.end(), i->second.begin(), i->second.end());
+	_edits.erase(i);
+}
+
+void PendingEdits::pageOut(const Region& region) {
+	const glm::ivec3& pos = chunkPos(region.getLowerCorner());
+	core::ScopedWriteLock lock(_lock);
+	_pagedIn.erase(pos);
+}
+
+size_t PendingEdits::size() const {
+	core::ScopedReadLock lock(_lock);
+	return _size;
+}
+
+void PendingEdits::clear() {
+	core::ScopedWriteLock lock(_lock);
+	_edits.clear();
+	_pagedIn.clear();
+	_size = 0u;
+}
+
+}
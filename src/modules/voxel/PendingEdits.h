@@ -0,0 +1,69 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "voxel/polyvox/ChunkBuffer.h"
+#include "core/ReadWriteLock.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+namespace voxel {
+
+/**
+ * @brief Voxel writes of the world generation that crossed into neighbouring chunks
+ *
+ * Edits for chunks that are not paged in are kept here until the chunk is paged in - see @c pageIn(). Edits for
+ * chunks that are already paged in are handed back to the caller to be written into the volume directly.
+ *
+ * @note All methods are thread safe
+ */
+class PendingEdits {
+private:
+	mutable core::ReadWriteLock _lock;
+	std::unordered_map<glm::ivec3, std::vector<VoxelEdit>, std::hash<glm::ivec3> > _edits;
+	std::unordered_set<glm::ivec3, std::hash<glm::ivec3> > _pagedIn;
+	uint8_t _chunkSideLengthPower = 8u;
+	size_t _size = 0u;
+
+	inline glm::ivec3 chunkPos(const glm::ivec3& pos) const {
+		return glm::ivec3(pos.x >> _chunkSideLengthPower, pos.y >> _chunkSideLengthPower, pos.z >> _chunkSideLengthPower);
+	}
+public:
+	PendingEdits();
+
+	void init(uint16_t chunkSideLength);
+
+	/**
+	 * @brief Stores the edits for the chunks that are not paged in
+	 * @param[out] pagedIn The edits for chunks that are already paged in
+	 */
+	void add(const std::vector<VoxelEdit>& edits, std::vector<VoxelEdit>& pagedIn);
+
+	/**
+	 * @brief Hands out the pending edits of the given chunk and marks it as paged in
+	 * @param[in] region The region of the chunk
+	 * @param[out] edits The edits that were recorded for the chunk
+	 * @note Call this after the chunk data is complete - from now on @c add() hands the edits for this
+	 * chunk back to be written into the volume.
+	 */
+	void pageIn(const Region& region, std::vector<VoxelEdit>& edits);
+
+	/**
+	 * @brief New edits for the given chunk are recorded again instead of being handed back by @c add()
+	 */
+	void pageOut(const Region& region);
+
+	/**
+	 * @return The amount of edits that are waiting for their chunk
+	 */
+	size_t size() const;
+
+	void clear();
+};
+
+}
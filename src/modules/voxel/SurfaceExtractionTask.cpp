@@ -1,11 +1,11 @@
 #include "SurfaceExtractionTask.h"
 #include "Octree.h"
 #include "OctreeNode.h"
+#include "LodPyramid.h"
 #include "core/App.h"
 #include "polyvox/Region.h"
 #include "polyvox/CubicSurfaceExtractor.h"
 #include "polyvox/RawVolume.h"
-#include "polyvox/VolumeRescaler.h"
 #include "IsQuadNeeded.h"
 #include "polyvox/PagedVolume.h"
 #include "polyvox/Mesh.h"
@@ -15,21 +15,28 @@
 
 namespace voxel {
 
-// Eliminate this
-static inline void scaleVertices(Mesh* mesh, uint32_t amount) {
-	core_trace_scoped(ScaleVertices);
-	for (uint32_t ct = 0; ct < mesh->getNoOfVertices(); ct++) {
-		VoxelVertex& vertex = const_cast<VoxelVertex&>(mesh->getVertex(ct));
-		vertex.position *= amount;
-	}
-}
-
 SurfaceExtractionTask::SurfaceExtractionTask(OctreeNode* octreeNode, PagedVolume* polyVoxVolume) :
 		_node(octreeNode), _volume(polyVoxVolume) {
 	const voxel::Region& region = octreeNode->region();
 	Log::debug("Extract volume data for region mins(%i:%i:%i), maxs(%i:%i:%i)",
 			region.getLowerX(), region.getLowerY(), region.getLowerZ(),
 			region.getUpperX(), region.getUpperY(), region.getUpperZ());
+	// a re-extraction usually ends up with a mesh of about the same size as before
+	const Mesh* mesh = octreeNode->getMesh();
+	if (mesh != nullptr) {
+		_expectedVertices = mesh->getNoOfVertices();
+		_expectedIndices = mesh->getNoOfIndices();
+	} else {
+		// one surface layer in the size of the extracted area
+		const int size = region.getWidthInVoxels() >> octreeNode->height();
+		_expectedVertices = size * size * 4;
+		_expectedIndices = size * size * 6;
+	}
+	const Mesh* waterMesh = octreeNode->getWaterMesh();
+	if (waterMesh != nullptr) {
+		_expectedWaterVertices = waterMesh->getNoOfVertices();
+		_expectedWaterIndices = waterMesh->getNoOfIndices();
+	}
 }
 
 SurfaceExtractionTask::~SurfaceExtractionTask() {
@@ -40,72 +47,28 @@ void SurfaceExtractionTask::process() {
 	core_trace_scoped(SurfaceExtractionTaskProcess);
 	_processingStartedTimestamp = _node->_octree->time();
 
-	// TODO: sizes to prevent (re-)allocations
-	_mesh = std::make_shared<Mesh>(0, 0, true);
-	_meshWater = std::make_shared<Mesh>(0, 0, true);
+	_mesh = std::make_shared<Mesh>(_expectedVertices, _expectedIndices, true);
+	_meshWater = std::make_shared<Mesh>(_expectedWaterVertices, _expectedWaterIndices, true);
 	Mesh* meshWater = _meshWater.get();
 	Mesh* mesh = _mesh.get();
 
-	const uint32_t downScaleFactor = 0x0001 << _node->height();
-
-	if (downScaleFactor == 1) {
+	const int level = _node->height();
+	if (level == 0) {
 		extractAllCubicMesh(_volume, _node->region(), mesh, meshWater, IsQuadNeeded(), IsWaterQuadNeeded(), MAX_WATER_HEIGHT);
-	} else if (downScaleFactor == 2) {
-		Region srcRegion = _node->region();
-		srcRegion.grow(2);
-
-		const glm::ivec3& lowerCorner = srcRegion.getLowerCorner();
-		glm::ivec3 upperCorner = srcRegion.getUpperCorner();
-
-		upperCorner = upperCorner - lowerCorner;
-		upperCorner = upperCorner / static_cast<int32_t>(downScaleFactor);
-		upperCorner = upperCorner + lowerCorner;
-
-		Region dstRegion(lowerCorner, upperCorner);
-
-		RawVolume resampledVolume(dstRegion);
-		rescaleVolume(*_volume, srcRegion, resampledVolume, dstRegion);
-
-		dstRegion.shrink(1);
-
-		extractAllCubicMesh(&resampledVolume, dstRegion, mesh, meshWater, IsQuadNeeded(), IsWaterQuadNeeded(), MAX_WATER_HEIGHT);
-
-		scaleVertices(mesh, downScaleFactor);
-		scaleVertices(meshWater, downScaleFactor);
-	} else if (downScaleFactor == 4) {
-		Region srcRegion = _node->region();
-		srcRegion.grow(4);
-
-		glm::ivec3 lowerCorner = srcRegion.getLowerCorner();
-		glm::ivec3 upperCorner = srcRegion.getUpperCorner();
-
-		upperCorner = upperCorner - lowerCorner;
-		upperCorner = upperCorner / static_cast<int32_t>(2);
-		upperCorner = upperCorner + lowerCorner;
-
-		const Region dstRegion(lowerCorner, upperCorner);
-
-		RawVolume resampledVolume(dstRegion);
-		rescaleVolume(*_volume, srcRegion, resampledVolume, dstRegion);
-
-		lowerCorner = dstRegion.getLowerCorner();
-		upperCorner = dstRegion.getUpperCorner();
-
-		upperCorner = upperCorner - lowerCorner;
-		upperCorner = upperCorner / static_cast<int32_t>(2);
-		upperCorner = upperCorner + lowerCorner;
-
-		Region dstRegion2(lowerCorner, upperCorner);
-
-		RawVolume resampledVolume2(dstRegion2);
-		rescaleVolume(resampledVolume, dstRegion, resampledVolume2, dstRegion2);
-
-		dstRegion2.shrink(1);
-
-		extractAllCubicMesh(&resampledVolume2, dstRegion2, mesh, meshWater, IsQuadNeeded(), IsWaterQuadNeeded(), MAX_WATER_HEIGHT);
-
-		scaleVertices(mesh, downScaleFactor);
-		scaleVertices(meshWater, downScaleFactor);
+	} else {
+		// the downsampled data is taken from the cached pyramid and the extractor emits the
+		// vertices in world coordinates.
+		LodPyramid& pyramid = _node->_octree->lodPyramid();
+		const int scale = 1 << level;
+		const Region& levelRegion = pyramid.levelRegion(_node->region(), level);
+		Region volumeRegion = levelRegion;
+		volumeRegion.grow(1);
+		RawVolume volume(volumeRegion);
+		pyramid.copy(level, volumeRegion, volume);
+
+		const int waterHeight = MAX_WATER_HEIGHT - pyramid.origin().y;
+		const int waterSurface = waterHeight >= 0 ? waterHeight / scale : (waterHeight - scale + 1) / scale;
+		extractAllCubicMesh(&volume, levelRegion, mesh, meshWater, IsQuadNeeded(), IsWaterQuadNeeded(), waterSurface, true, true, scale, pyramid.origin());
 	}
 
 	_node->_octree->_finishedExtractionTasks.push(this);
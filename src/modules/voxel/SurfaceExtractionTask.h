@@ -23,6 +23,11 @@ public:
 	PagedVolume* _volume;
 	std::shared_ptr<Mesh> _mesh;
 	std::shared_ptr<Mesh> _meshWater;
+	// the meshes are pre-sized to prevent re-allocations during the extraction
+	int _expectedVertices = 0;
+	int _expectedIndices = 0;
+	int _expectedWaterVertices = 0;
+	int _expectedWaterIndices = 0;
 	long _processingStartedTimestamp = std::numeric_limits<long>::max();
 };
 
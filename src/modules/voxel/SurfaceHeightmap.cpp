@@ -0,0 +1,113 @@
+/**
+ * @file
+ */
+
+#include "SurfaceHeightmap.h"
+#include "voxel/Constants.h"
+#include "core/Trace.h"
+
+namespace voxel {
+
+SurfaceHeightmap::~SurfaceHeightmap() {
+	shutdown();
+}
+
+void SurfaceHeightmap::init(PagedVolume* volume) {
+	_volume = volume;
+	_sideLength = volume->chunkSideLength();
+	_volume->addChunkListener(this);
+}
+
+void SurfaceHeightmap::shutdown() {
+	if (_volume != nullptr) {
+		_volume->removeChunkListener(this);
+		_volume = nullptr;
+	}
+	core::ScopedWriteLock lock(_lock);
+	_chunks.clear();
+}
+
+int SurfaceHeightmap::maxChunkY() const {
+	return MAX_HEIGHT / _sideLength;
+}
+
+int SurfaceHeightmap::scanColumn(const PagedVolume::ChunkPtr& chunk, int x, int z, int startY) const {
+	for (int y = startY; y >= 0; --y) {
+		if (isFloor(chunk->voxel(x, y, z).getMaterial())) {
+			return y;
+		}
+	}
+	return -1;
+}
+
+void SurfaceHeightmap::onCreate(const PagedVolume::ChunkPtr& chunk) {
+	const glm::ivec3 mins = chunk->region().getLowerCorner();
+	if (mins.y < 0 || mins.y > MAX_HEIGHT) {
+		return;
+	}
+	core_trace_scoped(SurfaceHeightmapBuild);
+	const int startY = glm::min(_sideLength - 1, MAX_HEIGHT - mins.y);
+	Columns columns(_sideLength * _sideLength);
+	for (int z = 0; z < _sideLength; ++z) {
+		for (int x = 0; x < _sideLength; ++x) {
+			columns[x + z * _sideLength] = scanColumn(chunk, x, z, startY);
+		}
+	}
+	core::ScopedWriteLock lock(_lock);
+	_chunks[mins / _sideLength] = std::move(columns);
+}
+
+void SurfaceHeightmap::onRemove(const PagedVolume::ChunkPtr& chunk) {
+	const glm::ivec3 mins = chunk->region().getLowerCorner();
+	core::ScopedWriteLock lock(_lock);
+	_chunks.erase(mins / _sideLength);
+}
+
+void SurfaceHeightmap::update(const glm::ivec3& pos, const Voxel& voxel) {
+	if (pos.y < 0 || pos.y > MAX_HEIGHT) {
+		return;
+	}
+	const glm::ivec3 chunkPos(glm::floor(glm::vec3(pos) / (float)_sideLength));
+	const glm::ivec3 local = pos - chunkPos * _sideLength;
+	const int index = local.x + local.z * _sideLength;
+	const bool walkable = isFloor(voxel.getMaterial());
+	// fetch the chunk before locking - the volume might call the listener while we are holding the lock
+	const PagedVolume::ChunkPtr& chunk = walkable ? PagedVolume::ChunkPtr() : _volume->chunk(pos);
+	core::ScopedWriteLock lock(_lock);
+	auto i = _chunks.find(chunkPos);
+	if (i == _chunks.end()) {
+		// not indexed yet - the heightmap is built once the chunk is paged in
+		return;
+	}
+	int16_t& height = i->second[index];
+	if (walkable) {
+		if (local.y > height) {
+			height = local.y;
+		}
+	} else if (local.y == height) {
+		// the topmost voxel was removed - search the next one below
+		height = scanColumn(chunk, local.x, local.z, local.y - 1);
+	}
+}
+
+bool SurfaceHeightmap::floor(int x, int z, int& y) const {
+	const int chunkX = (int)glm::floor(x / (float)_sideLength);
+	const int chunkZ = (int)glm::floor(z / (float)_sideLength);
+	const int index = (x - chunkX * _sideLength) + (z - chunkZ * _sideLength) * _sideLength;
+	core::ScopedReadLock lock(_lock);
+	for (int chunkY = maxChunkY(); chunkY >= 0; --chunkY) {
+		auto i = _chunks.find(glm::ivec3(chunkX, chunkY, chunkZ));
+		if (i == _chunks.end()) {
+			return false;
+		}
+		const int height = i->second[index];
+		if (height >= 0) {
+			y = chunkY * _sideLength + height;
+			return true;
+		}
+	}
+	y = NO_FLOOR_FOUND;
+	return true;
+}
+
+}
@@ -0,0 +1,57 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "voxel/polyvox/PagedVolume.h"
+#include "core/ReadWriteLock.h"
+#include "core/GLM.h"
+#include <unordered_map>
+#include <vector>
+
+namespace voxel {
+
+/**
+ * @brief Index of the topmost walkable (see @c isFloor()) voxel of every column of the paged in chunks
+ *
+ * The heightmap of a chunk is built as soon as the pager filled it and is dropped once the
+ * chunk is removed from the volume. Modifications must be reported via @c update() to keep the
+ * index in sync with the volume.
+ *
+ * @note Only the chunks between @c 0 and @c MAX_HEIGHT are indexed.
+ * @note Chunks that were paged in before @c init() was called are not indexed.
+ */
+class SurfaceHeightmap : public PagedVolume::IChunkListener {
+private:
+	PagedVolume* _volume = nullptr;
+	int _sideLength = 0;
+	// the chunk relative height of the topmost floor voxel per column (x + z * side) - -1 if there is none
+	typedef std::vector<int16_t> Columns;
+	std::unordered_map<glm::ivec3, Columns, std::hash<glm::ivec3> > _chunks;
+	core::ReadWriteLock _lock {"heightmap", true};
+
+	int scanColumn(const PagedVolume::ChunkPtr& chunk, int x, int z, int startY) const;
+	int maxChunkY() const;
+public:
+	~SurfaceHeightmap();
+
+	void init(PagedVolume* volume);
+	void shutdown();
+
+	void onCreate(const PagedVolume::ChunkPtr& chunk) override;
+	void onRemove(const PagedVolume::ChunkPtr& chunk) override;
+
+	/**
+	 * @brief Must be called after the given voxel was put into the volume
+	 */
+	void update(const glm::ivec3& pos, const Voxel& voxel);
+
+	/**
+	 * @param[out] y The height of the topmost floor voxel or @c NO_FLOOR_FOUND
+	 * @return @c false if not all chunks of the column are paged in - @c y is not valid then
+	 */
+	bool floor(int x, int z, int& y) const;
+};
+
+}
@@ -42,10 +42,18 @@ glm::ivec3 World::randomPos() const {
 	}
 	const int x = _random.random(lowestX, highestX);
 	const int z = _random.random(lowestZ, highestZ);
-	const int y = findFloor(x, z, isFloor);
+	const int y = findFloor(x, z);
 	return glm::ivec3(x, y, z);
 }
 
+int World::findFloor(int x, int z) const {
+	int y;
+	if (_heightmap.floor(x, z, y)) {
+		return y;
+	}
+	return findFloor(x, z, isFloor);
+}
+
 // Extract the surface for the specified region of the volume.
 // The surface extractor outputs the mesh in an efficient compressed format which
 // is not directly suitable for rendering.
@@ -79,10 +87,24 @@ PickResult World::pickVoxel(const glm::vec3& origin, const glm::vec3& directionW
 
 void World::setVoxel(const glm::ivec3& pos, const voxel::Voxel& voxel) {
 	_volumeData->setVoxel(pos, voxel);
+	_heightmap.update(pos, voxel);
 	allowReExtraction(pos);
 	scheduleMeshExtraction(pos);
 }
 
+void World::setVoxels(const glm::ivec3* positions, const voxel::Voxel* voxels, int amount) {
+	PositionSet meshes;
+	for (int i = 0; i < amount; ++i) {
+		_volumeData->setVoxel(positions[i], voxels[i]);
+		_heightmap.update(positions[i], voxels[i]);
+		meshes.insert(meshPos(positions[i]));
+	}
+	for (const glm::ivec3& pos : meshes) {
+		allowReExtraction(pos);
+		scheduleMeshExtraction(pos);
+	}
+}
+
 void World::updateExtractionOrder(const glm::ivec3& sortPos, const math::Frustum& frustum) {
 	// TODO: sort closest to camera and in frustum first
 }
@@ -119,6 +141,7 @@ bool World::init(const std::string& luaParameters, const std::string& luaBiomes,
 	}
 	_meshSize = core::Var::getSafe(cfg::VoxelMeshSize);
 	_volumeData = new PagedVolume(&_pager, volumeMemoryMegaBytes * 1024 * 1024, chunkSideLength);
+	_heightmap.init(_volumeData);
 
 	_pager.init(_volumeData, &_biomeManager, &_ctx);
 	if (_clientData) {
@@ -127,7 +150,7 @@ bool World::init(const std::string& luaParameters, const std::string& luaBiomes,
 		_pager.setCreateFlags(voxel::world::WORLDGEN_SERVER);
 	}
 
-	_threadPool.enqueue([this] () {extractScheduledMesh();});
+	_threadPool.schedule([this] () {extractScheduledMesh();});
 
 	return true;
 }
@@ -171,6 +194,7 @@ void World::shutdown() {
 	_extracted.clear();
 	_pager.shutdown();
 	_biomeManager.shutdown();
+	_heightmap.shutdown();
 	delete _volumeData;
 	_volumeData = nullptr;
 	_ctx = WorldContext();
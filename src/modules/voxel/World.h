@@ -22,6 +22,7 @@
 
 #include "WorldPager.h"
 #include "WorldContext.h"
+#include "SurfaceHeightmap.h"
 #include "io/Filesystem.h"
 #include "BiomeManager.h"
 #include "collection/ConcurrentQueue.h"
@@ -76,6 +77,10 @@ public:
 
 	bool findPath(const glm::ivec3& start, const glm::ivec3& end, std::list<glm::ivec3>& listResult);
 
+	/**
+	 * @brief Finds the topmost voxel of the column that matches the given checker by casting a ray down from @c MAX_HEIGHT
+	 * @sa findFloor(int, int)
+	 */
 	template<typename VoxelTypeChecker>
 	int findFloor(int x, int z, VoxelTypeChecker&& check) const {
 		const glm::vec3 start = glm::vec3(x, MAX_HEIGHT, z);
@@ -92,6 +97,14 @@ public:
 		return y;
 	}
 
+	/**
+	 * @brief Finds the topmost walkable voxel (see @c isFloor()) of the column
+	 * @note This is a lookup in the surface heightmap - only if the column isn't paged in completely, this
+	 * falls back to a raycast.
+	 * @return The y position of the voxel or @c NO_FLOOR_FOUND
+	 */
+	int findFloor(int x, int z) const;
+
 	/**
 	 * @return true if the ray hit something - false if not.
 	 * @note The callback has a parameter of @c const PagedVolume::Sampler& and returns a boolean. If the callback returns false,
@@ -123,6 +136,11 @@ public:
 
 	void setVoxel(const glm::ivec3& pos, const voxel::Voxel& voxel);
 
+	/**
+	 * @brief Sets several voxels at once. Every affected mesh tile is only scheduled once for re-extraction.
+	 */
+	void setVoxels(const glm::ivec3* positions, const voxel::Voxel* voxels, int amount);
+
 	PickResult pickVoxel(const glm::vec3& origin, const glm::vec3& directionWithLength);
 
 	/**
@@ -188,6 +206,7 @@ private:
 
 	WorldPager _pager;
 	PagedVolume *_volumeData = nullptr;
+	SurfaceHeightmap _heightmap;
 	BiomeManager _biomeManager;
 	WorldContext _ctx;
 	mutable std::mt19937 _engine;
@@ -5,7 +5,8 @@
 #include "voxel/BiomeManager.h"
 #include "voxel/WorldContext.h"
 #include "voxel/generator/WorldGenerator.h"
-#include "voxel/polyvox/PagedVolumeWrapper.h"
+#include "voxel/polyvox/ChunkBuffer.h"
+#include <algorithm>
 
 namespace voxel {
 
@@ -18,15 +19,25 @@ bool WorldPager::pageIn(PagedVolume::PagerContext& pctx) {
 	if (pctx.region.getLowerY() < 0) {
 		return false;
 	}
-	if (_worldPersister.load(pctx.chunk.get(), _seed)) {
-		return false;
+	bool modified = false;
+	if (!_worldPersister.load(pctx.chunk.get(), _seed)) {
+		create(pctx);
+		modified = true;
+	}
+	// the chunk is complete now - apply what the neighbours generated into it
+	std::vector<VoxelEdit> edits;
+	_pendingEdits.pageIn(pctx.region, edits);
+	const glm::ivec3& mins = pctx.region.getLowerCorner();
+	for (const VoxelEdit& edit : edits) {
+		const glm::ivec3 pos = edit.pos - mins;
+		pctx.chunk->setVoxel(pos.x, pos.y, pos.z, edit.voxel);
 	}
-	create(pctx);
-	return true;
+	return modified || !edits.empty();
 }
 
 void WorldPager::pageOut(PagedVolume::Chunk* chunk) {
 	core_assert(chunk != nullptr);
+	_pendingEdits.pageOut(chunk->region());
 	_worldPersister.save(chunk, _seed);
 }
 
@@ -42,14 +53,25 @@ void WorldPager::setCreateFlags(int flags) {
 	_createFlags = flags;
 }
 
+void WorldPager::setTreePrefabs(bool treePrefabs) {
+	_treePrefabs = treePrefabs;
+}
+
 void WorldPager::setNoiseOffset(const glm::vec2& noiseOffset) {
 	_noiseSeedOffset = noiseOffset;
 }
 
+size_t WorldPager::pendingEdits() const {
+	return _pendingEdits.size();
+}
+
 bool WorldPager::init(PagedVolume *volumeData, BiomeManager* biomeManager, WorldContext* ctx) {
 	_volumeData = volumeData;
 	_biomeManager = biomeManager;
 	_ctx = ctx;
+	if (_volumeData != nullptr) {
+		_pendingEdits.init(_volumeData->chunkSideLength());
+	}
 	return _ctx != nullptr && _volumeData != nullptr && _biomeManager != nullptr;
 }
 
@@ -57,31 +79,47 @@ void WorldPager::shutdown() {
 	if (_volumeData != nullptr) {
 		_volumeData->flushAll();
 	}
+	_pendingEdits.clear();
 	_volumeData = nullptr;
 	_biomeManager = nullptr;
 	_ctx = nullptr;
 }
 
 void WorldPager::create(PagedVolume::PagerContext& ctx) {
-	PagedVolumeWrapper wrapper(_volumeData, ctx.chunk, ctx.region);
 	core_trace_scoped(CreateWorld);
+	// reused for every chunk that is created by this thread
+	static thread_local ChunkBuffer buffer;
+	buffer.init(ctx.region);
 	voxel::world::WorldGenerator gen(*_biomeManager, _seed);
 	{
 		core_trace_scoped(World);
-		gen.createWorld(*_ctx, wrapper, _noiseSeedOffset.x, _noiseSeedOffset.y);
+		gen.createWorld(*_ctx, buffer, _noiseSeedOffset.x, _noiseSeedOffset.y);
 	}
 	if ((_createFlags & voxel::world::WORLDGEN_CLOUDS) != 0) {
 		core_trace_scoped(Clouds);
 		voxel::cloud::CloudContext ctx;
-		gen.createClouds(wrapper, ctx);
+		gen.createClouds(buffer, ctx);
 	}
 	if ((_createFlags & voxel::world::WORLDGEN_TREES) != 0) {
 		core_trace_scoped(Trees);
-		gen.createTrees(wrapper);
+		gen.createTrees(buffer, _treePrefabs ? &_treePrefabCache : nullptr);
 	}
 	{
 		core_trace_scoped(Buildings);
-		gen.createBuildings(wrapper);
+		gen.createBuildings(buffer);
+	}
+	buffer.commit(*ctx.chunk);
+
+	// the buffer is reused if writing into an already paged in neighbour pages in another chunk
+	std::vector<VoxelEdit> outside;
+	outside.swap(buffer.outside());
+	outside.erase(std::remove_if(outside.begin(), outside.end(), [] (const VoxelEdit& edit) {
+		return edit.pos.y < 0;
+	}), outside.end());
+	std::vector<VoxelEdit> pagedIn;
+	_pendingEdits.add(outside, pagedIn);
+	for (const VoxelEdit& edit : pagedIn) {
+		_volumeData->setVoxel(edit.pos, edit.voxel);
 	}
 }
 
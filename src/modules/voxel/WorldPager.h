@@ -5,6 +5,8 @@
 
 #include "voxel/polyvox/PagedVolume.h"
 #include "voxel/WorldPersister.h"
+#include "voxel/generator/TreePrefab.h"
+#include "voxel/PendingEdits.h"
 
 namespace voxel {
 
@@ -14,12 +16,20 @@ class PagedVolumeWrapper;
 
 /**
  * @brief Pager implementation for PagedVolume.
+ *
+ * New chunks are generated in a thread local @c ChunkBuffer and committed to the chunk in one step. Generator writes
+ * that cross into a neighbouring chunk are kept in the @c PendingEdits until the neighbour is paged in.
+ *
+ * @note Pending edits for chunks that were never paged in are not persisted.
  */
 class WorldPager: public PagedVolume::Pager {
 private:
 	WorldPersister _worldPersister;
 	long _seed = 0l;
 	int _createFlags = 0;
+	bool _treePrefabs = true;
+	tree::TreePrefabCache _treePrefabCache;
+	PendingEdits _pendingEdits;
 	glm::vec2 _noiseSeedOffset;
 
 	PagedVolume *_volumeData = nullptr;
@@ -61,8 +71,19 @@ public:
 	 */
 	void setCreateFlags(int flags);
 
+	/**
+	 * @brief Stamp the trees from cached prefabs instead of generating every single tree
+	 * @note Default is @c true
+	 */
+	void setTreePrefabs(bool treePrefabs);
+
 	void setNoiseOffset(const glm::vec2& noiseOffset);
 
+	/**
+	 * @return The amount of voxel writes that are waiting for their chunk to get paged in
+	 */
+	size_t pendingEdits() const;
+
 	void erase(const Region& region);
 	/**
 	 * @return @c true if the chunk was modified (created), @c false if it was just loaded
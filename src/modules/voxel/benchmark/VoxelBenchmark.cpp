@@ -1,11 +1,22 @@
 #include "core/benchmark/AbstractBenchmark.h"
 #include "voxel/WorldPager.h"
+#include "voxel/generator/WorldGenerator.h"
 #include "voxel/polyvox/PagedVolume.h"
 #include "voxel/polyvox/CubicSurfaceExtractor.h"
 #include "voxel/WorldContext.h"
 #include "voxel/BiomeManager.h"
 #include "voxel/Constants.h"
 #include "voxel/IsQuadNeeded.h"
+#include "voxel/LodPyramid.h"
+#include "voxel/polyvox/RawVolume.h"
+#include "voxel/polyvox/RawVolumeWrapper.h"
+#include "voxel/polyvox/VolumeMerger.h"
+#include "voxel/polyvox/VolumeRotator.h"
+#include "voxel/polyvox/VolumeRescaler.h"
+#include "voxel/World.h"
+#include "core/GameConfig.h"
+#include "core/LockProfiler.h"
+#include "math/Random.h"
 
 class PagedVolumeBenchmark: public core::AbstractBenchmark {
 protected:
@@ -53,4 +64,362 @@ BENCHMARK_DEFINE_F(PagedVolumeBenchmark, pageIn) (benchmark::State& state) {
 
 BENCHMARK_REGISTER_F(PagedVolumeBenchmark, pageIn)->RangeMultiplier(2)->Range(8, 256);
 
+/**
+ * @brief Lets the pager fill chunks of the bottom layer of the world - one after another along the x axis
+ */
+BENCHMARK_DEFINE_F(PagedVolumeBenchmark, chunkFill) (benchmark::State& state) {
+	const uint16_t chunkSideLength = state.range(0);
+	voxel::WorldPager pager;
+	pager.setSeed(0l);
+	pager.setPersist(false);
+	pager.setCreateFlags(0);
+	voxel::PagedVolume volumeData(&pager, 64 * 1024 * 1024, chunkSideLength);
+	pager.init(&volumeData, &_biomeManager, &_ctx);
+	int chunkX = 0;
+	while (state.KeepRunning()) {
+		const glm::ivec3 chunkPos(chunkX++, 0, 0);
+		const glm::ivec3 mins = chunkPos * (int)chunkSideLength;
+		voxel::PagedVolume::PagerContext ctx;
+		ctx.region = voxel::Region(mins, mins + glm::ivec3(chunkSideLength - 1));
+		ctx.chunk = std::make_shared<voxel::PagedVolume::Chunk>(chunkPos, chunkSideLength, &pager);
+		pager.pageIn(ctx);
+	}
+	state.SetItemsProcessed(state.iterations() * chunkSideLength * chunkSideLength * chunkSideLength);
+}
+
+BENCHMARK_REGISTER_F(PagedVolumeBenchmark, chunkFill)->RangeMultiplier(2)->Range(64, 256);
+
+/**
+ * @brief Lets the pager fill chunks with trees - the first argument toggles the tree prefab cache
+ */
+BENCHMARK_DEFINE_F(PagedVolumeBenchmark, chunkFillTrees) (benchmark::State& state) {
+	const uint16_t chunkSideLength = state.range(0);
+	voxel::WorldPager pager;
+	pager.setSeed(0l);
+	pager.setPersist(false);
+	pager.setCreateFlags(voxel::world::WORLDGEN_TREES);
+	pager.setTreePrefabs(state.range(1) != 0);
+	voxel::PagedVolume volumeData(&pager, 256 * 1024 * 1024, chunkSideLength);
+	pager.init(&volumeData, &_biomeManager, &_ctx);
+	int chunkX = 0;
+	while (state.KeepRunning()) {
+		const glm::ivec3 chunkPos(chunkX++, 0, 0);
+		const glm::ivec3 mins = chunkPos * (int)chunkSideLength;
+		voxel::PagedVolume::PagerContext ctx;
+		ctx.region = voxel::Region(mins, mins + glm::ivec3(chunkSideLength - 1));
+		ctx.chunk = std::make_shared<voxel::PagedVolume::Chunk>(chunkPos, chunkSideLength, &pager);
+		pager.pageIn(ctx);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(PagedVolumeBenchmark, chunkFillTrees)->Args({128, 0})->Args({128, 1})->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Generates chunks with trees and clouds along the x axis and counts the lock acquisitions per chunk
+ */
+BENCHMARK_DEFINE_F(PagedVolumeBenchmark, chunkGeneration) (benchmark::State& state) {
+	const uint16_t chunkSideLength = state.range(0);
+	voxel::WorldPager pager;
+	pager.setSeed(0l);
+	pager.setPersist(false);
+	pager.setCreateFlags(voxel::world::WORLDGEN_CLIENT);
+	voxel::PagedVolume volumeData(&pager, 256 * 1024 * 1024, chunkSideLength);
+	pager.init(&volumeData, &_biomeManager, &_ctx);
+	core::LockStats* chunkLocks = core::LockProfiler::stats("chunk");
+	core::LockStats* volumeLocks = core::LockProfiler::stats("pagedvolume");
+	core::LockProfiler::reset();
+	core::LockProfiler::setEnabled(true);
+	int chunkX = 0;
+	while (state.KeepRunning()) {
+		const glm::ivec3 chunkPos(chunkX++, 0, 0);
+		const glm::ivec3 mins = chunkPos * (int)chunkSideLength;
+		voxel::PagedVolume::PagerContext ctx;
+		ctx.region = voxel::Region(mins, mins + glm::ivec3(chunkSideLength - 1));
+		ctx.chunk = std::make_shared<voxel::PagedVolume::Chunk>(chunkPos, chunkSideLength, &pager);
+		pager.pageIn(ctx);
+	}
+	core::LockProfiler::setEnabled(false);
+	const double chunks = (double)state.iterations();
+	state.counters["chunkLocks/chunk"] = (double)(chunkLocks->readAcquisitions + chunkLocks->writeAcquisitions) / chunks;
+	state.counters["volumeLocks/chunk"] = (double)(volumeLocks->readAcquisitions + volumeLocks->writeAcquisitions) / chunks;
+	state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(PagedVolumeBenchmark, chunkGeneration)->Arg(64)->Arg(128)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Places every tree type on a grid - the argument toggles between generating and stamping the trees from
+ * the prefab cache
+ */
+BENCHMARK_DEFINE_F(PagedVolumeBenchmark, trees) (benchmark::State& state) {
+	const bool prefabs = state.range(0) != 0;
+	const voxel::Region region(0, 0, 0, 127, 127, 127);
+	voxel::RawVolume volume(region);
+	const voxel::Voxel& grass = voxel::createColorVoxel(voxel::VoxelType::Grass, 0);
+	const int floor = voxel::MAX_WATER_HEIGHT + 1;
+	for (int z = region.getLowerZ(); z <= region.getUpperZ(); ++z) {
+		for (int x = region.getLowerX(); x <= region.getUpperX(); ++x) {
+			volume.setVoxel(x, floor, z, grass);
+		}
+	}
+	voxel::RawVolumeWrapper wrapper(&volume);
+	const voxel::tree::TreePrefabCache cache;
+	if (prefabs) {
+		cache.createAll();
+	}
+	math::Random random(0);
+	int64_t trees = 0;
+	while (state.KeepRunning()) {
+		for (int i = 0; i < (int)voxel::TreeType::Max; ++i) {
+			voxel::TreeContext ctx;
+			ctx.type = (voxel::TreeType)i;
+			ctx.pos = glm::ivec3(32 + (i % 4) * 20, floor + 1, 32 + (i / 4) * 20);
+			const int size = random.random(voxel::tree::TreePrefabCache::MinSize, voxel::tree::TreePrefabCache::MaxSize);
+			if (prefabs) {
+				const int variant = random.random(0, voxel::tree::TreePrefabCache::Variants - 1);
+				cache.prefab(ctx.type, size, variant).stamp(wrapper, ctx.pos);
+			} else {
+				voxel::tree::fillTreeContext(ctx, size, voxel::tree::TreePrefabCache::MaxSize, random);
+				voxel::tree::createTree(wrapper, ctx, random);
+			}
+			++trees;
+		}
+	}
+	state.SetItemsProcessed(trees);
+}
+
+BENCHMARK_REGISTER_F(PagedVolumeBenchmark, trees)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Looks up the biome of every voxel of a chunk in the same order as the world generator
+ */
+BENCHMARK_DEFINE_F(PagedVolumeBenchmark, biomeLookup) (benchmark::State& state) {
+	const int chunkSideLength = state.range(0);
+	int lowerX = 0;
+	while (state.KeepRunning()) {
+		for (int z = 0; z < chunkSideLength; ++z) {
+			for (int x = lowerX; x < lowerX + chunkSideLength; ++x) {
+				for (int y = chunkSideLength - 1; y >= 0; --y) {
+					benchmark::DoNotOptimize(_biomeManager.getVoxel(x, y, z, y < chunkSideLength - 1));
+				}
+			}
+		}
+		lowerX += chunkSideLength;
+	}
+	state.SetItemsProcessed(state.iterations() * chunkSideLength * chunkSideLength * chunkSideLength);
+}
+
+BENCHMARK_REGISTER_F(PagedVolumeBenchmark, biomeLookup)->RangeMultiplier(2)->Range(64, 128);
+
+class LodPyramidBenchmark: public PagedVolumeBenchmark {
+protected:
+	const voxel::Region _region { glm::ivec3(0), glm::ivec3(127) };
+	const int _brickSize = 16;
+
+	void copyLevels(voxel::LodPyramid& pyramid, int maxLevel) {
+		for (int level = 1; level <= maxLevel; ++level) {
+			const voxel::Region& region = pyramid.levelRegion(_region, level);
+			voxel::RawVolume volume(region);
+			pyramid.copy(level, region, volume);
+		}
+	}
+};
+
+BENCHMARK_DEFINE_F(LodPyramidBenchmark, build) (benchmark::State& state) {
+	const int maxLevel = state.range(0);
+	voxel::WorldPager pager;
+	pager.setSeed(0l);
+	pager.setPersist(false);
+	voxel::PagedVolume volumeData(&pager, 256 * 1024 * 1024, 64);
+	pager.init(&volumeData, &_biomeManager, &_ctx);
+	while (state.KeepRunning()) {
+		voxel::LodPyramid pyramid(&volumeData, _region.getLowerCorner(), _brickSize);
+		copyLevels(pyramid, maxLevel);
+	}
+}
+
+BENCHMARK_DEFINE_F(LodPyramidBenchmark, rebuildAfterModification) (benchmark::State& state) {
+	const int maxLevel = state.range(0);
+	voxel::WorldPager pager;
+	pager.setSeed(0l);
+	pager.setPersist(false);
+	voxel::PagedVolume volumeData(&pager, 256 * 1024 * 1024, 64);
+	pager.init(&volumeData, &_biomeManager, &_ctx);
+	voxel::LodPyramid pyramid(&volumeData, _region.getLowerCorner(), _brickSize);
+	copyLevels(pyramid, maxLevel);
+	int x = 0;
+	while (state.KeepRunning()) {
+		// only the bricks that contain the modified voxel are built again
+		pyramid.markAsModified(glm::ivec3(x, 64, 64));
+		x = (x + 1) % _region.getWidthInVoxels();
+		copyLevels(pyramid, maxLevel);
+	}
+}
+
+BENCHMARK_REGISTER_F(LodPyramidBenchmark, build)->DenseRange(1, 3);
+BENCHMARK_REGISTER_F(LodPyramidBenchmark, rebuildAfterModification)->DenseRange(1, 3);
+
+/**
+ * @brief Region operations on a 128x128x128 volume. The argument selects between the per voxel
+ * version (@c 0) and the bulk version (@c 1) of the operation.
+ */
+class RawVolumeBenchmark: public core::AbstractBenchmark {
+protected:
+	const voxel::Region _region { glm::ivec3(0), glm::ivec3(127) };
+	const voxel::Voxel _voxels[2] { voxel::createVoxel(voxel::VoxelType::Grass, 1), voxel::createVoxel(voxel::VoxelType::Rock, 2) };
+
+	inline int64_t voxels() const {
+		return (int64_t)_region.getWidthInVoxels() * _region.getHeightInVoxels() * _region.getDepthInVoxels();
+	}
+
+	void fillHalf(voxel::RawVolume& volume) const {
+		const voxel::Region lower(_region.getLowerCorner(), glm::ivec3(_region.getUpperX(), _region.getCentreY(), _region.getUpperZ()));
+		volume.fill(lower, _voxels[0]);
+	}
+
+public:
+	bool onInitApp() override {
+		voxel::initDefaultMaterialColors();
+		return true;
+	}
+};
+
+BENCHMARK_DEFINE_F(RawVolumeBenchmark, fill) (benchmark::State& state) {
+	const bool bulk = state.range(0) != 0;
+	voxel::RawVolume volume(_region);
+	int i = 0;
+	while (state.KeepRunning()) {
+		const voxel::Voxel& voxel = _voxels[i++ & 1];
+		if (bulk) {
+			volume.fill(_region, voxel);
+			continue;
+		}
+		for (int32_t z = _region.getLowerZ(); z <= _region.getUpperZ(); ++z) {
+			for (int32_t y = _region.getLowerY(); y <= _region.getUpperY(); ++y) {
+				for (int32_t x = _region.getLowerX(); x <= _region.getUpperX(); ++x) {
+					volume.setVoxel(x, y, z, voxel);
+				}
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * voxels());
+}
+
+BENCHMARK_DEFINE_F(RawVolumeBenchmark, merge) (benchmark::State& state) {
+	const bool bulk = state.range(0) != 0;
+	voxel::RawVolume source(_region);
+	fillHalf(source);
+	while (state.KeepRunning()) {
+		voxel::RawVolume destination(_region);
+		if (bulk) {
+			voxel::mergeVolumes(&destination, &source, _region, _region);
+		} else {
+			voxel::RawVolumeWrapper wrapper(&destination);
+			voxel::mergeVolumes(&wrapper, &source, _region, _region);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * voxels());
+}
+
+BENCHMARK_DEFINE_F(RawVolumeBenchmark, rotate) (benchmark::State& state) {
+	const int degree = state.range(0);
+	voxel::RawVolume source(_region);
+	fillHalf(source);
+	while (state.KeepRunning()) {
+		delete voxel::rotateVolume(&source, glm::vec3(0.0f, degree, 0.0f), voxel::Voxel());
+	}
+	state.SetItemsProcessed(state.iterations() * voxels());
+}
+
+BENCHMARK_DEFINE_F(RawVolumeBenchmark, rescale) (benchmark::State& state) {
+	voxel::RawVolume source(_region);
+	fillHalf(source);
+	const voxel::Region destRegion(_region.getLowerCorner(), _region.getUpperCorner() / 2);
+	while (state.KeepRunning()) {
+		voxel::RawVolume destination(destRegion);
+		voxel::rescaleVolume(source, _region, destination, destRegion);
+	}
+	state.SetItemsProcessed(state.iterations() * voxels());
+}
+
+BENCHMARK_REGISTER_F(RawVolumeBenchmark, fill)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(RawVolumeBenchmark, merge)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(RawVolumeBenchmark, rotate)->Arg(45)->Arg(90)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(RawVolumeBenchmark, rescale)->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Lets 10k entities walk over the generated terrain and places them on the floor in every step
+ */
+class WorldFloorBenchmark: public core::AbstractBenchmark {
+protected:
+	static constexpr int Entities = 10000;
+	static constexpr int Area = 256;
+	std::unique_ptr<voxel::World> _world;
+	std::vector<glm::ivec2> _entities;
+	std::vector<glm::ivec2> _directions;
+
+	void move() {
+		for (int i = 0; i < Entities; ++i) {
+			glm::ivec2& pos = _entities[i];
+			pos = (pos + _directions[i] + Area) % Area;
+		}
+	}
+
+public:
+	void onCleanupApp() override {
+		_world->shutdown();
+		_world.reset();
+	}
+
+	bool onInitApp() override {
+		voxel::initDefaultMaterialColors();
+		core::Var::get(cfg::VoxelMeshSize, "16", core::CV_READONLY);
+		const io::FilesystemPtr& filesystem = core::App::getInstance()->filesystem();
+		_world = std::unique_ptr<voxel::World>(new voxel::World());
+		_world->setSeed(1l);
+		_world->setPersist(false);
+		if (!_world->init(filesystem->load("worldparams.lua"), filesystem->load("biomes.lua"), 512, 64)) {
+			return false;
+		}
+		math::Random random(1);
+		_entities.resize(Entities);
+		_directions.resize(Entities);
+		for (int i = 0; i < Entities; ++i) {
+			_entities[i] = glm::ivec2(random.random(0, Area - 1), random.random(0, Area - 1));
+			_directions[i] = glm::ivec2(random.random(-1, 1), random.random(-1, 1));
+		}
+		// page in the whole area
+		for (int x = 0; x < Area; x += 16) {
+			for (int z = 0; z < Area; z += 16) {
+				_world->findFloor(x, z, voxel::isFloor);
+			}
+		}
+		return true;
+	}
+};
+
+BENCHMARK_DEFINE_F(WorldFloorBenchmark, raycast) (benchmark::State& state) {
+	while (state.KeepRunning()) {
+		move();
+		for (const glm::ivec2& pos : _entities) {
+			benchmark::DoNotOptimize(_world->findFloor(pos.x, pos.y, voxel::isFloor));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Entities);
+}
+
+BENCHMARK_DEFINE_F(WorldFloorBenchmark, heightmap) (benchmark::State& state) {
+	while (state.KeepRunning()) {
+		move();
+		for (const glm::ivec2& pos : _entities) {
+			benchmark::DoNotOptimize(_world->findFloor(pos.x, pos.y));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Entities);
+}
+
+BENCHMARK_REGISTER_F(WorldFloorBenchmark, raycast);
+BENCHMARK_REGISTER_F(WorldFloorBenchmark, heightmap);
+
 BENCHMARK_MAIN()
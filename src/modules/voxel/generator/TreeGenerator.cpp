@@ -43,5 +43,39 @@ void Tree::generateBranches(Branches& branches, const glm::vec3& direction, floa
 	}
 }
 
+void fillTreeContext(TreeContext& ctx, int size, int maxSize, math::Random& random) {
+	ctx.trunkWidth = 3;
+	ctx.leavesWidth = size;
+	ctx.leavesDepth = size;
+	switch (ctx.type) {
+	case TreeType::Fir:
+		ctx.leavesHeight = random.random(20, 28);
+		ctx.trunkHeight = ctx.leavesHeight * 2;
+		break;
+	case TreeType::SpaceColonization:
+		ctx.leavesHeight = random.random(28, 34);
+		ctx.trunkHeight = ctx.leavesHeight / 2;
+		ctx.leavesWidth = ctx.leavesDepth = maxSize;
+		ctx.trunkWidth = 4;
+		break;
+	case TreeType::Pine:
+	case TreeType::Cone:
+	case TreeType::Dome:
+	case TreeType::DomeHangingLeaves:
+		ctx.leavesHeight = random.random(20, 28);
+		ctx.trunkHeight = ctx.leavesHeight + random.random(5, 9);
+		break;
+	case TreeType::BranchesEllipsis:
+		ctx.leavesHeight = random.random(10, 14);
+		ctx.trunkHeight = ctx.leavesHeight + random.random(6, 10);
+		ctx.trunkWidth = 3;
+		break;
+	default:
+		ctx.leavesHeight = random.random(10, 14);
+		ctx.trunkHeight = ctx.leavesHeight + random.random(5, 9);
+		break;
+	}
+}
+
 }
 }
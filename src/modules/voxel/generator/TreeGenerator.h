@@ -412,6 +412,13 @@ void createTree(Volume& volume, const TreeContext& ctx, math::Random& random) {
 	}
 }
 
+/**
+ * @brief Sets up the trunk and leaves dimensions for the tree type that is already set in the given context
+ * @param[in] size The width and depth of the leaves
+ * @param[in] maxSize The max width and depth of the leaves
+ */
+extern void fillTreeContext(TreeContext& ctx, int size, int maxSize, math::Random& random);
+
 /**
  * @brief Fill a world with trees based on the configured bioms
  */
@@ -433,39 +440,9 @@ void createTrees(Volume& volume, const Region& region, const BiomeManager& biomM
 			continue;
 		}
 		ctx.pos = glm::ivec3(position.x, y, position.y);
-		ctx.trunkWidth = 3;
-		int size = random.random(12, maxSize);
-		ctx.leavesWidth = size;
-		ctx.leavesDepth = size;
+		const int size = random.random(12, maxSize);
 		ctx.type = *random.randomElement(treeTypes.begin(), treeTypes.end());
-		switch (ctx.type) {
-		case TreeType::Fir:
-			ctx.leavesHeight = random.random(20, 28);
-			ctx.trunkHeight = ctx.leavesHeight * 2;
-			break;
-		case TreeType::SpaceColonization:
-			ctx.leavesHeight = random.random(28, 34);
-			ctx.trunkHeight = ctx.leavesHeight / 2;
-			ctx.leavesWidth = ctx.leavesDepth = maxSize;
-			ctx.trunkWidth = 4;
-			break;
-		case TreeType::Pine:
-		case TreeType::Cone:
-		case TreeType::Dome:
-		case TreeType::DomeHangingLeaves:
-			ctx.leavesHeight = random.random(20, 28);
-			ctx.trunkHeight = ctx.leavesHeight + random.random(5, 9);
-			break;
-		case TreeType::BranchesEllipsis:
-			ctx.leavesHeight = random.random(10, 14);
-			ctx.trunkHeight = ctx.leavesHeight + random.random(6, 10);
-			ctx.trunkWidth = 3;
-			break;
-		default:
-			ctx.leavesHeight = random.random(10, 14);
-			ctx.trunkHeight = ctx.leavesHeight + random.random(5, 9);
-			break;
-		}
+		fillTreeContext(ctx, size, maxSize, random);
 		createTree(volume, ctx, random);
 	}
 }
@@ -0,0 +1,108 @@
+/**
+ * @file
+ */
+
+#include "TreePrefab.h"
+#include "voxel/polyvox/RawVolume.h"
+#include "voxel/polyvox/RawVolumeWrapper.h"
+#include "voxel/MaterialColor.h"
+#include "core/Trace.h"
+
+namespace voxel {
+namespace tree {
+
+namespace {
+
+// the horizontal extent of the prefab volume around the trunk
+const int PrefabRadius = 48;
+// the trees are generated on a flat floor - findFloor() only accepts floors above the water level
+const int PrefabFloor = MAX_WATER_HEIGHT + 1;
+
+}
+
+void TreePrefab::create(const TreeContext& ctx, math::Random& random) {
+	core_trace_scoped(TreePrefabCreate);
+	_runs.clear();
+	_voxels.clear();
+
+	const Region region(-PrefabRadius, 0, -PrefabRadius, PrefabRadius, MAX_TERRAIN_HEIGHT + PrefabRadius, PrefabRadius);
+	RawVolume volume(region);
+	volume.setBorderValue(Voxel());
+	const Voxel& dirt = createColorVoxel(VoxelType::Dirt, 0);
+	for (int z = region.getLowerZ(); z <= region.getUpperZ(); ++z) {
+		for (int x = region.getLowerX(); x <= region.getUpperX(); ++x) {
+			volume.setVoxel(x, PrefabFloor, z, dirt);
+		}
+	}
+
+	TreeContext prefabCtx = ctx;
+	prefabCtx.pos = glm::ivec3(0, PrefabFloor + 1, 0);
+	RawVolumeWrapper wrapper(&volume);
+	createTree(wrapper, prefabCtx, random);
+
+	const int baseY = prefabCtx.pos.y;
+	for (int x = region.getLowerX(); x <= region.getUpperX(); ++x) {
+		for (int z = region.getLowerZ(); z <= region.getUpperZ(); ++z) {
+			int start = -1;
+			for (int y = baseY; y <= region.getUpperY() + 1; ++y) {
+				const bool solid = y <= region.getUpperY() && !isAir(volume.voxel(x, y, z).getMaterial());
+				if (solid) {
+					if (start == -1) {
+						start = y;
+					}
+					_voxels.push_back(volume.voxel(x, y, z));
+					continue;
+				}
+				if (start == -1) {
+					continue;
+				}
+				const int length = y - start;
+				const TreePrefabRun run = { (int16_t)x, (int16_t)(start - baseY), (int16_t)z, (uint16_t)length,
+						(uint32_t)(_voxels.size() - length) };
+				_runs.push_back(run);
+				start = -1;
+			}
+		}
+	}
+	_runs.shrink_to_fit();
+	_voxels.shrink_to_fit();
+}
+
+int TreePrefabCache::sizeBucket(int size) {
+	const int clamped = glm::clamp(size, MinSize, MaxSize);
+	const int range = MaxSize - MinSize + 1;
+	return std::min(SizeBuckets - 1, (clamped - MinSize) * SizeBuckets / range);
+}
+
+const TreePrefab& TreePrefabCache::prefab(TreeType type, int size, int variant) const {
+	core_assert(type >= (TreeType)0 && type < TreeType::Max);
+	core_assert(variant >= 0 && variant < Variants);
+	const int bucket = sizeBucket(size);
+	const int index = ((int)type * SizeBuckets + bucket) * Variants + variant;
+	Slot& slot = _slots[index];
+	std::call_once(slot.once, [&] () {
+		math::Random random(index + 1);
+		TreeContext ctx;
+		ctx.type = type;
+		// the representative size of the bucket
+		const int bucketSize = MinSize + (bucket * (MaxSize - MinSize)) / std::max(1, SizeBuckets - 1);
+		fillTreeContext(ctx, bucketSize, MaxSize, random);
+		slot.prefab.create(ctx, random);
+	});
+	return slot.prefab;
+}
+
+void TreePrefabCache::createAll() const {
+	core_trace_scoped(TreePrefabCacheCreateAll);
+	for (int type = 0; type < (int)TreeType::Max; ++type) {
+		for (int bucket = 0; bucket < SizeBuckets; ++bucket) {
+			const int size = MinSize + (bucket * (MaxSize - MinSize)) / std::max(1, SizeBuckets - 1);
+			for (int variant = 0; variant < Variants; ++variant) {
+				prefab((TreeType)type, size, variant);
+			}
+		}
+	}
+}
+
+}
+}
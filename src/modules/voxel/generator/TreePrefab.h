@@ -0,0 +1,178 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "TreeGenerator.h"
+#include "voxel/polyvox/Region.h"
+#include "voxel/polyvox/Voxel.h"
+#include <vector>
+#include <algorithm>
+#include <mutex>
+#include <stdint.h>
+
+namespace voxel {
+namespace tree {
+
+/**
+ * @brief A vertical run of solid voxels relative to the trunk bottom center of a @c TreePrefab
+ */
+struct TreePrefabRun {
+	int16_t x;
+	int16_t y;
+	int16_t z;
+	uint16_t length;
+	/**
+	 * @brief The index of the first voxel of the run in the voxels of the prefab
+	 */
+	uint32_t offset;
+};
+
+/**
+ * @brief A pre-generated tree that is stored as sparse vertical voxel runs
+ *
+ * The runs are sorted by column and ascending height. Stamping a prefab only copies the runs into the target
+ * volume - the tree generators are only executed once when the prefab is created.
+ */
+class TreePrefab {
+private:
+	std::vector<TreePrefabRun> _runs;
+	std::vector<Voxel> _voxels;
+
+	template<class Volume>
+	static void stampRun(Volume& volume, const Region& region, int x, int y, int z, const Voxel* voxels, int length) {
+		if (!region.containsPointInX(x) || !region.containsPointInZ(z)) {
+			volume.setVoxels(x, y, z, voxels, length);
+			return;
+		}
+		// split the run at the chunk boundaries - only the part inside is written into the chunk directly
+		const int end = y + length;
+		const int lower = region.getLowerY();
+		const int upper = region.getUpperY() + 1;
+		const int belowEnd = std::min(end, lower);
+		if (belowEnd > y) {
+			volume.setVoxels(x, y, z, voxels, belowEnd - y);
+		}
+		const int insideStart = std::max(y, lower);
+		const int insideEnd = std::min(end, upper);
+		if (insideEnd > insideStart) {
+			volume.setVoxels(x, insideStart, z, voxels + (insideStart - y), insideEnd - insideStart);
+		}
+		const int aboveStart = std::max(y, upper);
+		if (end > aboveStart) {
+			volume.setVoxels(x, aboveStart, z, voxels + (aboveStart - y), end - aboveStart);
+		}
+	}
+
+public:
+	/**
+	 * @brief Generates the tree for the given context and converts it into voxel runs
+	 * @note The position of the context is ignored
+	 */
+	void create(const TreeContext& ctx, math::Random& random);
+
+	/**
+	 * @brief Copies the runs into the given volume
+	 * @param[in] pos The floor position of the trunk bottom center
+	 * @note The trunk runs are extended down to the floor of their column - like @c createTrunk() does it.
+	 */
+	template<class Volume>
+	void stamp(Volume& volume, const glm::ivec3& pos) const {
+		const Region& region = volume.region();
+		Voxel trunk[MAX_TERRAIN_HEIGHT];
+		for (const TreePrefabRun& run : _runs) {
+			const int x = pos.x + run.x;
+			const int y = pos.y + run.y;
+			const int z = pos.z + run.z;
+			const Voxel* voxels = &_voxels[run.offset];
+			if (run.y == 0 && isWood(voxels->getMaterial())) {
+				const int floor = findFloor(volume, x, z);
+				if (floor != NO_FLOOR_FOUND && floor < y) {
+					const int n = std::min(y - floor, MAX_TERRAIN_HEIGHT);
+					std::fill_n(trunk, n, *voxels);
+					stampRun(volume, region, x, y - n, z, trunk, n);
+				}
+			}
+			stampRun(volume, region, x, y, z, voxels, run.length);
+		}
+	}
+
+	inline const std::vector<TreePrefabRun>& runs() const {
+		return _runs;
+	}
+
+	inline const std::vector<Voxel>& voxels() const {
+		return _voxels;
+	}
+
+	inline bool empty() const {
+		return _runs.empty();
+	}
+};
+
+/**
+ * @brief Bounded set of @c TreePrefab variants per @c TreeType and size bucket
+ *
+ * The prefabs are generated on first use - it's safe to query the cache from several pager threads.
+ */
+class TreePrefabCache {
+public:
+	static constexpr int MinSize = 12;
+	static constexpr int MaxSize = 18;
+	static constexpr int SizeBuckets = 3;
+	static constexpr int Variants = 4;
+
+private:
+	struct Slot {
+		std::once_flag once;
+		TreePrefab prefab;
+	};
+	mutable Slot _slots[(int)TreeType::Max * SizeBuckets * Variants];
+
+public:
+	/**
+	 * @return The bucket index for the given leaves size in the range [MinSize, MaxSize]
+	 */
+	static int sizeBucket(int size);
+
+	/**
+	 * @param[in] size The leaves size in the range [MinSize, MaxSize] - mapped onto a size bucket
+	 * @param[in] variant The variant in the range [0, Variants)
+	 */
+	const TreePrefab& prefab(TreeType type, int size, int variant) const;
+
+	/**
+	 * @brief Generates all prefabs up front instead of on first use
+	 */
+	void createAll() const;
+};
+
+/**
+ * @brief Fill a world with trees based on the configured bioms - the trees are stamped from the given cache
+ * @sa createTrees()
+ */
+template<class Volume>
+void createTrees(Volume& volume, const Region& region, const BiomeManager& biomManager, const TreePrefabCache& cache) {
+	std::vector<TreeType> treeTypes;
+	biomManager.getTreeTypes(region, treeTypes);
+	if (treeTypes.empty()) {
+		return;
+	}
+	math::Random random(region.getCentreX() + region.getCentreY() + region.getCentreZ());
+	std::vector<glm::vec2> positions;
+	biomManager.getTreePositions(region, positions, random, TreePrefabCache::MaxSize);
+	for (const glm::vec2& position : positions) {
+		const int y = findFloor(volume, position.x, position.y);
+		if (y == NO_FLOOR_FOUND) {
+			continue;
+		}
+		const int size = random.random(TreePrefabCache::MinSize, TreePrefabCache::MaxSize);
+		const TreeType type = *random.randomElement(treeTypes.begin(), treeTypes.end());
+		const int variant = random.random(0, TreePrefabCache::Variants - 1);
+		cache.prefab(type, size, variant).stamp(volume, glm::ivec3(position.x, y, position.y));
+	}
+}
+
+}
+}
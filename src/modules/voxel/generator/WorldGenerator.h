@@ -6,6 +6,7 @@
 
 #include "voxel/BiomeManager.h"
 #include "TreeGenerator.h"
+#include "TreePrefab.h"
 #include "CloudGenerator.h"
 #include "BuildingGenerator.h"
 #include "core/Trace.h"
@@ -71,14 +72,13 @@ public:
 		core_assert(region.getLowerY() >= 0);
 		Voxel voxels[MAX_TERRAIN_HEIGHT];
 
-		// TODO: store voxel data in local buffer and transfer in one step into the volume to reduce locking
 		const int size = 2;
 		core_assert(depth % size == 0);
 		core_assert(width % size == 0);
 		for (int z = lowerZ; z < lowerZ + depth; z += size) {
 			for (int x = lowerX; x < lowerX + width; x += size) {
 				const int ni = fillVoxels(x, lowerY, z, worldCtx, voxels, noiseSeedOffsetX, noiseSeedOffsetZ, MAX_TERRAIN_HEIGHT - 1);
-				volume.setVoxels(x, lowerY, z, size, size, voxels, ni);
+				volume.setVoxels(x, lowerY, z, size, size, voxels + lowerY, ni);
 			}
 		}
 	}
@@ -90,10 +90,17 @@ public:
 		return voxel::cloud::createClouds(volume, region, _biomeManager, ctx);
 	}
 
+	/**
+	 * @param[in] cache If not @c null, the trees are stamped from the cached prefabs instead of generating each of them
+	 */
 	template<class Volume>
-	void createTrees(Volume& volume) {
+	void createTrees(Volume& volume, const voxel::tree::TreePrefabCache* cache = nullptr) {
 		core_trace_scoped(Trees);
 		const voxel::Region& region = volume.region();
+		if (cache != nullptr) {
+			voxel::tree::createTrees(volume, region, _biomeManager, *cache);
+			return;
+		}
 		voxel::tree::createTrees(volume, region, _biomeManager);
 	}
 };
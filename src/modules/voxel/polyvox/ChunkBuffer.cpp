@@ -0,0 +1,76 @@
+/**
+ * @file
+ */
+
+#include "ChunkBuffer.h"
+#include "Morton.h"
+#include "core/Common.h"
+#include "core/Trace.h"
+#include <algorithm>
+
+namespace voxel {
+
+void ChunkBuffer::init(const Region& region) {
+	core_assert_msg(region.getWidthInVoxels() == region.getHeightInVoxels() && region.getWidthInVoxels() == region.getDepthInVoxels(),
+			"The region must be a cube");
+	core_assert_msg(region.getWidthInVoxels() <= 256, "The side length can't be greater than 256");
+	_region = region;
+	_mins = region.getLowerCorner();
+	_sideLength = (uint16_t)region.getWidthInVoxels();
+	const size_t size = (size_t)_sideLength * _sideLength * _sideLength;
+	_data.resize(size);
+	std::fill(_data.begin(), _data.end(), Voxel());
+	_outside.clear();
+}
+
+uint32_t ChunkBuffer::index(int x, int y, int z) const {
+	return morton256_x[x - _mins.x] | morton256_y[y - _mins.y] | morton256_z[z - _mins.z];
+}
+
+bool ChunkBuffer::setVoxel(int x, int y, int z, const Voxel& voxel) {
+	if (!_region.containsPoint(x, y, z)) {
+		_outside.push_back(VoxelEdit{glm::ivec3(x, y, z), voxel});
+		return false;
+	}
+	_data[index(x, y, z)] = voxel;
+	return true;
+}
+
+bool ChunkBuffer::setVoxels(int x, int y, int z, int nx, int nz, const Voxel* voxels, int amount) {
+	const bool columnInside = y >= _region.getLowerY() && y + amount - 1 <= _region.getUpperY();
+	bool inside = true;
+	for (int j = 0; j < nx; ++j) {
+		for (int k = 0; k < nz; ++k) {
+			const int fx = x + j;
+			const int fz = z + k;
+			if (!columnInside || !_region.containsPointInX(fx) || !_region.containsPointInZ(fz)) {
+				// at least a part of the column belongs to another chunk
+				for (int i = 0; i < amount; ++i) {
+					inside &= setVoxel(fx, y + i, fz, voxels[i]);
+				}
+				continue;
+			}
+			const uint32_t xz = morton256_x[fx - _mins.x] | morton256_z[fz - _mins.z];
+			for (int i = 0; i < amount; ++i) {
+				_data[xz | morton256_y[y + i - _mins.y]] = voxels[i];
+			}
+		}
+	}
+	return inside;
+}
+
+void ChunkBuffer::apply(const std::vector<VoxelEdit>& edits) {
+	for (const VoxelEdit& edit : edits) {
+		if (!_region.containsPoint(edit.pos)) {
+			continue;
+		}
+		_data[index(edit.pos.x, edit.pos.y, edit.pos.z)] = edit.voxel;
+	}
+}
+
+void ChunkBuffer::commit(PagedVolume::Chunk& chunk) const {
+	core_trace_scoped(ChunkBufferCommit);
+	chunk.setData(_data.data(), (uint32_t)(_data.size() * sizeof(Voxel)));
+}
+
+}
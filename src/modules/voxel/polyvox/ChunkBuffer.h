@@ -0,0 +1,165 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "Voxel.h"
+#include "Region.h"
+#include "PagedVolume.h"
+#include <vector>
+
+namespace voxel {
+
+/**
+ * @brief A voxel write that belongs to another chunk
+ */
+struct VoxelEdit {
+	glm::ivec3 pos;
+	Voxel voxel;
+};
+
+/**
+ * @brief Scratch buffer to generate the voxels of one chunk in without locking the @c PagedVolume
+ *
+ * The voxels are stored in the same order as in @c PagedVolume::Chunk - the finished buffer is committed to the
+ * chunk with one copy. Writes outside of the region are collected as @c VoxelEdit for the neighbouring chunks,
+ * reads outside of the region return the border value (air).
+ */
+class ChunkBuffer {
+public:
+	class Sampler {
+	private:
+		// the samplers of the other volumes are also able to modify the voxels
+		ChunkBuffer* _buffer;
+		glm::ivec3 _pos;
+	public:
+		Sampler(const ChunkBuffer* buffer) :
+				_buffer(const_cast<ChunkBuffer*>(buffer)) {
+		}
+
+		Sampler(const ChunkBuffer& buffer) :
+				_buffer(const_cast<ChunkBuffer*>(&buffer)) {
+		}
+
+		inline const Voxel& voxel() const {
+			return _buffer->voxel(_pos);
+		}
+
+		inline bool setVoxel(const Voxel& voxel) {
+			return _buffer->setVoxel(_pos, voxel);
+		}
+
+		inline bool currentPositionValid() const {
+			return _buffer->region().containsPoint(_pos);
+		}
+
+		inline void setPosition(const glm::ivec3& pos) {
+			_pos = pos;
+		}
+
+		inline void setPosition(int32_t x, int32_t y, int32_t z) {
+			_pos = glm::ivec3(x, y, z);
+		}
+
+		inline glm::ivec3 position() const {
+			return _pos;
+		}
+
+		inline void movePositiveX() {
+			++_pos.x;
+		}
+
+		inline void movePositiveY() {
+			++_pos.y;
+		}
+
+		inline void movePositiveZ() {
+			++_pos.z;
+		}
+
+		inline void moveNegativeX() {
+			--_pos.x;
+		}
+
+		inline void moveNegativeY() {
+			--_pos.y;
+		}
+
+		inline void moveNegativeZ() {
+			--_pos.z;
+		}
+	};
+
+private:
+	Region _region;
+	glm::ivec3 _mins;
+	uint16_t _sideLength = 0u;
+	std::vector<Voxel> _data;
+	std::vector<VoxelEdit> _outside;
+	const Voxel _border;
+
+	uint32_t index(int x, int y, int z) const;
+
+public:
+	/**
+	 * @brief Prepares the buffer for the given chunk region - all voxels are reset to air
+	 * @note The region must be a cube with a power of two side length like the chunks of the @c PagedVolume
+	 */
+	void init(const Region& region);
+
+	inline const Region& region() const {
+		return _region;
+	}
+
+	inline const Voxel& voxel(const glm::ivec3& pos) const {
+		return voxel(pos.x, pos.y, pos.z);
+	}
+
+	inline const Voxel& voxel(int x, int y, int z) const {
+		if (!_region.containsPoint(x, y, z)) {
+			return _border;
+		}
+		return _data[index(x, y, z)];
+	}
+
+	inline bool setVoxel(const glm::ivec3& pos, const Voxel& voxel) {
+		return setVoxel(pos.x, pos.y, pos.z, voxel);
+	}
+
+	/**
+	 * @return @c false if the voxel is outside of the region and was recorded as edit for another chunk
+	 */
+	bool setVoxel(int x, int y, int z, const Voxel& voxel);
+
+	/**
+	 * @brief Sets a column of @c amount voxels starting at @c y
+	 */
+	inline bool setVoxels(int x, int y, int z, const Voxel* voxels, int amount) {
+		return setVoxels(x, y, z, 1, 1, voxels, amount);
+	}
+
+	/**
+	 * @brief Sets the same column of @c amount voxels - starting at @c y - for all @c nx * @c nz columns
+	 */
+	bool setVoxels(int x, int y, int z, int nx, int nz, const Voxel* voxels, int amount);
+
+	/**
+	 * @brief Applies edits that other chunks recorded for this one
+	 */
+	void apply(const std::vector<VoxelEdit>& edits);
+
+	/**
+	 * @brief The writes that went outside of the region since the last @c init()
+	 */
+	inline std::vector<VoxelEdit>& outside() {
+		return _outside;
+	}
+
+	/**
+	 * @brief Copies the buffer into the chunk - the chunk is only locked once
+	 */
+	void commit(PagedVolume::Chunk& chunk) const;
+};
+
+}
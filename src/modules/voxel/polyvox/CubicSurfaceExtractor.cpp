@@ -124,7 +124,7 @@ void meshify(Mesh* result, bool mergeQuads, QuadListVector& vecListQuads) {
 }
 
 IndexType addVertex(bool reuseVertices, uint32_t uX, uint32_t uY, uint32_t uZ, const Voxel& materialIn, Array& existingVertices,
-		Mesh* meshCurrent, const VoxelType face1, const VoxelType face2, const VoxelType corner, const glm::ivec3& offset) {
+		Mesh* meshCurrent, const VoxelType face1, const VoxelType face2, const VoxelType corner, const glm::ivec3& offset, int scale) {
 	const uint8_t ambientOcclusion = vertexAmbientOcclusion(
 		!isAir(face1) && !isWater(face1),
 		!isAir(face2) && !isWater(face2),
@@ -138,7 +138,7 @@ IndexType addVertex(bool reuseVertices, uint32_t uX, uint32_t uY, uint32_t uZ, c
 			// The 0.5f offset is because vertices set between voxels in order to build cubes around them.
 			// see raycastWithEndpoints for this offset, too
 			VoxelVertex vertex;
-			vertex.position = glm::ivec3(uX, uY, uZ) + offset;
+			vertex.position = glm::ivec3(uX, uY, uZ) * scale + offset;
 			vertex.colorIndex = materialIn.getColor();
 			vertex.material = materialIn.getMaterial();
 			vertex.ambientOcclusion = ambientOcclusion;
@@ -103,8 +103,11 @@ typedef std::vector<QuadList> QuadListVector;
  * @section Surface extraction
  */
 
+/**
+ * @param[in] offset The vertex position is @code (uX, uY, uZ) * scale + offset @endcode
+ */
 extern IndexType addVertex(bool reuseVertices, uint32_t uX, uint32_t uY, uint32_t uZ, const Voxel& materialIn, Array& existingVertices,
-		Mesh* meshCurrent, const VoxelType face1, const VoxelType face2, const VoxelType corner, const glm::ivec3& offset);
+		Mesh* meshCurrent, const VoxelType face1, const VoxelType face2, const VoxelType corner, const glm::ivec3& offset, int scale);
 
 /**
  * @note Notice that the ambient occlusion is different for the vertices on the side than it is for the
@@ -309,13 +312,13 @@ void extractCubicMesh(VolumeType* volData, const Region& region, Mesh* result, I
 				// X [A] LEFT
 				if (isQuadNeeded(voxelCurrentMaterial, voxelLeftMaterial, NegativeX)) {
 					const IndexType v_0_1 = addVertex(reuseVertices, regX, regY,     regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelLeftBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, offset);
+							voxelLeftBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, offset, 1);
 					const IndexType v_1_4 = addVertex(reuseVertices, regX, regY,     regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelBelowLeftMaterial, voxelLeftBehindMaterial, voxelBelowLeftBehindMaterial, offset);
+							voxelBelowLeftMaterial, voxelLeftBehindMaterial, voxelBelowLeftBehindMaterial, offset, 1);
 					const IndexType v_2_8 = addVertex(reuseVertices, regX, regY + 1, regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelLeftBehindMaterial, voxelAboveLeftMaterial, voxelAboveLeftBehindMaterial, offset);
+							voxelLeftBehindMaterial, voxelAboveLeftMaterial, voxelAboveLeftBehindMaterial, offset, 1);
 					const IndexType v_3_5 = addVertex(reuseVertices, regX, regY + 1, regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelAboveLeftMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, offset);
+							voxelAboveLeftMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, offset, 1);
 					vecQuads[NegativeX][regX].emplace_back(v_0_1, v_1_4, v_2_8, v_3_5);
 				}
 
@@ -335,13 +338,13 @@ void extractCubicMesh(VolumeType* volData, const Region& region, Mesh* result, I
 					const VoxelType _voxelBelowRightBehind = volumeSampler.peekVoxel1px1ny1pz().getMaterial();
 
 					const IndexType v_0_2 = addVertex(reuseVertices, regX, regY,     regZ,     voxelLeft, previousSliceVertices, result,
-							_voxelBelowRight, _voxelRightBefore, _voxelBelowRightBefore, offset);
+							_voxelBelowRight, _voxelRightBefore, _voxelBelowRightBefore, offset, 1);
 					const IndexType v_1_3 = addVertex(reuseVertices, regX, regY,     regZ + 1, voxelLeft, currentSliceVertices,  result,
-							_voxelBelowRight, _voxelRightBehind, _voxelBelowRightBehind, offset);
+							_voxelBelowRight, _voxelRightBehind, _voxelBelowRightBehind, offset, 1);
 					const IndexType v_2_7 = addVertex(reuseVertices, regX, regY + 1, regZ + 1, voxelLeft, currentSliceVertices,  result,
-							_voxelAboveRight, _voxelRightBehind, _voxelAboveRightBehind, offset);
+							_voxelAboveRight, _voxelRightBehind, _voxelAboveRightBehind, offset, 1);
 					const IndexType v_3_6 = addVertex(reuseVertices, regX, regY + 1, regZ,     voxelLeft, previousSliceVertices, result,
-							_voxelAboveRight, _voxelRightBefore, _voxelAboveRightBefore, offset);
+							_voxelAboveRight, _voxelRightBefore, _voxelAboveRightBefore, offset, 1);
 					vecQuads[PositiveX][regX].emplace_back(v_0_2, v_3_6, v_2_7, v_1_3);
 
 					volumeSampler.movePositiveX();
@@ -359,13 +362,13 @@ void extractCubicMesh(VolumeType* volData, const Region& region, Mesh* result, I
 					const VoxelType voxelBelowBehindMaterial      = voxelBelowBehind.getMaterial();
 					const VoxelType voxelBelowRightBehindMaterial = voxelBelowRightBehind.getMaterial();
 					const IndexType v_0_1 = addVertex(reuseVertices, regX,     regY, regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelBelowBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, offset);
+							voxelBelowBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, offset, 1);
 					const IndexType v_1_2 = addVertex(reuseVertices, regX + 1, regY, regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelBelowRightMaterial, voxelBelowBeforeMaterial, voxelBelowRightBeforeMaterial, offset);
+							voxelBelowRightMaterial, voxelBelowBeforeMaterial, voxelBelowRightBeforeMaterial, offset, 1);
 					const IndexType v_2_3 = addVertex(reuseVertices, regX + 1, regY, regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelBelowBehindMaterial, voxelBelowRightMaterial, voxelBelowRightBehindMaterial, offset);
+							voxelBelowBehindMaterial, voxelBelowRightMaterial, voxelBelowRightBehindMaterial, offset, 1);
 					const IndexType v_3_4 = addVertex(reuseVertices, regX,     regY, regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelBelowLeftMaterial, voxelBelowBehindMaterial, voxelBelowLeftBehindMaterial, offset);
+							voxelBelowLeftMaterial, voxelBelowBehindMaterial, voxelBelowLeftBehindMaterial, offset, 1);
 					vecQuads[NegativeY][regY].emplace_back(v_0_1, v_1_2, v_2_3, v_3_4);
 				}
 
@@ -383,13 +386,13 @@ void extractCubicMesh(VolumeType* volData, const Region& region, Mesh* result, I
 					const VoxelType _voxelAboveRightBehind = volumeSampler.peekVoxel1px1py1pz().getMaterial();
 
 					const IndexType v_0_5 = addVertex(reuseVertices, regX,     regY, regZ,     voxelBelow, previousSliceVertices, result,
-							_voxelAboveBefore, _voxelAboveLeft, _voxelAboveLeftBefore, offset);
+							_voxelAboveBefore, _voxelAboveLeft, _voxelAboveLeftBefore, offset, 1);
 					const IndexType v_1_6 = addVertex(reuseVertices, regX + 1, regY, regZ,     voxelBelow, previousSliceVertices, result,
-							_voxelAboveRight, _voxelAboveBefore, _voxelAboveRightBefore, offset);
+							_voxelAboveRight, _voxelAboveBefore, _voxelAboveRightBefore, offset, 1);
 					const IndexType v_2_7 = addVertex(reuseVertices, regX + 1, regY, regZ + 1, voxelBelow, currentSliceVertices,  result,
-							_voxelAboveBehind, _voxelAboveRight, _voxelAboveRightBehind, offset);
+							_voxelAboveBehind, _voxelAboveRight, _voxelAboveRightBehind, offset, 1);
 					const IndexType v_3_8 = addVertex(reuseVertices, regX,     regY, regZ + 1, voxelBelow, currentSliceVertices,  result,
-							_voxelAboveLeft, _voxelAboveBehind, _voxelAboveLeftBehind, offset);
+							_voxelAboveLeft, _voxelAboveBehind, _voxelAboveLeftBehind, offset, 1);
 					vecQuads[PositiveY][regY].emplace_back(v_0_5, v_3_8, v_2_7, v_1_6);
 
 					volumeSampler.movePositiveY();
@@ -404,13 +407,13 @@ void extractCubicMesh(VolumeType* volData, const Region& region, Mesh* result, I
 					const VoxelType voxelBelowRightBeforeMaterial = voxelBelowRightBefore.getMaterial();
 
 					const IndexType v_0_1 = addVertex(reuseVertices, regX,     regY,     regZ, voxelCurrent, previousSliceVertices, result,
-							voxelBelowBeforeMaterial, voxelLeftBeforeMaterial, voxelBelowLeftBeforeMaterial, offset); //1
+							voxelBelowBeforeMaterial, voxelLeftBeforeMaterial, voxelBelowLeftBeforeMaterial, offset, 1); //1
 					const IndexType v_1_5 = addVertex(reuseVertices, regX,     regY + 1, regZ, voxelCurrent, previousSliceVertices, result,
-							voxelAboveBeforeMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, offset); //5
+							voxelAboveBeforeMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, offset, 1); //5
 					const IndexType v_2_6 = addVertex(reuseVertices, regX + 1, regY + 1, regZ, voxelCurrent, previousSliceVertices, result,
-							voxelAboveBeforeMaterial, voxelRightBeforeMaterial, voxelAboveRightBeforeMaterial, offset); //6
+							voxelAboveBeforeMaterial, voxelRightBeforeMaterial, voxelAboveRightBeforeMaterial, offset, 1); //6
 					const IndexType v_3_2 = addVertex(reuseVertices, regX + 1, regY,     regZ, voxelCurrent, previousSliceVertices, result,
-							voxelBelowBeforeMaterial, voxelRightBeforeMaterial, voxelBelowRightBeforeMaterial, offset); //2
+							voxelBelowBeforeMaterial, voxelRightBeforeMaterial, voxelBelowRightBeforeMaterial, offset, 1); //2
 					vecQuads[NegativeZ][regZ].emplace_back(v_0_1, v_1_5, v_2_6, v_3_2);
 				}
 
@@ -430,13 +433,13 @@ void extractCubicMesh(VolumeType* volData, const Region& region, Mesh* result, I
 					const VoxelType _voxelBelowRightBehind = volumeSampler.peekVoxel1px1ny1pz().getMaterial();
 
 					const IndexType v_0_4 = addVertex(reuseVertices, regX,     regY,     regZ, voxelBefore, previousSliceVertices, result,
-							_voxelBelowBehind, _voxelLeftBehind, _voxelBelowLeftBehind, offset); //4
+							_voxelBelowBehind, _voxelLeftBehind, _voxelBelowLeftBehind, offset, 1); //4
 					const IndexType v_1_8 = addVertex(reuseVertices, regX,     regY + 1, regZ, voxelBefore, previousSliceVertices, result,
-							_voxelAboveBehind, _voxelLeftBehind, _voxelAboveLeftBehind, offset); //8
+							_voxelAboveBehind, _voxelLeftBehind, _voxelAboveLeftBehind, offset, 1); //8
 					const IndexType v_2_7 = addVertex(reuseVertices, regX + 1, regY + 1, regZ, voxelBefore, previousSliceVertices, result,
-							_voxelAboveBehind, _voxelRightBehind, _voxelAboveRightBehind, offset); //7
+							_voxelAboveBehind, _voxelRightBehind, _voxelAboveRightBehind, offset, 1); //7
 					const IndexType v_3_3 = addVertex(reuseVertices, regX + 1, regY,     regZ, voxelBefore, previousSliceVertices, result,
-							_voxelBelowBehind, _voxelRightBehind, _voxelBelowRightBehind, offset); //3
+							_voxelBelowBehind, _voxelRightBehind, _voxelBelowRightBehind, offset, 1); //3
 					vecQuads[PositiveZ][regZ].emplace_back(v_0_4, v_3_3, v_2_7, v_1_8);
 
 					volumeSampler.movePositiveZ();
@@ -462,16 +465,23 @@ void extractCubicMesh(VolumeType* volData, const Region& region, Mesh* result, I
 	result->removeUnusedVertices();
 }
 
+/**
+ * @param[in] scale Downsampled volumes (see @c LodPyramid) are extracted with a scale > 1 - the vertices
+ * are emitted in world coordinates directly: @code volumePosition * scale + translation @endcode
+ * @param[in] translation The world position of the volume coordinate origin
+ */
 template<typename VolumeType, typename IsQuadNeeded, typename IsQuadNeededWater>
-void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result, Mesh* resultWater, IsQuadNeeded isQuadNeeded, IsQuadNeededWater isQuadNeededWater, int waterSurface, bool mergeQuads = true, bool reuseVertices = true) {
+void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result, Mesh* resultWater, IsQuadNeeded isQuadNeeded, IsQuadNeededWater isQuadNeededWater, int waterSurface, bool mergeQuads = true, bool reuseVertices = true,
+		int scale = 1, const glm::ivec3& translation = glm::ivec3(0)) {
 	core_trace_scoped(ExtractCubicMesh);
 
 	const glm::ivec3& offset = region.getLowerCorner();
 	const glm::ivec3& upper = region.getUpperCorner();
+	const glm::ivec3 vertexOffset = offset * scale + translation;
 	result->clear();
 	resultWater->clear();
-	result->setOffset(offset);
-	resultWater->setOffset(offset);
+	result->setOffset(vertexOffset);
+	resultWater->setOffset(vertexOffset);
 
 	// Used to avoid creating duplicate vertices.
 	const int widthInCells = upper.x - offset.x;
@@ -572,13 +582,13 @@ void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result
 				// X [A] LEFT
 				if (isQuadNeeded(voxelCurrentMaterial, voxelLeftMaterial, NegativeX)) {
 					const IndexType v_0_1 = addVertex(reuseVertices, regX, regY,     regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelLeftBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, offset);
+							voxelLeftBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, vertexOffset, scale);
 					const IndexType v_1_4 = addVertex(reuseVertices, regX, regY,     regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelBelowLeftMaterial, voxelLeftBehindMaterial, voxelBelowLeftBehindMaterial, offset);
+							voxelBelowLeftMaterial, voxelLeftBehindMaterial, voxelBelowLeftBehindMaterial, vertexOffset, scale);
 					const IndexType v_2_8 = addVertex(reuseVertices, regX, regY + 1, regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelLeftBehindMaterial, voxelAboveLeftMaterial, voxelAboveLeftBehindMaterial, offset);
+							voxelLeftBehindMaterial, voxelAboveLeftMaterial, voxelAboveLeftBehindMaterial, vertexOffset, scale);
 					const IndexType v_3_5 = addVertex(reuseVertices, regX, regY + 1, regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelAboveLeftMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, offset);
+							voxelAboveLeftMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, vertexOffset, scale);
 					vecQuads[NegativeX][regX].emplace_back(v_0_1, v_1_4, v_2_8, v_3_5);
 				}
 
@@ -598,13 +608,13 @@ void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result
 					const VoxelType _voxelBelowRightBehind = volumeSampler.peekVoxel1px1ny1pz().getMaterial();
 
 					const IndexType v_0_2 = addVertex(reuseVertices, regX, regY,     regZ,     voxelLeft, previousSliceVertices, result,
-							_voxelBelowRight, _voxelRightBefore, _voxelBelowRightBefore, offset);
+							_voxelBelowRight, _voxelRightBefore, _voxelBelowRightBefore, vertexOffset, scale);
 					const IndexType v_1_3 = addVertex(reuseVertices, regX, regY,     regZ + 1, voxelLeft, currentSliceVertices,  result,
-							_voxelBelowRight, _voxelRightBehind, _voxelBelowRightBehind, offset);
+							_voxelBelowRight, _voxelRightBehind, _voxelBelowRightBehind, vertexOffset, scale);
 					const IndexType v_2_7 = addVertex(reuseVertices, regX, regY + 1, regZ + 1, voxelLeft, currentSliceVertices,  result,
-							_voxelAboveRight, _voxelRightBehind, _voxelAboveRightBehind, offset);
+							_voxelAboveRight, _voxelRightBehind, _voxelAboveRightBehind, vertexOffset, scale);
 					const IndexType v_3_6 = addVertex(reuseVertices, regX, regY + 1, regZ,     voxelLeft, previousSliceVertices, result,
-							_voxelAboveRight, _voxelRightBefore, _voxelAboveRightBefore, offset);
+							_voxelAboveRight, _voxelRightBefore, _voxelAboveRightBefore, vertexOffset, scale);
 					vecQuads[PositiveX][regX].emplace_back(v_0_2, v_3_6, v_2_7, v_1_3);
 
 					volumeSampler.movePositiveX();
@@ -622,13 +632,13 @@ void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result
 					const VoxelType voxelBelowBehindMaterial      = voxelBelowBehind.getMaterial();
 					const VoxelType voxelBelowRightBehindMaterial = voxelBelowRightBehind.getMaterial();
 					const IndexType v_0_1 = addVertex(reuseVertices, regX,     regY, regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelBelowBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, offset);
+							voxelBelowBeforeMaterial, voxelBelowLeftMaterial, voxelBelowLeftBeforeMaterial, vertexOffset, scale);
 					const IndexType v_1_2 = addVertex(reuseVertices, regX + 1, regY, regZ,     voxelCurrent, previousSliceVertices, result,
-							voxelBelowRightMaterial, voxelBelowBeforeMaterial, voxelBelowRightBeforeMaterial, offset);
+							voxelBelowRightMaterial, voxelBelowBeforeMaterial, voxelBelowRightBeforeMaterial, vertexOffset, scale);
 					const IndexType v_2_3 = addVertex(reuseVertices, regX + 1, regY, regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelBelowBehindMaterial, voxelBelowRightMaterial, voxelBelowRightBehindMaterial, offset);
+							voxelBelowBehindMaterial, voxelBelowRightMaterial, voxelBelowRightBehindMaterial, vertexOffset, scale);
 					const IndexType v_3_4 = addVertex(reuseVertices, regX,     regY, regZ + 1, voxelCurrent, currentSliceVertices,  result,
-							voxelBelowLeftMaterial, voxelBelowBehindMaterial, voxelBelowLeftBehindMaterial, offset);
+							voxelBelowLeftMaterial, voxelBelowBehindMaterial, voxelBelowLeftBehindMaterial, vertexOffset, scale);
 					vecQuads[NegativeY][regY].emplace_back(v_0_1, v_1_2, v_2_3, v_3_4);
 				}
 
@@ -646,13 +656,13 @@ void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result
 					const VoxelType _voxelAboveRightBehind = volumeSampler.peekVoxel1px1py1pz().getMaterial();
 
 					const IndexType v_0_5 = addVertex(reuseVertices, regX,     regY, regZ,     voxelBelow, previousSliceVertices, result,
-							_voxelAboveBefore, _voxelAboveLeft, _voxelAboveLeftBefore, offset);
+							_voxelAboveBefore, _voxelAboveLeft, _voxelAboveLeftBefore, vertexOffset, scale);
 					const IndexType v_1_6 = addVertex(reuseVertices, regX + 1, regY, regZ,     voxelBelow, previousSliceVertices, result,
-							_voxelAboveRight, _voxelAboveBefore, _voxelAboveRightBefore, offset);
+							_voxelAboveRight, _voxelAboveBefore, _voxelAboveRightBefore, vertexOffset, scale);
 					const IndexType v_2_7 = addVertex(reuseVertices, regX + 1, regY, regZ + 1, voxelBelow, currentSliceVertices,  result,
-							_voxelAboveBehind, _voxelAboveRight, _voxelAboveRightBehind, offset);
+							_voxelAboveBehind, _voxelAboveRight, _voxelAboveRightBehind, vertexOffset, scale);
 					const IndexType v_3_8 = addVertex(reuseVertices, regX,     regY, regZ + 1, voxelBelow, currentSliceVertices,  result,
-							_voxelAboveLeft, _voxelAboveBehind, _voxelAboveLeftBehind, offset);
+							_voxelAboveLeft, _voxelAboveBehind, _voxelAboveLeftBehind, vertexOffset, scale);
 					vecQuads[PositiveY][regY].emplace_back(v_0_5, v_3_8, v_2_7, v_1_6);
 
 					volumeSampler.movePositiveY();
@@ -669,13 +679,13 @@ void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result
 					const VoxelType _voxelAboveRightBehind = volumeSampler.peekVoxel1px1py1pz().getMaterial();
 
 					const IndexType v_0_5 = addVertex(reuseVertices, regX,     regY, regZ,     voxelBelow, previousSliceVerticesWater, resultWater,
-							_voxelAboveBefore, _voxelAboveLeft, _voxelAboveLeftBefore, offset);
+							_voxelAboveBefore, _voxelAboveLeft, _voxelAboveLeftBefore, vertexOffset, scale);
 					const IndexType v_1_6 = addVertex(reuseVertices, regX + 1, regY, regZ,     voxelBelow, previousSliceVerticesWater, resultWater,
-							_voxelAboveRight, _voxelAboveBefore, _voxelAboveRightBefore, offset);
+							_voxelAboveRight, _voxelAboveBefore, _voxelAboveRightBefore, vertexOffset, scale);
 					const IndexType v_2_7 = addVertex(reuseVertices, regX + 1, regY, regZ + 1, voxelBelow, currentSliceVerticesWater,  resultWater,
-							_voxelAboveBehind, _voxelAboveRight, _voxelAboveRightBehind, offset);
+							_voxelAboveBehind, _voxelAboveRight, _voxelAboveRightBehind, vertexOffset, scale);
 					const IndexType v_3_8 = addVertex(reuseVertices, regX,     regY, regZ + 1, voxelBelow, currentSliceVerticesWater,  resultWater,
-							_voxelAboveLeft, _voxelAboveBehind, _voxelAboveLeftBehind, offset);
+							_voxelAboveLeft, _voxelAboveBehind, _voxelAboveLeftBehind, vertexOffset, scale);
 					vecQuadsWater[regY].emplace_back(v_0_5, v_3_8, v_2_7, v_1_6);
 
 					volumeSampler.movePositiveY();
@@ -690,13 +700,13 @@ void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result
 					const VoxelType voxelBelowRightBeforeMaterial = voxelBelowRightBefore.getMaterial();
 
 					const IndexType v_0_1 = addVertex(reuseVertices, regX,     regY,     regZ, voxelCurrent, previousSliceVertices, result,
-							voxelBelowBeforeMaterial, voxelLeftBeforeMaterial, voxelBelowLeftBeforeMaterial, offset); //1
+							voxelBelowBeforeMaterial, voxelLeftBeforeMaterial, voxelBelowLeftBeforeMaterial, vertexOffset, scale); //1
 					const IndexType v_1_5 = addVertex(reuseVertices, regX,     regY + 1, regZ, voxelCurrent, previousSliceVertices, result,
-							voxelAboveBeforeMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, offset); //5
+							voxelAboveBeforeMaterial, voxelLeftBeforeMaterial, voxelAboveLeftBeforeMaterial, vertexOffset, scale); //5
 					const IndexType v_2_6 = addVertex(reuseVertices, regX + 1, regY + 1, regZ, voxelCurrent, previousSliceVertices, result,
-							voxelAboveBeforeMaterial, voxelRightBeforeMaterial, voxelAboveRightBeforeMaterial, offset); //6
+							voxelAboveBeforeMaterial, voxelRightBeforeMaterial, voxelAboveRightBeforeMaterial, vertexOffset, scale); //6
 					const IndexType v_3_2 = addVertex(reuseVertices, regX + 1, regY,     regZ, voxelCurrent, previousSliceVertices, result,
-							voxelBelowBeforeMaterial, voxelRightBeforeMaterial, voxelBelowRightBeforeMaterial, offset); //2
+							voxelBelowBeforeMaterial, voxelRightBeforeMaterial, voxelBelowRightBeforeMaterial, vertexOffset, scale); //2
 					vecQuads[NegativeZ][regZ].emplace_back(v_0_1, v_1_5, v_2_6, v_3_2);
 				}
 
@@ -716,13 +726,13 @@ void extractAllCubicMesh(VolumeType* volData, const Region& region, Mesh* result
 					const VoxelType _voxelBelowRightBehind = volumeSampler.peekVoxel1px1ny1pz().getMaterial();
 
 					const IndexType v_0_4 = addVertex(reuseVertices, regX,     regY,     regZ, voxelBefore, previousSliceVertices, result,
-							_voxelBelowBehind, _voxelLeftBehind, _voxelBelowLeftBehind, offset); //4
+							_voxelBelowBehind, _voxelLeftBehind, _voxelBelowLeftBehind, vertexOffset, scale); //4
 					const IndexType v_1_8 = addVertex(reuseVertices, regX,     regY + 1, regZ, voxelBefore, previousSliceVertices, result,
-							_voxelAboveBehind, _voxelLeftBehind, _voxelAboveLeftBehind, offset); //8
+							_voxelAboveBehind, _voxelLeftBehind, _voxelAboveLeftBehind, vertexOffset, scale); //8
 					const IndexType v_2_7 = addVertex(reuseVertices, regX + 1, regY + 1, regZ, voxelBefore, previousSliceVertices, result,
-							_voxelAboveBehind, _voxelRightBehind, _voxelAboveRightBehind, offset); //7
+							_voxelAboveBehind, _voxelRightBehind, _voxelAboveRightBehind, vertexOffset, scale); //7
 					const IndexType v_3_3 = addVertex(reuseVertices, regX + 1, regY,     regZ, voxelBefore, previousSliceVertices, result,
-							_voxelBelowBehind, _voxelRightBehind, _voxelBelowRightBehind, offset); //3
+							_voxelBelowBehind, _voxelRightBehind, _voxelBelowRightBehind, vertexOffset, scale); //3
 					vecQuads[PositiveZ][regZ].emplace_back(v_0_4, v_3_3, v_2_7, v_1_8);
 
 					volumeSampler.movePositiveZ();
@@ -3,6 +3,7 @@
  */
 
 #include "PagedVolume.h"
+#include "RawVolume.h"
 #include "Morton.h"
 #include "Utility.h"
 #include "core/Log.h"
@@ -133,7 +134,7 @@ void PagedVolume::setVoxels(int32_t uXPos, int32_t uYPos, int32_t uZPos, int nx,
 				const uint16_t yOffset = static_cast<uint16_t>(y & _chunkMask);
 
 				ChunkPtr chunkPtr = chunk(chunkX, chunkY, chunkZ);
-				const int32_t n = std::min(left, int32_t(chunkPtr->_sideLength));
+				const int32_t n = std::min(left, int32_t(chunkPtr->_sideLength) - yOffset);
 
 				chunkPtr->setVoxels(xOffset, yOffset, zOffset, array, n);
 				left -= n;
@@ -144,6 +145,60 @@ void PagedVolume::setVoxels(int32_t uXPos, int32_t uYPos, int32_t uZPos, int nx,
 	}
 }
 
+template<class Func>
+void PagedVolume::visitChunks(const Region& region, Func&& func) {
+	if (!region.isValid()) {
+		return;
+	}
+	const glm::ivec3 lowerChunk = region.getLowerCorner() >> (int32_t)_chunkSideLengthPower;
+	const glm::ivec3 upperChunk = region.getUpperCorner() >> (int32_t)_chunkSideLengthPower;
+	for (int32_t chunkZ = lowerChunk.z; chunkZ <= upperChunk.z; ++chunkZ) {
+		for (int32_t chunkY = lowerChunk.y; chunkY <= upperChunk.y; ++chunkY) {
+			for (int32_t chunkX = lowerChunk.x; chunkX <= upperChunk.x; ++chunkX) {
+				const ChunkPtr& chunkPtr = chunk(chunkX, chunkY, chunkZ);
+				Region cropped = chunkPtr->region();
+				cropped.cropTo(region);
+				core::RecursiveScopedWriteLock writeLock(chunkPtr->_rwLock);
+				func(*chunkPtr, cropped);
+				chunkPtr->_dataModified = true;
+			}
+		}
+	}
+}
+
+void PagedVolume::fill(const Region& region, const Voxel& voxel) {
+	visitChunks(region, [&] (Chunk& chunk, const Region& cropped) {
+		const glm::ivec3& mins = cropped.getLowerCorner() & _chunkMask;
+		const glm::ivec3& maxs = cropped.getUpperCorner() & _chunkMask;
+		for (int32_t z = mins.z; z <= maxs.z; ++z) {
+			for (int32_t y = mins.y; y <= maxs.y; ++y) {
+				const uint32_t yz = morton256_y[y] | morton256_z[z];
+				for (int32_t x = mins.x; x <= maxs.x; ++x) {
+					chunk._data[morton256_x[x] | yz] = voxel;
+				}
+			}
+		}
+	});
+}
+
+void PagedVolume::copy(const RawVolume& source, const Region& sourceRegion, const glm::ivec3& destMins) {
+	Region srcRegion = sourceRegion;
+	srcRegion.cropTo(source.region());
+	const glm::ivec3 offset = destMins - sourceRegion.getLowerCorner();
+	const Region destRegion(srcRegion.getLowerCorner() + offset, srcRegion.getUpperCorner() + offset);
+	visitChunks(destRegion, [&] (Chunk& chunk, const Region& cropped) {
+		const glm::ivec3& chunkMins = chunk.region().getLowerCorner();
+		for (int32_t z = cropped.getLowerZ(); z <= cropped.getUpperZ(); ++z) {
+			for (int32_t y = cropped.getLowerY(); y <= cropped.getUpperY(); ++y) {
+				const uint32_t yz = morton256_y[y - chunkMins.y] | morton256_z[z - chunkMins.z];
+				for (int32_t x = cropped.getLowerX(); x <= cropped.getUpperX(); ++x) {
+					chunk._data[morton256_x[x - chunkMins.x] | yz] = source.voxel(x - offset.x, y - offset.y, z - offset.z);
+				}
+			}
+		}
+	});
+}
+
 /**
  * Removes all voxels from memory by removing all chunks. The application has the chance to persist the data via @c Pager::pageOut
  */
@@ -152,6 +207,14 @@ void PagedVolume::flushAll() {
 	// Clear this pointer as all chunks are about to be removed.
 	_lastAccessedChunk = ChunkPtr();
 
+	{
+		core::RecursiveScopedReadLock readLock(_listenerLock);
+		for (IChunkListener* l : _listener) {
+			for (const auto& e : _chunks) {
+				l->onRemove(e.second);
+			}
+		}
+	}
 	// Erase all the most recently used chunks.
 	_chunks.clear();
 }
@@ -18,6 +18,8 @@
 
 namespace voxel {
 
+class RawVolume;
+
 /**
  * This class provide a volume implementation which avoids storing all the data in memory at all times. Instead it breaks the volume
  * down into a set of chunks and moves these into and out of memory on demand. This means it is much more memory efficient than the
@@ -61,10 +63,15 @@ public:
 		void setVoxels(uint32_t uXPos, uint32_t uZPos, const Voxel* tValues, int amount);
 		void setVoxels(uint32_t uXPos, uint32_t uYPos, uint32_t uZPos, const Voxel* tValues, int amount);
 		void setVoxel(const glm::i16vec3& v3dPos, const Voxel& tValue);
+		/**
+		 * @brief Replaces all voxels of the chunk - the data must be in the same (morton) order as the chunk data
+		 */
+		void setData(const Voxel* voxels, uint32_t sizeInBytes);
 
 	private:
 		// This is updated by the PagedVolume and used to discard the least recently used chunks.
-		uint32_t _chunkLastAccessed = 0u;
+		// It's written while only holding the read lock of the volume.
+		std::atomic_uint _chunkLastAccessed { 0u };
 
 		uint32_t calculateSizeInBytes() const;
 		static uint32_t calculateSizeInBytes(uint32_t uSideLength);
@@ -299,7 +306,20 @@ public:
 	void setVoxel(const glm::ivec3& v3dPos, const Voxel& tValue);
 	/// Sets the voxel at the position given by <tt>x,z</tt> coordinates
 	void setVoxels(int32_t uXPos, int32_t uZPos, const Voxel* tArray, int amount);
+	/**
+	 * @brief Sets the same column of @c amount voxels - starting at @c uYPos - for all @c nx * @c nz columns
+	 */
 	void setVoxels(int32_t uXPos, int32_t uYPos, int32_t uZPos, int nx, int nz, const Voxel* tArray, int amount);
+	/**
+	 * @brief Sets all voxels of the given region - every chunk is only locked once
+	 */
+	void fill(const Region& region, const Voxel& voxel);
+	/**
+	 * @brief Copies the voxels of the source region into this volume
+	 * @param destMins The position of the lower corner of the source region in this volume. Voxels
+	 * that are outside of the source volume are skipped.
+	 */
+	void copy(const RawVolume& source, const Region& sourceRegion, const glm::ivec3& destMins);
 
 	/// Removes all voxels from memory
 	void flushAll();
@@ -326,6 +346,12 @@ private:
 	ChunkPtr existingChunk(int32_t uChunkX, int32_t uChunkY, int32_t uChunkZ) const;
 	ChunkPtr createNewChunk(int32_t uChunkX, int32_t uChunkY, int32_t uChunkZ) const;
 	void deleteOldestChunkIfNeeded() const;
+	/**
+	 * @brief Calls the given function with every chunk that intersects the given region and the intersection
+	 * @note The chunks are locked for writing while the function is executed
+	 */
+	template<class Func>
+	void visitChunks(const Region& region, Func&& func);
 
 	// Storing these properties individually has proved to be faster than keeping
 	// them in a glm::ivec3 as it avoids constructions and comparison overheads.
@@ -30,7 +30,8 @@ PagedVolume::BufferedSampler::BufferedSampler(const PagedVolume* volume, const R
 
 	std::unordered_map<glm::ivec3, ChunkPtr> chunks;
 
-	core::RecursiveScopedReadLock readLock(volume->_rwLock);
+	// no need to lock the volume here - the chunks are kept alive by the local map and PagedVolume::chunk()
+	// would have to upgrade the read lock to update the last accessed chunk
 	glm::ivec3 chunkPos(std::numeric_limits<int>::min()), newChunkPos;
 	for (int32_t z = offset.z; z <= upper.z; ++z) {
 		const uint32_t regZ = z - offset.z;
@@ -78,16 +78,16 @@ void PagedVolume::Chunk::setVoxels(uint32_t uXPos, uint32_t uZPos, const Voxel*
 void PagedVolume::Chunk::setVoxels(uint32_t uXPos, uint32_t uYPos, uint32_t uZPos, const Voxel* tValues, int amount) {
 	// This code is not usually expected to be called by the user, with the exception of when implementing paging
 	// of uncompressed data. It's a performance critical code path
-	core_assert_msg(amount <= _sideLength, "Supplied amount exceeds chunk boundaries");
+	core_assert_msg(uYPos + amount <= _sideLength, "Supplied amount exceeds chunk boundaries");
 	core_assert_msg(uXPos < _sideLength, "Supplied x position is outside of the chunk");
 	core_assert_msg(uYPos < _sideLength, "Supplied y position is outside of the chunk");
 	core_assert_msg(uZPos < _sideLength, "Supplied z position is outside of the chunk");
 	core_assert_msg(_data, "No uncompressed data - chunk must be decompressed before accessing voxels.");
 
 	core::RecursiveScopedWriteLock writeLock(_rwLock);
-	for (int y = uYPos; y < amount; ++y) {
-		const uint32_t index = morton256_x[uXPos] | morton256_y[y] | morton256_z[uZPos];
-		_data[index] = tValues[y];
+	for (int i = 0; i < amount; ++i) {
+		const uint32_t index = morton256_x[uXPos] | morton256_y[uYPos + i] | morton256_z[uZPos];
+		_data[index] = tValues[i];
 	}
 	_dataModified = true;
 }
@@ -96,6 +96,14 @@ void PagedVolume::Chunk::setVoxel(const glm::i16vec3& v3dPos, const Voxel& tValu
 	setVoxel(v3dPos.x, v3dPos.y, v3dPos.z, tValue);
 }
 
+void PagedVolume::Chunk::setData(const Voxel* voxels, uint32_t sizeInBytes) {
+	core_assert_msg(sizeInBytes == dataSizeInBytes(), "Supplied data size doesn't match the chunk size");
+	core_assert_msg(_data, "No uncompressed data - chunk must be decompressed before accessing voxels.");
+	core::RecursiveScopedWriteLock writeLock(_rwLock);
+	memcpy(_data, voxels, sizeInBytes);
+	_dataModified = true;
+}
+
 uint32_t PagedVolume::Chunk::calculateSizeInBytes() const {
 	// Call through to the static version
 	return calculateSizeInBytes(_sideLength);
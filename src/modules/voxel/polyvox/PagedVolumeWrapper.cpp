@@ -84,7 +84,7 @@ bool PagedVolumeWrapper::setVoxels(int x, int y, int z, int nx, int nz, const Vo
 			int left = amount;
 			if (_validRegion.containsPoint(fx, y, fz)) {
 				// first part goes into the chunk
-				const int h = _validRegion.getHeightInVoxels();
+				const int h = _validRegion.getUpperY() - y + 1;
 				_chunk->setVoxels(fx - _validRegion.getLowerX(), y - _validRegion.getLowerY(), fz - _validRegion.getLowerZ(), voxels, std::min(h, left));
 				left -= h;
 				if (left > 0) {
@@ -141,6 +141,86 @@ bool RawVolume::setVoxel(const glm::ivec3& pos, const Voxel& voxel) {
 	return true;
 }
 
+int RawVolume::fill(const Region& region, const Voxel& voxel) {
+	return fill(region, voxel, [] (const Voxel&) {
+		return true;
+	});
+}
+
+int RawVolume::copy(const RawVolume& source, const Region& sourceRegion, const glm::ivec3& destMins) {
+	return copy(source, sourceRegion, destMins, [] (const Voxel&) {
+		return true;
+	});
+}
+
+bool RawVolume::cropCopyRegion(const RawVolume& source, Region& sourceRegion, glm::ivec3& destMins) const {
+	const glm::ivec3 offset = destMins - sourceRegion.getLowerCorner();
+	sourceRegion.cropTo(source.region());
+	Region destRegion(sourceRegion.getLowerCorner() + offset, sourceRegion.getUpperCorner() + offset);
+	destRegion.cropTo(_region);
+	if (!destRegion.isValid()) {
+		return false;
+	}
+	sourceRegion = Region(destRegion.getLowerCorner() - offset, destRegion.getUpperCorner() - offset);
+	destMins = destRegion.getLowerCorner();
+	return true;
+}
+
+static inline int32_t dot(const glm::ivec3& a, const glm::ivec3& b) {
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+int RawVolume::copyRotated(const RawVolume& source, const glm::highp_imat3x3& rotation, const Voxel& empty) {
+	const glm::ivec3 srcSize(source.width(), source.height(), source.depth());
+	// the rotated position of the source voxel at the local position (0,0,0) - the local positions of
+	// the rotated voxels start at (0,0,0) again
+	glm::ivec3 origin(0);
+	for (int column = 0; column < 3; ++column) {
+		for (int row = 0; row < 3; ++row) {
+			const int v = rotation[column][row];
+			core_assert_msg(v >= -1 && v <= 1, "Only rotations in 90 degree steps are supported");
+			if (v < 0) {
+				origin[row] += srcSize[column] - 1;
+			}
+		}
+	}
+	core_assert_msg(glm::abs(rotation * srcSize) == glm::ivec3(width(), height(), depth()), "Rotated source volume doesn't match the volume size");
+
+	// the offset in the data array of this volume when moving one step along the source axes
+	const glm::ivec3 strides(1, width(), width() * height());
+	const int32_t stepX = dot(rotation[0], strides);
+	const int32_t stepY = dot(rotation[1], strides);
+	const int32_t stepZ = dot(rotation[2], strides);
+	const int32_t start = dot(origin, strides);
+
+	const Voxel* src = source._data;
+	const VoxelType emptyType = empty.getMaterial();
+	int copied = 0;
+	for (int32_t z = 0; z < srcSize.z; ++z) {
+		for (int32_t y = 0; y < srcSize.y; ++y) {
+			int32_t dst = start + y * stepY + z * stepZ;
+			for (int32_t x = 0; x < srcSize.x; ++x, ++src, dst += stepX) {
+				if (src->getMaterial() == emptyType) {
+					continue;
+				}
+				_data[dst] = *src;
+				++copied;
+			}
+		}
+	}
+	if (copied > 0) {
+		// only the bounds of the source have to be rotated
+		const glm::ivec3& lowerCorner = _region.getLowerCorner();
+		const glm::ivec3& srcLowerCorner = source.region().getLowerCorner();
+		const glm::ivec3 a = rotation * (source.mins() - srcLowerCorner) + origin;
+		const glm::ivec3 b = rotation * (source.maxs() - srcLowerCorner) + origin;
+		_mins = glm::min(_mins, glm::min(a, b) + lowerCorner);
+		_maxs = glm::max(_maxs, glm::max(a, b) + lowerCorner);
+		_boundsValid = true;
+	}
+	return copied;
+}
+
 /**
  * This function should probably be made internal...
  */
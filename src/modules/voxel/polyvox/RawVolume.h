@@ -8,6 +8,7 @@
 #include "Region.h"
 #include "Utility.h"
 #include "core/NonCopyable.h"
+#include <glm/gtc/matrix_integer.hpp>
 #include <limits>
 #include <memory>
 
@@ -136,6 +137,44 @@ public:
 	/// Sets the voxel at the position given by a 3D vector
 	bool setVoxel(const glm::ivec3& pos, const Voxel& voxel);
 
+	/**
+	 * @brief Sets all voxels of the given region. The region is cropped to the volume.
+	 * @return The amount of voxels that were changed
+	 * @note Works on whole rows of voxels - prefer this over calling @c setVoxel() for every voxel of a region
+	 */
+	int fill(const Region& region, const Voxel& voxel);
+	/**
+	 * @brief Sets those voxels of the given region that pass the given condition.
+	 * @param condition Gets the current voxel - must return @c false for voxels that should be kept
+	 * @return The amount of voxels that were changed
+	 */
+	template<class Condition>
+	int fill(const Region& region, const Voxel& voxel, Condition condition);
+	/**
+	 * @brief Copies the voxels of the source region into this volume
+	 * @param destMins The position of the lower corner of the source region in this volume. Voxels that are
+	 * outside of one of the two volumes are skipped.
+	 * @return The amount of voxels that were changed
+	 */
+	int copy(const RawVolume& source, const Region& sourceRegion, const glm::ivec3& destMins);
+	/**
+	 * @brief Copies only those voxels of the source region into this volume that pass the given mask
+	 * @param mask Gets the source voxel - must return @c false for voxels that should be skipped
+	 * @return The amount of voxels that were changed
+	 * @sa copy()
+	 */
+	template<class Mask>
+	int copy(const RawVolume& source, const Region& sourceRegion, const glm::ivec3& destMins, Mask mask);
+	/**
+	 * @brief Copies the whole source volume rotated in 90 degree steps into this volume
+	 * @param rotation May only contain the values @c -1, @c 0 and @c 1 - this is a rotation by a multiple
+	 * of 90 degrees around the axes or a transposition of the axes. The rotated source volume must have
+	 * the same dimensions as this volume.
+	 * @param empty The source voxels that are of the same type are skipped
+	 * @return The amount of voxels that were copied
+	 */
+	int copyRotated(const RawVolume& source, const glm::highp_imat3x3& rotation, const Voxel& empty);
+
 	/// Calculates approximatly how many bytes of memory the volume is currently using.
 	uint32_t calculateSizeInBytes();
 
@@ -143,6 +182,12 @@ public:
 
 private:
 	void initialise(const Region& region);
+	/// The index of the voxel at the given position in the data array
+	int32_t index(int32_t x, int32_t y, int32_t z) const;
+	/// Crops the source region in a way that both the source and the destination are inside their volumes
+	bool cropCopyRegion(const RawVolume& source, Region& sourceRegion, glm::ivec3& destMins) const;
+	/// Extends the bounds by the voxels [lowerX, upperX] of the given row
+	void extendBounds(int32_t lowerX, int32_t upperX, int32_t y, int32_t z);
 
 	/** The size of the volume */
 	Region _region;
@@ -158,6 +203,84 @@ private:
 	bool _boundsValid;
 };
 
+inline int32_t RawVolume::index(int32_t x, int32_t y, int32_t z) const {
+	const glm::ivec3& lowerCorner = _region.getLowerCorner();
+	return (x - lowerCorner.x) + (y - lowerCorner.y) * width() + (z - lowerCorner.z) * width() * height();
+}
+
+inline void RawVolume::extendBounds(int32_t lowerX, int32_t upperX, int32_t y, int32_t z) {
+	_mins = glm::min(_mins, glm::ivec3(lowerX, y, z));
+	_maxs = glm::max(_maxs, glm::ivec3(upperX, y, z));
+	_boundsValid = true;
+}
+
+template<class Condition>
+int RawVolume::fill(const Region& region, const Voxel& voxel, Condition condition) {
+	Region cropped = region;
+	cropped.cropTo(_region);
+	if (!cropped.isValid()) {
+		return 0;
+	}
+	const int32_t lowerX = cropped.getLowerX();
+	const int32_t n = cropped.getWidthInVoxels();
+	int changed = 0;
+	for (int32_t z = cropped.getLowerZ(); z <= cropped.getUpperZ(); ++z) {
+		for (int32_t y = cropped.getLowerY(); y <= cropped.getUpperY(); ++y) {
+			Voxel* row = _data + index(lowerX, y, z);
+			// branch free to let the compiler vectorize the row
+			int32_t rowMin = n;
+			int32_t rowMax = -1;
+			int rowChanged = 0;
+			for (int32_t i = 0; i < n; ++i) {
+				const bool set = condition(row[i]) && !row[i].isSame(voxel);
+				row[i] = set ? voxel : row[i];
+				rowChanged += set;
+				rowMin = std::min(rowMin, set ? i : n);
+				rowMax = std::max(rowMax, set ? i : -1);
+			}
+			if (rowChanged > 0) {
+				changed += rowChanged;
+				extendBounds(lowerX + rowMin, lowerX + rowMax, y, z);
+			}
+		}
+	}
+	return changed;
+}
+
+template<class Mask>
+int RawVolume::copy(const RawVolume& source, const Region& sourceRegion, const glm::ivec3& destMins, Mask mask) {
+	Region srcRegion = sourceRegion;
+	glm::ivec3 dstMins = destMins;
+	if (!cropCopyRegion(source, srcRegion, dstMins)) {
+		return 0;
+	}
+	const glm::ivec3 offset = dstMins - srcRegion.getLowerCorner();
+	const int32_t n = srcRegion.getWidthInVoxels();
+	int changed = 0;
+	for (int32_t z = srcRegion.getLowerZ(); z <= srcRegion.getUpperZ(); ++z) {
+		for (int32_t y = srcRegion.getLowerY(); y <= srcRegion.getUpperY(); ++y) {
+			const Voxel* srcRow = source._data + source.index(srcRegion.getLowerX(), y, z);
+			Voxel* dstRow = _data + index(dstMins.x, y + offset.y, z + offset.z);
+			int32_t rowMin = n;
+			int32_t rowMax = -1;
+			int rowChanged = 0;
+			for (int32_t i = 0; i < n; ++i) {
+				const Voxel& voxel = srcRow[i];
+				const bool set = mask(voxel) && !dstRow[i].isSame(voxel);
+				dstRow[i] = set ? voxel : dstRow[i];
+				rowChanged += set;
+				rowMin = std::min(rowMin, set ? i : n);
+				rowMax = std::max(rowMax, set ? i : -1);
+			}
+			if (rowChanged > 0) {
+				changed += rowChanged;
+				extendBounds(dstMins.x + rowMin, dstMins.x + rowMax, y + offset.y, z + offset.z);
+			}
+		}
+	}
+	return changed;
+}
+
 inline glm::ivec3 RawVolume::mins() const {
 	if (!_boundsValid) {
 		return _region.getLowerCorner();
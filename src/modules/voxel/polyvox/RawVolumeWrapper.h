@@ -86,11 +86,15 @@ public:
 		return true;
 	}
 
+	inline bool setVoxels(int x, int y, int z, const Voxel* voxels, int amount) {
+		return setVoxels(x, y, z, 1, 1, voxels, amount);
+	}
+
 	inline bool setVoxels(int x, int y, int z, int nx, int nz, const Voxel* voxels, int amount) {
 		for (int j = 0; j < nx; ++j) {
 			for (int k = 0; k < nz; ++k) {
-				for (int ny = y; ny < amount; ++ny) {
-					setVoxel(x + j, ny, z + k, voxels[ny]);
+				for (int i = 0; i < amount; ++i) {
+					setVoxel(x + j, y + i, z + k, voxels[i]);
 				}
 			}
 		}
@@ -8,6 +8,7 @@
 #include "core/Trace.h"
 #include "PagedVolume.h"
 #include "RawVolume.h"
+#include "ChunkBuffer.h"
 
 namespace voxel {
 namespace RaycastResults {
@@ -197,6 +198,11 @@ inline RaycastResult raycastWithEndpointsVolume(const PagedVolume* volData, cons
 	return raycastWithEndpoints(volData, v3dStart, v3dEnd, callback);
 }
 
+template<typename Callback>
+inline RaycastResult raycastWithEndpointsVolume(const ChunkBuffer& volData, const glm::vec3& v3dStart, const glm::vec3& v3dEnd, Callback&& callback) {
+	return raycastWithEndpoints(&volData, v3dStart, v3dEnd, callback);
+}
+
 template<typename Callback>
 inline RaycastResult raycastWithEndpointsVolume(const RawVolume* volData, const glm::vec3& v3dStart, const glm::vec3& v3dEnd, Callback&& callback) {
 	return raycastWithEndpoints(volData, v3dStart, v3dEnd, callback);
@@ -47,6 +47,18 @@ int mergeVolumes(Volume1* destination, const Volume2* source, const Region& dest
 	return cnt;
 }
 
+/**
+ * @note This version copies whole rows of voxels - voxels that are outside of one of the two volumes are skipped
+ * @note The given merge condition function must return false for voxels that should be skipped.
+ * @sa MergeSkipEmpty
+ * @sa RawVolume::copy()
+ */
+template<typename MergeCondition = MergeSkipEmpty>
+int mergeVolumes(RawVolume* destination, const RawVolume* source, const Region& destReg, const Region& sourceReg, MergeCondition mergeCondition = MergeCondition()) {
+	core_trace_scoped(MergeRawVolumes);
+	return destination->copy(*source, sourceReg, destReg.getLowerCorner(), mergeCondition);
+}
+
 /**
  * The given merge condition function must return false for voxels that should be skipped.
  * @sa MergeSkipEmpty
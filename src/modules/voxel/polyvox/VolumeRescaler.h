@@ -40,6 +40,9 @@ void rescaleVolume(const SourceVolume& sourceVolume, const Region& sourceRegion,
 				float avgOf8Red = 0.0f;
 				float avgOf8Green = 0.0f;
 				float avgOf8Blue = 0.0f;
+				srcSampler.setPosition(srcPos);
+				const uint8_t firstColor = srcSampler.voxel().getColor();
+				bool sameColor = true;
 				for (int32_t childZ = 0; childZ < 2; ++childZ) {
 					for (int32_t childY = 0; childY < 2; ++childY) {
 						for (int32_t childX = 0; childX < 2; ++childX) {
@@ -52,6 +55,7 @@ void rescaleVolume(const SourceVolume& sourceVolume, const Region& sourceRegion,
 								avgOf8Red += color.r;
 								avgOf8Green += color.g;
 								avgOf8Blue += color.b;
+								sameColor &= child.getColor() == firstColor;
 							}
 						}
 					}
@@ -60,8 +64,12 @@ void rescaleVolume(const SourceVolume& sourceVolume, const Region& sourceRegion,
 				// We only make a voxel solid if the eight corresponding voxels are also all solid. This
 				// means that higher LOD meshes actually shrink away which ensures cracks aren't visible.
 				if (solidVoxels > 7) {
-					const glm::vec4 avgColor(avgOf8Red / (float)solidVoxels, avgOf8Green / (float)solidVoxels, avgOf8Blue / (float)solidVoxels, 1.0f);
-					const int index = core::Color::getClosestMatch(avgColor, colors);
+					int index = firstColor;
+					// the palette lookup is expensive - the common case of eight equal colors doesn't need it
+					if (!sameColor) {
+						const glm::vec4 avgColor(avgOf8Red / (float)solidVoxels, avgOf8Green / (float)solidVoxels, avgOf8Blue / (float)solidVoxels, 1.0f);
+						index = core::Color::getClosestMatch(avgColor, colors);
+					}
 					Voxel voxel = createVoxel(VoxelType::Generic, index);
 					destVolume.setVoxel(dstPos, voxel);
 				} else {
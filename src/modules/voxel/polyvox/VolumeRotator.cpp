@@ -9,6 +9,10 @@
 
 namespace voxel {
 
+static inline bool isRightAngle(float angle) {
+	return glm::mod(angle, 90.0f) == 0.0f;
+}
+
 /**
  * @param[in] source The RawVolume to rotate
  * @param[in] angles The angles for the x, y and z axis given in degrees
@@ -32,6 +36,19 @@ RawVolume* rotateVolume(const RawVolume* source, const glm::vec3& angles, const
 	const glm::mat4& rot = glm::mat4_cast(quat);
 #endif
 	const voxel::Region& srcRegion = source->region();
+	if (isRightAngle(angles.x) && isRightAngle(angles.y) && isRightAngle(angles.z)) {
+		// the voxels are just moved around - no resampling is needed
+		const glm::mat3 rot3(rot);
+		const glm::highp_imat3x3 rotation(glm::ivec3(glm::round(rot3[0])), glm::ivec3(glm::round(rot3[1])), glm::ivec3(glm::round(rot3[2])));
+		const glm::ivec3 srcSize(srcRegion.getWidthInVoxels(), srcRegion.getHeightInVoxels(), srcRegion.getDepthInVoxels());
+		const glm::ivec3 destSize = glm::abs(rotation * srcSize);
+		if (increaseSize || destSize == srcSize) {
+			const voxel::Region destRegion = increaseSize ? voxel::Region(glm::ivec3(0), destSize - 1) : srcRegion;
+			voxel::RawVolume* destination = new RawVolume(destRegion);
+			destination->copyRotated(*source, rotation, empty);
+			return destination;
+		}
+	}
 	const glm::ivec3& srcCenter = srcRegion.getCentre();
 	voxel::Region destRegion;
 
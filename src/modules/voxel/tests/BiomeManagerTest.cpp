@@ -66,6 +66,18 @@ TEST_F(BiomeManagerTest, testHumidityTemperature) {
 	EXPECT_EQ(VoxelType::Sand, mgr.getBiome(p3)->type);
 }
 
+TEST_F(BiomeManagerTest, testClimateMapBorders) {
+	BiomeManager mgr;
+	mgr.init("");
+	const int size = ClimateMap::Size;
+	EXPECT_NE(mgr.getClimateMap(size - 1, 0)->column(), mgr.getClimateMap(size, 0)->column());
+	EXPECT_EQ(glm::ivec2(-1, -1), mgr.getClimateMap(-1, -1)->column());
+	for (int z = -size; z <= size; z += ClimateMap::SampleStep / 2) {
+		EXPECT_NEAR(mgr.getHumidity(size - 1, z), mgr.getHumidity(size, z), 0.01f) << "Humidity is not continuous at z: " << z;
+		EXPECT_NEAR(mgr.getTemperature(-1, z), mgr.getTemperature(0, z), 0.01f) << "Temperature is not continuous at z: " << z;
+	}
+}
+
 TEST_F(BiomeManagerTest, testLoadLUA) {
 	BiomeManager mgr;
 	const io::FilesystemPtr& filesystem = _testApp->filesystem();
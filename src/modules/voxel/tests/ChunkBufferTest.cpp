@@ -0,0 +1,76 @@
+/**
+ * @file
+ */
+
+#include "AbstractVoxelTest.h"
+#include "voxel/polyvox/ChunkBuffer.h"
+#include "voxel/PendingEdits.h"
+
+namespace voxel {
+
+class ChunkBufferTest: public AbstractVoxelTest {
+};
+
+TEST_F(ChunkBufferTest, testCommit) {
+	const Region region(32, 0, 32, 63, 31, 63);
+	ChunkBuffer buffer;
+	buffer.init(region);
+	const Voxel wood = createColorVoxel(VoxelType::Wood, 0);
+	Voxel voxels[8];
+	for (int i = 0; i < 8; ++i) {
+		voxels[i] = wood;
+	}
+	EXPECT_TRUE(buffer.setVoxels(40, 4, 40, 2, 2, voxels, 8));
+	EXPECT_TRUE(buffer.setVoxel(63, 31, 63, wood));
+	// the column continues in the chunk above
+	EXPECT_FALSE(buffer.setVoxels(50, 28, 50, voxels, 8));
+	EXPECT_FALSE(buffer.setVoxel(64, 0, 32, wood));
+	ASSERT_EQ(5u, buffer.outside().size());
+	EXPECT_EQ(glm::ivec3(50, 32, 50), buffer.outside()[0].pos);
+	EXPECT_EQ(glm::ivec3(64, 0, 32), buffer.outside()[4].pos);
+	EXPECT_TRUE(isAir(buffer.voxel(64, 0, 32).getMaterial()));
+
+	PagedVolume::Chunk chunk(glm::ivec3(1, 0, 1), 32, &_pager);
+	buffer.commit(chunk);
+	for (int y = 4; y < 12; ++y) {
+		EXPECT_TRUE(isWood(chunk.voxel(8, y, 8).getMaterial())) << "No wood at y: " << y;
+		EXPECT_TRUE(isWood(chunk.voxel(9, y, 9).getMaterial())) << "No wood at y: " << y;
+	}
+	EXPECT_TRUE(isAir(chunk.voxel(8, 12, 8).getMaterial()));
+	EXPECT_TRUE(isWood(chunk.voxel(31, 31, 31).getMaterial()));
+	for (int y = 28; y < 32; ++y) {
+		EXPECT_TRUE(isWood(chunk.voxel(18, y, 18).getMaterial())) << "No wood at y: " << y;
+	}
+}
+
+TEST_F(ChunkBufferTest, testPendingEdits) {
+	PendingEdits pending;
+	pending.init(32);
+	const Voxel wood = createColorVoxel(VoxelType::Wood, 0);
+	const Region neighbour(32, 0, 0, 63, 31, 31);
+	std::vector<VoxelEdit> edits = { {glm::ivec3(32, 1, 1), wood}, {glm::ivec3(-1, 1, 1), wood} };
+	std::vector<VoxelEdit> pagedIn;
+	pending.add(edits, pagedIn);
+	EXPECT_TRUE(pagedIn.empty()) << "None of the chunks is paged in";
+	EXPECT_EQ(2u, pending.size());
+
+	std::vector<VoxelEdit> taken;
+	pending.pageIn(neighbour, taken);
+	ASSERT_EQ(1u, taken.size());
+	EXPECT_EQ(glm::ivec3(32, 1, 1), taken[0].pos);
+	EXPECT_EQ(1u, pending.size());
+
+	// the neighbour is paged in now - the edits must be applied directly
+	pending.add(edits, pagedIn);
+	ASSERT_EQ(1u, pagedIn.size());
+	EXPECT_EQ(glm::ivec3(32, 1, 1), pagedIn[0].pos);
+	EXPECT_EQ(2u, pending.size());
+
+	pending.pageOut(neighbour);
+	pagedIn.clear();
+	pending.add(edits, pagedIn);
+	EXPECT_TRUE(pagedIn.empty());
+	EXPECT_EQ(4u, pending.size());
+}
+
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ */
+
+#include "AbstractVoxelTest.h"
+#include "voxel/ChunkDelta.h"
+
+namespace voxel {
+
+class ChunkDeltaTest: public AbstractVoxelTest {
+};
+
+TEST_F(ChunkDeltaTest, testIndex) {
+	const glm::ivec3 positions[] = { glm::ivec3(0), glm::ivec3(31, 0, 0), glm::ivec3(-1, 5, -33), glm::ivec3(100, 200, -100) };
+	for (const glm::ivec3& pos : positions) {
+		const glm::ivec3& chunkPos = deltaChunkPos(pos);
+		EXPECT_EQ(pos, deltaPosition(chunkPos, deltaIndex(pos)));
+	}
+	EXPECT_EQ(glm::ivec3(-1, 0, -2), deltaChunkPos(glm::ivec3(-1, 5, -33)));
+	EXPECT_EQ(deltaIndex(glm::ivec3(0)) + 1u, deltaIndex(glm::ivec3(1, 0, 0)));
+}
+
+TEST_F(ChunkDeltaTest, testEncodeDecode) {
+	std::vector<VoxelChange> changes;
+	const Voxel rock = createVoxel(VoxelType::Rock, 1);
+	const Voxel grass = createVoxel(VoxelType::Grass, 2);
+	for (uint32_t i = 0; i < 64; ++i) {
+		changes.push_back(VoxelChange { i, rock });
+	}
+	changes.push_back(VoxelChange { 100, grass });
+	changes.push_back(VoxelChange { 101, rock });
+	changes.push_back(VoxelChange { 5000, grass });
+
+	std::vector<uint8_t> encoded;
+	ASSERT_TRUE(encodeChunkDelta(changes, encoded));
+	EXPECT_LT(encoded.size(), changes.size() * sizeof(VoxelChange) / 4);
+
+	std::vector<VoxelChange> decoded;
+	ASSERT_TRUE(decodeChunkDelta(encoded.data(), encoded.size(), decoded));
+	ASSERT_EQ(changes.size(), decoded.size());
+	for (size_t i = 0; i < changes.size(); ++i) {
+		EXPECT_EQ(changes[i].index, decoded[i].index);
+		EXPECT_TRUE(changes[i].voxel.isSame(decoded[i].voxel));
+	}
+}
+
+TEST_F(ChunkDeltaTest, testInvalid) {
+	std::vector<uint8_t> encoded;
+	const std::vector<VoxelChange> unsorted = { VoxelChange { 2, Voxel() }, VoxelChange { 1, Voxel() } };
+	EXPECT_FALSE(encodeChunkDelta(unsorted, encoded));
+
+	const std::vector<VoxelChange> changes = { VoxelChange { 1, Voxel() }, VoxelChange { 10, Voxel() } };
+	encoded.clear();
+	ASSERT_TRUE(encodeChunkDelta(changes, encoded));
+	std::vector<VoxelChange> decoded;
+	EXPECT_FALSE(decodeChunkDelta(encoded.data(), encoded.size() - 1, decoded));
+}
+
+TEST_F(ChunkDeltaTest, testTracker) {
+	ChunkDeltaTracker tracker;
+	const glm::ivec3 pos(1, 2, 3);
+	const glm::ivec3& chunkPos = deltaChunkPos(pos);
+	EXPECT_EQ(0u, tracker.version(chunkPos));
+	tracker.track(pos, createVoxel(VoxelType::Rock, 0));
+	tracker.track(pos + glm::ivec3(1, 0, 0), createVoxel(VoxelType::Rock, 0));
+	EXPECT_EQ(2u, tracker.version(chunkPos));
+	EXPECT_EQ(1u, tracker.dirty().size());
+
+	std::vector<VoxelChange> changes;
+	EXPECT_TRUE(tracker.changes(chunkPos, 0u, changes));
+	EXPECT_EQ(2u, changes.size());
+
+	// overwrite the first voxel - only this change is newer than version 2
+	tracker.track(pos, createVoxel(VoxelType::Sand, 0));
+	changes.clear();
+	EXPECT_TRUE(tracker.changes(chunkPos, 2u, changes));
+	ASSERT_EQ(1u, changes.size());
+	EXPECT_EQ(deltaIndex(pos), changes[0].index);
+	EXPECT_TRUE(isSand(changes[0].voxel.getMaterial()));
+
+	changes.clear();
+	EXPECT_FALSE(tracker.changes(chunkPos, 3u, changes));
+	tracker.clearDirty();
+	EXPECT_TRUE(tracker.dirty().empty());
+}
+
+}
@@ -0,0 +1,110 @@
+/**
+ * @file
+ */
+
+#include "voxel/tests/AbstractVoxelTest.h"
+#include "voxel/LodPyramid.h"
+
+namespace voxel {
+
+class LodPyramidTest: public AbstractVoxelTest {
+protected:
+	const int _groundHeight = 32;
+	const Voxel _ground = createVoxel(VoxelType::Rock, 1);
+
+	bool pageIn(const Region& region, const PagedVolume::ChunkPtr& chunk) override {
+		for (int z = 0; z < region.getDepthInVoxels(); ++z) {
+			for (int y = 0; y < region.getHeightInVoxels(); ++y) {
+				for (int x = 0; x < region.getWidthInVoxels(); ++x) {
+					if (region.getLowerY() + y < _groundHeight) {
+						chunk->setVoxel(x, y, z, _ground);
+					} else {
+						chunk->setVoxel(x, y, z, Voxel());
+					}
+				}
+			}
+		}
+		return true;
+	}
+};
+
+TEST_F(LodPyramidTest, testLevelRegion) {
+	LodPyramid pyramid(&_volData, glm::ivec3(-32, 0, -32), 16);
+	const Region region(glm::ivec3(0), glm::ivec3(63));
+	const Region& level1 = pyramid.levelRegion(region, 1);
+	EXPECT_EQ(glm::ivec3(16, 0, 16), level1.getLowerCorner());
+	EXPECT_EQ(glm::ivec3(47, 31, 47), level1.getUpperCorner());
+	const Region& level2 = pyramid.levelRegion(region, 2);
+	EXPECT_EQ(glm::ivec3(8, 0, 8), level2.getLowerCorner());
+	EXPECT_EQ(glm::ivec3(23, 15, 23), level2.getUpperCorner());
+	const Region& negative = pyramid.levelRegion(Region(glm::ivec3(-64), glm::ivec3(-33)), 1);
+	EXPECT_EQ(glm::ivec3(-16, -32, -16), negative.getLowerCorner());
+	EXPECT_EQ(glm::ivec3(-1, -17, -1), negative.getUpperCorner());
+}
+
+TEST_F(LodPyramidTest, testDownsample) {
+	LodPyramid pyramid(&_volData, glm::ivec3(0), 16);
+	for (int level = 1; level <= 3; ++level) {
+		const Region& region = pyramid.levelRegion(_region, level);
+		RawVolume volume(region);
+		pyramid.copy(level, region, volume);
+		const int surface = _groundHeight >> level;
+		for (int y = region.getLowerY(); y <= region.getUpperY(); ++y) {
+			const Voxel& voxel = volume.voxel(3, y, 5);
+			if (y < surface) {
+				EXPECT_EQ(VoxelType::Rock, voxel.getMaterial()) << "level " << level << ", y: " << y;
+			} else {
+				EXPECT_EQ(VoxelType::Air, voxel.getMaterial()) << "level " << level << ", y: " << y;
+			}
+		}
+	}
+}
+
+TEST_F(LodPyramidTest, testCache) {
+	LodPyramid pyramid(&_volData, glm::ivec3(0), 16);
+	const Region& region2 = pyramid.levelRegion(_region, 2);
+	RawVolume volume2(region2);
+	pyramid.copy(2, region2, volume2);
+	// one brick on level 2 - built from eight bricks of level 1
+	EXPECT_EQ(9, pyramid.builtBricks());
+	pyramid.copy(2, region2, volume2);
+	EXPECT_EQ(9, pyramid.builtBricks()) << "The level 2 brick should have been reused";
+
+	const Region& region1 = pyramid.levelRegion(_region, 1);
+	RawVolume volume1(region1);
+	pyramid.copy(1, region1, volume1);
+	EXPECT_EQ(9, pyramid.builtBricks()) << "The level 1 bricks should have been reused";
+}
+
+TEST_F(LodPyramidTest, testMarkAsModified) {
+	LodPyramid pyramid(&_volData, glm::ivec3(0), 16);
+	const Region& region1 = pyramid.levelRegion(_region, 1);
+	const Region& region2 = pyramid.levelRegion(_region, 2);
+	RawVolume volume1(region1);
+	RawVolume volume2(region2);
+	pyramid.copy(2, region2, volume2);
+	EXPECT_EQ(9, pyramid.builtBricks());
+
+	// dig a hole into the ground that is big enough to remove one voxel on level 2
+	const Region hole(glm::ivec3(0, 28, 0), glm::ivec3(3, 31, 3));
+	for (int z = hole.getLowerZ(); z <= hole.getUpperZ(); ++z) {
+		for (int y = hole.getLowerY(); y <= hole.getUpperY(); ++y) {
+			for (int x = hole.getLowerX(); x <= hole.getUpperX(); ++x) {
+				_volData.setVoxel(x, y, z, Voxel());
+			}
+		}
+	}
+	pyramid.markAsModified(hole);
+	pyramid.copy(1, region1, volume1);
+	// only the affected brick of level 1 was rebuilt
+	EXPECT_EQ(10, pyramid.builtBricks());
+	EXPECT_EQ(VoxelType::Air, volume1.voxel(0, 15, 0).getMaterial());
+	EXPECT_EQ(VoxelType::Rock, volume1.voxel(2, 15, 2).getMaterial());
+
+	pyramid.copy(2, region2, volume2);
+	EXPECT_EQ(11, pyramid.builtBricks());
+	EXPECT_EQ(VoxelType::Air, volume2.voxel(0, 7, 0).getMaterial());
+	EXPECT_EQ(VoxelType::Rock, volume2.voxel(1, 7, 1).getMaterial());
+}
+
+}
@@ -0,0 +1,104 @@
+/**
+ * @file
+ */
+
+#include "voxel/tests/AbstractVoxelTest.h"
+#include "voxel/SurfaceHeightmap.h"
+
+namespace voxel {
+
+class SurfaceHeightmapTest: public AbstractVoxelTest {
+protected:
+	SurfaceHeightmap _heightmap;
+
+	static int terrainHeight(int x, int z) {
+		return 20 + glm::abs(x + z) % 7;
+	}
+
+	bool pageIn(const Region& region, const PagedVolume::ChunkPtr& chunk) override {
+		for (int z = 0; z < region.getDepthInVoxels(); ++z) {
+			for (int y = 0; y < region.getHeightInVoxels(); ++y) {
+				for (int x = 0; x < region.getWidthInVoxels(); ++x) {
+					const glm::ivec3 pos = region.getLowerCorner() + glm::ivec3(x, y, z);
+					const int height = terrainHeight(pos.x, pos.z);
+					Voxel voxel;
+					if (pos.y <= height) {
+						voxel = createVoxel(VoxelType::Grass, 0);
+					} else if (pos.y <= height + 3 && pos.x % 8 == 0) {
+						// leaves are not walkable
+						voxel = createVoxel(VoxelType::Leaf, 0);
+					}
+					chunk->setVoxel(x, y, z, voxel);
+				}
+			}
+		}
+		return true;
+	}
+
+	void pageInColumn(int x, int z) {
+		for (int y = 0; y <= MAX_HEIGHT; y += _volData.chunkSideLength()) {
+			_volData.voxel(x, y, z);
+		}
+	}
+
+public:
+	void SetUp() override {
+		// register before the fixture pages in the first chunk
+		_heightmap.init(&_volData);
+		AbstractVoxelTest::SetUp();
+	}
+
+	void TearDown() override {
+		_heightmap.shutdown();
+		AbstractVoxelTest::TearDown();
+	}
+};
+
+TEST_F(SurfaceHeightmapTest, testFloor) {
+	int y;
+	EXPECT_FALSE(_heightmap.floor(0, 0, y)) << "The column is not yet paged in";
+	for (int x = -70; x < 70; x += 7) {
+		for (int z = -70; z < 70; z += 5) {
+			pageInColumn(x, z);
+			ASSERT_TRUE(_heightmap.floor(x, z, y));
+			EXPECT_EQ(terrainHeight(x, z), y) << "x: " << x << ", z: " << z;
+		}
+	}
+}
+
+TEST_F(SurfaceHeightmapTest, testUpdate) {
+	const int x = 8;
+	const int z = 3;
+	const int height = terrainHeight(x, z);
+	pageInColumn(x, z);
+
+	int y;
+	const glm::ivec3 above(x, 100, z);
+	const Voxel grass = createVoxel(VoxelType::Grass, 0);
+	_volData.setVoxel(above, grass);
+	_heightmap.update(above, grass);
+	ASSERT_TRUE(_heightmap.floor(x, z, y));
+	EXPECT_EQ(100, y);
+
+	_volData.setVoxel(above, Voxel());
+	_heightmap.update(above, Voxel());
+	ASSERT_TRUE(_heightmap.floor(x, z, y));
+	EXPECT_EQ(height, y);
+
+	const glm::ivec3 top(x, height, z);
+	const Voxel leaves = createVoxel(VoxelType::Leaf, 0);
+	_volData.setVoxel(top, leaves);
+	_heightmap.update(top, leaves);
+	ASSERT_TRUE(_heightmap.floor(x, z, y));
+	EXPECT_EQ(height - 1, y);
+}
+
+TEST_F(SurfaceHeightmapTest, testFlush) {
+	pageInColumn(1, 1);
+	int y;
+	EXPECT_TRUE(_heightmap.floor(1, 1, y));
+	_volData.flushAll();
+	EXPECT_FALSE(_heightmap.floor(1, 1, y));
+}
+
+}
@@ -0,0 +1,72 @@
+/**
+ * @file
+ */
+
+#include "AbstractVoxelTest.h"
+#include "voxel/generator/TreePrefab.h"
+#include "voxel/polyvox/RawVolumeWrapper.h"
+
+namespace voxel {
+
+class TreePrefabTest: public AbstractVoxelTest {
+};
+
+TEST_F(TreePrefabTest, testSetVoxelsAcrossChunks) {
+	const Voxel wood = createColorVoxel(VoxelType::Wood, 0);
+	Voxel voxels[10];
+	for (int i = 0; i < 10; ++i) {
+		voxels[i] = wood;
+	}
+	// the run starts inside of the chunk of the wrapper and continues in the chunk above
+	ASSERT_TRUE(_ctx.setVoxels(5, 58, 5, voxels, 10));
+	for (int y = 58; y < 68; ++y) {
+		EXPECT_TRUE(isWood(_volData.voxel(5, y, 5).getMaterial())) << "No wood at y: " << y;
+	}
+	EXPECT_FALSE(isWood(_volData.voxel(5, 57, 5).getMaterial()));
+	EXPECT_FALSE(isWood(_volData.voxel(5, 68, 5).getMaterial()));
+}
+
+TEST_F(TreePrefabTest, testPrefabRuns) {
+	const tree::TreePrefabCache cache;
+	const tree::TreePrefab& prefab = cache.prefab(TreeType::Ellipsis, 15, 0);
+	ASSERT_FALSE(prefab.empty());
+	EXPECT_EQ(&prefab, &cache.prefab(TreeType::Ellipsis, 16, 0)) << "Same size bucket should lead to the same prefab";
+	EXPECT_NE(&prefab, &cache.prefab(TreeType::Ellipsis, 15, 1));
+	size_t voxels = 0u;
+	bool trunk = false;
+	for (const tree::TreePrefabRun& run : prefab.runs()) {
+		ASSERT_GT(run.length, 0u);
+		ASSERT_EQ(voxels, run.offset);
+		voxels += run.length;
+		if (run.x == 0 && run.z == 0) {
+			trunk = run.y == 0 && isWood(prefab.voxels()[run.offset].getMaterial());
+		}
+	}
+	EXPECT_EQ(voxels, prefab.voxels().size());
+	EXPECT_TRUE(trunk) << "The trunk should start at the floor position";
+}
+
+TEST_F(TreePrefabTest, testStampTrunkToFloor) {
+	const tree::TreePrefabCache cache;
+	const tree::TreePrefab& prefab = cache.prefab(TreeType::Ellipsis, 12, 0);
+	const Region region(-32, 0, -32, 32, 127, 32);
+	RawVolume volume(region);
+	volume.setBorderValue(Voxel());
+	const Voxel dirt = createColorVoxel(VoxelType::Dirt, 0);
+	const int floor = MAX_WATER_HEIGHT + 10;
+	for (int z = region.getLowerZ(); z <= region.getUpperZ(); ++z) {
+		for (int x = region.getLowerX(); x <= region.getUpperX(); ++x) {
+			volume.setVoxel(x, floor, z, dirt);
+		}
+	}
+	RawVolumeWrapper wrapper(&volume);
+	// the tree is placed above the floor - the trunk must still reach it
+	const glm::ivec3 pos(0, floor + 5, 0);
+	prefab.stamp(wrapper, pos);
+	EXPECT_TRUE(isDirt(volume.voxel(0, floor, 0).getMaterial()));
+	for (int y = floor + 1; y <= pos.y; ++y) {
+		EXPECT_TRUE(isWood(volume.voxel(0, y, 0).getMaterial())) << "No trunk at y: " << y;
+	}
+}
+
+}
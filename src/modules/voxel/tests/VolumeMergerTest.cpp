@@ -57,4 +57,32 @@ TEST_F(VolumeMergerTest, testOffsets) {
 	ASSERT_EQ(smallVolume.voxel(regionSmall.getUpperCorner()), createVoxel(voxel::VoxelType::Grass, 0)) << smallVolume << ", " << bigVolume;
 }
 
+TEST_F(VolumeMergerTest, testFillRegion) {
+	voxel::RawVolume volume(voxel::Region(0, 9));
+	const voxel::Voxel vox = createVoxel(VoxelType::Grass, 1);
+	const voxel::Region fillRegion(2, 3);
+	EXPECT_EQ(8, volume.fill(fillRegion, vox));
+	EXPECT_EQ(0, volume.fill(fillRegion, vox)) << "The voxels were already set";
+	EXPECT_EQ(glm::ivec3(2), volume.mins());
+	EXPECT_EQ(glm::ivec3(3), volume.maxs());
+	EXPECT_TRUE(volume.voxel(3, 3, 3).isSame(vox));
+	EXPECT_FALSE(volume.voxel(4, 3, 3).isSame(vox));
+	EXPECT_EQ(0, volume.fill(voxel::Region(1, 4), createVoxel(VoxelType::Rock, 0), [] (const voxel::Voxel& v) {
+		return v.getMaterial() == VoxelType::Rock;
+	})) << "The condition doesn't match any voxel";
+}
+
+TEST_F(VolumeMergerTest, testCopyCropped) {
+	voxel::RawVolume source(voxel::Region(0, 3));
+	const voxel::Voxel vox = createVoxel(VoxelType::Grass, 0);
+	ASSERT_TRUE(source.setVoxel(glm::ivec3(2), vox));
+	ASSERT_TRUE(source.setVoxel(glm::ivec3(3), vox));
+	voxel::RawVolume target(voxel::Region(0, 4));
+	EXPECT_EQ(1, target.copy(source, source.region(), glm::ivec3(2)))
+		<< "Only the voxel at the lower corner of the target fits into the target";
+	EXPECT_EQ(target.voxel(glm::ivec3(4)), vox);
+	EXPECT_EQ(glm::ivec3(4), target.mins());
+	EXPECT_EQ(glm::ivec3(4), target.maxs());
+}
+
 }
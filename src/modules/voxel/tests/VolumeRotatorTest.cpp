@@ -79,4 +79,35 @@ TEST_F(VolumeRotatorTest, testRotate45YNoExtend) {
 	EXPECT_EQ(voxel::VoxelType::Rock, rotated->voxel(rotPos.x, rotPos.y, rotPos.z).getMaterial());
 }
 
+TEST_F(VolumeRotatorTest, testRotateY90NonCubic) {
+	const voxel::Region region(glm::ivec3(0), glm::ivec3(3, 1, 5));
+	voxel::RawVolume volume(region);
+	int color = 0;
+	for (int32_t z = region.getLowerZ(); z <= region.getUpperZ(); ++z) {
+		for (int32_t y = region.getLowerY(); y <= region.getUpperY(); ++y) {
+			for (int32_t x = region.getLowerX(); x <= region.getUpperX(); ++x) {
+				ASSERT_TRUE(volume.setVoxel(x, y, z, createVoxel(voxel::VoxelType::Grass, color++)));
+			}
+		}
+	}
+	voxel::RawVolume* rotated = voxel::rotateVolume(&volume, glm::ivec3(0, 90, 0), voxel::Voxel());
+	ASSERT_NE(nullptr, rotated);
+	EXPECT_EQ(6, rotated->width());
+	EXPECT_EQ(2, rotated->height());
+	EXPECT_EQ(4, rotated->depth());
+	std::unique_ptr<voxel::RawVolume> current(rotated);
+	for (int i = 0; i < 3; ++i) {
+		current.reset(voxel::rotateVolume(current.get(), glm::ivec3(0, 90, 0), voxel::Voxel()));
+		ASSERT_NE(nullptr, current);
+	}
+	ASSERT_EQ(region, current->region()) << str(current->region());
+	for (int32_t z = region.getLowerZ(); z <= region.getUpperZ(); ++z) {
+		for (int32_t y = region.getLowerY(); y <= region.getUpperY(); ++y) {
+			for (int32_t x = region.getLowerX(); x <= region.getUpperX(); ++x) {
+				ASSERT_TRUE(current->voxel(x, y, z).isSame(volume.voxel(x, y, z))) << x << ":" << y << ":" << z;
+			}
+		}
+	}
+}
+
 }
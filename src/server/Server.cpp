@@ -52,6 +52,11 @@ core::AppState Server::onConstruct() {
 	core::Var::get(cfg::ServerPort, "11337");
 	core::Var::get(cfg::ServerHost, "");
 	core::Var::get(cfg::ServerMaxClients, "1024");
+	core::Var::get(cfg::ServerNetworkThread, "true");
+	core::Var::get(cfg::ServerCapture, "");
+	core::Var::get(cfg::ServerReplay, "");
+	core::Var::get(cfg::ServerReplaySpeed, "1.0");
+	core::Var::get(cfg::ServerEntityUpdateInterval, "100");
 	core::Var::get(cfg::ServerSeed, "1");
 	core::Var::get(cfg::VoxelMeshSize, "16", core::CV_READONLY);
 	core::Var::get(cfg::DatabaseMinConnections, "2");
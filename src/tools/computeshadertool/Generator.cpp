@@ -132,6 +132,57 @@ bool generateSrc(const io::FilesystemPtr& filesystem,
 		kernels << "\t\treturn state;\n";
 		kernels << "\t}\n";
 
+		std::string upperName = k.name;
+		upperName[0] = SDL_toupper(upperName[0]);
+		kernels << "\n";
+		kernels << "\t/**\n";
+		kernels << "\t * @brief Native implementation of '" << k.name << "' for the host backend.\n";
+		kernels << "\t * Must process the flattened global work-items from @c range.begin to @c range.end (exclusive).\n";
+		kernels << "\t * @sa register" << upperName << "Host()\n";
+		kernels << "\t */\n";
+		kernels << "\ttypedef void (*" << k.name << "HostFunc)(\n\t\t";
+		for (const Parameter& p : k.parameters) {
+			const util::CLTypeMapping& clType = util::vectorType(p.type);
+			const bool readOnly = p.qualifier == "const" || (p.flags & compute::BufferFlag::ReadOnly) != compute::BufferFlag::None;
+			if (core::string::contains(p.type, "*")) {
+				if (readOnly) {
+					kernels << "const ";
+				}
+				kernels << clType.type << "* " << p.name;
+			} else if (clType.arraySize > 0) {
+				kernels << "const " << clType.type << "* " << p.name;
+			} else {
+				kernels << "const " << clType.type << "& " << p.name;
+			}
+			kernels << ",\n\t\t";
+		}
+		kernels << "const compute::HostWorkRange& range);\n";
+		kernels << "\n";
+		kernels << "\t/**\n";
+		kernels << "\t * @brief Registers the native implementation of '" << k.name << "' that is used if the\n";
+		kernels << "\t * compute module runs with @c compute::Backend::Host\n";
+		kernels << "\t * @note Must be called before @c setup()\n";
+		kernels << "\t */\n";
+		kernels << "\tstatic void register" << upperName << "Host(" << k.name << "HostFunc func) {\n";
+		kernels << "\t\tcompute::registerHostKernel(\"" << k.name << "\", [func] (const compute::HostKernelArgs& args, const compute::HostWorkRange& range) {\n";
+		kernels << "\t\t\tfunc(";
+		for (size_t i = 0; i < k.parameters.size(); ++i) {
+			const Parameter& p = k.parameters[i];
+			const util::CLTypeMapping& clType = util::vectorType(p.type);
+			const bool readOnly = p.qualifier == "const" || (p.flags & compute::BufferFlag::ReadOnly) != compute::BufferFlag::None;
+			if (core::string::contains(p.type, "*")) {
+				kernels << "args.buffer<" << (readOnly ? "const " : "") << clType.type << ">(" << i << ")";
+			} else if (clType.arraySize > 0) {
+				kernels << "&args.value<" << clType.type << ">(" << i << ")";
+			} else {
+				kernels << "args.value<" << clType.type << ">(" << i << ")";
+			}
+			kernels << ", ";
+		}
+		kernels << "range);\n";
+		kernels << "\t\t});\n";
+		kernels << "\t}\n";
+
 		kernelMembers << "\tcompute::Id _kernel" << k.name << " = compute::InvalidId;\n";
 
 		core_assert_always(k.returnValue.type == "void");
@@ -0,0 +1,211 @@
+/**
+ * @file
+ */
+
+#include "ClientMessages_generated.h"
+#include "Bot.h"
+#include "core/Password.h"
+#include "core/GLM.h"
+#include "core/Log.h"
+#include <algorithm>
+
+namespace loadtest {
+
+Bot::Bot(int id, const std::string& email, const std::string& password, const BotProfile& profile,
+		const network::ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const core::EventBusPtr& eventBus, BotStats& stats) :
+		_id(id), _email(email), _password(core::pwhash(password)), _profile(profile), _stats(stats), _random(id),
+		_network(std::make_shared<network::ClientNetwork>(protocolHandlerRegistry, eventBus)), _messageSender(_network) {
+}
+
+bool Bot::init() {
+	return _network->init();
+}
+
+void Bot::shutdown(uint64_t now) {
+	closeConnection(now, true);
+	_state = BotState::Done;
+}
+
+uint64_t Bot::nextActionMillis(uint64_t now, float perSecond) const {
+	if (perSecond <= 0.0f) {
+		return 0u;
+	}
+	// spread the actions of the bots to not let them act all in the same frame
+	const float intervalMillis = 1000.0f / perSecond;
+	return now + (uint64_t)_random.randomf(0.5f * intervalMillis, 1.5f * intervalMillis);
+}
+
+void Bot::start(const std::string& host, uint16_t port, uint64_t connectMillis) {
+	_host = host;
+	_port = port;
+	_connectMillis = connectMillis;
+	_state = BotState::Idle;
+}
+
+void Bot::connect(uint64_t now) {
+	ENetPeer* peer = _network->connect(_port, _host);
+	if (peer == nullptr) {
+		Log::error("Bot %i failed to connect to %s:%i", _id, _host.c_str(), (int)_port);
+		_state = BotState::Done;
+		return;
+	}
+	peer->data = this;
+	_state = BotState::Connecting;
+}
+
+void Bot::closeConnection(uint64_t now, bool logout) {
+	if (!_network->isConnected()) {
+		return;
+	}
+	if (logout && (_state == BotState::LoggingIn || _state == BotState::Playing)) {
+		_messageSender.sendClientMessage(_fbb, network::ClientMsgType::UserDisconnect, network::CreateUserDisconnect(_fbb).Union());
+	}
+	ENetPeer* peer = _network->peer();
+	if (peer != nullptr) {
+		peer->data = nullptr;
+	}
+	_sentBytes += _network->sentBytes();
+	_receivedBytes += _network->receivedBytes();
+	_network->disconnect();
+	_entityId = -1;
+	_targets.clear();
+}
+
+void Bot::update(uint64_t now) {
+	if (_state == BotState::Playing) {
+		_onlineMillis += now - _lastUpdateMillis;
+	}
+	_lastUpdateMillis = now;
+
+	switch (_state) {
+	case BotState::Idle:
+		if (now >= _connectMillis) {
+			connect(now);
+		}
+		break;
+	case BotState::Playing:
+		if (_sessionEndMillis > 0u && now >= _sessionEndMillis) {
+			closeConnection(now, true);
+			if (_profile.reconnectSeconds < 0.0f) {
+				_state = BotState::Done;
+			} else {
+				_state = BotState::Idle;
+				_connectMillis = now + (uint64_t)(_profile.reconnectSeconds * 1000.0f);
+			}
+			return;
+		}
+		if (_nextMoveMillis > 0u && now >= _nextMoveMillis) {
+			move(now);
+		}
+		if (_nextAttackMillis > 0u && now >= _nextAttackMillis) {
+			attack(now);
+		}
+		break;
+	case BotState::Connecting:
+	case BotState::LoggingIn:
+	case BotState::Done:
+		break;
+	}
+
+	if (_network->isConnected()) {
+		_network->update();
+	}
+}
+
+void Bot::move(uint64_t now) {
+	_nextMoveMillis = nextActionMillis(now, _profile.movesPerSecond);
+	// any combination of the four move direction flags - including standing still
+	const network::MoveDirection direction = (network::MoveDirection)_random.random(0, 15);
+	const float yaw = _random.randomf(0.0f, glm::two_pi<float>());
+	_messageSender.sendClientMessage(_fbb, network::ClientMsgType::Move, network::CreateMove(_fbb, direction, 0.0f, yaw).Union());
+	++_stats.moves;
+}
+
+void Bot::attack(uint64_t now) {
+	_nextAttackMillis = nextActionMillis(now, _profile.attacksPerSecond);
+	if (_targets.empty()) {
+		return;
+	}
+	const int64_t targetId = *_random.randomElement(_targets.begin(), _targets.end());
+	_messageSender.sendClientMessage(_fbb, network::ClientMsgType::Attack, network::CreateAttack(_fbb, targetId).Union());
+	++_stats.attacks;
+}
+
+void Bot::onConnected(uint64_t now) {
+	if (_state != BotState::Connecting) {
+		return;
+	}
+	_state = BotState::LoggingIn;
+	_loginMillis = now;
+	_messageSender.sendClientMessage(_fbb, network::ClientMsgType::UserConnect,
+			network::CreateUserConnect(_fbb, _fbb.CreateString(_email), _fbb.CreateString(_password)).Union());
+}
+
+void Bot::onDisconnected(uint64_t now) {
+	Log::debug("Bot %i was disconnected", _id);
+	++_stats.disconnects;
+	closeConnection(now, false);
+	if (_state == BotState::Done || _profile.reconnectSeconds < 0.0f) {
+		_state = BotState::Done;
+		return;
+	}
+	_state = BotState::Idle;
+	_connectMillis = now + (uint64_t)(_profile.reconnectSeconds * 1000.0f);
+}
+
+void Bot::onUserSpawn(int64_t entityId, uint64_t now) {
+	if (_state != BotState::LoggingIn) {
+		onEntitySpawn(entityId);
+		return;
+	}
+	_stats.loginMillis.push_back((uint32_t)(now - _loginMillis));
+	++_stats.logins;
+	_entityId = entityId;
+	_state = BotState::Playing;
+	_messageSender.sendClientMessage(_fbb, network::ClientMsgType::UserConnected, network::CreateUserConnected(_fbb).Union());
+	_sessionEndMillis = _profile.sessionSeconds > 0.0f ? now + (uint64_t)(_profile.sessionSeconds * 1000.0f) : 0u;
+	_nextMoveMillis = nextActionMillis(now, _profile.movesPerSecond);
+	_nextAttackMillis = nextActionMillis(now, _profile.attacksPerSecond);
+}
+
+void Bot::onEntitySpawn(int64_t entityId) {
+	if (entityId == _entityId) {
+		return;
+	}
+	// don't let the target list grow with the amount of bots
+	const size_t maxTargets = 16u;
+	if (_targets.size() >= maxTargets) {
+		_targets[_random.random(0, maxTargets - 1)] = entityId;
+		return;
+	}
+	_targets.push_back(entityId);
+}
+
+void Bot::onEntityRemove(int64_t entityId) {
+	auto i = std::find(_targets.begin(), _targets.end(), entityId);
+	if (i != _targets.end()) {
+		*i = _targets.back();
+		_targets.pop_back();
+	}
+}
+
+void Bot::onAuthFailed(uint64_t now) {
+	Log::error("Bot %i failed to log in with %s", _id, _email.c_str());
+	++_stats.authFailures;
+	closeConnection(now, false);
+	_state = BotState::Done;
+}
+
+void Bot::onMessage() {
+	++_stats.messages;
+}
+
+int Bot::roundTripMillis() const {
+	const ENetPeer* peer = _network->peer();
+	if (peer == nullptr || peer->state != ENET_PEER_STATE_CONNECTED) {
+		return -1;
+	}
+	return (int)peer->roundTripTime;
+}
+
+}
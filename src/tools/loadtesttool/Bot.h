@@ -0,0 +1,150 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "BotProfile.h"
+#include "network/ClientNetwork.h"
+#include "network/ClientMessageSender.h"
+#include "math/Random.h"
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+namespace loadtest {
+
+/**
+ * @brief The values that all bots are contributing to
+ */
+struct BotStats {
+	// the time between sending the login and receiving the spawn of the own user
+	std::vector<uint32_t> loginMillis;
+	uint32_t logins = 0u;
+	uint32_t authFailures = 0u;
+	uint32_t disconnects = 0u;
+	uint32_t moves = 0u;
+	uint32_t attacks = 0u;
+	uint32_t messages = 0u;
+};
+
+enum class BotState {
+	Idle,
+	Connecting,
+	LoggingIn,
+	Playing,
+	Done
+};
+
+/**
+ * @brief A headless user that logs into the server and acts according to its @c BotProfile
+ *
+ * Every bot has its own connection to the server - all bots are sharing the protocol handlers.
+ * The bot is put into the @c data pointer of its peer.
+ */
+class Bot {
+private:
+	const int _id;
+	const std::string _email;
+	const std::string _password;
+	const BotProfile& _profile;
+	BotStats& _stats;
+	math::Random _random;
+	network::ClientNetworkPtr _network;
+	network::ClientMessageSender _messageSender;
+	flatbuffers::FlatBufferBuilder _fbb;
+	std::string _host;
+	uint16_t _port = 0u;
+
+	BotState _state = BotState::Idle;
+	// the entity id of the own user
+	int64_t _entityId = -1;
+	// entities the bot has seen and might attack
+	std::vector<int64_t> _targets;
+
+	uint64_t _connectMillis = 0u;
+	uint64_t _loginMillis = 0u;
+	uint64_t _sessionEndMillis = 0u;
+	uint64_t _nextMoveMillis = 0u;
+	uint64_t _nextAttackMillis = 0u;
+	uint64_t _lastUpdateMillis = 0u;
+
+	uint64_t _onlineMillis = 0u;
+	uint64_t _sentBytes = 0u;
+	uint64_t _receivedBytes = 0u;
+
+	uint64_t nextActionMillis(uint64_t now, float perSecond) const;
+	void connect(uint64_t now);
+	void closeConnection(uint64_t now, bool logout);
+	void move(uint64_t now);
+	void attack(uint64_t now);
+public:
+	Bot(int id, const std::string& email, const std::string& password, const BotProfile& profile,
+			const network::ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const core::EventBusPtr& eventBus, BotStats& stats);
+
+	bool init();
+	/**
+	 * @brief Logs out and closes the connection
+	 */
+	void shutdown(uint64_t now);
+
+	/**
+	 * @brief Connect to the given server at the given time
+	 */
+	void start(const std::string& host, uint16_t port, uint64_t connectMillis);
+	void update(uint64_t now);
+
+	void onConnected(uint64_t now);
+	void onDisconnected(uint64_t now);
+	void onUserSpawn(int64_t entityId, uint64_t now);
+	void onEntitySpawn(int64_t entityId);
+	void onEntityRemove(int64_t entityId);
+	void onAuthFailed(uint64_t now);
+	void onMessage();
+
+	int id() const;
+	const BotProfile& profile() const;
+	BotState state() const;
+	/**
+	 * @return The round trip time in millis as measured by enet or @c -1 if there is no connection
+	 */
+	int roundTripMillis() const;
+	/**
+	 * @return The time the bot was logged in
+	 */
+	uint64_t onlineMillis() const;
+	/**
+	 * @return The bytes that were sent over all sessions of the bot
+	 */
+	uint64_t sentBytes() const;
+	/**
+	 * @return The bytes that were received over all sessions of the bot
+	 */
+	uint64_t receivedBytes() const;
+};
+
+inline int Bot::id() const {
+	return _id;
+}
+
+inline const BotProfile& Bot::profile() const {
+	return _profile;
+}
+
+inline BotState Bot::state() const {
+	return _state;
+}
+
+inline uint64_t Bot::onlineMillis() const {
+	return _onlineMillis;
+}
+
+inline uint64_t Bot::sentBytes() const {
+	return _sentBytes + _network->sentBytes();
+}
+
+inline uint64_t Bot::receivedBytes() const {
+	return _receivedBytes + _network->receivedBytes();
+}
+
+}
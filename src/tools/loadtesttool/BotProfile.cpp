@@ -0,0 +1,56 @@
+/**
+ * @file
+ */
+
+#include "BotProfile.h"
+#include "commonlua/LUA.h"
+#include "core/Log.h"
+
+namespace loadtest {
+
+bool loadBotProfiles(const std::string& luaString, BotProfiles& profiles) {
+	if (luaString.empty()) {
+		Log::error("Empty bot profile script given");
+		return false;
+	}
+	lua::LUA lua;
+	if (!lua.load(luaString)) {
+		Log::error("Could not load the bot profiles: %s", lua.error().c_str());
+		return false;
+	}
+	lua.globalKeyValue("profiles");
+	if (!lua_istable(lua.state(), -2)) {
+		Log::error("No profiles table found");
+		lua.pop(2);
+		return false;
+	}
+	while (lua.nextKeyValue()) {
+		if (!lua_istable(lua.state(), -1)) {
+			Log::warn("Skip invalid profile entry");
+			lua.pop(1);
+			continue;
+		}
+		BotProfile profile;
+		profile.name = lua.key();
+		profile.weight = lua.valueFloatFromTable("weight", profile.weight);
+		profile.movesPerSecond = lua.valueFloatFromTable("movesPerSecond", profile.movesPerSecond);
+		profile.attacksPerSecond = lua.valueFloatFromTable("attacksPerSecond", profile.attacksPerSecond);
+		profile.sessionSeconds = lua.valueFloatFromTable("sessionSeconds", profile.sessionSeconds);
+		profile.reconnectSeconds = lua.valueFloatFromTable("reconnectSeconds", profile.reconnectSeconds);
+		lua.pop(1);
+		if (profile.weight <= 0.0f) {
+			Log::warn("Skip profile %s without weight", profile.name.c_str());
+			continue;
+		}
+		Log::debug("Loaded bot profile %s", profile.name.c_str());
+		profiles.push_back(profile);
+	}
+	lua.pop(1);
+	if (profiles.empty()) {
+		Log::error("No valid bot profile found");
+		return false;
+	}
+	return true;
+}
+
+}
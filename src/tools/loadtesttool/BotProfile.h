@@ -0,0 +1,54 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace loadtest {
+
+/**
+ * @brief Describes how a bot behaves once it is logged into the server
+ */
+struct BotProfile {
+	std::string name;
+	/**
+	 * @brief The relative amount of bots that are using this profile
+	 */
+	float weight = 1.0f;
+	/**
+	 * @brief How often the bot changes its movement
+	 */
+	float movesPerSecond = 1.0f;
+	/**
+	 * @brief How often the bot attacks one of the entities it has seen
+	 */
+	float attacksPerSecond = 0.0f;
+	/**
+	 * @brief The time after which the bot disconnects - @c 0 means that it stays until the tool quits
+	 */
+	float sessionSeconds = 0.0f;
+	/**
+	 * @brief The time a disconnected bot waits before it logs in again - a negative value means that it
+	 * doesn't reconnect
+	 */
+	float reconnectSeconds = -1.0f;
+};
+
+typedef std::vector<BotProfile> BotProfiles;
+
+/**
+ * @brief Loads the profiles from the global @c profiles table of the given lua script
+ *
+ * @code
+ * profiles = {
+ *   walker = { weight = 3, movesPerSecond = 2, sessionSeconds = 120, reconnectSeconds = 5 },
+ *   fighter = { weight = 1, movesPerSecond = 1, attacksPerSecond = 1 }
+ * }
+ * @endcode
+ */
+extern bool loadBotProfiles(const std::string& luaString, BotProfiles& profiles);
+
+}
@@ -0,0 +1,73 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "ServerMessages_generated.h"
+#include "network/IMsgProtocolHandler.h"
+#include "Bot.h"
+#include "core/App.h"
+
+namespace loadtest {
+
+template<class MSGTYPE>
+class IBotProtocolHandler: public network::IMsgProtocolHandler<MSGTYPE, Bot> {
+public:
+	IBotProtocolHandler() :
+			network::IMsgProtocolHandler<MSGTYPE, Bot>(true) {
+	}
+
+	virtual ~IBotProtocolHandler() {
+	}
+
+	void execute(Bot* bot, const MSGTYPE* message) override {
+		bot->onMessage();
+		execute(bot, message, core::App::getInstance()->timeProvider()->tickMillis());
+	}
+
+	virtual void execute(Bot* bot, const MSGTYPE* message, uint64_t now) {
+	}
+};
+
+#define BOTPROTOHANDLER(msgType) \
+struct msgType##Handler: public IBotProtocolHandler<network::msgType> { \
+	using IBotProtocolHandler<network::msgType>::execute; \
+	void execute(Bot* bot, const network::msgType* message, uint64_t now) override; \
+}
+
+#define BOTPROTOHANDLERIMPL(msgType) \
+BOTPROTOHANDLER(msgType); \
+inline void msgType##Handler::execute(Bot* bot, const network::msgType* message, uint64_t now)
+
+/**
+ * @brief Only counts the message
+ */
+#define BOTPROTOHANDLERIGNORE(msgType) \
+struct msgType##Handler: public IBotProtocolHandler<network::msgType> { \
+}
+
+BOTPROTOHANDLERIMPL(UserSpawn) {
+	bot->onUserSpawn(message->id(), now);
+}
+
+BOTPROTOHANDLERIMPL(EntitySpawn) {
+	bot->onEntitySpawn(message->id());
+}
+
+BOTPROTOHANDLERIMPL(EntityRemove) {
+	bot->onEntityRemove(message->id());
+}
+
+BOTPROTOHANDLERIMPL(AuthFailed) {
+	bot->onAuthFailed(now);
+}
+
+BOTPROTOHANDLERIGNORE(Seed);
+BOTPROTOHANDLERIGNORE(EntityUpdate);
+BOTPROTOHANDLERIGNORE(AttribUpdate);
+BOTPROTOHANDLERIGNORE(StartCooldown);
+BOTPROTOHANDLERIGNORE(StopCooldown);
+BOTPROTOHANDLERIGNORE(VoxelUpdate);
+
+}
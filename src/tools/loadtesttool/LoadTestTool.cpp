@@ -0,0 +1,248 @@
+/**
+ * @file
+ */
+
+#include "LoadTestTool.h"
+#include "BotProtocolHandlers.h"
+#include "io/Filesystem.h"
+#include "engine-config.h"
+#include "core/String.h"
+#include "core/Log.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @param[in] values Must be sorted
+ */
+uint32_t percentile(const std::vector<uint32_t>& values, float p) {
+	if (values.empty()) {
+		return 0u;
+	}
+	const size_t index = (size_t)(p * (float)(values.size() - 1) + 0.5f);
+	return values[(std::min)(index, values.size() - 1)];
+}
+
+void logPercentiles(const char* name, std::vector<uint32_t> values) {
+	if (values.empty()) {
+		Log::info("%s: no samples", name);
+		return;
+	}
+	std::sort(values.begin(), values.end());
+	Log::info("%s: p50 %u, p90 %u, p99 %u, max %u (%i samples)", name, percentile(values, 0.5f),
+			percentile(values, 0.9f), percentile(values, 0.99f), values.back(), (int)values.size());
+}
+
+}
+
+LoadTestTool::LoadTestTool(const network::ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const io::FilesystemPtr& filesystem,
+		const core::EventBusPtr& eventBus, const core::TimeProviderPtr& timeProvider) :
+		Super(filesystem, eventBus, timeProvider, 0), _protocolHandlerRegistry(protocolHandlerRegistry) {
+	// this ensures that we are sleeping 1 millisecond if there is enough room for it
+	setFramesPerSecondsCap(1000.0);
+	init(ORGANISATION, "loadtesttool");
+}
+
+void LoadTestTool::onEvent(const network::NewConnectionEvent& event) {
+	loadtest::Bot* bot = reinterpret_cast<loadtest::Bot*>(event.peer()->data);
+	if (bot == nullptr) {
+		return;
+	}
+	bot->onConnected(_now);
+}
+
+void LoadTestTool::onEvent(const network::DisconnectEvent& event) {
+	loadtest::Bot* bot = reinterpret_cast<loadtest::Bot*>(event.peer()->data);
+	if (bot == nullptr) {
+		return;
+	}
+	bot->onDisconnected(_now);
+}
+
+core::AppState LoadTestTool::onConstruct() {
+	registerArg("--host").setDescription("The host the server is running on").setDefaultValue(SERVER_HOST);
+	registerArg("--port").setShort("-p").setDescription("The port the server is listening on").setDefaultValue(SERVER_PORT);
+	registerArg("--bots").setShort("-b").setDescription("The amount of bots to spawn").setDefaultValue("100");
+	registerArg("--rampup").setShort("-r").setDescription("The amount of bots that connect per second").setDefaultValue("50");
+	registerArg("--duration").setShort("-d").setDescription("The seconds to run the test - 0 runs until the tool is stopped").setDefaultValue("60");
+	registerArg("--profiles").setDescription("The lua file with the bot profiles").setDefaultValue("botprofiles.lua");
+	registerArg("--email").setDescription("The printf pattern for the login of the bots - gets the bot index").setDefaultValue("bot%i@engine.local");
+	registerArg("--password").setDescription("The password of the bot users").setDefaultValue("bot");
+	registerArg("--metricport").setDescription("The port to receive the server metrics on - 0 disables it").setDefaultValue("8125");
+	registerArg("--report").setDescription("The seconds between two reports").setDefaultValue("5");
+	return Super::onConstruct();
+}
+
+const loadtest::BotProfile& LoadTestTool::selectProfile(const math::Random& random) const {
+	float weightSum = 0.0f;
+	for (const loadtest::BotProfile& profile : _profiles) {
+		weightSum += profile.weight;
+	}
+	float weight = random.randomf(0.0f, weightSum);
+	for (const loadtest::BotProfile& profile : _profiles) {
+		if (weight < profile.weight) {
+			return profile;
+		}
+		weight -= profile.weight;
+	}
+	return _profiles.back();
+}
+
+core::AppState LoadTestTool::onInit() {
+	const core::AppState state = Super::onInit();
+	if (state != core::AppState::Running) {
+		return state;
+	}
+
+	const std::string& profilesFile = getArgVal("--profiles");
+	if (!loadtest::loadBotProfiles(filesystem()->load(profilesFile), _profiles)) {
+		Log::error("Failed to load the bot profiles from %s", profilesFile.c_str());
+		return core::AppState::InitFailure;
+	}
+
+	const network::ProtocolHandlerRegistryPtr& r = _protocolHandlerRegistry;
+	r->registerHandler(network::ServerMsgType::Seed, std::make_shared<loadtest::SeedHandler>());
+	r->registerHandler(network::ServerMsgType::UserSpawn, std::make_shared<loadtest::UserSpawnHandler>());
+	r->registerHandler(network::ServerMsgType::EntitySpawn, std::make_shared<loadtest::EntitySpawnHandler>());
+	r->registerHandler(network::ServerMsgType::EntityRemove, std::make_shared<loadtest::EntityRemoveHandler>());
+	r->registerHandler(network::ServerMsgType::EntityUpdate, std::make_shared<loadtest::EntityUpdateHandler>());
+	r->registerHandler(network::ServerMsgType::AuthFailed, std::make_shared<loadtest::AuthFailedHandler>());
+	r->registerHandler(network::ServerMsgType::AttribUpdate, std::make_shared<loadtest::AttribUpdateHandler>());
+	r->registerHandler(network::ServerMsgType::StartCooldown, std::make_shared<loadtest::StartCooldownHandler>());
+	r->registerHandler(network::ServerMsgType::StopCooldown, std::make_shared<loadtest::StopCooldownHandler>());
+	r->registerHandler(network::ServerMsgType::VoxelUpdate, std::make_shared<loadtest::VoxelUpdateHandler>());
+
+	eventBus()->subscribe<network::NewConnectionEvent>(*this);
+	eventBus()->subscribe<network::DisconnectEvent>(*this);
+
+	const int metricPort = core::string::toInt(getArgVal("--metricport"));
+	if (metricPort > 0 && !_metricListener.init((uint16_t)metricPort)) {
+		Log::warn("Server metrics are not available");
+	}
+
+	const int bots = (std::max)(1, core::string::toInt(getArgVal("--bots")));
+	const float rampUp = (std::max)(0.001f, core::string::toFloat(getArgVal("--rampup")));
+	const std::string& host = getArgVal("--host");
+	const uint16_t port = (uint16_t)core::string::toInt(getArgVal("--port"));
+	const std::string& emailPattern = getArgVal("--email");
+	const std::string& password = getArgVal("--password");
+
+	const math::Random random(0u);
+	_bots.reserve(bots);
+	for (int i = 0; i < bots; ++i) {
+		char email[256];
+		SDL_snprintf(email, sizeof(email), emailPattern.c_str(), i + 1);
+		const loadtest::BotProfile& profile = selectProfile(random);
+		std::unique_ptr<loadtest::Bot> bot(new loadtest::Bot(i + 1, email, password, profile, _protocolHandlerRegistry, eventBus(), _stats));
+		// init all connections before the first bot connects - the enet init resets the enet time
+		if (!bot->init()) {
+			Log::error("Failed to initialize the network for bot %i", i + 1);
+			return core::AppState::InitFailure;
+		}
+		bot->start(host, port, _now + (uint64_t)((float)i * 1000.0f / rampUp));
+		_bots.push_back(std::move(bot));
+	}
+	Log::info("Spawning %i bots against %s:%i with %.1f bots per second", bots, host.c_str(), (int)port, rampUp);
+
+	const int duration = core::string::toInt(getArgVal("--duration"));
+	_endMillis = duration > 0 ? _now + (uint64_t)duration * 1000u : 0u;
+	_reportIntervalMillis = (uint64_t)(std::max)(1, core::string::toInt(getArgVal("--report"))) * 1000u;
+	_nextReportMillis = _now + _reportIntervalMillis;
+
+	return state;
+}
+
+void LoadTestTool::report(bool final) {
+	int connecting = 0;
+	int playing = 0;
+	int done = 0;
+	uint64_t onlineMillis = 0u;
+	uint64_t sentBytes = 0u;
+	uint64_t receivedBytes = 0u;
+	for (const auto& bot : _bots) {
+		switch (bot->state()) {
+		case loadtest::BotState::Connecting:
+		case loadtest::BotState::LoggingIn:
+			++connecting;
+			break;
+		case loadtest::BotState::Playing:
+			++playing;
+			break;
+		case loadtest::BotState::Done:
+			++done;
+			break;
+		case loadtest::BotState::Idle:
+			break;
+		}
+		if (!final) {
+			const int rtt = bot->roundTripMillis();
+			if (rtt >= 0) {
+				_roundTripMillis.push_back((uint32_t)rtt);
+			}
+		}
+		onlineMillis += bot->onlineMillis();
+		sentBytes += bot->sentBytes();
+		receivedBytes += bot->receivedBytes();
+	}
+
+	Log::info("%s after %i seconds", final ? "Final report" : "Report", (int)lifetimeInSeconds());
+	Log::info("bots: %i connecting, %i playing, %i done - logins: %u, auth failures: %u, disconnects: %u",
+			connecting, playing, done, _stats.logins, _stats.authFailures, _stats.disconnects);
+	Log::info("sent moves: %u, sent attacks: %u, received messages: %u", _stats.moves, _stats.attacks, _stats.messages);
+	logPercentiles("login latency (ms)", _stats.loginMillis);
+	logPercentiles("round trip time (ms)", _roundTripMillis);
+	if (onlineMillis > 0u) {
+		const double onlineSeconds = (double)onlineMillis / 1000.0;
+		Log::info("bandwidth per user: %.1f bytes/s up, %.1f bytes/s down", (double)sentBytes / onlineSeconds,
+				(double)receivedBytes / onlineSeconds);
+	}
+	int tickAvg;
+	int tickMax;
+	int ticks;
+	if (_metricListener.value("server.tick.avg_us", tickAvg) && _metricListener.value("server.tick.max_us", tickMax)
+			&& _metricListener.value("server.tick.count", ticks)) {
+		Log::info("server tick: avg %i us, max %i us, %i ticks/s", tickAvg, tickMax, ticks);
+	}
+}
+
+core::AppState LoadTestTool::onRunning() {
+	// the console app would quit after the first frame
+	Super::onRunning();
+
+	for (const auto& bot : _bots) {
+		bot->update(_now);
+	}
+	_metricListener.update();
+
+	if (_now >= _nextReportMillis) {
+		report(false);
+		_nextReportMillis = _now + _reportIntervalMillis;
+	}
+	if (_endMillis > 0u && _now >= _endMillis) {
+		return core::AppState::Cleanup;
+	}
+	return core::AppState::Running;
+}
+
+core::AppState LoadTestTool::onCleanup() {
+	eventBus()->unsubscribe<network::NewConnectionEvent>(*this);
+	eventBus()->unsubscribe<network::DisconnectEvent>(*this);
+	for (const auto& bot : _bots) {
+		bot->shutdown(_now);
+	}
+	if (!_bots.empty()) {
+		report(true);
+	}
+	_bots.clear();
+	_metricListener.shutdown();
+	return Super::onCleanup();
+}
+
+int main(int argc, char *argv[]) {
+	const core::EventBusPtr eventBus = std::make_shared<core::EventBus>();
+	const io::FilesystemPtr filesystem = std::make_shared<io::Filesystem>();
+	const core::TimeProviderPtr timeProvider = std::make_shared<core::TimeProvider>();
+	const network::ProtocolHandlerRegistryPtr protocolHandlerRegistry = std::make_shared<network::ProtocolHandlerRegistry>();
+	LoadTestTool app(protocolHandlerRegistry, filesystem, eventBus, timeProvider);
+	return app.startMainLoop(argc, argv);
+}
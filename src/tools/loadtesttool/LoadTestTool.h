@@ -0,0 +1,53 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+#include "core/ConsoleApp.h"
+#include "network/NetworkEvents.h"
+#include "network/ProtocolHandlerRegistry.h"
+#include "Bot.h"
+#include "BotProfile.h"
+#include "MetricListener.h"
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Headless tool that puts load on the server by letting a swarm of bots log in, move, attack and
+ * disconnect according to the profiles in @c botprofiles.lua
+ *
+ * The tool periodically reports the login and the round trip latencies, the bandwidth per user and - if
+ * the server sends its metrics to the tool - the server tick time.
+ */
+class LoadTestTool: public core::ConsoleApp,
+		public core::IEventBusHandler<network::NewConnectionEvent>,
+		public core::IEventBusHandler<network::DisconnectEvent> {
+private:
+	using Super = core::ConsoleApp;
+	network::ProtocolHandlerRegistryPtr _protocolHandlerRegistry;
+	loadtest::BotProfiles _profiles;
+	std::vector<std::unique_ptr<loadtest::Bot> > _bots;
+	loadtest::BotStats _stats;
+	loadtest::MetricListener _metricListener;
+	// the round trip times of all connected bots - sampled with every report
+	std::vector<uint32_t> _roundTripMillis;
+
+	uint64_t _endMillis = 0u;
+	uint64_t _reportIntervalMillis = 0u;
+	uint64_t _nextReportMillis = 0u;
+
+	const loadtest::BotProfile& selectProfile(const math::Random& random) const;
+	void report(bool final);
+public:
+	LoadTestTool(const network::ProtocolHandlerRegistryPtr& protocolHandlerRegistry, const io::FilesystemPtr& filesystem,
+			const core::EventBusPtr& eventBus, const core::TimeProviderPtr& timeProvider);
+
+	void onEvent(const network::NewConnectionEvent& event) override;
+	void onEvent(const network::DisconnectEvent& event) override;
+
+	core::AppState onConstruct() override;
+	core::AppState onInit() override;
+	core::AppState onRunning() override;
+	core::AppState onCleanup() override;
+};
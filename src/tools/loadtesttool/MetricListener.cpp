@@ -0,0 +1,79 @@
+/**
+ * @file
+ */
+
+#include "MetricListener.h"
+#include "core/Log.h"
+#include <string.h>
+#include <stdlib.h>
+
+namespace loadtest {
+
+MetricListener::~MetricListener() {
+	shutdown();
+}
+
+bool MetricListener::init(uint16_t port) {
+	_socket = enet_socket_create(ENET_SOCKET_TYPE_DATAGRAM);
+	if (_socket == ENET_SOCKET_NULL) {
+		Log::error("Failed to create the metric socket");
+		return false;
+	}
+	ENetAddress address;
+	address.host = ENET_HOST_ANY;
+	address.port = port;
+	if (enet_socket_bind(_socket, &address) != 0) {
+		Log::error("Failed to bind the metric socket to port %i", (int)port);
+		shutdown();
+		return false;
+	}
+	enet_socket_set_option(_socket, ENET_SOCKOPT_NONBLOCK, 1);
+	Log::info("Listening for server metrics on port %i", (int)port);
+	return true;
+}
+
+void MetricListener::shutdown() {
+	if (_socket != ENET_SOCKET_NULL) {
+		enet_socket_destroy(_socket);
+	}
+	_socket = ENET_SOCKET_NULL;
+}
+
+void MetricListener::parse(const char* line) {
+	// <key>[,<tags>]:<value>|<type>[|#<tags>]
+	const char* valueStart = strchr(line, ':');
+	if (valueStart == nullptr) {
+		return;
+	}
+	const size_t keyLength = strcspn(line, ",:");
+	_values[std::string(line, keyLength)] = atoi(valueStart + 1);
+}
+
+void MetricListener::update() {
+	if (_socket == ENET_SOCKET_NULL) {
+		return;
+	}
+	char buf[512];
+	ENetBuffer buffer;
+	buffer.data = buf;
+	buffer.dataLength = sizeof(buf) - 1;
+	for (;;) {
+		const int length = enet_socket_receive(_socket, nullptr, &buffer, 1);
+		if (length <= 0) {
+			break;
+		}
+		buf[length] = '\0';
+		parse(buf);
+	}
+}
+
+bool MetricListener::value(const std::string& key, int& value) const {
+	auto i = _values.find(key);
+	if (i == _values.end()) {
+		return false;
+	}
+	value = i->second;
+	return true;
+}
+
+}
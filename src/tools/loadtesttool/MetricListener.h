@@ -0,0 +1,46 @@
+/**
+ * @file
+ */
+
+#pragma once
+
+extern "C" {
+#include <enet/enet.h>
+}
+#include <map>
+#include <string>
+#include <stdint.h>
+
+namespace loadtest {
+
+/**
+ * @brief Receives the statsd metrics that the server is sending (see @c metric::Metric)
+ *
+ * Only the latest value of every key is kept - the server must be configured to send the
+ * metrics to the host the tool is running on.
+ */
+class MetricListener {
+private:
+	ENetSocket _socket = ENET_SOCKET_NULL;
+	std::map<std::string, int> _values;
+
+	void parse(const char* line);
+public:
+	~MetricListener();
+
+	bool init(uint16_t port);
+	void shutdown();
+
+	/**
+	 * @brief Reads all pending metrics from the socket
+	 */
+	void update();
+
+	/**
+	 * @param key The metric key including the prefix (e.g. @c server.tick.avg_us)
+	 * @return @c false if the metric wasn't received yet
+	 */
+	bool value(const std::string& key, int& value) const;
+};
+
+}
@@ -26,6 +26,20 @@ public:
 	}
 };
 
+class StateDeltaHandler: public ProtocolHandler<AIStateDeltaMessage> {
+private:
+	AIDebugger& _aiDebugger;
+public:
+	StateDeltaHandler (AIDebugger& aiDebugger) :
+			_aiDebugger(aiDebugger) {
+	}
+
+	void execute(const ClientId&, const AIStateDeltaMessage* msg) override {
+		_aiDebugger.updateEntities(msg->getStates(), msg->getRemoved());
+		emit _aiDebugger.onEntitiesUpdated();
+	}
+};
+
 class CharacterHandler: public ProtocolHandler<AICharacterDetailsMessage> {
 private:
 	AIDebugger& _aiDebugger;
@@ -84,7 +98,7 @@ public:
 };
 
 AIDebugger::AIDebugger(AINodeStaticResolver& resolver) :
-		QObject(), _stateHandler(new StateHandler(*this)), _characterHandler(new CharacterHandler(*this)), _characterStaticHandler(
+		QObject(), _stateHandler(new StateHandler(*this)), _stateDeltaHandler(new StateDeltaHandler(*this)), _characterHandler(new CharacterHandler(*this)), _characterStaticHandler(
 				new CharacterStaticHandler(*this)), _pauseHandler(new PauseHandler(*this)), _namesHandler(new NamesHandler(*this)), _nopHandler(
 				new NopHandler()), _selectedId(AI_NOTHING_SELECTED), _socket(this), _pause(false), _resolver(resolver) {
 	connect(&_socket, SIGNAL(readyRead()), SLOT(readTcpData()));
@@ -92,6 +106,7 @@ AIDebugger::AIDebugger(AINodeStaticResolver& resolver) :
 
 	ai::ProtocolHandlerRegistry& r = ai::ProtocolHandlerRegistry::get();
 	r.registerHandler(ai::PROTO_STATE, _stateHandler);
+	r.registerHandler(ai::PROTO_STATE_DELTA, _stateDeltaHandler);
 	r.registerHandler(ai::PROTO_CHARACTER_DETAILS, _characterHandler);
 	r.registerHandler(ai::PROTO_CHARACTER_STATIC, _characterStaticHandler);
 	r.registerHandler(ai::PROTO_PAUSE, _pauseHandler);
@@ -102,6 +117,7 @@ AIDebugger::AIDebugger(AINodeStaticResolver& resolver) :
 AIDebugger::~AIDebugger() {
 	disconnectFromAIServer();
 	delete _stateHandler;
+	delete _stateDeltaHandler;
 	delete _characterHandler;
 	delete _characterStaticHandler;
 	delete _pauseHandler;
@@ -199,6 +215,10 @@ void AIDebugger::change(const QString& name) {
 	writeMessage(AIChangeMessage(name.toStdString()));
 }
 
+void AIDebugger::setFilter(const AIStateFilter& filter) {
+	writeMessage(AIFilterMessage(filter));
+}
+
 void AIDebugger::updateNode(int32_t nodeId, const QVariant& name, const QVariant& type, const QVariant& condition) {
 	writeMessage(AIUpdateNodeMessage(nodeId, _selectedId, name.toString().toStdString(), type.toString().toStdString(), condition.toString().toStdString()));
 }
@@ -328,5 +348,14 @@ void AIDebugger::setEntities(const std::vector<AIStateWorld>& entities) {
 //	unselect();
 }
 
+void AIDebugger::updateEntities(const std::vector<AIStateWorld>& entities, const std::vector<CharacterId>& removed) {
+	for (const CharacterId& id : removed) {
+		_entities.remove(id);
+	}
+	for (const AIStateWorld& state : entities) {
+		_entities.insert(state.getId(), state);
+	}
+}
+
 }
 }
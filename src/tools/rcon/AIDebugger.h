@@ -41,6 +41,7 @@ protected:
 
 	// the network protocol message handlers
 	ai::IProtocolHandler *_stateHandler;
+	ai::IProtocolHandler *_stateDeltaHandler;
 	ai::IProtocolHandler *_characterHandler;
 	ai::IProtocolHandler *_characterStaticHandler;
 	ai::IProtocolHandler *_pauseHandler;
@@ -78,6 +79,10 @@ public:
 	 */
 	const Entities& getEntities() const;
 	void setEntities(const std::vector<AIStateWorld>& entities);
+	/**
+	 * @brief Applies the changes of the entities since the last update
+	 */
+	void updateEntities(const std::vector<AIStateWorld>& entities, const std::vector<CharacterId>& removed);
 	void setCharacterDetails(const CharacterId& id, const AIStateAggro& aggro, const AIStateNode& node);
 	void addCharacterStaticData(const AICharacterStaticMessage& msg);
 	void setNames(const std::vector<std::string>& names);
@@ -108,6 +113,10 @@ public:
 	void step();
 	void reset();
 	void change(const QString& name);
+	/**
+	 * @brief Limits the entities the server is sending the states for
+	 */
+	void setFilter(const AIStateFilter& filter);
 	void updateNode(int32_t nodeId, const QVariant& name, const QVariant& type, const QVariant& condition);
 	void deleteNode(int32_t nodeId);
 	void addNode(int32_t parentNodeId, const QVariant& name, const QVariant& type, const QVariant& condition);
@@ -103,7 +103,9 @@ core::AppState ShapeTool::onInit() {
 	glm::vec3 targetPos = _camera.position();
 	targetPos.x += 1000.0f;
 	targetPos.z += 1000.0f;
-	_entity->lerpPosition(targetPos, _entity->orientation());
+	// move the entity to the target position within 200 millis
+	_entity->addSnapshot(0u, _entity->position(), _entity->orientation());
+	_entity->addSnapshot(200u, targetPos, _entity->orientation());
 
 	_worldTimer.init();
 
@@ -427,8 +427,8 @@ void Model::paste() {
 	voxel::RawVolume* cursorVolume = cursorPositionVolume();
 	const voxel::Region& srcRegion = cursorVolume->region();
 	const voxel::Region destRegion = srcRegion + _cursorPos;
-	voxel::RawVolumeWrapper wrapper(modelVolume());
-	voxel::mergeVolumes(&wrapper, cursorVolume, destRegion, srcRegion);
+	// the parts of the cursor volume that are outside of the model are skipped
+	voxel::mergeVolumes(modelVolume(), cursorVolume, destRegion, srcRegion);
 }
 
 void Model::cut() {
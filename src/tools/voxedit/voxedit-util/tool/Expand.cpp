@@ -4,7 +4,6 @@
 
 #include "Expand.h"
 #include "voxel/polyvox/VolumeMerger.h"
-#include "voxel/polyvox/RawVolumeWrapper.h"
 
 namespace voxedit {
 namespace tool {
@@ -18,8 +17,7 @@ voxel::RawVolume* expand(const voxel::RawVolume* source, const glm::ivec3& size)
 	voxel::RawVolume* newVolume = new voxel::RawVolume(region);
 	const voxel::Region& destRegion = source->region();
 	const voxel::Region& srcRegion = source->region();
-	voxel::RawVolumeWrapper wrapper(newVolume);
-	voxel::mergeVolumes(&wrapper, source, destRegion, srcRegion);
+	voxel::mergeVolumes(newVolume, source, destRegion, srcRegion);
 	return newVolume;
 }
 